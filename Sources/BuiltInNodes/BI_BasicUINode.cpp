@@ -104,6 +104,12 @@ bool BasicUINode::RegisterFeature (const NodeFeaturePtr& newFeature)
 	return true;
 }
 
+NE::Stream::Status BasicUINode::WriteFeatures (NE::OutputStream& outputStream) const
+{
+	// the features change the calculation, so they are part of the calculation settings
+	return nodeFeatureSet.Write (outputStream);
+}
+
 NUIE::EventHandlerResult BasicUINode::HandleMouseClick (NUIE::NodeUIEnvironment& env, const NUIE::ModifierKeys& modifierKeys, NUIE::MouseButton mouseButton, const NUIE::Point& position, NUIE::UINodeCommandInterface& commandInterface)
 {
 	return layout->HandleMouseClick (*this, env, modifierKeys, mouseButton, position, commandInterface);
@@ -1,8 +1,12 @@
 #include "BI_BinaryOperationNodes.hpp"
+#include "BI_BuiltInSlotIds.hpp"
 #include "NE_Localization.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_Debug.hpp"
 #include "NUIE_NodeCommonParameters.hpp"
 
 #include <cmath>
+#include <algorithm>
 
 namespace BI
 {
@@ -31,27 +35,50 @@ BinaryOperationNode::~BinaryOperationNode ()
 
 void BinaryOperationNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("a"), NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("b"), NE::LocString (L"B"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("result"), NE::LocString (L"Result"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (ASlotId, NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (BSlotId, NE::LocString (L"B"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (ResultSlotId, NE::LocString (L"Result"))));
 	RegisterFeature (NodeFeaturePtr (new ValueCombinationFeature (NE::ValueCombinationMode::Longest)));
 }
 
 NE::ValueConstPtr BinaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr aValue = EvaluateInputSlot (NE::SlotId ("a"), env);
-	NE::ValueConstPtr bValue = EvaluateInputSlot (NE::SlotId ("b"), env);
+	return CalculateHandle (env);
+}
+
+NE::ValueHandle BinaryOperationNode::CalculateHandle (NE::EvaluationEnv& env) const
+{
+	// single numbers are calculated without boxing them into values
+	NE::ValueHandle aHandle = EvaluateInputSlot (ASlotId, env);
+	NE::ValueHandle bHandle = EvaluateInputSlot (BSlotId, env);
+	if (aHandle.IsNumber () && bHandle.IsNumber ()) {
+		return DoSingleOperation (aHandle.ToDouble (), bHandle.ToDouble ());
+	}
+
+	NE::ValueConstPtr aValue = aHandle;
+	NE::ValueConstPtr bValue = bHandle;
 	if (!NE::IsComplexType<NE::NumberValue> (aValue) || !NE::IsComplexType<NE::NumberValue> (bValue)) {
 		return nullptr;
 	}
 
-	if (NE::IsSingleValue (aValue) && NE::IsSingleValue (bValue)) {
-		return DoSingleOperation (aValue, bValue);
+	std::shared_ptr<ValueCombinationFeature> valueCombination = GetValueCombinationFeature (this);
+	NumberSequence aSequence;
+	NumberSequence bSequence;
+	if (aSequence.Set (aValue) && bSequence.Set (bValue)) {
+		NE::ValuePtr result = DoSequenceOperation (valueCombination->GetValueCombinationMode (), aSequence, bSequence);
+		if (result != nullptr) {
+			return result;
+		}
+	}
+
+	NumberArray aNumbers;
+	NumberArray bNumbers;
+	if (aNumbers.Set (aValue) && bNumbers.Set (bValue)) {
+		return DoArrayOperation (valueCombination->GetValueCombinationMode (), aNumbers, bNumbers);
 	} else {
 		NE::ListValuePtr resultListValue (new NE::ListValue ());
-		std::shared_ptr<ValueCombinationFeature> valueCombination = GetValueCombinationFeature (this);
 		bool isValid = valueCombination->CombineValues ({ aValue, bValue }, [&] (const NE::ValueCombination& combination) {
-			NE::ValuePtr result = DoSingleOperation (combination.GetValue (0), combination.GetValue (1));
+			NE::ValueHandle result = DoSingleOperation (NE::NumberValue::ToDouble (combination.GetValue (0)), NE::NumberValue::ToDouble (combination.GetValue (1)));
 			if (result == nullptr) {
 				return false;
 			}
@@ -68,8 +95,8 @@ NE::ValueConstPtr BinaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 void BinaryOperationNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, NE::SlotId ("a"), NE::LocString (L"A"), NUIE::ParameterType::Double);
-	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, NE::SlotId ("b"), NE::LocString (L"B"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, ASlotId, NE::LocString (L"A"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, BSlotId, NE::LocString (L"B"), NUIE::ParameterType::Double);
 }
 
 bool BinaryOperationNode::IsForceCalculated () const
@@ -77,6 +104,16 @@ bool BinaryOperationNode::IsForceCalculated () const
 	return true;
 }
 
+bool BinaryOperationNode::IsThreadSafe () const
+{
+	return true;
+}
+
+bool BinaryOperationNode::IsCalculatedValueProcessed () const
+{
+	return false;
+}
+
 NE::Stream::Status BinaryOperationNode::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -91,15 +128,91 @@ NE::Stream::Status BinaryOperationNode::Write (NE::OutputStream& outputStream) c
 	return outputStream.GetStatus ();
 }
 
-NE::ValuePtr BinaryOperationNode::DoSingleOperation (const NE::ValueConstPtr& aValue, const NE::ValueConstPtr& bValue) const
+NE::Stream::Status BinaryOperationNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
 {
-	double aDouble = NE::NumberValue::ToDouble (aValue);
-	double bDouble = NE::NumberValue::ToDouble (bValue);
-	double result = DoOperation (aDouble, bDouble);
+	return WriteFeatures (outputStream);
+}
+
+NE::ValueHandle BinaryOperationNode::DoSingleOperation (double a, double b) const
+{
+	double result = DoOperation (a, b);
 	if (std::isnan (result) || std::isinf (result)) {
 		return nullptr;
 	}
-	return NE::ValuePtr (new NE::DoubleValue (result));
+	return NE::ValueHandle (result);
+}
+
+NE::ValuePtr BinaryOperationNode::DoArrayOperation (NE::ValueCombinationMode combinationMode, const NumberArray& aNumbers, const NumberArray& bNumbers) const
+{
+	const double* a = aNumbers.GetData ();
+	const double* b = bNumbers.GetData ();
+	size_t aSize = aNumbers.GetSize ();
+	size_t bSize = bNumbers.GetSize ();
+	if (DBGERROR (aSize == 0 || bSize == 0)) {
+		return nullptr;
+	}
+
+	NE::ValueCombinationIterator<2> iterator (combinationMode, { aSize, bSize });
+	std::vector<double> result (iterator.GetCombinationCount ());
+	double* resultPtr = result.data ();
+	iterator.EnumerateBlocks ([&] (const NE::CombinationBlock<2>& block) {
+		DoOperations (a + block.firstIndices[0], block.strides[0], b + block.firstIndices[1], block.strides[1], resultPtr, block.count);
+		resultPtr += block.count;
+		return true;
+	});
+
+	if (!IsFiniteArray (result.data (), result.size ())) {
+		return nullptr;
+	}
+	return NE::ValuePtr (new NE::DoubleListValue (std::move (result)));
+}
+
+NE::ValuePtr BinaryOperationNode::DoSequenceOperation (NE::ValueCombinationMode combinationMode, const NumberSequence& aSequence, const NumberSequence& bSequence) const
+{
+	// the result stays a sequence only if no list has to repeat its last element
+	size_t aSize = aSequence.GetSize ();
+	size_t bSize = bSequence.GetSize ();
+	size_t resultSize = 0;
+	if (combinationMode == NE::ValueCombinationMode::Shortest) {
+		resultSize = std::min (aSize, bSize);
+	} else if (combinationMode == NE::ValueCombinationMode::Longest) {
+		if (aSize != bSize && aSize != 1 && bSize != 1) {
+			return nullptr;
+		}
+		resultSize = std::max (aSize, bSize);
+	} else if (combinationMode == NE::ValueCombinationMode::CrossProduct) {
+		if (aSize != 1 && bSize != 1) {
+			return nullptr;
+		}
+		resultSize = aSize * bSize;
+	}
+	if (resultSize == 0) {
+		return nullptr;
+	}
+
+	double resultStart = 0.0;
+	double resultStep = 0.0;
+	if (!DoSequenceOperation (aSequence.GetStart (), aSequence.GetStep (), bSequence.GetStart (), bSequence.GetStep (), resultStart, resultStep)) {
+		return nullptr;
+	}
+	double resultEnd = resultStart + (double) (resultSize - 1) * resultStep;
+	double resultBounds[3] = { resultStart, resultStep, resultEnd };
+	if (!IsFiniteArray (resultBounds, 3)) {
+		return nullptr;
+	}
+	return NE::ValuePtr (new NE::DoubleSequenceValue (resultStart, resultStep, resultSize));
+}
+
+void BinaryOperationNode::DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const
+{
+	for (size_t i = 0; i < count; i++) {
+		result[i] = DoOperation (a[i * aStride], b[i * bStride]);
+	}
+}
+
+bool BinaryOperationNode::DoSequenceOperation (double, double, double, double, double&, double&) const
+{
+	return false;
 }
 
 AdditionNode::AdditionNode () :
@@ -124,6 +237,16 @@ double AdditionNode::DoOperation (double a, double b) const
 	return a + b;
 }
 
+void AdditionNode::DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const
+{
+	CalculateBinaryKernel (BinaryKernel::Addition, a, aStride, b, bStride, result, count);
+}
+
+bool AdditionNode::DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const
+{
+	return CalculateSequenceKernel (BinaryKernel::Addition, aStart, aStep, bStart, bStep, resultStart, resultStep);
+}
+
 SubtractionNode::SubtractionNode () :
 	BinaryOperationNode ()
 {
@@ -146,6 +269,16 @@ double SubtractionNode::DoOperation (double a, double b) const
 	return a - b;
 }
 
+void SubtractionNode::DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const
+{
+	CalculateBinaryKernel (BinaryKernel::Subtraction, a, aStride, b, bStride, result, count);
+}
+
+bool SubtractionNode::DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const
+{
+	return CalculateSequenceKernel (BinaryKernel::Subtraction, aStart, aStep, bStart, bStep, resultStart, resultStep);
+}
+
 MultiplicationNode::MultiplicationNode () :
 	BinaryOperationNode ()
 {
@@ -168,6 +301,16 @@ double MultiplicationNode::DoOperation (double a, double b) const
 	return a * b;
 }
 
+void MultiplicationNode::DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const
+{
+	CalculateBinaryKernel (BinaryKernel::Multiplication, a, aStride, b, bStride, result, count);
+}
+
+bool MultiplicationNode::DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const
+{
+	return CalculateSequenceKernel (BinaryKernel::Multiplication, aStart, aStep, bStart, bStep, resultStart, resultStep);
+}
+
 DivisionNode::DivisionNode () :
 	BinaryOperationNode ()
 {
@@ -190,4 +333,14 @@ double DivisionNode::DoOperation (double a, double b) const
 	return a / b;
 }
 
+void DivisionNode::DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const
+{
+	CalculateBinaryKernel (BinaryKernel::Division, a, aStride, b, bStride, result, count);
+}
+
+bool DivisionNode::DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const
+{
+	return CalculateSequenceKernel (BinaryKernel::Division, aStart, aStep, bStart, bStep, resultStart, resultStep);
+}
+
 }
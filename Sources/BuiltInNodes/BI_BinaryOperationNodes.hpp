@@ -4,6 +4,7 @@
 #include "NE_SingleValues.hpp"
 #include "BI_BasicUINode.hpp"
 #include "BI_BuiltInFeatures.hpp"
+#include "BI_NumericKernels.hpp"
 
 namespace BI
 {
@@ -19,16 +20,24 @@ public:
 
 	virtual void				Initialize () override;
 	virtual NE::ValueConstPtr	Calculate (NE::EvaluationEnv& env) const override;
+	virtual NE::ValueHandle		CalculateHandle (NE::EvaluationEnv& env) const override;
 		
 	virtual void				RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
 	virtual bool				IsForceCalculated () const override;
+	virtual bool				IsThreadSafe () const override;
+	virtual bool				IsCalculatedValueProcessed () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status	WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 
 private:
-	NE::ValuePtr				DoSingleOperation (const NE::ValueConstPtr& aValue, const NE::ValueConstPtr& bValue) const;
+	NE::ValueHandle				DoSingleOperation (double a, double b) const;
+	NE::ValuePtr				DoArrayOperation (NE::ValueCombinationMode combinationMode, const NumberArray& aNumbers, const NumberArray& bNumbers) const;
+	NE::ValuePtr				DoSequenceOperation (NE::ValueCombinationMode combinationMode, const NumberSequence& aSequence, const NumberSequence& bSequence) const;
 	virtual double				DoOperation (double a, double b) const = 0;
+	virtual void				DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const;
+	virtual bool				DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const;
 };
 
 class AdditionNode : public BinaryOperationNode
@@ -41,7 +50,9 @@ public:
 	virtual ~AdditionNode ();
 
 private:
-	virtual double DoOperation (double a, double b) const override;
+	virtual double	DoOperation (double a, double b) const override;
+	virtual void	DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const override;
+	virtual bool	DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const override;
 };
 
 class SubtractionNode : public BinaryOperationNode
@@ -54,7 +65,9 @@ public:
 	virtual ~SubtractionNode ();
 
 private:
-	virtual double DoOperation (double a, double b) const override;
+	virtual double	DoOperation (double a, double b) const override;
+	virtual void	DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const override;
+	virtual bool	DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const override;
 };
 
 class MultiplicationNode : public BinaryOperationNode
@@ -67,7 +80,9 @@ public:
 	virtual ~MultiplicationNode ();
 
 private:
-	virtual double DoOperation (double a, double b) const override;
+	virtual double	DoOperation (double a, double b) const override;
+	virtual void	DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const override;
+	virtual bool	DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const override;
 };
 
 class DivisionNode : public BinaryOperationNode
@@ -80,7 +95,9 @@ public:
 	virtual ~DivisionNode ();
 
 private:
-	virtual double DoOperation (double a, double b) const override;
+	virtual double	DoOperation (double a, double b) const override;
+	virtual void	DoOperations (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count) const override;
+	virtual bool	DoSequenceOperation (double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep) const override;
 };
 
 }
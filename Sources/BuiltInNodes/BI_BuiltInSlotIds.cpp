@@ -0,0 +1,16 @@
+#include "BI_BuiltInSlotIds.hpp"
+
+namespace BI
+{
+
+const NE::SlotId InSlotId ("in");
+const NE::SlotId OutSlotId ("out");
+const NE::SlotId ASlotId ("a");
+const NE::SlotId BSlotId ("b");
+const NE::SlotId ResultSlotId ("result");
+const NE::SlotId StartSlotId ("start");
+const NE::SlotId StepSlotId ("step");
+const NE::SlotId EndSlotId ("end");
+const NE::SlotId CountSlotId ("count");
+
+}
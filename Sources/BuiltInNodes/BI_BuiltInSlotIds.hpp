@@ -0,0 +1,23 @@
+#ifndef BI_BUILTINSLOTIDS_HPP
+#define BI_BUILTINSLOTIDS_HPP
+
+#include "NE_SlotId.hpp"
+
+namespace BI
+{
+
+// the slot ids of built-in nodes are interned only once, so they
+// don't have to be looked up in the intern table on every evaluation
+extern const NE::SlotId InSlotId;
+extern const NE::SlotId OutSlotId;
+extern const NE::SlotId ASlotId;
+extern const NE::SlotId BSlotId;
+extern const NE::SlotId ResultSlotId;
+extern const NE::SlotId StartSlotId;
+extern const NE::SlotId StepSlotId;
+extern const NE::SlotId EndSlotId;
+extern const NE::SlotId CountSlotId;
+
+}
+
+#endif
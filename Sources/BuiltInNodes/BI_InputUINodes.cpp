@@ -1,6 +1,8 @@
 #include "BI_InputUINodes.hpp"
+#include "BI_BuiltInSlotIds.hpp"
 #include "BI_UINodePanels.hpp"
 #include "NE_Localization.hpp"
+#include "NE_ListValues.hpp"
 #include "NUIE_NodeParameters.hpp"
 #include "NUIE_NodeCommonParameters.hpp"
 #include "NUIE_NodeUIManager.hpp"
@@ -102,7 +104,7 @@ BooleanNode::~BooleanNode ()
 
 void BooleanNode::Initialize ()
 {
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 bool BooleanNode::IsForceCalculated () const
@@ -110,9 +112,24 @@ bool BooleanNode::IsForceCalculated () const
 	return true;
 }
 
-NE::ValueConstPtr BooleanNode::Calculate (NE::EvaluationEnv&) const
+bool BooleanNode::IsThreadSafe () const
 {
-	return NE::ValueConstPtr (new NE::BooleanValue (val));
+	return true;
+}
+
+bool BooleanNode::IsCalculatedValueProcessed () const
+{
+	return false;
+}
+
+NE::ValueConstPtr BooleanNode::Calculate (NE::EvaluationEnv& env) const
+{
+	return CalculateHandle (env);
+}
+
+NE::ValueHandle BooleanNode::CalculateHandle (NE::EvaluationEnv&) const
+{
+	return NE::ValueHandle (val);
 }
 
 void BooleanNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
@@ -159,6 +176,13 @@ NE::Stream::Status BooleanNode::Write (NE::OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status BooleanNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	WriteFeatures (outputStream);
+	outputStream.Write (val);
+	return outputStream.GetStatus ();
+}
+
 bool BooleanNode::GetValue () const
 {
 	return val;
@@ -236,7 +260,7 @@ NumericUpDownNode::~NumericUpDownNode ()
 
 void NumericUpDownNode::Initialize ()
 {
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 bool NumericUpDownNode::IsForceCalculated () const
@@ -244,6 +268,16 @@ bool NumericUpDownNode::IsForceCalculated () const
 	return true;
 }
 
+bool NumericUpDownNode::IsThreadSafe () const
+{
+	return true;
+}
+
+bool NumericUpDownNode::IsCalculatedValueProcessed () const
+{
+	return false;
+}
+
 NE::Stream::Status NumericUpDownNode::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -277,9 +311,14 @@ IntegerUpDownNode::~IntegerUpDownNode ()
 
 }
 
-NE::ValueConstPtr IntegerUpDownNode::Calculate (NE::EvaluationEnv&) const
+NE::ValueConstPtr IntegerUpDownNode::Calculate (NE::EvaluationEnv& env) const
 {
-	return NE::ValueConstPtr (new NE::IntValue (val));
+	return CalculateHandle (env);
+}
+
+NE::ValueHandle IntegerUpDownNode::CalculateHandle (NE::EvaluationEnv&) const
+{
+	return NE::ValueHandle (val);
 }
 
 void IntegerUpDownNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
@@ -351,6 +390,14 @@ NE::Stream::Status IntegerUpDownNode::Write (NE::OutputStream& outputStream) con
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status IntegerUpDownNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	WriteFeatures (outputStream);
+	outputStream.Write (val);
+	outputStream.Write (step);
+	return outputStream.GetStatus ();
+}
+
 void IntegerUpDownNode::Increase ()
 {
 	val = val + step;
@@ -400,9 +447,14 @@ DoubleUpDownNode::~DoubleUpDownNode ()
 
 }
 
-NE::ValueConstPtr DoubleUpDownNode::Calculate (NE::EvaluationEnv&) const
+NE::ValueConstPtr DoubleUpDownNode::Calculate (NE::EvaluationEnv& env) const
+{
+	return CalculateHandle (env);
+}
+
+NE::ValueHandle DoubleUpDownNode::CalculateHandle (NE::EvaluationEnv&) const
 {
-	return NE::ValueConstPtr (new NE::DoubleValue (val));
+	return NE::ValueHandle (val);
 }
 
 void DoubleUpDownNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
@@ -474,6 +526,14 @@ NE::Stream::Status DoubleUpDownNode::Write (NE::OutputStream& outputStream) cons
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status DoubleUpDownNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	WriteFeatures (outputStream);
+	outputStream.Write (val);
+	outputStream.Write (step);
+	return outputStream.GetStatus ();
+}
+
 void DoubleUpDownNode::Increase ()
 {
 	val = val + step;
@@ -526,6 +586,11 @@ bool NumericRangeNode::IsForceCalculated () const
 	return true;
 }
 
+bool NumericRangeNode::IsThreadSafe () const
+{
+	return true;
+}
+
 NE::Stream::Status NumericRangeNode::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -540,6 +605,11 @@ NE::Stream::Status NumericRangeNode::Write (NE::OutputStream& outputStream) cons
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status NumericRangeNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	return WriteFeatures (outputStream);
+}
+
 IntegerIncrementedNode::IntegerIncrementedNode () :
 	IntegerIncrementedNode (NE::LocString (), NUIE::Point ())
 {
@@ -559,17 +629,17 @@ IntegerIncrementedNode::~IntegerIncrementedNode ()
 
 void IntegerIncrementedNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("start"), NE::LocString (L"Start"), NE::ValuePtr (new NE::IntValue (0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("step"), NE::LocString (L"Step"), NE::ValuePtr (new NE::IntValue (1)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("count"), NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"List"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StartSlotId, NE::LocString (L"Start"), NE::ValuePtr (new NE::IntValue (0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StepSlotId, NE::LocString (L"Step"), NE::ValuePtr (new NE::IntValue (1)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (CountSlotId, NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"List"))));
 }
 
 NE::ValueConstPtr IntegerIncrementedNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr start = EvaluateInputSlot (NE::SlotId ("start"), env);
-	NE::ValueConstPtr step = EvaluateInputSlot (NE::SlotId ("step"), env);
-	NE::ValueConstPtr count = EvaluateInputSlot (NE::SlotId ("count"), env);
+	NE::ValueConstPtr start = EvaluateInputSlot (StartSlotId, env);
+	NE::ValueConstPtr step = EvaluateInputSlot (StepSlotId, env);
+	NE::ValueConstPtr count = EvaluateInputSlot (CountSlotId, env);
 	if (!NE::IsSingleType<NE::NumberValue> (start) || !NE::IsSingleType<NE::NumberValue> (step) || !NE::IsSingleType<NE::NumberValue> (count)) {
 		return nullptr;
 	}
@@ -581,20 +651,15 @@ NE::ValueConstPtr IntegerIncrementedNode::Calculate (NE::EvaluationEnv& env) con
 		return nullptr;
 	}
 
-	NE::ListValuePtr list (new NE::ListValue ());
-	for (int i = 0; i < countNum; ++i) {
-		list->Push (NE::ValuePtr (new NE::IntValue (startNum + i * stepNum)));
-	}
-
-	return list;
+	return NE::ValuePtr (new NE::IntSequenceValue (startNum, stepNum, (size_t) countNum));
 }
 
 void IntegerIncrementedNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, NE::SlotId ("start"), NE::LocString (L"Start"), NUIE::ParameterType::Integer);
-	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, NE::SlotId ("step"), NE::LocString (L"Step"), NUIE::ParameterType::Integer);
-	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<IntegerIncrementedNode> (NE::SlotId ("count"), NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
+	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, StartSlotId, NE::LocString (L"Start"), NUIE::ParameterType::Integer);
+	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, StepSlotId, NE::LocString (L"Step"), NUIE::ParameterType::Integer);
+	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<IntegerIncrementedNode> (CountSlotId, NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
 }
 
 NE::Stream::Status IntegerIncrementedNode::Read (NE::InputStream& inputStream)
@@ -630,17 +695,17 @@ DoubleIncrementedNode::~DoubleIncrementedNode ()
 
 void DoubleIncrementedNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("start"), NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("step"), NE::LocString (L"Step"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("count"), NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"List"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StartSlotId, NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StepSlotId, NE::LocString (L"Step"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (CountSlotId, NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"List"))));
 }
 
 NE::ValueConstPtr DoubleIncrementedNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr start = EvaluateInputSlot (NE::SlotId ("start"), env);
-	NE::ValueConstPtr step = EvaluateInputSlot (NE::SlotId ("step"), env);
-	NE::ValueConstPtr count = EvaluateInputSlot (NE::SlotId ("count"), env);
+	NE::ValueConstPtr start = EvaluateInputSlot (StartSlotId, env);
+	NE::ValueConstPtr step = EvaluateInputSlot (StepSlotId, env);
+	NE::ValueConstPtr count = EvaluateInputSlot (CountSlotId, env);
 	if (!NE::IsSingleType<NE::NumberValue> (start) || !NE::IsSingleType<NE::NumberValue> (step) || !NE::IsSingleType<NE::NumberValue> (count)) {
 		return nullptr;
 	}
@@ -652,20 +717,15 @@ NE::ValueConstPtr DoubleIncrementedNode::Calculate (NE::EvaluationEnv& env) cons
 		return nullptr;
 	}
 
-	NE::ListValuePtr list (new NE::ListValue ());
-	for (int i = 0; i < countNum; ++i) {
-		list->Push (NE::ValuePtr (new NE::DoubleValue (startNum + i * stepNum)));
-	}
-
-	return list;
+	return NE::ValuePtr (new NE::DoubleSequenceValue (startNum, stepNum, (size_t) countNum));
 }
 
 void DoubleIncrementedNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, NE::SlotId ("start"), NE::LocString (L"Start"), NUIE::ParameterType::Double);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, NE::SlotId ("step"), NE::LocString (L"Step"), NUIE::ParameterType::Double);
-	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleIncrementedNode> (NE::SlotId ("count"), NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, StartSlotId, NE::LocString (L"Start"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, StepSlotId, NE::LocString (L"Step"), NUIE::ParameterType::Double);
+	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleIncrementedNode> (CountSlotId, NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
 }
 
 NE::Stream::Status DoubleIncrementedNode::Read (NE::InputStream& inputStream)
@@ -701,17 +761,17 @@ DoubleDistributedNode::~DoubleDistributedNode ()
 
 void DoubleDistributedNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("start"), NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("end"), NE::LocString (L"End"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("count"), NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"List"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StartSlotId, NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (EndSlotId, NE::LocString (L"End"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (CountSlotId, NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"List"))));
 }
 
 NE::ValueConstPtr DoubleDistributedNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr start = EvaluateInputSlot (NE::SlotId ("start"), env);
-	NE::ValueConstPtr end = EvaluateInputSlot (NE::SlotId ("end"), env);
-	NE::ValueConstPtr count = EvaluateInputSlot (NE::SlotId ("count"), env);
+	NE::ValueConstPtr start = EvaluateInputSlot (StartSlotId, env);
+	NE::ValueConstPtr end = EvaluateInputSlot (EndSlotId, env);
+	NE::ValueConstPtr count = EvaluateInputSlot (CountSlotId, env);
 	if (!NE::IsSingleType<NE::NumberValue> (start) || !NE::IsSingleType<NE::NumberValue> (end) || !NE::IsSingleType<NE::NumberValue> (count)) {
 		return nullptr;
 	}
@@ -724,20 +784,15 @@ NE::ValueConstPtr DoubleDistributedNode::Calculate (NE::EvaluationEnv& env) cons
 	}
 
 	double segmentVal = std::fabs (startNum - endNum) / (double) (countNum - 1);
-	NE::ListValuePtr list (new NE::ListValue ());
-	for (int i = 0; i < countNum; ++i) {
-		list->Push (NE::ValuePtr (new NE::DoubleValue (startNum + i * segmentVal)));
-	}
-
-	return list;
+	return NE::ValuePtr (new NE::DoubleSequenceValue (startNum, segmentVal, (size_t) countNum));
 }
 
 void DoubleDistributedNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, NE::SlotId ("start"), NE::LocString (L"Start"), NUIE::ParameterType::Double);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, NE::SlotId ("end"), NE::LocString (L"End"), NUIE::ParameterType::Double);
-	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleDistributedNode> (NE::SlotId ("count"), NE::LocString (L"Count"), NUIE::ParameterType::Integer, 2)));
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, StartSlotId, NE::LocString (L"Start"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, EndSlotId, NE::LocString (L"End"), NUIE::ParameterType::Double);
+	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleDistributedNode> (CountSlotId, NE::LocString (L"Count"), NUIE::ParameterType::Integer, 2)));
 }
 
 NE::Stream::Status DoubleDistributedNode::Read (NE::InputStream& inputStream)
@@ -773,23 +828,25 @@ ListBuilderNode::~ListBuilderNode ()
 
 void ListBuilderNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("in"), NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Multiple)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (InSlotId, NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Multiple)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
+}
+
+bool ListBuilderNode::IsThreadSafe () const
+{
+	return true;
 }
 
 NE::ValueConstPtr ListBuilderNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr in = EvaluateInputSlot (NE::SlotId ("in"), env);
+	NE::ValueConstPtr in = EvaluateInputSlot (InSlotId, env);
 	if (in == nullptr) {
 		return nullptr;
 	}
 
-	NE::ListValuePtr list (new NE::ListValue ());
-	NE::FlatEnumerate (in, [&] (const NE::ValueConstPtr& innerVal) {
-		list->Push (innerVal);
-		return true;
-	});
-	return list;
+	std::vector<NE::ValueConstPtr> values;
+	NE::FlatCollect (in, values);
+	return NE::ValuePtr (new NE::ListValue (std::move (values)));
 }
 
 NE::Stream::Status ListBuilderNode::Read (NE::InputStream& inputStream)
@@ -806,4 +863,9 @@ NE::Stream::Status ListBuilderNode::Write (NE::OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status ListBuilderNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	return WriteFeatures (outputStream);
+}
+
 }
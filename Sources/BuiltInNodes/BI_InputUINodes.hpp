@@ -30,12 +30,16 @@ public:
 
 	virtual void						Initialize () override;
 	virtual bool						IsForceCalculated () const override;
+	virtual bool						IsThreadSafe () const override;
+	virtual bool						IsCalculatedValueProcessed () const override;
 
 	virtual NE::ValueConstPtr			Calculate (NE::EvaluationEnv& env) const override;
+	virtual NE::ValueHandle				CalculateHandle (NE::EvaluationEnv& env) const override;
 	virtual void						RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status			WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 
 	bool								GetValue () const;
 	void								SetValue (bool newVal);
@@ -68,6 +72,8 @@ public:
 	virtual void						Initialize () override;
 
 	virtual bool						IsForceCalculated () const override;
+	virtual bool						IsThreadSafe () const override;
+	virtual bool						IsCalculatedValueProcessed () const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
@@ -86,10 +92,12 @@ public:
 	virtual ~IntegerUpDownNode ();
 
 	virtual NE::ValueConstPtr			Calculate (NE::EvaluationEnv& env) const override;
+	virtual NE::ValueHandle				CalculateHandle (NE::EvaluationEnv& env) const override;
 	virtual void						RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status			WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 
 	virtual void						Increase () override;
 	virtual void						Decrease () override;
@@ -115,10 +123,12 @@ public:
 	virtual ~DoubleUpDownNode ();
 
 	virtual NE::ValueConstPtr			Calculate (NE::EvaluationEnv& env) const override;
+	virtual NE::ValueHandle				CalculateHandle (NE::EvaluationEnv& env) const override;
 	virtual void						RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status			WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 
 	virtual void						Increase () override;
 	virtual void						Decrease () override;
@@ -144,9 +154,11 @@ public:
 	virtual ~NumericRangeNode ();
 
 	virtual bool				IsForceCalculated () const override;
+	virtual bool				IsThreadSafe () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status	WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 };
 
 class IntegerIncrementedNode : public NumericRangeNode
@@ -210,10 +222,12 @@ public:
 	virtual ~ListBuilderNode ();
 
 	virtual void						Initialize () override;
+	virtual bool						IsThreadSafe () const override;
 	virtual NE::ValueConstPtr			Calculate (NE::EvaluationEnv& env) const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status			WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 };
 
 }
@@ -0,0 +1,656 @@
+#include "BI_NumericKernels.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_Debug.hpp"
+
+#include <cmath>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define BI_KERNELS_SSE2
+	#include <emmintrin.h>
+#endif
+
+#if defined (BI_KERNELS_SSE2) && defined (__GNUC__)
+	#define BI_KERNELS_AVX
+	#define BI_KERNELS_AVX_TARGET __attribute__ ((target ("avx")))
+	#include <immintrin.h>
+#endif
+
+namespace BI
+{
+
+struct AdditionKernel
+{
+	static double Calculate (double a, double b)
+	{
+		return a + b;
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a, __m128d b)
+	{
+		return _mm_add_pd (a, b);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a, __m256d b)
+	{
+		return _mm256_add_pd (a, b);
+	}
+#endif
+};
+
+struct SubtractionKernel
+{
+	static double Calculate (double a, double b)
+	{
+		return a - b;
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a, __m128d b)
+	{
+		return _mm_sub_pd (a, b);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a, __m256d b)
+	{
+		return _mm256_sub_pd (a, b);
+	}
+#endif
+};
+
+struct MultiplicationKernel
+{
+	static double Calculate (double a, double b)
+	{
+		return a * b;
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a, __m128d b)
+	{
+		return _mm_mul_pd (a, b);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a, __m256d b)
+	{
+		return _mm256_mul_pd (a, b);
+	}
+#endif
+};
+
+struct DivisionKernel
+{
+	static double Calculate (double a, double b)
+	{
+		return a / b;
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a, __m128d b)
+	{
+		return _mm_div_pd (a, b);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a, __m256d b)
+	{
+		return _mm256_div_pd (a, b);
+	}
+#endif
+};
+
+struct AbsKernel
+{
+	static double Calculate (double a)
+	{
+		return std::abs (a);
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a)
+	{
+		return _mm_andnot_pd (_mm_set1_pd (-0.0), a);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a)
+	{
+		return _mm256_andnot_pd (_mm256_set1_pd (-0.0), a);
+	}
+#endif
+};
+
+struct FloorKernel
+{
+	static double Calculate (double a)
+	{
+		return std::floor (a);
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a)
+	{
+		// sse2 has no rounding instruction
+		double values[2];
+		_mm_storeu_pd (values, a);
+		return _mm_set_pd (std::floor (values[1]), std::floor (values[0]));
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a)
+	{
+		return _mm256_floor_pd (a);
+	}
+#endif
+};
+
+struct CeilKernel
+{
+	static double Calculate (double a)
+	{
+		return std::ceil (a);
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a)
+	{
+		double values[2];
+		_mm_storeu_pd (values, a);
+		return _mm_set_pd (std::ceil (values[1]), std::ceil (values[0]));
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a)
+	{
+		return _mm256_ceil_pd (a);
+	}
+#endif
+};
+
+struct NegativeKernel
+{
+	static double Calculate (double a)
+	{
+		return -a;
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a)
+	{
+		return _mm_xor_pd (_mm_set1_pd (-0.0), a);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a)
+	{
+		return _mm256_xor_pd (_mm256_set1_pd (-0.0), a);
+	}
+#endif
+};
+
+struct SqrtKernel
+{
+	static double Calculate (double a)
+	{
+		return std::sqrt (a);
+	}
+
+#ifdef BI_KERNELS_SSE2
+	static __m128d Calculate (__m128d a)
+	{
+		return _mm_sqrt_pd (a);
+	}
+#endif
+
+#ifdef BI_KERNELS_AVX
+	BI_KERNELS_AVX_TARGET static __m256d Calculate (__m256d a)
+	{
+		return _mm256_sqrt_pd (a);
+	}
+#endif
+};
+
+template <class Kernel>
+static void CalculateBinaryScalar (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t from, size_t count)
+{
+	for (size_t i = from; i < count; i++) {
+		result[i] = Kernel::Calculate (a[i * aStride], b[i * bStride]);
+	}
+}
+
+template <class Kernel>
+static void CalculateUnaryScalar (const double* a, double* result, size_t from, size_t count)
+{
+	for (size_t i = from; i < count; i++) {
+		result[i] = Kernel::Calculate (a[i]);
+	}
+}
+
+static bool IsFiniteArrayScalar (const double* values, size_t from, size_t count)
+{
+	for (size_t i = from; i < count; i++) {
+		if (std::isnan (values[i]) || std::isinf (values[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#ifdef BI_KERNELS_SSE2
+
+template <class Kernel>
+static size_t CalculateBinarySSE2 (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count)
+{
+	const __m128d aFirst = _mm_set1_pd (a[0]);
+	const __m128d bFirst = _mm_set1_pd (b[0]);
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		__m128d aValues = (aStride == 0 ? aFirst : _mm_loadu_pd (a + i));
+		__m128d bValues = (bStride == 0 ? bFirst : _mm_loadu_pd (b + i));
+		_mm_storeu_pd (result + i, Kernel::Calculate (aValues, bValues));
+	}
+	return i;
+}
+
+template <class Kernel>
+static size_t CalculateUnarySSE2 (const double* a, double* result, size_t count)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		_mm_storeu_pd (result + i, Kernel::Calculate (_mm_loadu_pd (a + i)));
+	}
+	return i;
+}
+
+static bool IsFiniteArraySSE2 (const double* values, size_t count)
+{
+	// multiplying by zero gives nan for infinite and nan values, and zero otherwise
+	const __m128d zero = _mm_setzero_pd ();
+	__m128d accumulator = zero;
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		accumulator = _mm_add_pd (accumulator, _mm_mul_pd (_mm_loadu_pd (values + i), zero));
+	}
+	if (_mm_movemask_pd (_mm_cmpunord_pd (accumulator, accumulator)) != 0) {
+		return false;
+	}
+	return IsFiniteArrayScalar (values, i, count);
+}
+
+#endif
+
+#ifdef BI_KERNELS_AVX
+
+template <class Kernel>
+BI_KERNELS_AVX_TARGET static size_t CalculateBinaryAVX (const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count)
+{
+	const __m256d aFirst = _mm256_set1_pd (a[0]);
+	const __m256d bFirst = _mm256_set1_pd (b[0]);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256d aValues = (aStride == 0 ? aFirst : _mm256_loadu_pd (a + i));
+		__m256d bValues = (bStride == 0 ? bFirst : _mm256_loadu_pd (b + i));
+		_mm256_storeu_pd (result + i, Kernel::Calculate (aValues, bValues));
+	}
+	return i;
+}
+
+template <class Kernel>
+BI_KERNELS_AVX_TARGET static size_t CalculateUnaryAVX (const double* a, double* result, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm256_storeu_pd (result + i, Kernel::Calculate (_mm256_loadu_pd (a + i)));
+	}
+	return i;
+}
+
+BI_KERNELS_AVX_TARGET static bool IsFiniteArrayAVX (const double* values, size_t count)
+{
+	const __m256d zero = _mm256_setzero_pd ();
+	__m256d accumulator = zero;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		accumulator = _mm256_add_pd (accumulator, _mm256_mul_pd (_mm256_loadu_pd (values + i), zero));
+	}
+	if (_mm256_movemask_pd (_mm256_cmp_pd (accumulator, accumulator, _CMP_UNORD_Q)) != 0) {
+		return false;
+	}
+	return IsFiniteArrayScalar (values, i, count);
+}
+
+#endif
+
+template <class Kernel>
+static void CalculateBinary (KernelInstructionSet instructionSet, const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count)
+{
+	size_t calculatedCount = 0;
+	if (instructionSet == KernelInstructionSet::AVX) {
+#ifdef BI_KERNELS_AVX
+		calculatedCount = CalculateBinaryAVX<Kernel> (a, aStride, b, bStride, result, count);
+#endif
+	} else if (instructionSet == KernelInstructionSet::SSE2) {
+#ifdef BI_KERNELS_SSE2
+		calculatedCount = CalculateBinarySSE2<Kernel> (a, aStride, b, bStride, result, count);
+#endif
+	}
+	CalculateBinaryScalar<Kernel> (a, aStride, b, bStride, result, calculatedCount, count);
+}
+
+template <class Kernel>
+static void CalculateUnary (KernelInstructionSet instructionSet, const double* a, double* result, size_t count)
+{
+	size_t calculatedCount = 0;
+	if (instructionSet == KernelInstructionSet::AVX) {
+#ifdef BI_KERNELS_AVX
+		calculatedCount = CalculateUnaryAVX<Kernel> (a, result, count);
+#endif
+	} else if (instructionSet == KernelInstructionSet::SSE2) {
+#ifdef BI_KERNELS_SSE2
+		calculatedCount = CalculateUnarySSE2<Kernel> (a, result, count);
+#endif
+	}
+	CalculateUnaryScalar<Kernel> (a, result, calculatedCount, count);
+}
+
+static KernelInstructionSet DetectKernelInstructionSet ()
+{
+#ifdef BI_KERNELS_AVX
+	__builtin_cpu_init ();
+	if (__builtin_cpu_supports ("avx")) {
+		return KernelInstructionSet::AVX;
+	}
+#endif
+#ifdef BI_KERNELS_SSE2
+	return KernelInstructionSet::SSE2;
+#else
+	return KernelInstructionSet::Scalar;
+#endif
+}
+
+static KernelInstructionSet GetSupportedInstructionSet (KernelInstructionSet instructionSet)
+{
+	KernelInstructionSet supportedInstructionSet = GetKernelInstructionSet ();
+	if (instructionSet > supportedInstructionSet) {
+		return supportedInstructionSet;
+	}
+	return instructionSet;
+}
+
+NumberArray::NumberArray () :
+	value (nullptr),
+	data (nullptr),
+	size (0),
+	storage ()
+{
+
+}
+
+NumberArray::~NumberArray ()
+{
+
+}
+
+bool NumberArray::Set (const NE::ValueConstPtr& newValue)
+{
+	Clear ();
+	if (newValue == nullptr) {
+		return false;
+	}
+
+	if (NE::Value::IsType<NE::NumberValue> (newValue)) {
+		storage.push_back (NE::NumberValue::ToDouble (newValue));
+	} else if (NE::Value::IsType<NE::DoubleListValue> (newValue)) {
+		const std::vector<double>& values = NE::Value::Cast<NE::DoubleListValue> (newValue.get ())->GetValues ();
+		value = newValue;
+		data = values.data ();
+		size = values.size ();
+		return true;
+	} else if (NE::Value::IsType<NE::IListValue> (newValue)) {
+		const NE::IListValue* listValue = NE::Value::Cast<NE::IListValue> (newValue.get ());
+		const NE::NumberListValue* numberListValue = NE::Value::Cast<NE::NumberListValue> (newValue.get ());
+		storage.reserve (listValue->GetSize ());
+		if (numberListValue != nullptr) {
+			for (size_t i = 0; i < listValue->GetSize (); i++) {
+				storage.push_back (numberListValue->ToDouble (i));
+			}
+		} else {
+			bool isValid = listValue->Enumerate ([&] (const NE::ValueConstPtr& innerValue) {
+				if (!NE::Value::IsType<NE::NumberValue> (innerValue)) {
+					return false;
+				}
+				storage.push_back (NE::NumberValue::ToDouble (innerValue));
+				return true;
+			});
+			if (!isValid) {
+				Clear ();
+				return false;
+			}
+		}
+	} else {
+		return false;
+	}
+
+	data = storage.data ();
+	size = storage.size ();
+	return true;
+}
+
+bool NumberArray::SetFlattened (const NE::ValueConstPtr& newValue)
+{
+	if (Set (newValue)) {
+		return true;
+	}
+
+	Clear ();
+	if (newValue == nullptr) {
+		return false;
+	}
+	storage.reserve (NE::GetFlatValueCount (newValue));
+	bool isValid = NE::FlatEnumerate (newValue, [&] (const NE::ValueConstPtr& innerValue) {
+		if (!NE::Value::IsType<NE::NumberValue> (innerValue)) {
+			return false;
+		}
+		storage.push_back (NE::NumberValue::ToDouble (innerValue));
+		return true;
+	});
+	if (!isValid) {
+		Clear ();
+		return false;
+	}
+
+	data = storage.data ();
+	size = storage.size ();
+	return true;
+}
+
+const double* NumberArray::GetData () const
+{
+	return data;
+}
+
+size_t NumberArray::GetSize () const
+{
+	return size;
+}
+
+void NumberArray::Clear ()
+{
+	value = nullptr;
+	data = nullptr;
+	size = 0;
+	storage.clear ();
+}
+
+NumberSequence::NumberSequence () :
+	start (0.0),
+	step (0.0),
+	size (0)
+{
+
+}
+
+NumberSequence::~NumberSequence ()
+{
+
+}
+
+bool NumberSequence::Set (const NE::ValueConstPtr& value)
+{
+	if (NE::Value::IsType<NE::NumberValue> (value)) {
+		start = NE::NumberValue::ToDouble (value);
+		step = 0.0;
+		size = 1;
+		return true;
+	} else if (NE::Value::IsType<NE::NumberSequenceValue> (value)) {
+		const NE::NumberSequenceValue* sequenceValue = NE::Value::Cast<NE::NumberSequenceValue> (value.get ());
+		size = NE::Value::Cast<NE::IListValue> (value.get ())->GetSize ();
+		if (size == 0) {
+			return false;
+		}
+		start = sequenceValue->GetStartAsDouble ();
+		step = (size > 1 ? sequenceValue->GetStepAsDouble () : 0.0);
+		return true;
+	}
+	return false;
+}
+
+double NumberSequence::GetStart () const
+{
+	return start;
+}
+
+double NumberSequence::GetStep () const
+{
+	return step;
+}
+
+size_t NumberSequence::GetSize () const
+{
+	return size;
+}
+
+KernelInstructionSet GetKernelInstructionSet ()
+{
+	static const KernelInstructionSet instructionSet = DetectKernelInstructionSet ();
+	return instructionSet;
+}
+
+void CalculateBinaryKernel (BinaryKernel kernel, const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count)
+{
+	CalculateBinaryKernel (GetKernelInstructionSet (), kernel, a, aStride, b, bStride, result, count);
+}
+
+void CalculateBinaryKernel (KernelInstructionSet instructionSet, BinaryKernel kernel, const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count)
+{
+	DBGASSERT (aStride <= 1 && bStride <= 1);
+	if (count == 0) {
+		return;
+	}
+
+	instructionSet = GetSupportedInstructionSet (instructionSet);
+	switch (kernel) {
+		case BinaryKernel::Addition:
+			CalculateBinary<AdditionKernel> (instructionSet, a, aStride, b, bStride, result, count);
+			break;
+		case BinaryKernel::Subtraction:
+			CalculateBinary<SubtractionKernel> (instructionSet, a, aStride, b, bStride, result, count);
+			break;
+		case BinaryKernel::Multiplication:
+			CalculateBinary<MultiplicationKernel> (instructionSet, a, aStride, b, bStride, result, count);
+			break;
+		case BinaryKernel::Division:
+			CalculateBinary<DivisionKernel> (instructionSet, a, aStride, b, bStride, result, count);
+			break;
+	}
+}
+
+void CalculateUnaryKernel (UnaryKernel kernel, const double* a, double* result, size_t count)
+{
+	CalculateUnaryKernel (GetKernelInstructionSet (), kernel, a, result, count);
+}
+
+void CalculateUnaryKernel (KernelInstructionSet instructionSet, UnaryKernel kernel, const double* a, double* result, size_t count)
+{
+	if (count == 0) {
+		return;
+	}
+
+	instructionSet = GetSupportedInstructionSet (instructionSet);
+	switch (kernel) {
+		case UnaryKernel::Abs:
+			CalculateUnary<AbsKernel> (instructionSet, a, result, count);
+			break;
+		case UnaryKernel::Floor:
+			CalculateUnary<FloorKernel> (instructionSet, a, result, count);
+			break;
+		case UnaryKernel::Ceil:
+			CalculateUnary<CeilKernel> (instructionSet, a, result, count);
+			break;
+		case UnaryKernel::Negative:
+			CalculateUnary<NegativeKernel> (instructionSet, a, result, count);
+			break;
+		case UnaryKernel::Sqrt:
+			CalculateUnary<SqrtKernel> (instructionSet, a, result, count);
+			break;
+	}
+}
+
+bool IsFiniteArray (const double* values, size_t count)
+{
+	KernelInstructionSet instructionSet = GetKernelInstructionSet ();
+	if (instructionSet == KernelInstructionSet::AVX) {
+#ifdef BI_KERNELS_AVX
+		return IsFiniteArrayAVX (values, count);
+#endif
+	} else if (instructionSet == KernelInstructionSet::SSE2) {
+#ifdef BI_KERNELS_SSE2
+		return IsFiniteArraySSE2 (values, count);
+#endif
+	}
+	return IsFiniteArrayScalar (values, 0, count);
+}
+
+bool CalculateSequenceKernel (BinaryKernel kernel, double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep)
+{
+	switch (kernel) {
+		case BinaryKernel::Addition:
+			resultStart = aStart + bStart;
+			resultStep = aStep + bStep;
+			return true;
+		case BinaryKernel::Subtraction:
+			resultStart = aStart - bStart;
+			resultStep = aStep - bStep;
+			return true;
+		case BinaryKernel::Multiplication:
+			// the product of two sequences is quadratic
+			if (aStep != 0.0 && bStep != 0.0) {
+				return false;
+			}
+			resultStart = aStart * bStart;
+			resultStep = aStart * bStep + aStep * bStart;
+			return true;
+		case BinaryKernel::Division:
+			if (bStep != 0.0) {
+				return false;
+			}
+			resultStart = aStart / bStart;
+			resultStep = aStep / bStart;
+			return true;
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,92 @@
+#ifndef BI_NUMERICKERNELS_HPP
+#define BI_NUMERICKERNELS_HPP
+
+#include "NE_Value.hpp"
+
+#include <vector>
+
+namespace BI
+{
+
+enum class BinaryKernel
+{
+	Addition,
+	Subtraction,
+	Multiplication,
+	Division
+};
+
+enum class UnaryKernel
+{
+	Abs,
+	Floor,
+	Ceil,
+	Negative,
+	Sqrt
+};
+
+enum class KernelInstructionSet
+{
+	Scalar,
+	SSE2,
+	AVX
+};
+
+class NumberArray
+{
+public:
+	NumberArray ();
+	NumberArray (const NumberArray& src) = delete;
+	~NumberArray ();
+
+	NumberArray&		operator= (const NumberArray& rhs) = delete;
+
+	bool				Set (const NE::ValueConstPtr& value);
+	bool				SetFlattened (const NE::ValueConstPtr& value);
+
+	const double*		GetData () const;
+	size_t				GetSize () const;
+
+private:
+	void				Clear ();
+
+	NE::ValueConstPtr	value;
+	const double*		data;
+	size_t				size;
+	std::vector<double>	storage;
+};
+
+// a single number is a sequence with zero step
+class NumberSequence
+{
+public:
+	NumberSequence ();
+	~NumberSequence ();
+
+	bool				Set (const NE::ValueConstPtr& value);
+
+	double				GetStart () const;
+	double				GetStep () const;
+	size_t				GetSize () const;
+
+private:
+	double				start;
+	double				step;
+	size_t				size;
+};
+
+KernelInstructionSet	GetKernelInstructionSet ();
+
+// a stride of zero repeats the first element, a stride of one reads the array
+void					CalculateBinaryKernel (BinaryKernel kernel, const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count);
+void					CalculateBinaryKernel (KernelInstructionSet instructionSet, BinaryKernel kernel, const double* a, size_t aStride, const double* b, size_t bStride, double* result, size_t count);
+void					CalculateUnaryKernel (UnaryKernel kernel, const double* a, double* result, size_t count);
+void					CalculateUnaryKernel (KernelInstructionSet instructionSet, UnaryKernel kernel, const double* a, double* result, size_t count);
+bool					IsFiniteArray (const double* values, size_t count);
+
+// returns false if the result of the operation is not an arithmetic sequence
+bool					CalculateSequenceKernel (BinaryKernel kernel, double aStart, double aStep, double bStart, double bStep, double& resultStart, double& resultStep);
+
+}
+
+#endif
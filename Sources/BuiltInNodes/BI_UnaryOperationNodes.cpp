@@ -1,5 +1,8 @@
 #include "BI_UnaryOperationNodes.hpp"
+#include "BI_BuiltInSlotIds.hpp"
 #include "NE_Localization.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_Debug.hpp"
 #include "NUIE_NodeCommonParameters.hpp"
 
 #include <cmath>
@@ -32,40 +35,46 @@ UnaryOperationNode::~UnaryOperationNode ()
 
 void UnaryOperationNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("a"), NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("result"), NE::LocString (L"Result"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (ASlotId, NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (ResultSlotId, NE::LocString (L"Result"))));
 }
 
 NE::ValueConstPtr UnaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr aValue = EvaluateInputSlot (NE::SlotId ("a"), env);
+	return CalculateHandle (env);
+}
+
+NE::ValueHandle UnaryOperationNode::CalculateHandle (NE::EvaluationEnv& env) const
+{
+	// single numbers are calculated without boxing them into values
+	NE::ValueHandle aHandle = EvaluateInputSlot (ASlotId, env);
+	if (aHandle.IsNumber ()) {
+		return DoSingleOperation (aHandle.ToDouble ());
+	}
+
+	NE::ValueConstPtr aValue = aHandle;
 	if (!NE::IsComplexType<NE::NumberValue> (aValue)) {
 		return nullptr;
 	}
 
-	if (NE::IsSingleValue (aValue)) {
-		return DoSingleOperation (aValue);
-	} else {
-		NE::ListValuePtr resultListValue (new NE::ListValue ());
-		bool isValid = NE::FlatEnumerate (aValue, [&] (const NE::ValueConstPtr& val) {
-			NE::ValuePtr result = DoSingleOperation (val);
-			if (result == nullptr) {
-				return false;
-			}
-			resultListValue->Push (result);
-			return true;
-		});
-		if (!isValid) {
-			return nullptr;
-		}
-		return resultListValue;
+	NumberArray aNumbers;
+	if (DBGERROR (!aNumbers.SetFlattened (aValue))) {
+		return nullptr;
+	}
+	std::vector<double> result (aNumbers.GetSize ());
+	if (!DoOperations (aNumbers.GetData (), result.data (), result.size ())) {
+		return nullptr;
 	}
+	if (!IsFiniteArray (result.data (), result.size ())) {
+		return nullptr;
+	}
+	return NE::ValuePtr (new NE::DoubleListValue (std::move (result)));
 }
 
 void UnaryOperationNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<UnaryOperationNode, NE::DoubleValue> (parameterList, NE::SlotId ("a"), NE::LocString (L"A"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<UnaryOperationNode, NE::DoubleValue> (parameterList, ASlotId, NE::LocString (L"A"), NUIE::ParameterType::Double);
 }
 
 bool UnaryOperationNode::IsForceCalculated () const
@@ -73,6 +82,16 @@ bool UnaryOperationNode::IsForceCalculated () const
 	return true;
 }
 
+bool UnaryOperationNode::IsThreadSafe () const
+{
+	return true;
+}
+
+bool UnaryOperationNode::IsCalculatedValueProcessed () const
+{
+	return false;
+}
+
 NE::Stream::Status UnaryOperationNode::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -87,17 +106,21 @@ NE::Stream::Status UnaryOperationNode::Write (NE::OutputStream& outputStream) co
 	return outputStream.GetStatus ();
 }
 
-NE::ValuePtr UnaryOperationNode::DoSingleOperation (const NE::ValueConstPtr& aValue) const
+NE::Stream::Status UnaryOperationNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
 {
-	double aDouble = NE::NumberValue::ToDouble (aValue);
-	if (!IsValidInput (aDouble)) {
+	return WriteFeatures (outputStream);
+}
+
+NE::ValueHandle UnaryOperationNode::DoSingleOperation (double a) const
+{
+	if (!IsValidInput (a)) {
 		return nullptr;
 	}
-	double result = DoOperation (aDouble);
+	double result = DoOperation (a);
 	if (std::isnan (result) || std::isinf (result)) {
 		return nullptr;
 	}
-	return NE::ValuePtr (new NE::DoubleValue (result));
+	return NE::ValueHandle (result);
 }
 
 bool UnaryOperationNode::IsValidInput (double) const
@@ -105,6 +128,17 @@ bool UnaryOperationNode::IsValidInput (double) const
 	return true;
 }
 
+bool UnaryOperationNode::DoOperations (const double* a, double* result, size_t count) const
+{
+	for (size_t i = 0; i < count; i++) {
+		if (!IsValidInput (a[i])) {
+			return false;
+		}
+		result[i] = DoOperation (a[i]);
+	}
+	return true;
+}
+
 AbsNode::AbsNode () :
 	UnaryOperationNode ()
 {
@@ -127,6 +161,12 @@ double AbsNode::DoOperation (double a) const
 	return std::abs (a);
 }
 
+bool AbsNode::DoOperations (const double* a, double* result, size_t count) const
+{
+	CalculateUnaryKernel (UnaryKernel::Abs, a, result, count);
+	return true;
+}
+
 FloorNode::FloorNode () :
 	UnaryOperationNode ()
 {
@@ -149,6 +189,12 @@ double FloorNode::DoOperation (double a) const
 	return std::floor (a);
 }
 
+bool FloorNode::DoOperations (const double* a, double* result, size_t count) const
+{
+	CalculateUnaryKernel (UnaryKernel::Floor, a, result, count);
+	return true;
+}
+
 CeilNode::CeilNode () :
 	UnaryOperationNode ()
 {
@@ -171,6 +217,12 @@ double CeilNode::DoOperation (double a) const
 	return std::ceil (a);
 }
 
+bool CeilNode::DoOperations (const double* a, double* result, size_t count) const
+{
+	CalculateUnaryKernel (UnaryKernel::Ceil, a, result, count);
+	return true;
+}
+
 NegativeNode::NegativeNode () :
 	UnaryOperationNode ()
 {
@@ -193,6 +245,12 @@ double NegativeNode::DoOperation (double a) const
 	return a * -1.0;
 }
 
+bool NegativeNode::DoOperations (const double* a, double* result, size_t count) const
+{
+	CalculateUnaryKernel (UnaryKernel::Negative, a, result, count);
+	return true;
+}
+
 SqrtNode::SqrtNode () :
 	UnaryOperationNode ()
 {
@@ -220,4 +278,11 @@ double SqrtNode::DoOperation (double a) const
 	return sqrt (a);
 }
 
+bool SqrtNode::DoOperations (const double* a, double* result, size_t count) const
+{
+	// negative inputs produce nan, which is rejected like an invalid input
+	CalculateUnaryKernel (UnaryKernel::Sqrt, a, result, count);
+	return true;
+}
+
 }
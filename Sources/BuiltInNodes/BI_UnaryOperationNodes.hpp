@@ -4,6 +4,7 @@
 #include "NE_SingleValues.hpp"
 #include "BI_BasicUINode.hpp"
 #include "BI_BuiltInFeatures.hpp"
+#include "BI_NumericKernels.hpp"
 
 namespace BI
 {
@@ -19,17 +20,22 @@ public:
 
 	virtual void				Initialize () override;
 	virtual NE::ValueConstPtr	Calculate (NE::EvaluationEnv& env) const override;
+	virtual NE::ValueHandle		CalculateHandle (NE::EvaluationEnv& env) const override;
 		
 	virtual void				RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
 	virtual bool				IsForceCalculated () const override;
+	virtual bool				IsThreadSafe () const override;
+	virtual bool				IsCalculatedValueProcessed () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status	WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 
 private:
-	NE::ValuePtr				DoSingleOperation (const NE::ValueConstPtr& aValue) const;
+	NE::ValueHandle				DoSingleOperation (double a) const;
 	virtual bool				IsValidInput (double a) const;
 	virtual double				DoOperation (double a) const = 0;
+	virtual bool				DoOperations (const double* a, double* result, size_t count) const;
 };
 
 class AbsNode : public UnaryOperationNode
@@ -42,7 +48,8 @@ public:
 	virtual ~AbsNode ();
 
 private:
-	virtual double DoOperation (double a) const override;
+	virtual double	DoOperation (double a) const override;
+	virtual bool	DoOperations (const double* a, double* result, size_t count) const override;
 };
 
 class FloorNode : public UnaryOperationNode
@@ -55,7 +62,8 @@ public:
 	virtual ~FloorNode ();
 
 private:
-	virtual double DoOperation (double a) const override;
+	virtual double	DoOperation (double a) const override;
+	virtual bool	DoOperations (const double* a, double* result, size_t count) const override;
 };
 
 class CeilNode : public UnaryOperationNode
@@ -68,7 +76,8 @@ public:
 	virtual ~CeilNode ();
 
 private:
-	virtual double DoOperation (double a) const override;
+	virtual double	DoOperation (double a) const override;
+	virtual bool	DoOperations (const double* a, double* result, size_t count) const override;
 };
 
 class NegativeNode : public UnaryOperationNode
@@ -81,7 +90,8 @@ public:
 	virtual ~NegativeNode ();
 
 private:
-	virtual double DoOperation (double a) const override;
+	virtual double	DoOperation (double a) const override;
+	virtual bool	DoOperations (const double* a, double* result, size_t count) const override;
 };
 
 class SqrtNode : public UnaryOperationNode
@@ -96,6 +106,7 @@ public:
 private:
 	virtual bool	IsValidInput (double a) const override;
 	virtual double	DoOperation (double a) const override;
+	virtual bool	DoOperations (const double* a, double* result, size_t count) const override;
 };
 
 }
@@ -1,4 +1,5 @@
 #include "BI_ViewerUINodes.hpp"
+#include "BI_BuiltInSlotIds.hpp"
 #include "BI_UINodePanels.hpp"
 #include "NE_Localization.hpp"
 #include "NUIE_NodeCommonParameters.hpp"
@@ -48,8 +49,8 @@ ViewerNode::~ViewerNode ()
 
 void ViewerNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("in"), NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (InSlotId, NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 bool ViewerNode::IsForceCalculated () const
@@ -57,9 +58,14 @@ bool ViewerNode::IsForceCalculated () const
 	return true;
 }
 
+bool ViewerNode::IsThreadSafe () const
+{
+	return true;
+}
+
 NE::ValueConstPtr ViewerNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr val = EvaluateInputSlot (NE::SlotId ("in"), env);
+	NE::ValueConstPtr val = EvaluateInputSlot (InSlotId, env);
 	if (val == nullptr) {
 		return nullptr;
 	}
@@ -80,6 +86,11 @@ NE::Stream::Status ViewerNode::Write (NE::OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status ViewerNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	return WriteFeatures (outputStream);
+}
+
 MultiLineViewerNode::Layout::Layout (	const std::string& leftButtonId,
 										const std::wstring& leftButtonText,
 										const std::string& rightButtonId,
@@ -132,13 +143,13 @@ MultiLineViewerNode::~MultiLineViewerNode ()
 
 void MultiLineViewerNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("in"), NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (InSlotId, NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 NE::ValueConstPtr MultiLineViewerNode::Calculate (NE::EvaluationEnv& env) const
 {
-	return EvaluateInputSlot (NE::SlotId ("in"), env);
+	return EvaluateInputSlot (InSlotId, env);
 }
 
 void MultiLineViewerNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
@@ -174,6 +185,11 @@ bool MultiLineViewerNode::IsForceCalculated () const
 	return true;
 }
 
+bool MultiLineViewerNode::IsThreadSafe () const
+{
+	return true;
+}
+
 NE::Stream::Status MultiLineViewerNode::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -190,6 +206,11 @@ NE::Stream::Status MultiLineViewerNode::Write (NE::OutputStream& outputStream) c
 	return outputStream.GetStatus ();
 }
 
+NE::Stream::Status MultiLineViewerNode::WriteCalculationSettings (NE::OutputStream& outputStream) const
+{
+	return WriteFeatures (outputStream);
+}
+
 size_t MultiLineViewerNode::GetTextsPerPage () const
 {
 	return textsPerPage;
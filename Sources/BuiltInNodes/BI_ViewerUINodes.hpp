@@ -28,11 +28,13 @@ public:
 
 	virtual void						Initialize () override;
 	virtual bool						IsForceCalculated () const override;
+	virtual bool						IsThreadSafe () const override;
 
 	virtual NE::ValueConstPtr			Calculate (NE::EvaluationEnv& env) const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status			WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 };
 
 class MultiLineViewerNode : public BasicUINode
@@ -63,9 +65,11 @@ public:
 	virtual void						RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
 
 	virtual bool						IsForceCalculated () const override;
+	virtual bool						IsThreadSafe () const override;
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::Stream::Status			WriteCalculationSettings (NE::OutputStream& outputStream) const override;
 
 	size_t								GetTextsPerPage () const;
 	void								SetTextsPerPage (size_t newTextsPerPage);
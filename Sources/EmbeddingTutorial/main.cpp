@@ -84,6 +84,11 @@ public:
 
 	}
 
+	virtual void OnEvaluationProgress (const NE::EvaluationProgress&) override
+	{
+
+	}
+
 	virtual void OnValuesRecalculated () override
 	{
 
@@ -39,6 +39,7 @@ public:
 	virtual NE::EvaluationEnv& 			GetEvaluationEnv () override;
 	virtual void 						OnEvaluationBegin () override;
 	virtual void						OnEvaluationEnd () override;
+	virtual void						OnEvaluationProgress (const NE::EvaluationProgress& progress) override;
 	virtual void						OnValuesRecalculated () override;
 	virtual void						OnRedrawRequested () override;
 
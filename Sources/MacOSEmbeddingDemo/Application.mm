@@ -336,6 +336,11 @@ void AppNodeUIEnvironment::OnEvaluationEnd ()
 
 }
 
+void AppNodeUIEnvironment::OnEvaluationProgress (const NE::EvaluationProgress&)
+{
+
+}
+
 void AppNodeUIEnvironment::OnValuesRecalculated ()
 {
 
@@ -0,0 +1,77 @@
+#include "NE_BackgroundEvaluator.hpp"
+#include "NE_Debug.hpp"
+
+namespace NE
+{
+
+BackgroundEvaluator::BackgroundEvaluator () :
+	snapshot (nullptr),
+	thread (),
+	isFinished (false),
+	isCancelled (false)
+{
+
+}
+
+BackgroundEvaluator::~BackgroundEvaluator ()
+{
+	Cancel ();
+	Finish ();
+}
+
+bool BackgroundEvaluator::IsRunning () const
+{
+	return snapshot != nullptr;
+}
+
+bool BackgroundEvaluator::IsFinished () const
+{
+	return isFinished;
+}
+
+bool BackgroundEvaluator::Start (std::unique_ptr<EvaluationSnapshot>&& newSnapshot, const EvaluationDataPtr& evaluationData)
+{
+	if (DBGERROR (IsRunning () || newSnapshot == nullptr)) {
+		return false;
+	}
+	snapshot = std::move (newSnapshot);
+	isFinished = false;
+	isCancelled = false;
+	thread = std::thread (&BackgroundEvaluator::WorkerThread, this, evaluationData);
+	return true;
+}
+
+void BackgroundEvaluator::Cancel ()
+{
+	isCancelled = true;
+}
+
+void BackgroundEvaluator::Wait ()
+{
+	if (thread.joinable ()) {
+		thread.join ();
+	}
+}
+
+std::unique_ptr<EvaluationSnapshot> BackgroundEvaluator::Finish ()
+{
+	if (!IsRunning ()) {
+		return nullptr;
+	}
+	Wait ();
+	return std::move (snapshot);
+}
+
+void BackgroundEvaluator::WorkerThread (EvaluationDataPtr evaluationData)
+{
+	EvaluationEnv env (evaluationData);
+	// the snapshot is evaluated node by node, so a cancellation request is
+	// noticed after the node under calculation is finished
+	EvaluationProgress progress;
+	do {
+		progress = snapshot->Evaluate (env, std::chrono::microseconds::zero ());
+	} while (!progress.IsFinished () && !isCancelled);
+	isFinished = true;
+}
+
+}
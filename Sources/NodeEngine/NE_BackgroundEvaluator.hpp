@@ -0,0 +1,44 @@
+#ifndef NE_BACKGROUNDEVALUATOR_HPP
+#define NE_BACKGROUNDEVALUATOR_HPP
+
+#include "NE_EvaluationSnapshot.hpp"
+#include "NE_EvaluationEnv.hpp"
+
+#include <memory>
+#include <thread>
+#include <atomic>
+
+namespace NE
+{
+
+class BackgroundEvaluator
+{
+public:
+	BackgroundEvaluator ();
+	BackgroundEvaluator (const BackgroundEvaluator& src) = delete;
+	~BackgroundEvaluator ();
+
+	BackgroundEvaluator&				operator= (const BackgroundEvaluator& rhs) = delete;
+
+	bool								IsRunning () const;
+	bool								IsFinished () const;
+
+	// the worker evaluates with its own environment created from the given data,
+	// so the environment of the caller can be changed while the worker is running
+	bool								Start (std::unique_ptr<EvaluationSnapshot>&& newSnapshot, const EvaluationDataPtr& evaluationData);
+	void								Cancel ();
+	void								Wait ();
+	std::unique_ptr<EvaluationSnapshot>	Finish ();
+
+private:
+	void								WorkerThread (EvaluationDataPtr evaluationData);
+
+	std::unique_ptr<EvaluationSnapshot>	snapshot;
+	std::thread							thread;
+	std::atomic<bool>					isFinished;
+	std::atomic<bool>					isCancelled;
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <list>
 #include <unordered_map>
+#include <functional>
 
 namespace NE
 {
@@ -31,17 +32,33 @@ public:
 	bool				Contains (const KeyType& key) const;
 	void				Clear ();
 
+	size_t				Count () const;
+	size_t				GetSize () const;
+	size_t				GetMaxSize () const;
+	void				SetMaxSize (size_t newMaxSize);
+
 	bool				Add (const KeyType& key, const ValueType& value);
+	bool				Add (const KeyType& key, const ValueType& value, size_t valueSize);
 	const ValueType&	Get (const KeyType& key);
+	void				Enumerate (const std::function<void (const KeyType&, const ValueType&)>& processor) const;
 
 private:
-	using KeyValuePair = std::pair<KeyType, ValueType>;
-	using KeyValuePairIterator = typename std::list<KeyValuePair>::iterator;
+	struct Entry
+	{
+		KeyType		key;
+		ValueType	value;
+		size_t		size;
+	};
+
+	using EntryIterator = typename std::list<Entry>::iterator;
+
+	void										RemoveLeastRecentlyUsed ();
 
-	size_t												maxSize;
-	Controller*											controller;
-	std::list<KeyValuePair>								valueList;
-	std::unordered_map<KeyType, KeyValuePairIterator>	valueMap;
+	size_t										maxSize;
+	size_t										size;
+	Controller*									controller;
+	std::list<Entry>							valueList;
+	std::unordered_map<KeyType, EntryIterator>	valueMap;
 };
 
 template <typename KeyType, typename ValueType>
@@ -66,6 +83,7 @@ Cache<KeyType, ValueType>::Cache (size_t maxSize) :
 template <typename KeyType, typename ValueType>
 Cache<KeyType, ValueType>::Cache (size_t maxSize, Controller* controller) :
 	maxSize (maxSize),
+	size (0),
 	controller (controller),
 	valueList (),
 	valueMap ()
@@ -89,30 +107,60 @@ template <typename KeyType, typename ValueType>
 void Cache<KeyType, ValueType>::Clear ()
 {
 	if (controller != nullptr) {
-		for (KeyValuePair& it : valueList) {
-			controller->DisposeValue (it.second);
+		for (Entry& entry : valueList) {
+			controller->DisposeValue (entry.value);
 		}
 	}
 	valueList.clear ();
 	valueMap.clear ();
+	size = 0;
+}
+
+template <typename KeyType, typename ValueType>
+size_t Cache<KeyType, ValueType>::Count () const
+{
+	return valueList.size ();
+}
+
+template <typename KeyType, typename ValueType>
+size_t Cache<KeyType, ValueType>::GetSize () const
+{
+	return size;
+}
+
+template <typename KeyType, typename ValueType>
+size_t Cache<KeyType, ValueType>::GetMaxSize () const
+{
+	return maxSize;
+}
+
+template <typename KeyType, typename ValueType>
+void Cache<KeyType, ValueType>::SetMaxSize (size_t newMaxSize)
+{
+	maxSize = newMaxSize;
+	while (size > maxSize) {
+		RemoveLeastRecentlyUsed ();
+	}
 }
 
 template <typename KeyType, typename ValueType>
 bool Cache<KeyType, ValueType>::Add (const KeyType& key, const ValueType& value)
 {
-	if (Contains (key)) {
+	return Add (key, value, 1);
+}
+
+template <typename KeyType, typename ValueType>
+bool Cache<KeyType, ValueType>::Add (const KeyType& key, const ValueType& value, size_t valueSize)
+{
+	if (Contains (key) || valueSize > maxSize) {
 		return false;
 	}
-	if (valueList.size () >= maxSize) {
-		KeyValuePair& keyValuePair = valueList.front ();
-		if (controller != nullptr) {
-			controller->DisposeValue (keyValuePair.second);
-		}
-		valueMap.erase (keyValuePair.first);
-		valueList.pop_front ();
+	while (size + valueSize > maxSize) {
+		RemoveLeastRecentlyUsed ();
 	}
-	valueList.push_back ({ key, value });
+	valueList.push_back ({ key, value, valueSize });
 	valueMap.insert ({ key, std::prev (valueList.end ()) });
+	size += valueSize;
 	return true;
 }
 
@@ -122,8 +170,29 @@ const ValueType& Cache<KeyType, ValueType>::Get (const KeyType& key)
 	if (controller != nullptr && !Contains (key)) {
 		Add (key, controller->CreateValue (key));
 	}
-	const KeyValuePair& pair = *valueMap.at (key);
-	return pair.second;
+	EntryIterator entryIt = valueMap.at (key);
+	valueList.splice (valueList.end (), valueList, entryIt);
+	return entryIt->value;
+}
+
+template <typename KeyType, typename ValueType>
+void Cache<KeyType, ValueType>::Enumerate (const std::function<void (const KeyType&, const ValueType&)>& processor) const
+{
+	for (const Entry& entry : valueList) {
+		processor (entry.key, entry.value);
+	}
+}
+
+template <typename KeyType, typename ValueType>
+void Cache<KeyType, ValueType>::RemoveLeastRecentlyUsed ()
+{
+	Entry& entry = valueList.front ();
+	if (controller != nullptr) {
+		controller->DisposeValue (entry.value);
+	}
+	size -= entry.size;
+	valueMap.erase (entry.key);
+	valueList.pop_front ();
 }
 
 }
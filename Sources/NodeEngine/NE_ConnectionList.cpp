@@ -0,0 +1,133 @@
+#include "NE_ConnectionList.hpp"
+#include "NE_Debug.hpp"
+
+#include <algorithm>
+
+namespace NE
+{
+
+static const std::vector<size_t> EmptyConnections;
+
+ConnectionList::ConnectionList () :
+	connections (),
+	connectionCountHistogram (),
+	connectionCount (0),
+	connectionCapacity (0),
+	maxConnectionCount (0)
+{
+
+}
+
+ConnectionList::~ConnectionList ()
+{
+
+}
+
+void ConnectionList::Clear ()
+{
+	connections.clear ();
+	connectionCountHistogram.clear ();
+	connectionCount = 0;
+	connectionCapacity = 0;
+	maxConnectionCount = 0;
+}
+
+bool ConnectionList::IsEmpty () const
+{
+	return connectionCount == 0;
+}
+
+size_t ConnectionList::GetConnectionCount () const
+{
+	return connectionCount;
+}
+
+size_t ConnectionList::GetConnectionCount (size_t begIndex) const
+{
+	return GetConnections (begIndex).size ();
+}
+
+size_t ConnectionList::GetMaxConnectionCount () const
+{
+	return maxConnectionCount;
+}
+
+size_t ConnectionList::GetMemorySize () const
+{
+	size_t memorySize = sizeof (ConnectionList);
+	memorySize += connections.capacity () * sizeof (std::vector<size_t>);
+	memorySize += connectionCountHistogram.capacity () * sizeof (size_t);
+	memorySize += connectionCapacity * sizeof (size_t);
+	return memorySize;
+}
+
+bool ConnectionList::HasConnection (size_t begIndex) const
+{
+	return !GetConnections (begIndex).empty ();
+}
+
+bool ConnectionList::HasConnection (size_t begIndex, size_t endIndex) const
+{
+	const std::vector<size_t>& endIndices = GetConnections (begIndex);
+	return std::find (endIndices.begin (), endIndices.end (), endIndex) != endIndices.end ();
+}
+
+const std::vector<size_t>& ConnectionList::GetConnections (size_t begIndex) const
+{
+	if (begIndex >= connections.size ()) {
+		return EmptyConnections;
+	}
+	return connections[begIndex];
+}
+
+void ConnectionList::AddConnection (size_t begIndex, size_t endIndex)
+{
+	DBGASSERT (!HasConnection (begIndex, endIndex));
+	if (begIndex >= connections.size ()) {
+		connections.resize (begIndex + 1);
+	}
+	std::vector<size_t>& endIndices = connections[begIndex];
+	size_t oldCapacity = endIndices.capacity ();
+	endIndices.push_back (endIndex);
+	connectionCapacity += endIndices.capacity () - oldCapacity;
+	ChangeConnectionCount (endIndices.size () - 1, endIndices.size ());
+	connectionCount++;
+}
+
+void ConnectionList::DeleteConnection (size_t begIndex, size_t endIndex)
+{
+	DBGASSERT (HasConnection (begIndex, endIndex));
+	if (DBGERROR (begIndex >= connections.size ())) {
+		return;
+	}
+	std::vector<size_t>& endIndices = connections[begIndex];
+	auto foundEndIndex = std::find (endIndices.begin (), endIndices.end (), endIndex);
+	if (DBGVERIFY (foundEndIndex != endIndices.end ())) {
+		endIndices.erase (foundEndIndex);
+		ChangeConnectionCount (endIndices.size () + 1, endIndices.size ());
+		connectionCount--;
+	}
+}
+
+void ConnectionList::ChangeConnectionCount (size_t oldCount, size_t newCount)
+{
+	// the histogram counts the slots by connection count, so the maximum
+	// can be found again after a deletion without visiting every slot
+	if (newCount >= connectionCountHistogram.size ()) {
+		connectionCountHistogram.resize (newCount + 1, 0);
+	}
+	if (oldCount > 0) {
+		connectionCountHistogram[oldCount]--;
+	}
+	if (newCount > 0) {
+		connectionCountHistogram[newCount]++;
+	}
+	if (newCount > maxConnectionCount) {
+		maxConnectionCount = newCount;
+	}
+	while (maxConnectionCount > 0 && connectionCountHistogram[maxConnectionCount] == 0) {
+		maxConnectionCount--;
+	}
+}
+
+}
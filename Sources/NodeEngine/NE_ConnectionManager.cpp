@@ -7,6 +7,8 @@ namespace NE
 {
 
 ConnectionManager::ConnectionManager () :
+	inputSlots (),
+	outputSlots (),
 	outputToInputConnections (),
 	inputToOutputConnections ()
 {
@@ -15,6 +17,8 @@ ConnectionManager::ConnectionManager () :
 
 void ConnectionManager::Clear ()
 {
+	inputSlots.Clear ();
+	outputSlots.Clear ();
 	outputToInputConnections.Clear ();
 	inputToOutputConnections.Clear ();
 }
@@ -31,34 +35,51 @@ size_t ConnectionManager::GetConnectionCount () const
 	return outputToInputConnections.GetConnectionCount ();
 }
 
+size_t ConnectionManager::GetMaxConnectedOutputSlotCount () const
+{
+	return inputToOutputConnections.GetMaxConnectionCount ();
+}
+
+size_t ConnectionManager::GetMaxConnectedInputSlotCount () const
+{
+	return outputToInputConnections.GetMaxConnectionCount ();
+}
+
+size_t ConnectionManager::GetMemorySize () const
+{
+	size_t memorySize = inputSlots.GetMemorySize () + outputSlots.GetMemorySize ();
+	memorySize += outputToInputConnections.GetMemorySize () + inputToOutputConnections.GetMemorySize ();
+	return memorySize;
+}
+
 bool ConnectionManager::HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const
 {
-	return inputToOutputConnections.HasConnection (inputSlot);
+	return inputToOutputConnections.HasConnection (inputSlots.Find (inputSlot));
 }
 
 bool ConnectionManager::HasConnectedInputSlots (const OutputSlotConstPtr& outputSlot) const
 {
-	return outputToInputConnections.HasConnection (outputSlot);
+	return outputToInputConnections.HasConnection (outputSlots.Find (outputSlot));
 }
 
 size_t ConnectionManager::GetConnectedOutputSlotCount (const InputSlotConstPtr& inputSlot) const
 {
-	return inputToOutputConnections.GetConnectionCount (inputSlot);
+	return inputToOutputConnections.GetConnectionCount (inputSlots.Find (inputSlot));
 }
 
 size_t ConnectionManager::GetConnectedInputSlotCount (const OutputSlotConstPtr& outputSlot) const
 {
-	return outputToInputConnections.GetConnectionCount (outputSlot);
+	return outputToInputConnections.GetConnectionCount (outputSlots.Find (outputSlot));
 }
 
 void ConnectionManager::EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const
 {
-	inputToOutputConnections.EnumerateConnections (inputSlot, processor);
+	ForEachConnectedOutputSlot (inputSlot, processor);
 }
 
 void ConnectionManager::EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::function<void (const InputSlotConstPtr&)>& processor) const
 {
-	outputToInputConnections.EnumerateConnections (outputSlot, processor);
+	ForEachConnectedInputSlot (outputSlot, processor);
 }
 
 bool ConnectionManager::IsOutputSlotConnectedToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const
@@ -66,8 +87,13 @@ bool ConnectionManager::IsOutputSlotConnectedToInputSlot (const OutputSlotConstP
 	if (outputSlot == nullptr || inputSlot == nullptr) {
 		return false;
 	}
-	DBGASSERT (outputToInputConnections.HasConnection (outputSlot, inputSlot) == inputToOutputConnections.HasConnection (inputSlot, outputSlot));
-	return outputToInputConnections.HasConnection (outputSlot, inputSlot);
+	size_t outputSlotIndex = outputSlots.Find (outputSlot);
+	size_t inputSlotIndex = inputSlots.Find (inputSlot);
+	if (outputSlotIndex == InvalidSlotIndex || inputSlotIndex == InvalidSlotIndex) {
+		return false;
+	}
+	DBGASSERT (outputToInputConnections.HasConnection (outputSlotIndex, inputSlotIndex) == inputToOutputConnections.HasConnection (inputSlotIndex, outputSlotIndex));
+	return outputToInputConnections.HasConnection (outputSlotIndex, inputSlotIndex);
 }
 
 bool ConnectionManager::CanConnectOutputSlotToInputSlot (const InputSlotConstPtr& inputSlot) const
@@ -111,8 +137,7 @@ bool ConnectionManager::CanConnectOutputSlotToInputSlot (const OutputSlotConstPt
 		return false;
 	}
 
-	DBGASSERT (outputToInputConnections.HasConnection (outputSlot, inputSlot) == inputToOutputConnections.HasConnection (inputSlot, outputSlot));
-	if (outputToInputConnections.HasConnection (outputSlot, inputSlot)) {
+	if (IsOutputSlotConnectedToInputSlot (outputSlot, inputSlot)) {
 		return false;
 	}
 
@@ -127,8 +152,11 @@ bool ConnectionManager::ConnectOutputSlotToInputSlot (const OutputSlotConstPtr&
 	if (inputSlot->GetOutputSlotConnectionMode () == OutputSlotConnectionMode::Single) {
 		DisconnectAllOutputSlotsFromInputSlot (inputSlot);
 	}
-	inputToOutputConnections.AddConnection (inputSlot, outputSlot);
-	outputToInputConnections.AddConnection (outputSlot, inputSlot);
+	// slots registered after their node was added get their index here
+	size_t outputSlotIndex = outputSlots.Add (outputSlot);
+	size_t inputSlotIndex = inputSlots.Add (inputSlot);
+	inputToOutputConnections.AddConnection (inputSlotIndex, outputSlotIndex);
+	outputToInputConnections.AddConnection (outputSlotIndex, inputSlotIndex);
 	return true;
 }
 
@@ -137,8 +165,13 @@ bool ConnectionManager::DisconnectOutputSlotFromInputSlot (const OutputSlotConst
 	if (DBGERROR (outputSlot == nullptr || inputSlot == nullptr)) {
 		return false;
 	}
-	inputToOutputConnections.DeleteConnection (inputSlot, outputSlot);
-	outputToInputConnections.DeleteConnection (outputSlot, inputSlot);
+	size_t outputSlotIndex = outputSlots.Find (outputSlot);
+	size_t inputSlotIndex = inputSlots.Find (inputSlot);
+	if (DBGERROR (outputSlotIndex == InvalidSlotIndex || inputSlotIndex == InvalidSlotIndex)) {
+		return false;
+	}
+	inputToOutputConnections.DeleteConnection (inputSlotIndex, outputSlotIndex);
+	outputToInputConnections.DeleteConnection (outputSlotIndex, inputSlotIndex);
 	return true;
 }
 
@@ -147,12 +180,9 @@ bool ConnectionManager::DisconnectAllOutputSlotsFromInputSlot (const InputSlotCo
 	if (DBGERROR (inputSlot == nullptr)) {
 		return false;
 	}
-	std::unordered_set<OutputSlotConstPtr> outputSlotsToDisconnect;
-	EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
-		outputSlotsToDisconnect.insert (outputSlot);
-	});
-	for (const OutputSlotConstPtr& outputSlot : outputSlotsToDisconnect) {
-		DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot);
+	std::vector<size_t> outputSlotIndicesToDisconnect = GetConnectedOutputSlotIndices (inputSlot);
+	for (size_t outputSlotIndex : outputSlotIndicesToDisconnect) {
+		DisconnectOutputSlotFromInputSlot (outputSlots.Get (outputSlotIndex), inputSlot);
 	}
 	return true;
 }
@@ -162,14 +192,65 @@ bool ConnectionManager::DisconnectAllInputSlotsFromOutputSlot (const OutputSlotC
 	if (DBGERROR (outputSlot == nullptr)) {
 		return false;
 	}
-	std::unordered_set<InputSlotConstPtr> inputSlotsToDisconnect;
-	EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
-		inputSlotsToDisconnect.insert (inputSlot);
-	});
-	for (const InputSlotConstPtr& inputSlot : inputSlotsToDisconnect) {
-		DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot);
+	std::vector<size_t> inputSlotIndicesToDisconnect = GetConnectedInputSlotIndices (outputSlot);
+	for (size_t inputSlotIndex : inputSlotIndicesToDisconnect) {
+		DisconnectOutputSlotFromInputSlot (outputSlot, inputSlots.Get (inputSlotIndex));
 	}
 	return true;
 }
 
+void ConnectionManager::RegisterInputSlot (const InputSlotConstPtr& inputSlot)
+{
+	if (DBGERROR (inputSlot == nullptr)) {
+		return;
+	}
+	inputSlots.Add (inputSlot);
+}
+
+void ConnectionManager::RegisterOutputSlot (const OutputSlotConstPtr& outputSlot)
+{
+	if (DBGERROR (outputSlot == nullptr)) {
+		return;
+	}
+	outputSlots.Add (outputSlot);
+}
+
+void ConnectionManager::UnregisterInputSlot (const InputSlotConstPtr& inputSlot)
+{
+	if (DBGERROR (inputSlot == nullptr)) {
+		return;
+	}
+	DBGASSERT (!HasConnectedOutputSlots (inputSlot));
+	inputSlots.Remove (inputSlot);
+}
+
+void ConnectionManager::UnregisterOutputSlot (const OutputSlotConstPtr& outputSlot)
+{
+	if (DBGERROR (outputSlot == nullptr)) {
+		return;
+	}
+	DBGASSERT (!HasConnectedInputSlots (outputSlot));
+	outputSlots.Remove (outputSlot);
+}
+
+const std::vector<size_t>& ConnectionManager::GetConnectedOutputSlotIndices (const InputSlotConstPtr& inputSlot) const
+{
+	return inputToOutputConnections.GetConnections (inputSlots.Find (inputSlot));
+}
+
+const std::vector<size_t>& ConnectionManager::GetConnectedInputSlotIndices (const OutputSlotConstPtr& outputSlot) const
+{
+	return outputToInputConnections.GetConnections (outputSlots.Find (outputSlot));
+}
+
+const InputSlotConstPtr& ConnectionManager::GetInputSlot (size_t inputSlotIndex) const
+{
+	return inputSlots.Get (inputSlotIndex);
+}
+
+const OutputSlotConstPtr& ConnectionManager::GetOutputSlot (size_t outputSlotIndex) const
+{
+	return outputSlots.Get (outputSlotIndex);
+}
+
 }
@@ -3,8 +3,7 @@
 
 #include "NE_NodeEngineTypes.hpp"
 #include "NE_ConnectionList.hpp"
-#include <unordered_map>
-#include <unordered_set>
+#include "NE_SlotIndexTable.hpp"
 #include <functional>
 
 namespace NE
@@ -18,6 +17,9 @@ public:
 	void	Clear ();
 	bool	IsEmpty () const;
 	size_t	GetConnectionCount () const;
+	size_t	GetMaxConnectedOutputSlotCount () const;
+	size_t	GetMaxConnectedInputSlotCount () const;
+	size_t	GetMemorySize () const;
 
 	bool	HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const;
 	bool	HasConnectedInputSlots (const OutputSlotConstPtr& outputSlot) const;
@@ -28,6 +30,11 @@ public:
 	void	EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const;
 	void	EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::function<void (const InputSlotConstPtr&)>& processor) const;
 
+	template <typename Processor>
+	void	ForEachConnectedOutputSlot (const InputSlotConstPtr& inputSlot, Processor&& processor) const;
+	template <typename Processor>
+	void	ForEachConnectedInputSlot (const OutputSlotConstPtr& outputSlot, Processor&& processor) const;
+
 	bool	IsOutputSlotConnectedToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const;
 	bool	CanConnectOutputSlotToInputSlot (const InputSlotConstPtr& inputSlot) const;
 	bool	CanConnectOutputSlotToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const;
@@ -37,11 +44,40 @@ public:
 	bool	DisconnectAllOutputSlotsFromInputSlot (const InputSlotConstPtr& inputSlot);
 	bool	DisconnectAllInputSlotsFromOutputSlot (const OutputSlotConstPtr& outputSlot);
 
+	void	RegisterInputSlot (const InputSlotConstPtr& inputSlot);
+	void	RegisterOutputSlot (const OutputSlotConstPtr& outputSlot);
+	void	UnregisterInputSlot (const InputSlotConstPtr& inputSlot);
+	void	UnregisterOutputSlot (const OutputSlotConstPtr& outputSlot);
+
+	// index based access, the returned indices can be resolved with GetInputSlot and GetOutputSlot
+	const std::vector<size_t>&	GetConnectedOutputSlotIndices (const InputSlotConstPtr& inputSlot) const;
+	const std::vector<size_t>&	GetConnectedInputSlotIndices (const OutputSlotConstPtr& outputSlot) const;
+	const InputSlotConstPtr&	GetInputSlot (size_t inputSlotIndex) const;
+	const OutputSlotConstPtr&	GetOutputSlot (size_t outputSlotIndex) const;
+
 private:
-	ConnectionList<OutputSlotConstPtr, InputSlotConstPtr>	outputToInputConnections;
-	ConnectionList<InputSlotConstPtr, OutputSlotConstPtr>	inputToOutputConnections;
+	SlotIndexTable<InputSlotConstPtr>	inputSlots;
+	SlotIndexTable<OutputSlotConstPtr>	outputSlots;
+	ConnectionList						outputToInputConnections;
+	ConnectionList						inputToOutputConnections;
 };
 
+template <typename Processor>
+void ConnectionManager::ForEachConnectedOutputSlot (const InputSlotConstPtr& inputSlot, Processor&& processor) const
+{
+	for (size_t outputSlotIndex : GetConnectedOutputSlotIndices (inputSlot)) {
+		processor (outputSlots.Get (outputSlotIndex));
+	}
+}
+
+template <typename Processor>
+void ConnectionManager::ForEachConnectedInputSlot (const OutputSlotConstPtr& outputSlot, Processor&& processor) const
+{
+	for (size_t inputSlotIndex : GetConnectedInputSlotIndices (outputSlot)) {
+		processor (inputSlots.Get (inputSlotIndex));
+	}
+}
+
 }
 
 #endif
@@ -0,0 +1,149 @@
+#include "NE_EvaluationArena.hpp"
+#include "NE_Debug.hpp"
+
+#include <atomic>
+#include <new>
+
+namespace NE
+{
+
+static const size_t Alignment = alignof (std::max_align_t);
+
+static size_t AlignSize (size_t size)
+{
+	return (size + Alignment - 1) / Alignment * Alignment;
+}
+
+// every block is preceded by a pointer to its chunk
+struct EvaluationArena::Chunk
+{
+	std::atomic<size_t>	refCount;
+	size_t				size;
+	size_t				used;
+};
+
+static const size_t BlockHeaderSize = AlignSize (sizeof (void*));
+
+EvaluationArenaStatistics::EvaluationArenaStatistics () :
+	EvaluationArenaStatistics (0, 0, 0)
+{
+
+}
+
+EvaluationArenaStatistics::EvaluationArenaStatistics (size_t allocationCount, size_t chunkCount, size_t allocatedSize) :
+	allocationCount (allocationCount),
+	chunkCount (chunkCount),
+	allocatedSize (allocatedSize)
+{
+
+}
+
+EvaluationArenaStatistics::~EvaluationArenaStatistics ()
+{
+
+}
+
+size_t EvaluationArenaStatistics::GetAllocationCount () const
+{
+	return allocationCount;
+}
+
+size_t EvaluationArenaStatistics::GetChunkCount () const
+{
+	return chunkCount;
+}
+
+size_t EvaluationArenaStatistics::GetAllocatedSize () const
+{
+	return allocatedSize;
+}
+
+EvaluationArena::EvaluationArena () :
+	EvaluationArena (DefaultChunkSize)
+{
+
+}
+
+EvaluationArena::EvaluationArena (size_t chunkSize) :
+	mutex (),
+	chunkSize (chunkSize),
+	currentChunk (nullptr),
+	allocationCount (0),
+	chunkCount (0),
+	allocatedSize (0)
+{
+
+}
+
+EvaluationArena::~EvaluationArena ()
+{
+	// the chunk stays alive while there are living objects in it
+	if (currentChunk != nullptr) {
+		ReleaseChunk (currentChunk);
+	}
+}
+
+void* EvaluationArena::Allocate (size_t size)
+{
+	size_t blockSize = BlockHeaderSize + AlignSize (size);
+
+	std::lock_guard<std::mutex> lock (mutex);
+	allocationCount++;
+	allocatedSize += size;
+
+	Chunk* chunk = nullptr;
+	if (blockSize > chunkSize / 4) {
+		// large blocks get their own chunk, its only reference is the block
+		chunk = CreateChunk (blockSize);
+	} else {
+		if (currentChunk == nullptr || currentChunk->used + blockSize > currentChunk->size) {
+			if (currentChunk != nullptr) {
+				ReleaseChunk (currentChunk);
+			}
+			currentChunk = CreateChunk (chunkSize);
+		}
+		chunk = currentChunk;
+		chunk->refCount.fetch_add (1, std::memory_order_relaxed);
+	}
+
+	char* block = reinterpret_cast<char*> (chunk) + AlignSize (sizeof (Chunk)) + chunk->used;
+	chunk->used += blockSize;
+	*reinterpret_cast<Chunk**> (block) = chunk;
+	return block + BlockHeaderSize;
+}
+
+void EvaluationArena::Deallocate (void* ptr)
+{
+	if (DBGERROR (ptr == nullptr)) {
+		return;
+	}
+	char* block = static_cast<char*> (ptr) - BlockHeaderSize;
+	ReleaseChunk (*reinterpret_cast<Chunk**> (block));
+}
+
+EvaluationArenaStatistics EvaluationArena::GetStatistics () const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return EvaluationArenaStatistics (allocationCount, chunkCount, allocatedSize);
+}
+
+EvaluationArena::Chunk* EvaluationArena::CreateChunk (size_t minimumSize)
+{
+	void* memory = ::operator new (AlignSize (sizeof (Chunk)) + minimumSize);
+	Chunk* chunk = new (memory) Chunk ();
+	chunk->refCount.store (1, std::memory_order_relaxed);
+	chunk->size = minimumSize;
+	chunk->used = 0;
+	chunkCount++;
+	return chunk;
+}
+
+void EvaluationArena::ReleaseChunk (Chunk* chunk)
+{
+	if (chunk->refCount.fetch_sub (1, std::memory_order_acq_rel) == 1) {
+		chunk->~Chunk ();
+		::operator delete (chunk);
+	}
+}
+
+}
@@ -0,0 +1,121 @@
+#ifndef NE_EVALUATIONARENA_HPP
+#define NE_EVALUATIONARENA_HPP
+
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+namespace NE
+{
+
+class EvaluationArenaStatistics
+{
+public:
+	EvaluationArenaStatistics ();
+	EvaluationArenaStatistics (size_t allocationCount, size_t chunkCount, size_t allocatedSize);
+	~EvaluationArenaStatistics ();
+
+	size_t	GetAllocationCount () const;
+	size_t	GetChunkCount () const;
+	size_t	GetAllocatedSize () const;
+
+private:
+	size_t	allocationCount;
+	size_t	chunkCount;
+	size_t	allocatedSize;
+};
+
+// allocates objects from large chunks instead of allocating them one by one,
+// every chunk counts the objects living in it, so objects can outlive the
+// arena itself, the chunk is released when the last object in it is destroyed
+class EvaluationArena
+{
+public:
+	static const size_t DefaultChunkSize = 64 * 1024;
+
+	EvaluationArena ();
+	EvaluationArena (size_t chunkSize);
+	EvaluationArena (const EvaluationArena& src) = delete;
+	~EvaluationArena ();
+
+	EvaluationArena&			operator= (const EvaluationArena& rhs) = delete;
+
+	template <typename Type, typename... Args>
+	std::shared_ptr<Type>		Create (Args&&... args);
+
+	void*						Allocate (size_t size);
+	static void					Deallocate (void* ptr);
+
+	EvaluationArenaStatistics	GetStatistics () const;
+
+private:
+	struct Chunk;
+
+	Chunk*						CreateChunk (size_t minimumSize);
+	static void					ReleaseChunk (Chunk* chunk);
+
+	mutable std::mutex			mutex;
+	size_t						chunkSize;
+	Chunk*						currentChunk;
+	size_t						allocationCount;
+	size_t						chunkCount;
+	size_t						allocatedSize;
+};
+
+using EvaluationArenaPtr = std::shared_ptr<EvaluationArena>;
+using EvaluationArenaConstPtr = std::shared_ptr<const EvaluationArena>;
+
+template <typename Type>
+class EvaluationArenaAllocator
+{
+public:
+	using value_type = Type;
+
+	EvaluationArenaAllocator (EvaluationArena* arena) :
+		arena (arena)
+	{
+
+	}
+
+	template <typename OtherType>
+	EvaluationArenaAllocator (const EvaluationArenaAllocator<OtherType>& src) :
+		arena (src.arena)
+	{
+
+	}
+
+	Type* allocate (size_t count)
+	{
+		return static_cast<Type*> (arena->Allocate (count * sizeof (Type)));
+	}
+
+	void deallocate (Type* ptr, size_t)
+	{
+		EvaluationArena::Deallocate (ptr);
+	}
+
+	template <typename OtherType>
+	bool operator== (const EvaluationArenaAllocator<OtherType>& rhs) const
+	{
+		return arena == rhs.arena;
+	}
+
+	template <typename OtherType>
+	bool operator!= (const EvaluationArenaAllocator<OtherType>& rhs) const
+	{
+		return arena != rhs.arena;
+	}
+
+	EvaluationArena* arena;
+};
+
+template <typename Type, typename... Args>
+std::shared_ptr<Type> EvaluationArena::Create (Args&&... args)
+{
+	// the object and its control block are allocated together in the arena
+	return std::allocate_shared<Type> (EvaluationArenaAllocator<Type> (this), std::forward<Args> (args)...);
+}
+
+}
+
+#endif
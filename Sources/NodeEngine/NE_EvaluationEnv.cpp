@@ -14,7 +14,15 @@ EvaluationData::~EvaluationData ()
 }
 
 EvaluationEnv::EvaluationEnv (const EvaluationDataPtr& data) :
-	data (data)
+	EvaluationEnv (data, nullptr)
+{
+
+}
+
+EvaluationEnv::EvaluationEnv (const EvaluationDataPtr& data, const EvaluationArenaPtr& arena) :
+	data (data),
+	arena (arena),
+	nodeEvaluator (nullptr)
 {
 
 }
@@ -24,6 +32,31 @@ EvaluationEnv::~EvaluationEnv ()
 
 }
 
+bool EvaluationEnv::HasArena () const
+{
+	return arena != nullptr;
+}
+
+const EvaluationArenaPtr& EvaluationEnv::GetArena () const
+{
+	return arena;
+}
+
+void EvaluationEnv::SetArena (const EvaluationArenaPtr& newArena)
+{
+	arena = newArena;
+}
+
+const NodeEvaluator* EvaluationEnv::GetNodeEvaluator () const
+{
+	return nodeEvaluator;
+}
+
+void EvaluationEnv::SetNodeEvaluator (const NodeEvaluator* newNodeEvaluator)
+{
+	nodeEvaluator = newNodeEvaluator;
+}
+
 EvaluationEnv EmptyEvaluationEnv (nullptr);
 
 }
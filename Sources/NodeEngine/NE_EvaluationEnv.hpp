@@ -1,11 +1,15 @@
 #ifndef NE_EVALUATIONENVIRONMENT_HPP
 #define NE_EVALUATIONENVIRONMENT_HPP
 
+#include "NE_EvaluationArena.hpp"
+
 #include <memory>
 
 namespace NE
 {
 
+class NodeEvaluator;
+
 class EvaluationData
 {
 public:
@@ -20,6 +24,7 @@ class EvaluationEnv
 {
 public:
 	EvaluationEnv (const EvaluationDataPtr& data);
+	EvaluationEnv (const EvaluationDataPtr& data, const EvaluationArenaPtr& arena);
 	~EvaluationEnv ();
 
 	template <typename T>
@@ -28,8 +33,25 @@ public:
 	template <typename T>
 	std::shared_ptr<T> GetData ();
 
+	// creates a temporary object of the calculation in the arena if there is one,
+	// otherwise on the heap, an object in the arena keeps its whole chunk alive,
+	// so the calculated values must be created on the heap
+	template <typename T, typename... Args>
+	std::shared_ptr<T> CreateTemporary (Args&&... args);
+
+	bool HasArena () const;
+	const EvaluationArenaPtr& GetArena () const;
+	void SetArena (const EvaluationArenaPtr& newArena);
+
+	// the evaluator overrides the evaluators of the nodes, so nodes can be
+	// evaluated against another graph state, like an evaluation snapshot
+	const NodeEvaluator* GetNodeEvaluator () const;
+	void SetNodeEvaluator (const NodeEvaluator* newNodeEvaluator);
+
 private:
 	EvaluationDataPtr data;
+	EvaluationArenaPtr arena;
+	const NodeEvaluator* nodeEvaluator;
 };
 
 template <typename T>
@@ -44,6 +66,15 @@ std::shared_ptr<T> EvaluationEnv::GetData ()
 	return std::dynamic_pointer_cast<T> (data);
 }
 
+template <typename T, typename... Args>
+std::shared_ptr<T> EvaluationEnv::CreateTemporary (Args&&... args)
+{
+	if (arena == nullptr) {
+		return std::shared_ptr<T> (new T (std::forward<Args> (args)...));
+	}
+	return arena->Create<T> (std::forward<Args> (args)...);
+}
+
 extern EvaluationEnv EmptyEvaluationEnv;
 
 }
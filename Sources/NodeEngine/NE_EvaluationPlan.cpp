@@ -0,0 +1,171 @@
+#include "NE_EvaluationPlan.hpp"
+#include "NE_Node.hpp"
+#include "NE_Debug.hpp"
+
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+namespace NE
+{
+
+const size_t InvalidEvaluationPlanIndex = std::numeric_limits<size_t>::max ();
+
+EvaluationPlan::Graph::Graph ()
+{
+
+}
+
+EvaluationPlan::Graph::~Graph ()
+{
+
+}
+
+EvaluationPlan::NodeEntry::NodeEntry (const NodeConstPtr& node, size_t firstInput) :
+	node (node),
+	firstInput (firstInput),
+	inputCount (0)
+{
+
+}
+
+EvaluationPlan::InputEntry::InputEntry (const InputSlot* inputSlot, size_t firstSource) :
+	inputSlot (inputSlot),
+	firstSource (firstSource),
+	sourceCount (0)
+{
+
+}
+
+EvaluationPlan::SourceEntry::SourceEntry (const OutputSlotConstPtr& outputSlot, size_t nodeIndex) :
+	outputSlot (outputSlot),
+	nodeIndex (nodeIndex)
+{
+
+}
+
+EvaluationPlan::EvaluationPlan () :
+	isValid (false),
+	buildStamp (),
+	depth (0),
+	nodes (),
+	inputs (),
+	sources ()
+{
+
+}
+
+EvaluationPlan::EvaluationPlan (const Stamp& buildStamp) :
+	isValid (false),
+	buildStamp (buildStamp),
+	depth (0),
+	nodes (),
+	inputs (),
+	sources ()
+{
+
+}
+
+EvaluationPlan::~EvaluationPlan ()
+{
+
+}
+
+bool EvaluationPlan::IsValid () const
+{
+	return isValid;
+}
+
+void EvaluationPlan::Invalidate ()
+{
+	isValid = false;
+	depth = 0;
+	nodes.clear ();
+	inputs.clear ();
+	sources.clear ();
+}
+
+void EvaluationPlan::Build (const std::vector<NodeConstPtr>& sortedNodes, const Graph& graph)
+{
+	Invalidate ();
+
+	std::unordered_map<NodeId, size_t> nodeIdToIndex;
+	for (size_t nodeIndex = 0; nodeIndex < sortedNodes.size (); nodeIndex++) {
+		nodeIdToIndex.insert ({ sortedNodes[nodeIndex]->GetId (), nodeIndex });
+	}
+
+	// the nodes are sorted, so the level of every source is known before its targets
+	std::vector<size_t> nodeLevels;
+	nodeLevels.reserve (sortedNodes.size ());
+	nodes.reserve (sortedNodes.size ());
+	for (const NodeConstPtr& node : sortedNodes) {
+		NodeEntry nodeEntry (node, inputs.size ());
+		size_t nodeLevel = 1;
+		node->ForEachInputSlot ([&] (InputSlotConstPtr inputSlot) {
+			InputEntry inputEntry (inputSlot.get (), sources.size ());
+			graph.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+				size_t sourceNodeIndex = nodeIdToIndex.at (outputSlot->GetOwnerNodeId ());
+				DBGASSERT (sourceNodeIndex < nodes.size ());
+				sources.push_back (SourceEntry (outputSlot, sourceNodeIndex));
+				nodeLevel = std::max (nodeLevel, nodeLevels[sourceNodeIndex] + 1);
+				inputEntry.sourceCount++;
+			});
+			inputs.push_back (inputEntry);
+			nodeEntry.inputCount++;
+			return true;
+		});
+		nodes.push_back (nodeEntry);
+		nodeLevels.push_back (nodeLevel);
+		depth = std::max (depth, nodeLevel);
+	}
+
+	isValid = true;
+	buildStamp.Update ();
+}
+
+const Stamp& EvaluationPlan::GetBuildStamp () const
+{
+	return buildStamp;
+}
+
+size_t EvaluationPlan::GetNodeCount () const
+{
+	return nodes.size ();
+}
+
+size_t EvaluationPlan::GetDepth () const
+{
+	return depth;
+}
+
+size_t EvaluationPlan::GetMemorySize () const
+{
+	size_t memorySize = sizeof (EvaluationPlan);
+	memorySize += nodes.capacity () * sizeof (NodeEntry);
+	memorySize += inputs.capacity () * sizeof (InputEntry);
+	memorySize += sources.capacity () * sizeof (SourceEntry);
+	return memorySize;
+}
+
+const NodeConstPtr& EvaluationPlan::GetNode (size_t nodeIndex) const
+{
+	return nodes[nodeIndex].node;
+}
+
+bool EvaluationPlan::EnumerateConnectedOutputSlots (size_t nodeIndex, const InputSlot* inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const
+{
+	return ForEachSource (nodeIndex, inputSlot, processor);
+}
+
+void EvaluationPlan::EnumeratePredecessors (size_t nodeIndex, const std::function<void (size_t)>& processor) const
+{
+	const NodeEntry& nodeEntry = nodes[nodeIndex];
+	for (size_t inputIndex = nodeEntry.firstInput; inputIndex < nodeEntry.firstInput + nodeEntry.inputCount; inputIndex++) {
+		const InputEntry& inputEntry = inputs[inputIndex];
+		for (size_t sourceIndex = inputEntry.firstSource; sourceIndex < inputEntry.firstSource + inputEntry.sourceCount; sourceIndex++) {
+			processor (sources[sourceIndex].nodeIndex);
+		}
+	}
+}
+
+}
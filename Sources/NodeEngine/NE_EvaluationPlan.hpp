@@ -0,0 +1,105 @@
+#ifndef NE_EVALUATIONPLAN_HPP
+#define NE_EVALUATIONPLAN_HPP
+
+#include "NE_NodeEngineTypes.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_Stamp.hpp"
+
+#include <vector>
+#include <functional>
+
+namespace NE
+{
+
+extern const size_t InvalidEvaluationPlanIndex;
+
+class EvaluationPlan
+{
+public:
+	class Graph
+	{
+	public:
+		Graph ();
+		virtual ~Graph ();
+
+		virtual void	EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const = 0;
+	};
+
+	EvaluationPlan ();
+	EvaluationPlan (const Stamp& buildStamp);
+	~EvaluationPlan ();
+
+	bool					IsValid () const;
+	void					Invalidate ();
+	void					Build (const std::vector<NodeConstPtr>& sortedNodes, const Graph& graph);
+	const Stamp&			GetBuildStamp () const;
+
+	size_t					GetNodeCount () const;
+	size_t					GetDepth () const;
+	size_t					GetMemorySize () const;
+	const NodeConstPtr&		GetNode (size_t nodeIndex) const;
+
+	bool					EnumerateConnectedOutputSlots (size_t nodeIndex, const InputSlot* inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const;
+	template <typename Processor>
+	bool					ForEachSource (size_t nodeIndex, const InputSlot* inputSlot, Processor&& processor) const;
+	void					EnumeratePredecessors (size_t nodeIndex, const std::function<void (size_t)>& processor) const;
+
+private:
+	struct NodeEntry
+	{
+		NodeEntry (const NodeConstPtr& node, size_t firstInput);
+
+		NodeConstPtr	node;
+		size_t			firstInput;
+		size_t			inputCount;
+	};
+
+	struct InputEntry
+	{
+		InputEntry (const InputSlot* inputSlot, size_t firstSource);
+
+		const InputSlot*	inputSlot;
+		size_t				firstSource;
+		size_t				sourceCount;
+	};
+
+	struct SourceEntry
+	{
+		SourceEntry (const OutputSlotConstPtr& outputSlot, size_t nodeIndex);
+
+		OutputSlotConstPtr	outputSlot;
+		size_t				nodeIndex;
+	};
+
+	bool						isValid;
+	Stamp						buildStamp;
+	size_t						depth;
+	std::vector<NodeEntry>		nodes;
+	std::vector<InputEntry>		inputs;
+	std::vector<SourceEntry>	sources;
+};
+
+template <typename Processor>
+bool EvaluationPlan::ForEachSource (size_t nodeIndex, const InputSlot* inputSlot, Processor&& processor) const
+{
+	if (!isValid || nodeIndex >= nodes.size ()) {
+		return false;
+	}
+	const NodeEntry& nodeEntry = nodes[nodeIndex];
+	for (size_t inputIndex = nodeEntry.firstInput; inputIndex < nodeEntry.firstInput + nodeEntry.inputCount; inputIndex++) {
+		const InputEntry& inputEntry = inputs[inputIndex];
+		if (inputEntry.inputSlot != inputSlot) {
+			continue;
+		}
+		for (size_t sourceIndex = inputEntry.firstSource; sourceIndex < inputEntry.firstSource + inputEntry.sourceCount; sourceIndex++) {
+			processor (sources[sourceIndex].outputSlot);
+		}
+		return true;
+	}
+	return false;
+}
+
+}
+
+#endif
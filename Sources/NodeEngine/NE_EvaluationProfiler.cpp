@@ -0,0 +1,206 @@
+#include "NE_EvaluationProfiler.hpp"
+#include "NE_StringUtils.hpp"
+#include "NE_Debug.hpp"
+
+#include <sstream>
+#include <iomanip>
+
+namespace NE
+{
+
+static std::string EscapeJsonString (const std::string& str)
+{
+	std::ostringstream result;
+	for (char ch : str) {
+		switch (ch) {
+			case '"':
+				result << "\\\"";
+				break;
+			case '\\':
+				result << "\\\\";
+				break;
+			case '\n':
+				result << "\\n";
+				break;
+			case '\t':
+				result << "\\t";
+				break;
+			default:
+				if ((unsigned char) ch < 0x20) {
+					result << "\\u" << std::hex << std::setw (4) << std::setfill ('0') << (int) ch << std::dec;
+				} else {
+					result << ch;
+				}
+				break;
+		}
+	}
+	return result.str ();
+}
+
+static double ToMicroseconds (const std::chrono::nanoseconds& time)
+{
+	return std::chrono::duration<double, std::micro> (time).count ();
+}
+
+NodeEvaluationProfile::NodeEvaluationProfile () :
+	calculationCount (0),
+	cacheHitCount (0),
+	calculationTime (std::chrono::nanoseconds::zero ()),
+	valueSize (0)
+{
+
+}
+
+NodeEvaluationProfile::~NodeEvaluationProfile ()
+{
+
+}
+
+size_t NodeEvaluationProfile::GetCalculationCount () const
+{
+	return calculationCount;
+}
+
+size_t NodeEvaluationProfile::GetCacheHitCount () const
+{
+	return cacheHitCount;
+}
+
+std::chrono::nanoseconds NodeEvaluationProfile::GetCalculationTime () const
+{
+	return calculationTime;
+}
+
+size_t NodeEvaluationProfile::GetValueSize () const
+{
+	return valueSize;
+}
+
+void NodeEvaluationProfile::AddCalculation (std::chrono::nanoseconds time, size_t newValueSize)
+{
+	calculationCount++;
+	calculationTime += time;
+	valueSize = newValueSize;
+}
+
+void NodeEvaluationProfile::AddCacheHit ()
+{
+	cacheHitCount++;
+}
+
+EvaluationProfiler::EvaluationProfiler () :
+	isEnabled (false),
+	mutex (),
+	originTime (Clock::now ()),
+	nodeProfiles (),
+	events (),
+	threadIndices ()
+{
+
+}
+
+EvaluationProfiler::~EvaluationProfiler ()
+{
+
+}
+
+bool EvaluationProfiler::IsEnabled () const
+{
+	return isEnabled;
+}
+
+void EvaluationProfiler::SetEnabled (bool newIsEnabled)
+{
+	isEnabled = newIsEnabled;
+}
+
+void EvaluationProfiler::Clear ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	originTime = Clock::now ();
+	nodeProfiles.clear ();
+	events.clear ();
+	threadIndices.clear ();
+}
+
+void EvaluationProfiler::RecordCalculation (const NodeId& nodeId, const Clock::time_point& startTime, const Clock::time_point& endTime, size_t valueSize)
+{
+	std::chrono::nanoseconds duration = endTime - startTime;
+	std::lock_guard<std::mutex> lock (mutex);
+	nodeProfiles[nodeId].AddCalculation (duration, valueSize);
+	events.push_back ({ nodeId, GetThreadIndex (std::this_thread::get_id ()), startTime - originTime, duration, valueSize });
+}
+
+void EvaluationProfiler::RecordCacheHit (const NodeId& nodeId)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	nodeProfiles[nodeId].AddCacheHit ();
+}
+
+bool EvaluationProfiler::HasNodeProfile (const NodeId& nodeId) const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return nodeProfiles.find (nodeId) != nodeProfiles.end ();
+}
+
+NodeEvaluationProfile EvaluationProfiler::GetNodeProfile (const NodeId& nodeId) const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	auto found = nodeProfiles.find (nodeId);
+	if (DBGERROR (found == nodeProfiles.end ())) {
+		return NodeEvaluationProfile ();
+	}
+	return found->second;
+}
+
+void EvaluationProfiler::EnumerateNodeProfiles (const std::function<void (const NodeId&, const NodeEvaluationProfile&)>& processor) const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	for (const auto& it : nodeProfiles) {
+		processor (it.first, it.second);
+	}
+}
+
+std::string EvaluationProfiler::ExportChromeTrace () const
+{
+	return ExportChromeTrace ([] (const NodeId& nodeId) {
+		return L"Node " + std::to_wstring (nodeId.GetUniqueId ());
+	});
+}
+
+std::string EvaluationProfiler::ExportChromeTrace (const std::function<std::wstring (const NodeId&)>& getNodeName) const
+{
+	// trace event format with complete events, timestamps are in microseconds
+	std::lock_guard<std::mutex> lock (mutex);
+	std::ostringstream trace;
+	trace << std::fixed << std::setprecision (3);
+	trace << "{\"traceEvents\":[";
+	bool isFirst = true;
+	for (const CalculationEvent& event : events) {
+		if (!isFirst) {
+			trace << ",";
+		}
+		trace << "\n{\"name\":\"" << EscapeJsonString (WStringToString (getNodeName (event.nodeId))) << "\"";
+		trace << ",\"cat\":\"calculation\",\"ph\":\"X\",\"pid\":0";
+		trace << ",\"tid\":" << event.threadIndex;
+		trace << ",\"ts\":" << ToMicroseconds (event.startTime);
+		trace << ",\"dur\":" << ToMicroseconds (event.duration);
+		trace << ",\"args\":{\"nodeId\":" << event.nodeId.GetUniqueId () << ",\"valueSize\":" << event.valueSize << "}}";
+		isFirst = false;
+	}
+	trace << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return trace.str ();
+}
+
+size_t EvaluationProfiler::GetThreadIndex (const std::thread::id& threadId)
+{
+	auto found = threadIndices.find (threadId);
+	if (found != threadIndices.end ()) {
+		return found->second;
+	}
+	size_t threadIndex = threadIndices.size ();
+	threadIndices.insert ({ threadId, threadIndex });
+	return threadIndex;
+}
+
+}
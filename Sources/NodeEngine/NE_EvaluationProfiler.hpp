@@ -0,0 +1,86 @@
+#ifndef NE_EVALUATIONPROFILER_HPP
+#define NE_EVALUATIONPROFILER_HPP
+
+#include "NE_NodeId.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+namespace NE
+{
+
+class NodeEvaluationProfile
+{
+public:
+	NodeEvaluationProfile ();
+	~NodeEvaluationProfile ();
+
+	size_t						GetCalculationCount () const;
+	size_t						GetCacheHitCount () const;
+	std::chrono::nanoseconds	GetCalculationTime () const;
+	size_t						GetValueSize () const;
+
+	void						AddCalculation (std::chrono::nanoseconds time, size_t valueSize);
+	void						AddCacheHit ();
+
+private:
+	size_t						calculationCount;
+	size_t						cacheHitCount;
+	std::chrono::nanoseconds	calculationTime;
+	size_t						valueSize;
+};
+
+class EvaluationProfiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	EvaluationProfiler ();
+	EvaluationProfiler (const EvaluationProfiler& src) = delete;
+	~EvaluationProfiler ();
+
+	EvaluationProfiler&		operator= (const EvaluationProfiler& rhs) = delete;
+
+	bool					IsEnabled () const;
+	void					SetEnabled (bool newIsEnabled);
+	void					Clear ();
+
+	void					RecordCalculation (const NodeId& nodeId, const Clock::time_point& startTime, const Clock::time_point& endTime, size_t valueSize);
+	void					RecordCacheHit (const NodeId& nodeId);
+
+	bool					HasNodeProfile (const NodeId& nodeId) const;
+	NodeEvaluationProfile	GetNodeProfile (const NodeId& nodeId) const;
+	void					EnumerateNodeProfiles (const std::function<void (const NodeId&, const NodeEvaluationProfile&)>& processor) const;
+
+	std::string				ExportChromeTrace () const;
+	std::string				ExportChromeTrace (const std::function<std::wstring (const NodeId&)>& getNodeName) const;
+
+private:
+	struct CalculationEvent
+	{
+		NodeId						nodeId;
+		size_t						threadIndex;
+		std::chrono::nanoseconds	startTime;
+		std::chrono::nanoseconds	duration;
+		size_t						valueSize;
+	};
+
+	size_t												GetThreadIndex (const std::thread::id& threadId);
+
+	std::atomic<bool>									isEnabled;
+	mutable std::mutex									mutex;
+	Clock::time_point									originTime;
+	std::unordered_map<NodeId, NodeEvaluationProfile>	nodeProfiles;
+	std::vector<CalculationEvent>						events;
+	std::unordered_map<std::thread::id, size_t>			threadIndices;
+};
+
+}
+
+#endif
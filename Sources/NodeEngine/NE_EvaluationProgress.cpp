@@ -0,0 +1,55 @@
+#include "NE_EvaluationProgress.hpp"
+
+namespace NE
+{
+
+EvaluationProgress::EvaluationProgress () :
+	evaluatedNodeCount (0),
+	nodeCount (0),
+	calculatedNodes ()
+{
+
+}
+
+EvaluationProgress::EvaluationProgress (size_t evaluatedNodeCount, size_t nodeCount) :
+	evaluatedNodeCount (evaluatedNodeCount),
+	nodeCount (nodeCount),
+	calculatedNodes ()
+{
+
+}
+
+EvaluationProgress::EvaluationProgress (size_t evaluatedNodeCount, size_t nodeCount, const std::vector<NodeId>& calculatedNodes) :
+	evaluatedNodeCount (evaluatedNodeCount),
+	nodeCount (nodeCount),
+	calculatedNodes (calculatedNodes)
+{
+
+}
+
+EvaluationProgress::~EvaluationProgress ()
+{
+
+}
+
+size_t EvaluationProgress::GetEvaluatedNodeCount () const
+{
+	return evaluatedNodeCount;
+}
+
+size_t EvaluationProgress::GetNodeCount () const
+{
+	return nodeCount;
+}
+
+bool EvaluationProgress::IsFinished () const
+{
+	return evaluatedNodeCount >= nodeCount;
+}
+
+const std::vector<NodeId>& EvaluationProgress::GetCalculatedNodes () const
+{
+	return calculatedNodes;
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef NE_EVALUATIONPROGRESS_HPP
+#define NE_EVALUATIONPROGRESS_HPP
+
+#include "NE_NodeId.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace NE
+{
+
+class EvaluationProgress
+{
+public:
+	EvaluationProgress ();
+	EvaluationProgress (size_t evaluatedNodeCount, size_t nodeCount);
+	EvaluationProgress (size_t evaluatedNodeCount, size_t nodeCount, const std::vector<NodeId>& calculatedNodes);
+	~EvaluationProgress ();
+
+	size_t						GetEvaluatedNodeCount () const;
+	size_t						GetNodeCount () const;
+	bool						IsFinished () const;
+
+	// the nodes calculated by the call that returned the progress
+	const std::vector<NodeId>&	GetCalculatedNodes () const;
+
+private:
+	size_t					evaluatedNodeCount;
+	size_t					nodeCount;
+	std::vector<NodeId>		calculatedNodes;
+};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "NE_EvaluationSnapshot.hpp"
+#include "NE_Node.hpp"
+#include "NE_Debug.hpp"
+
+namespace NE
+{
+
+class EvaluationSnapshotNodeEvaluator : public NodeEvaluator
+{
+public:
+	EvaluationSnapshotNodeEvaluator (EvaluationSnapshot& snapshot) :
+		snapshot (snapshot)
+	{
+
+	}
+
+	virtual void InvalidateNodeValue (const NodeId&) const override
+	{
+		DBGBREAK ();
+	}
+
+	virtual bool HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const override
+	{
+		bool hasConnectedOutputSlots = false;
+		EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr&) {
+			hasConnectedOutputSlots = true;
+		});
+		return hasConnectedOutputSlots;
+	}
+
+	virtual void EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const override
+	{
+		size_t planIndex = snapshot.GetPlanIndex (inputSlot->GetOwnerNodeId ());
+		if (DBGERROR (planIndex == InvalidEvaluationPlanIndex)) {
+			return;
+		}
+		DBGVERIFY (snapshot.plan->EnumerateConnectedOutputSlots (planIndex, inputSlot.get (), processor));
+	}
+
+	virtual const EvaluationPlan* GetEvaluationPlan (const Node& node, size_t& planIndex) const override
+	{
+		planIndex = snapshot.GetPlanIndex (node.GetId ());
+		if (DBGERROR (planIndex == InvalidEvaluationPlanIndex)) {
+			return nullptr;
+		}
+		return snapshot.plan.get ();
+	}
+
+	virtual bool IsCalculationEnabled () const override
+	{
+		return snapshot.isCalculationEnabled;
+	}
+
+	virtual bool HasCalculatedNodeValue (const NodeId& nodeId) const override
+	{
+		return snapshot.values.find (nodeId) != snapshot.values.end ();
+	}
+
+	virtual ValueHandle GetCalculatedNodeValue (const NodeId& nodeId) const override
+	{
+		auto found = snapshot.values.find (nodeId);
+		if (found == snapshot.values.end ()) {
+			return nullptr;
+		}
+		return found->second;
+	}
+
+	virtual bool GetPassNodeValue (const Node&, ValueHandle&) const override
+	{
+		return false;
+	}
+
+	virtual bool IsCalculatedNodeValueEvicted (const NodeId&) const override
+	{
+		return false;
+	}
+
+	virtual void SetCalculatedNodeValue (const Node& node, const ValueHandle& value) const override
+	{
+		snapshot.values[node.GetId ()] = value;
+	}
+
+	virtual bool IsValueProcessingDeferred () const override
+	{
+		return true;
+	}
+
+	virtual NodeValueMemo* GetNodeValueMemo () const override
+	{
+		return snapshot.nodeValueMemo.get ();
+	}
+
+	virtual EvaluationProfiler* GetEvaluationProfiler () const override
+	{
+		return snapshot.evaluationProfiler.get ();
+	}
+
+private:
+	EvaluationSnapshot& snapshot;
+};
+
+EvaluationSnapshot::EvaluationSnapshot () :
+	sourceNodeManager (nullptr),
+	plan (nullptr),
+	planIndices (),
+	valueStamps (),
+	values (),
+	nodePlanIndices (),
+	isCalculationEnabled (false),
+	nodeValueMemo (nullptr),
+	evaluationProfiler (nullptr),
+	nodeEvaluator (new EvaluationSnapshotNodeEvaluator (*this)),
+	position (0)
+{
+
+}
+
+EvaluationSnapshot::~EvaluationSnapshot ()
+{
+
+}
+
+size_t EvaluationSnapshot::GetNodeCount () const
+{
+	return planIndices.size ();
+}
+
+EvaluationProgress EvaluationSnapshot::Evaluate (EvaluationEnv& env, std::chrono::microseconds timeBudget)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now ();
+	EvaluationEnv snapshotEnv (env);
+	snapshotEnv.SetNodeEvaluator (nodeEvaluator.get ());
+
+	std::vector<NodeId> calculatedNodes;
+	while (position < planIndices.size ()) {
+		const NodeConstPtr& node = plan->GetNode (planIndices[position]);
+		node->Evaluate (snapshotEnv);
+		calculatedNodes.push_back (node->GetId ());
+		position++;
+		if (std::chrono::steady_clock::now () - startTime >= timeBudget) {
+			break;
+		}
+	}
+	return EvaluationProgress (position, planIndices.size (), calculatedNodes);
+}
+
+size_t EvaluationSnapshot::GetPlanIndex (const NodeId& nodeId)
+{
+	// the index stored in the node belongs to the live plan, so the snapshot
+	// builds its own lookup from the shared plan when it is first needed
+	if (nodePlanIndices.empty ()) {
+		nodePlanIndices.reserve (plan->GetNodeCount ());
+		for (size_t planIndex = 0; planIndex < plan->GetNodeCount (); planIndex++) {
+			nodePlanIndices.insert ({ plan->GetNode (planIndex)->GetId (), planIndex });
+		}
+	}
+	auto found = nodePlanIndices.find (nodeId);
+	if (found == nodePlanIndices.end ()) {
+		return InvalidEvaluationPlanIndex;
+	}
+	return found->second;
+}
+
+}
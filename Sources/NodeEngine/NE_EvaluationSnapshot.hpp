@@ -0,0 +1,61 @@
+#ifndef NE_EVALUATIONSNAPSHOT_HPP
+#define NE_EVALUATIONSNAPSHOT_HPP
+
+#include "NE_NodeId.hpp"
+#include "NE_Stamp.hpp"
+#include "NE_ValueHandle.hpp"
+#include "NE_EvaluationEnv.hpp"
+#include "NE_EvaluationPlan.hpp"
+#include "NE_EvaluationProgress.hpp"
+#include "NE_NodeValueMemo.hpp"
+#include "NE_EvaluationProfiler.hpp"
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+
+namespace NE
+{
+
+class NodeManager;
+class NodeEvaluator;
+
+// the snapshot shares the nodes and the evaluation plan with its node manager, and holds
+// the values the calculated nodes depend on, so connections, values and new nodes can be
+// changed in the live graph while the snapshot is evaluated, but the shared nodes must not
+// be deleted or modified until the evaluation is finished or cancelled
+class EvaluationSnapshot
+{
+	friend class NodeManager;
+	friend class EvaluationSnapshotNodeEvaluator;
+
+public:
+	EvaluationSnapshot ();
+	EvaluationSnapshot (const EvaluationSnapshot& src) = delete;
+	~EvaluationSnapshot ();
+
+	EvaluationSnapshot&		operator= (const EvaluationSnapshot& rhs) = delete;
+
+	size_t					GetNodeCount () const;
+	EvaluationProgress		Evaluate (EvaluationEnv& env, std::chrono::microseconds timeBudget);
+
+private:
+	size_t					GetPlanIndex (const NodeId& nodeId);
+
+	const NodeManager*							sourceNodeManager;
+	std::shared_ptr<const EvaluationPlan>		plan;
+	std::vector<size_t>							planIndices;
+	std::vector<Stamp>							valueStamps;
+	std::unordered_map<NodeId, ValueHandle>		values;
+	std::unordered_map<NodeId, size_t>			nodePlanIndices;
+	bool										isCalculationEnabled;
+	std::shared_ptr<NodeValueMemo>				nodeValueMemo;
+	std::shared_ptr<EvaluationProfiler>			evaluationProfiler;
+	std::unique_ptr<NodeEvaluator>				nodeEvaluator;
+	size_t										position;
+};
+
+}
+
+#endif
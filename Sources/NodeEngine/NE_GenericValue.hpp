@@ -21,6 +21,8 @@ public:
 	void					SetValue (const Type& newVal);
 	const Type&				GetValue () const;
 
+	virtual size_t			GetMemorySize () const override;
+
 	static const Type&		Get (const ValueConstPtr& val);
 	static const Type&		Get (const ValuePtr& val);
 	static const Type&		Get (Value* val);
@@ -54,6 +56,12 @@ const Type& GenericValue<Type>::GetValue () const
 	return val;
 }
 
+template <class Type>
+size_t GenericValue<Type>::GetMemorySize () const
+{
+	return sizeof (GenericValue<Type>);
+}
+
 template <class Type>
 const Type& GenericValue<Type>::Get (const ValueConstPtr& val)
 {
@@ -0,0 +1,115 @@
+#include "NE_GraphStatistics.hpp"
+
+namespace NE
+{
+
+GraphMemoryStatistics::GraphMemoryStatistics () :
+	GraphMemoryStatistics (0, 0, 0, 0)
+{
+
+}
+
+GraphMemoryStatistics::GraphMemoryStatistics (size_t connectionMemorySize, size_t evaluationPlanMemorySize, size_t valueCacheMemorySize, size_t valueMemoMemorySize) :
+	connectionMemorySize (connectionMemorySize),
+	evaluationPlanMemorySize (evaluationPlanMemorySize),
+	valueCacheMemorySize (valueCacheMemorySize),
+	valueMemoMemorySize (valueMemoMemorySize)
+{
+
+}
+
+GraphMemoryStatistics::~GraphMemoryStatistics ()
+{
+
+}
+
+size_t GraphMemoryStatistics::GetConnectionMemorySize () const
+{
+	return connectionMemorySize;
+}
+
+size_t GraphMemoryStatistics::GetEvaluationPlanMemorySize () const
+{
+	return evaluationPlanMemorySize;
+}
+
+size_t GraphMemoryStatistics::GetValueCacheMemorySize () const
+{
+	return valueCacheMemorySize;
+}
+
+size_t GraphMemoryStatistics::GetValueMemoMemorySize () const
+{
+	return valueMemoMemorySize;
+}
+
+size_t GraphMemoryStatistics::GetTotalMemorySize () const
+{
+	return connectionMemorySize + evaluationPlanMemorySize + valueCacheMemorySize + valueMemoMemorySize;
+}
+
+GraphStatistics::GraphStatistics () :
+	GraphStatistics (0, 0, 0, 0, 0, true, 0, GraphMemoryStatistics ())
+{
+
+}
+
+GraphStatistics::GraphStatistics (size_t nodeCount, size_t connectionCount, size_t nodeGroupCount, size_t maxFanIn, size_t maxFanOut, bool isDepthKnown, size_t depth, const GraphMemoryStatistics& memoryStatistics) :
+	nodeCount (nodeCount),
+	connectionCount (connectionCount),
+	nodeGroupCount (nodeGroupCount),
+	maxFanIn (maxFanIn),
+	maxFanOut (maxFanOut),
+	isDepthKnown (isDepthKnown),
+	depth (depth),
+	memoryStatistics (memoryStatistics)
+{
+
+}
+
+GraphStatistics::~GraphStatistics ()
+{
+
+}
+
+size_t GraphStatistics::GetNodeCount () const
+{
+	return nodeCount;
+}
+
+size_t GraphStatistics::GetConnectionCount () const
+{
+	return connectionCount;
+}
+
+size_t GraphStatistics::GetNodeGroupCount () const
+{
+	return nodeGroupCount;
+}
+
+size_t GraphStatistics::GetMaxFanIn () const
+{
+	return maxFanIn;
+}
+
+size_t GraphStatistics::GetMaxFanOut () const
+{
+	return maxFanOut;
+}
+
+bool GraphStatistics::IsDepthKnown () const
+{
+	return isDepthKnown;
+}
+
+size_t GraphStatistics::GetDepth () const
+{
+	return depth;
+}
+
+const GraphMemoryStatistics& GraphStatistics::GetMemoryStatistics () const
+{
+	return memoryStatistics;
+}
+
+}
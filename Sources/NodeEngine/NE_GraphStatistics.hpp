@@ -0,0 +1,64 @@
+#ifndef NE_GRAPHSTATISTICS_HPP
+#define NE_GRAPHSTATISTICS_HPP
+
+#include <cstddef>
+
+namespace NE
+{
+
+// approximate memory usage of the node manager subsystems in bytes
+class GraphMemoryStatistics
+{
+public:
+	GraphMemoryStatistics ();
+	GraphMemoryStatistics (size_t connectionMemorySize, size_t evaluationPlanMemorySize, size_t valueCacheMemorySize, size_t valueMemoMemorySize);
+	~GraphMemoryStatistics ();
+
+	size_t	GetConnectionMemorySize () const;
+	size_t	GetEvaluationPlanMemorySize () const;
+	size_t	GetValueCacheMemorySize () const;
+	size_t	GetValueMemoMemorySize () const;
+	size_t	GetTotalMemorySize () const;
+
+private:
+	size_t	connectionMemorySize;
+	size_t	evaluationPlanMemorySize;
+	size_t	valueCacheMemorySize;
+	size_t	valueMemoMemorySize;
+};
+
+// fan-in is the maximum number of output slots connected to one input slot,
+// fan-out is the maximum number of input slots connected to one output slot,
+// depth is the number of nodes on the longest path of the graph, it comes
+// from the evaluation plan, so it is unknown after an edit until the next
+// evaluation builds the plan again, the other values are always up to date
+class GraphStatistics
+{
+public:
+	GraphStatistics ();
+	GraphStatistics (size_t nodeCount, size_t connectionCount, size_t nodeGroupCount, size_t maxFanIn, size_t maxFanOut, bool isDepthKnown, size_t depth, const GraphMemoryStatistics& memoryStatistics);
+	~GraphStatistics ();
+
+	size_t							GetNodeCount () const;
+	size_t							GetConnectionCount () const;
+	size_t							GetNodeGroupCount () const;
+	size_t							GetMaxFanIn () const;
+	size_t							GetMaxFanOut () const;
+	bool							IsDepthKnown () const;
+	size_t							GetDepth () const;
+	const GraphMemoryStatistics&	GetMemoryStatistics () const;
+
+private:
+	size_t					nodeCount;
+	size_t					connectionCount;
+	size_t					nodeGroupCount;
+	size_t					maxFanIn;
+	size_t					maxFanOut;
+	bool					isDepthKnown;
+	size_t					depth;
+	GraphMemoryStatistics	memoryStatistics;
+};
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "NE_InternedString.hpp"
+
+#include <unordered_set>
+#include <mutex>
+
+namespace NE
+{
+
+class InternedStringTable
+{
+public:
+	InternedStringTable () :
+		mutex (),
+		strings (),
+		emptyString (Intern (std::string ()))
+	{
+
+	}
+
+	const std::string* Intern (const std::string& str)
+	{
+		// the set never rehashes its nodes, so the address of a stored string is stable
+		std::lock_guard<std::mutex> lock (mutex);
+		return &*strings.insert (str).first;
+	}
+
+	const std::string* GetEmptyString () const
+	{
+		return emptyString;
+	}
+
+	size_t GetCount () const
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		return strings.size ();
+	}
+
+private:
+	mutable std::mutex				mutex;
+	std::unordered_set<std::string>	strings;
+	const std::string*				emptyString;
+};
+
+static InternedStringTable& GetInternedStringTable ()
+{
+	// the table is never destroyed, so interned strings stay valid during static destruction
+	static InternedStringTable* internedStringTable = new InternedStringTable ();
+	return *internedStringTable;
+}
+
+InternedString::InternedString () :
+	str (GetInternedStringTable ().GetEmptyString ())
+{
+
+}
+
+InternedString::InternedString (const std::string& str) :
+	str (GetInternedStringTable ().Intern (str))
+{
+
+}
+
+InternedString::~InternedString ()
+{
+
+}
+
+const std::string& InternedString::Get () const
+{
+	return *str;
+}
+
+size_t InternedString::GenerateHashValue () const
+{
+	return std::hash<const std::string*> {} (str);
+}
+
+bool InternedString::operator< (const InternedString& rhs) const
+{
+	return str != rhs.str && *str < *rhs.str;
+}
+
+bool InternedString::operator> (const InternedString& rhs) const
+{
+	return str != rhs.str && *str > *rhs.str;
+}
+
+bool InternedString::operator== (const InternedString& rhs) const
+{
+	return str == rhs.str;
+}
+
+bool InternedString::operator!= (const InternedString& rhs) const
+{
+	return !operator== (rhs);
+}
+
+size_t InternedString::GetInternedStringCount ()
+{
+	return GetInternedStringTable ().GetCount ();
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef NE_INTERNEDSTRING_HPP
+#define NE_INTERNEDSTRING_HPP
+
+#include <string>
+#include <functional>
+
+namespace NE
+{
+
+// every distinct string is stored only once in a global table, so interned strings
+// can be hashed and compared by address, the stored strings are never released
+class InternedString
+{
+public:
+	InternedString ();
+	explicit InternedString (const std::string& str);
+	~InternedString ();
+
+	const std::string&	Get () const;
+	size_t				GenerateHashValue () const;
+
+	bool				operator< (const InternedString& rhs) const;
+	bool				operator> (const InternedString& rhs) const;
+	bool				operator== (const InternedString& rhs) const;
+	bool				operator!= (const InternedString& rhs) const;
+
+	static size_t		GetInternedStringCount ();
+
+private:
+	const std::string*	str;
+};
+
+}
+
+namespace std
+{
+	template <>
+	struct hash<NE::InternedString>
+	{
+		size_t operator() (const NE::InternedString& str) const noexcept
+		{
+			return str.GenerateHashValue ();
+		}
+	};
+}
+
+#endif
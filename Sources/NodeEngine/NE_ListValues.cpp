@@ -0,0 +1,434 @@
+#include "NE_ListValues.hpp"
+#include "NE_Debug.hpp"
+
+#include <algorithm>
+
+namespace NE
+{
+
+DYNAMIC_SERIALIZATION_INFO (IntListValue, 1, "{8FC1855F-D667-46B7-A186-88D03C765FD0}");
+DYNAMIC_SERIALIZATION_INFO (DoubleListValue, 1, "{99DC48D5-28C2-4016-BDE5-A074AD30ABBA}");
+DYNAMIC_SERIALIZATION_INFO (IntSequenceValue, 1, "{5B0E7C3A-91D4-4F6E-8A27-C3D6B1E04F92}");
+DYNAMIC_SERIALIZATION_INFO (DoubleSequenceValue, 1, "{E2A4F917-6C38-4B5D-9E01-7D8C2B35A6F4}");
+DYNAMIC_SERIALIZATION_INFO (FlattenedListValue, 1, "{ED070CDB-F3C4-4965-B391-C3D09151B792}");
+
+NumberListValue::NumberListValue ()
+{
+
+}
+
+NumberListValue::~NumberListValue ()
+{
+
+}
+
+NumberSequenceValue::NumberSequenceValue ()
+{
+
+}
+
+NumberSequenceValue::~NumberSequenceValue ()
+{
+
+}
+
+IntListValue::IntListValue () :
+	GenericListValue<int, IntValue> ()
+{
+
+}
+
+IntListValue::IntListValue (const std::vector<int>& values) :
+	GenericListValue<int, IntValue> (values)
+{
+
+}
+
+IntListValue::IntListValue (std::vector<int>&& values) :
+	GenericListValue<int, IntValue> (std::move (values))
+{
+
+}
+
+IntListValue::~IntListValue ()
+{
+
+}
+
+ValuePtr IntListValue::Clone () const
+{
+	return std::make_shared<IntListValue> (values);
+}
+
+Stream::Status IntListValue::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Value::Read (inputStream);
+	ReadValues (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status IntListValue::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Value::Write (outputStream);
+	WriteValues (outputStream);
+	return outputStream.GetStatus ();
+}
+
+DoubleListValue::DoubleListValue () :
+	GenericListValue<double, DoubleValue> ()
+{
+
+}
+
+DoubleListValue::DoubleListValue (const std::vector<double>& values) :
+	GenericListValue<double, DoubleValue> (values)
+{
+
+}
+
+DoubleListValue::DoubleListValue (std::vector<double>&& values) :
+	GenericListValue<double, DoubleValue> (std::move (values))
+{
+
+}
+
+DoubleListValue::~DoubleListValue ()
+{
+
+}
+
+ValuePtr DoubleListValue::Clone () const
+{
+	return std::make_shared<DoubleListValue> (values);
+}
+
+Stream::Status DoubleListValue::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Value::Read (inputStream);
+	ReadValues (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status DoubleListValue::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Value::Write (outputStream);
+	WriteValues (outputStream);
+	return outputStream.GetStatus ();
+}
+
+IntSequenceValue::IntSequenceValue () :
+	GenericSequenceValue<int, IntValue> ()
+{
+
+}
+
+IntSequenceValue::IntSequenceValue (int start, int step, size_t count) :
+	GenericSequenceValue<int, IntValue> (start, step, count)
+{
+
+}
+
+IntSequenceValue::~IntSequenceValue ()
+{
+
+}
+
+ValuePtr IntSequenceValue::Clone () const
+{
+	return std::make_shared<IntSequenceValue> (start, step, count);
+}
+
+Stream::Status IntSequenceValue::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Value::Read (inputStream);
+	ReadSequence (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status IntSequenceValue::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Value::Write (outputStream);
+	WriteSequence (outputStream);
+	return outputStream.GetStatus ();
+}
+
+DoubleSequenceValue::DoubleSequenceValue () :
+	GenericSequenceValue<double, DoubleValue> ()
+{
+
+}
+
+DoubleSequenceValue::DoubleSequenceValue (double start, double step, size_t count) :
+	GenericSequenceValue<double, DoubleValue> (start, step, count)
+{
+
+}
+
+DoubleSequenceValue::~DoubleSequenceValue ()
+{
+
+}
+
+ValuePtr DoubleSequenceValue::Clone () const
+{
+	return std::make_shared<DoubleSequenceValue> (start, step, count);
+}
+
+Stream::Status DoubleSequenceValue::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Value::Read (inputStream);
+	ReadSequence (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status DoubleSequenceValue::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Value::Write (outputStream);
+	WriteSequence (outputStream);
+	return outputStream.GetStatus ();
+}
+
+FlattenedListValue::Segment::Segment (const ValueConstPtr& owner, size_t firstIndex, size_t count, size_t offset) :
+	owner (owner),
+	list (Value::Cast<IListValue> (owner.get ())),
+	firstIndex (firstIndex),
+	count (count),
+	offset (offset)
+{
+
+}
+
+FlattenedListValue::FlattenedListValue () :
+	FlattenedListValue (ValueConstPtr (new ListValue ()))
+{
+
+}
+
+FlattenedListValue::FlattenedListValue (const ValueConstPtr& source) :
+	source (source),
+	segments (),
+	elementPrototype (nullptr),
+	size (0)
+{
+	BuildSegments ();
+}
+
+FlattenedListValue::~FlattenedListValue ()
+{
+
+}
+
+ValuePtr FlattenedListValue::Clone () const
+{
+	return std::make_shared<FlattenedListValue> (source->Clone ());
+}
+
+std::wstring FlattenedListValue::ToString (const StringConverter& stringConverter) const
+{
+	class ListEnumerator : public StringConverter::ListEnumerator
+	{
+	public:
+		ListEnumerator (const FlattenedListValue* val, const StringConverter& converter) :
+			val (val),
+			converter (converter)
+		{
+		}
+
+		virtual size_t GetSize () const override
+		{
+			return val->GetSize ();
+		}
+
+		virtual std::wstring GetItem (size_t index) const override
+		{
+			return val->GetElement (index)->ToString (converter);
+		}
+
+	private:
+		const FlattenedListValue*	val;
+		const StringConverter&		converter;
+	};
+
+	ListEnumerator enumerator (this, stringConverter);
+	return stringConverter.ListToString (enumerator);
+}
+
+size_t FlattenedListValue::GetMemorySize () const
+{
+	// the leaves belong to the source, only the view itself is counted
+	return sizeof (FlattenedListValue) + segments.capacity () * sizeof (Segment);
+}
+
+Stream::Status FlattenedListValue::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Value::Read (inputStream);
+	ListValuePtr list (new ListValue ());
+	size_t valueCount = 0;
+	inputStream.Read (valueCount);
+	for (size_t i = 0; i < valueCount; i++) {
+		ValuePtr value (ReadDynamicObject<Value> (inputStream));
+		if (DBGVERIFY (value != nullptr)) {
+			list->Push (value);
+		}
+	}
+	source = list;
+	BuildSegments ();
+	return inputStream.GetStatus ();
+}
+
+Stream::Status FlattenedListValue::Write (OutputStream& outputStream) const
+{
+	// the flattened leaves are written, the source structure is not kept
+	ObjectHeader header (outputStream, serializationInfo);
+	Value::Write (outputStream);
+	outputStream.Write (size);
+	Enumerate ([&] (const ValueConstPtr& value) {
+		WriteDynamicObject (outputStream, value.get ());
+		return true;
+	});
+	return outputStream.GetStatus ();
+}
+
+size_t FlattenedListValue::GetSize () const
+{
+	return size;
+}
+
+ValueConstPtr FlattenedListValue::GetElement (size_t index) const
+{
+	const Segment& segment = FindSegment (index);
+	return segment.list->GetElement (segment.firstIndex + index - segment.offset);
+}
+
+bool FlattenedListValue::Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const
+{
+	for (const Segment& segment : segments) {
+		size_t endIndex = segment.firstIndex + segment.count;
+		for (size_t i = segment.firstIndex; i < endIndex; i++) {
+			if (!processor (segment.list->GetElement (i))) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+const Value* FlattenedListValue::GetElementPrototype () const
+{
+	return elementPrototype;
+}
+
+ListValueSummary FlattenedListValue::GetSummary () const
+{
+	if (size == 0) {
+		return ListValueSummary (nullptr, 1, 0);
+	}
+	if (elementPrototype != nullptr) {
+		return ListValueSummary (elementPrototype, 1, size);
+	}
+	// the source keeps the leaves alive, so its leaf prototype is valid here too
+	ListValueSummary sourceSummary = Value::Cast<IListValue> (source.get ())->GetSummary ();
+	return ListValueSummary (sourceSummary.GetLeafPrototype (), 1, size);
+}
+
+const ValueConstPtr& FlattenedListValue::GetSource () const
+{
+	return source;
+}
+
+size_t FlattenedListValue::GetSegmentCount () const
+{
+	return segments.size ();
+}
+
+void FlattenedListValue::BuildSegments ()
+{
+	class ListFrame
+	{
+	public:
+		ListFrame (const ValueConstPtr& owner) :
+			owner (owner),
+			list (Value::Cast<IListValue> (owner.get ())),
+			index (0),
+			runStart (0)
+		{
+		}
+
+		ValueConstPtr		owner;
+		const IListValue*	list;
+		size_t				index;
+		size_t				runStart;
+	};
+
+	if (!Value::IsType<IListValue> (source)) {
+		// a single value is the only leaf of itself
+		source = ValueConstPtr (new ListValue ({ source }));
+	}
+
+	segments.clear ();
+	size = 0;
+	std::vector<ListFrame> frames;
+	frames.push_back (ListFrame (source));
+	while (!frames.empty ()) {
+		ListFrame& frame = frames.back ();
+		size_t listSize = frame.list->GetSize ();
+		if (frame.list->GetElementPrototype () != nullptr) {
+			if (listSize > 0) {
+				segments.push_back (Segment (frame.owner, 0, listSize, size));
+				size += listSize;
+			}
+			frames.pop_back ();
+			continue;
+		}
+		ValueConstPtr innerValue = nullptr;
+		while (frame.index < listSize) {
+			innerValue = frame.list->GetElement (frame.index);
+			if (Value::IsType<IListValue> (innerValue)) {
+				break;
+			}
+			frame.index++;
+		}
+		if (frame.index > frame.runStart) {
+			size_t runCount = frame.index - frame.runStart;
+			segments.push_back (Segment (frame.owner, frame.runStart, runCount, size));
+			size += runCount;
+		}
+		if (frame.index >= listSize) {
+			frames.pop_back ();
+			continue;
+		}
+		frame.index++;
+		frame.runStart = frame.index;
+		frames.push_back (ListFrame (innerValue));
+	}
+
+	elementPrototype = nullptr;
+	for (const Segment& segment : segments) {
+		const Value* segmentPrototype = segment.list->GetElementPrototype ();
+		if (segmentPrototype == nullptr || (elementPrototype != nullptr && typeid (*elementPrototype) != typeid (*segmentPrototype))) {
+			elementPrototype = nullptr;
+			break;
+		}
+		elementPrototype = segmentPrototype;
+	}
+}
+
+const FlattenedListValue::Segment& FlattenedListValue::FindSegment (size_t index) const
+{
+	DBGASSERT (index < size);
+	std::vector<Segment>::const_iterator found = std::upper_bound (segments.begin (), segments.end (), index, [] (size_t value, const Segment& segment) {
+		return value < segment.offset;
+	});
+	return *(found - 1);
+}
+
+}
@@ -0,0 +1,555 @@
+#ifndef NE_LISTVALUES_HPP
+#define NE_LISTVALUES_HPP
+
+#include "NE_Value.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_Serializable.hpp"
+
+#include <vector>
+
+namespace NE
+{
+
+class NumberListValue
+{
+public:
+	NumberListValue ();
+	virtual ~NumberListValue ();
+
+	virtual int		ToInteger (size_t index) const = 0;
+	virtual double	ToDouble (size_t index) const = 0;
+};
+
+class NumberSequenceValue
+{
+public:
+	NumberSequenceValue ();
+	virtual ~NumberSequenceValue ();
+
+	virtual double	GetStartAsDouble () const = 0;
+	virtual double	GetStepAsDouble () const = 0;
+};
+
+template <class Type, class ElementValueType>
+class GenericListValue :	public Value,
+							public IListValue,
+							public NumberListValue
+{
+public:
+	GenericListValue ();
+	GenericListValue (const std::vector<Type>& values);
+	GenericListValue (std::vector<Type>&& values);
+	GenericListValue (const GenericListValue&) = delete;
+	virtual ~GenericListValue ();
+
+	GenericListValue&			operator= (const GenericListValue&) = delete;
+
+	virtual std::wstring		ToString (const StringConverter& stringConverter) const override;
+	virtual size_t				GetMemorySize () const override;
+
+	virtual size_t				GetSize () const override;
+	virtual ValueConstPtr		GetElement (size_t index) const override;
+	virtual bool				Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const override;
+	virtual const Value*		GetElementPrototype () const override;
+
+	virtual int					ToInteger (size_t index) const override;
+	virtual double				ToDouble (size_t index) const override;
+
+	const Type&					Get (size_t index) const;
+	const std::vector<Type>&	GetValues () const;
+	void						Push (const Type& value);
+	void						Reserve (size_t count);
+
+protected:
+	Stream::Status				ReadValues (InputStream& inputStream);
+	Stream::Status				WriteValues (OutputStream& outputStream) const;
+
+	std::vector<Type>			values;
+};
+
+template <class Type, class ElementValueType>
+GenericListValue<Type, ElementValueType>::GenericListValue () :
+	values ()
+{
+
+}
+
+template <class Type, class ElementValueType>
+GenericListValue<Type, ElementValueType>::GenericListValue (const std::vector<Type>& values) :
+	values (values)
+{
+
+}
+
+template <class Type, class ElementValueType>
+GenericListValue<Type, ElementValueType>::GenericListValue (std::vector<Type>&& values) :
+	values (std::move (values))
+{
+
+}
+
+template <class Type, class ElementValueType>
+GenericListValue<Type, ElementValueType>::~GenericListValue ()
+{
+
+}
+
+template <class Type, class ElementValueType>
+std::wstring GenericListValue<Type, ElementValueType>::ToString (const StringConverter& stringConverter) const
+{
+	class ListEnumerator : public StringConverter::ListEnumerator
+	{
+	public:
+		ListEnumerator (const std::vector<Type>& values, const StringConverter& converter) :
+			values (values),
+			converter (converter)
+		{
+		}
+
+		virtual size_t GetSize () const override
+		{
+			return values.size ();
+		}
+
+		virtual std::wstring GetItem (size_t index) const override
+		{
+			ElementValueType element (values[index]);
+			return element.ToString (converter);
+		}
+
+	private:
+		const std::vector<Type>&	values;
+		const StringConverter&		converter;
+	};
+
+	ListEnumerator enumerator (values, stringConverter);
+	return stringConverter.ListToString (enumerator);
+}
+
+template <class Type, class ElementValueType>
+size_t GenericListValue<Type, ElementValueType>::GetMemorySize () const
+{
+	return sizeof (GenericListValue<Type, ElementValueType>) + values.capacity () * sizeof (Type);
+}
+
+template <class Type, class ElementValueType>
+size_t GenericListValue<Type, ElementValueType>::GetSize () const
+{
+	return values.size ();
+}
+
+template <class Type, class ElementValueType>
+ValueConstPtr GenericListValue<Type, ElementValueType>::GetElement (size_t index) const
+{
+	return ValueConstPtr (new ElementValueType (values[index]));
+}
+
+template <class Type, class ElementValueType>
+bool GenericListValue<Type, ElementValueType>::Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const
+{
+	for (const Type& value : values) {
+		if (!processor (ValueConstPtr (new ElementValueType (value)))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class Type, class ElementValueType>
+const Value* GenericListValue<Type, ElementValueType>::GetElementPrototype () const
+{
+	static const ElementValueType elementPrototype;
+	return &elementPrototype;
+}
+
+template <class Type, class ElementValueType>
+int GenericListValue<Type, ElementValueType>::ToInteger (size_t index) const
+{
+	return (int) values[index];
+}
+
+template <class Type, class ElementValueType>
+double GenericListValue<Type, ElementValueType>::ToDouble (size_t index) const
+{
+	return (double) values[index];
+}
+
+template <class Type, class ElementValueType>
+const Type& GenericListValue<Type, ElementValueType>::Get (size_t index) const
+{
+	return values[index];
+}
+
+template <class Type, class ElementValueType>
+const std::vector<Type>& GenericListValue<Type, ElementValueType>::GetValues () const
+{
+	return values;
+}
+
+template <class Type, class ElementValueType>
+void GenericListValue<Type, ElementValueType>::Push (const Type& value)
+{
+	values.push_back (value);
+}
+
+template <class Type, class ElementValueType>
+void GenericListValue<Type, ElementValueType>::Reserve (size_t count)
+{
+	values.reserve (count);
+}
+
+template <class Type, class ElementValueType>
+Stream::Status GenericListValue<Type, ElementValueType>::ReadValues (InputStream& inputStream)
+{
+	size_t valueCount = 0;
+	inputStream.Read (valueCount);
+	if (inputStream.GetStatus () != Stream::Status::NoError) {
+		return inputStream.GetStatus ();
+	}
+	values.clear ();
+	for (size_t i = 0; i < valueCount; i++) {
+		Type value = Type ();
+		if (inputStream.Read (value) != Stream::Status::NoError) {
+			break;
+		}
+		values.push_back (value);
+	}
+	return inputStream.GetStatus ();
+}
+
+template <class Type, class ElementValueType>
+Stream::Status GenericListValue<Type, ElementValueType>::WriteValues (OutputStream& outputStream) const
+{
+	outputStream.Write (values.size ());
+	for (const Type& value : values) {
+		outputStream.Write (value);
+	}
+	return outputStream.GetStatus ();
+}
+
+// element i is calculated on demand as start + i * step
+template <class Type, class ElementValueType>
+class GenericSequenceValue :	public Value,
+								public IListValue,
+								public NumberListValue,
+								public NumberSequenceValue
+{
+public:
+	GenericSequenceValue ();
+	GenericSequenceValue (Type start, Type step, size_t count);
+	GenericSequenceValue (const GenericSequenceValue&) = delete;
+	virtual ~GenericSequenceValue ();
+
+	GenericSequenceValue&		operator= (const GenericSequenceValue&) = delete;
+
+	virtual std::wstring		ToString (const StringConverter& stringConverter) const override;
+	virtual size_t				GetMemorySize () const override;
+
+	virtual size_t				GetSize () const override;
+	virtual ValueConstPtr		GetElement (size_t index) const override;
+	virtual bool				Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const override;
+	virtual const Value*		GetElementPrototype () const override;
+
+	virtual int					ToInteger (size_t index) const override;
+	virtual double				ToDouble (size_t index) const override;
+
+	virtual double				GetStartAsDouble () const override;
+	virtual double				GetStepAsDouble () const override;
+
+	Type						Get (size_t index) const;
+	Type						GetStart () const;
+	Type						GetStep () const;
+
+protected:
+	Stream::Status				ReadSequence (InputStream& inputStream);
+	Stream::Status				WriteSequence (OutputStream& outputStream) const;
+
+	Type						start;
+	Type						step;
+	size_t						count;
+};
+
+template <class Type, class ElementValueType>
+GenericSequenceValue<Type, ElementValueType>::GenericSequenceValue () :
+	GenericSequenceValue (Type (), Type (), 0)
+{
+
+}
+
+template <class Type, class ElementValueType>
+GenericSequenceValue<Type, ElementValueType>::GenericSequenceValue (Type start, Type step, size_t count) :
+	start (start),
+	step (step),
+	count (count)
+{
+
+}
+
+template <class Type, class ElementValueType>
+GenericSequenceValue<Type, ElementValueType>::~GenericSequenceValue ()
+{
+
+}
+
+template <class Type, class ElementValueType>
+std::wstring GenericSequenceValue<Type, ElementValueType>::ToString (const StringConverter& stringConverter) const
+{
+	class ListEnumerator : public StringConverter::ListEnumerator
+	{
+	public:
+		ListEnumerator (const GenericSequenceValue& sequence, const StringConverter& converter) :
+			sequence (sequence),
+			converter (converter)
+		{
+		}
+
+		virtual size_t GetSize () const override
+		{
+			return sequence.GetSize ();
+		}
+
+		virtual std::wstring GetItem (size_t index) const override
+		{
+			ElementValueType element (sequence.Get (index));
+			return element.ToString (converter);
+		}
+
+	private:
+		const GenericSequenceValue&	sequence;
+		const StringConverter&		converter;
+	};
+
+	ListEnumerator enumerator (*this, stringConverter);
+	return stringConverter.ListToString (enumerator);
+}
+
+template <class Type, class ElementValueType>
+size_t GenericSequenceValue<Type, ElementValueType>::GetMemorySize () const
+{
+	return sizeof (GenericSequenceValue<Type, ElementValueType>);
+}
+
+template <class Type, class ElementValueType>
+size_t GenericSequenceValue<Type, ElementValueType>::GetSize () const
+{
+	return count;
+}
+
+template <class Type, class ElementValueType>
+ValueConstPtr GenericSequenceValue<Type, ElementValueType>::GetElement (size_t index) const
+{
+	return ValueConstPtr (new ElementValueType (Get (index)));
+}
+
+template <class Type, class ElementValueType>
+bool GenericSequenceValue<Type, ElementValueType>::Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const
+{
+	for (size_t i = 0; i < count; i++) {
+		if (!processor (ValueConstPtr (new ElementValueType (Get (i))))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class Type, class ElementValueType>
+const Value* GenericSequenceValue<Type, ElementValueType>::GetElementPrototype () const
+{
+	static const ElementValueType elementPrototype;
+	return &elementPrototype;
+}
+
+template <class Type, class ElementValueType>
+int GenericSequenceValue<Type, ElementValueType>::ToInteger (size_t index) const
+{
+	return (int) Get (index);
+}
+
+template <class Type, class ElementValueType>
+double GenericSequenceValue<Type, ElementValueType>::ToDouble (size_t index) const
+{
+	return (double) Get (index);
+}
+
+template <class Type, class ElementValueType>
+double GenericSequenceValue<Type, ElementValueType>::GetStartAsDouble () const
+{
+	return (double) start;
+}
+
+template <class Type, class ElementValueType>
+double GenericSequenceValue<Type, ElementValueType>::GetStepAsDouble () const
+{
+	return (double) step;
+}
+
+template <class Type, class ElementValueType>
+Type GenericSequenceValue<Type, ElementValueType>::Get (size_t index) const
+{
+	return start + (Type) index * step;
+}
+
+template <class Type, class ElementValueType>
+Type GenericSequenceValue<Type, ElementValueType>::GetStart () const
+{
+	return start;
+}
+
+template <class Type, class ElementValueType>
+Type GenericSequenceValue<Type, ElementValueType>::GetStep () const
+{
+	return step;
+}
+
+template <class Type, class ElementValueType>
+Stream::Status GenericSequenceValue<Type, ElementValueType>::ReadSequence (InputStream& inputStream)
+{
+	inputStream.Read (start);
+	inputStream.Read (step);
+	inputStream.Read (count);
+	return inputStream.GetStatus ();
+}
+
+template <class Type, class ElementValueType>
+Stream::Status GenericSequenceValue<Type, ElementValueType>::WriteSequence (OutputStream& outputStream) const
+{
+	outputStream.Write (start);
+	outputStream.Write (step);
+	outputStream.Write (count);
+	return outputStream.GetStatus ();
+}
+
+class IntListValue : public GenericListValue<int, IntValue>
+{
+	DYNAMIC_SERIALIZABLE (IntListValue);
+	VALUE_TYPE_INFO (IntListValue);
+
+public:
+	IntListValue ();
+	IntListValue (const std::vector<int>& values);
+	IntListValue (std::vector<int>&& values);
+	virtual ~IntListValue ();
+
+	virtual ValuePtr		Clone () const override;
+
+	virtual Stream::Status	Read (InputStream& inputStream) override;
+	virtual Stream::Status	Write (OutputStream& outputStream) const override;
+};
+
+class DoubleListValue : public GenericListValue<double, DoubleValue>
+{
+	DYNAMIC_SERIALIZABLE (DoubleListValue);
+	VALUE_TYPE_INFO (DoubleListValue);
+
+public:
+	DoubleListValue ();
+	DoubleListValue (const std::vector<double>& values);
+	DoubleListValue (std::vector<double>&& values);
+	virtual ~DoubleListValue ();
+
+	virtual ValuePtr		Clone () const override;
+
+	virtual Stream::Status	Read (InputStream& inputStream) override;
+	virtual Stream::Status	Write (OutputStream& outputStream) const override;
+};
+
+class IntSequenceValue : public GenericSequenceValue<int, IntValue>
+{
+	DYNAMIC_SERIALIZABLE (IntSequenceValue);
+	VALUE_TYPE_INFO (IntSequenceValue);
+
+public:
+	IntSequenceValue ();
+	IntSequenceValue (int start, int step, size_t count);
+	virtual ~IntSequenceValue ();
+
+	virtual ValuePtr		Clone () const override;
+
+	virtual Stream::Status	Read (InputStream& inputStream) override;
+	virtual Stream::Status	Write (OutputStream& outputStream) const override;
+};
+
+class DoubleSequenceValue : public GenericSequenceValue<double, DoubleValue>
+{
+	DYNAMIC_SERIALIZABLE (DoubleSequenceValue);
+	VALUE_TYPE_INFO (DoubleSequenceValue);
+
+public:
+	DoubleSequenceValue ();
+	DoubleSequenceValue (double start, double step, size_t count);
+	virtual ~DoubleSequenceValue ();
+
+	virtual ValuePtr		Clone () const override;
+
+	virtual Stream::Status	Read (InputStream& inputStream) override;
+	virtual Stream::Status	Write (OutputStream& outputStream) const override;
+};
+
+// a read-only flat list over the leaves of a nested list, the leaves are not copied,
+// every segment refers to a run of consecutive leaves in one of the source lists
+class FlattenedListValue :	public Value,
+							public IListValue
+{
+	DYNAMIC_SERIALIZABLE (FlattenedListValue);
+	VALUE_TYPE_INFO (FlattenedListValue);
+
+public:
+	FlattenedListValue ();
+	FlattenedListValue (const ValueConstPtr& source);
+	FlattenedListValue (const FlattenedListValue&) = delete;
+	virtual ~FlattenedListValue ();
+
+	FlattenedListValue&			operator= (const FlattenedListValue&) = delete;
+
+	virtual ValuePtr			Clone () const override;
+	virtual std::wstring		ToString (const StringConverter& stringConverter) const override;
+	virtual size_t				GetMemorySize () const override;
+
+	virtual Stream::Status		Read (InputStream& inputStream) override;
+	virtual Stream::Status		Write (OutputStream& outputStream) const override;
+
+	virtual size_t				GetSize () const override;
+	virtual ValueConstPtr		GetElement (size_t index) const override;
+	virtual bool				Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const override;
+	virtual const Value*		GetElementPrototype () const override;
+	virtual ListValueSummary	GetSummary () const override;
+
+	const ValueConstPtr&		GetSource () const;
+	size_t						GetSegmentCount () const;
+
+private:
+	class Segment
+	{
+	public:
+		Segment (const ValueConstPtr& owner, size_t firstIndex, size_t count, size_t offset);
+
+		ValueConstPtr		owner;
+		const IListValue*	list;
+		size_t				firstIndex;
+		size_t				count;
+		size_t				offset;
+	};
+
+	void						BuildSegments ();
+	const Segment&				FindSegment (size_t index) const;
+
+	ValueConstPtr				source;
+	std::vector<Segment>		segments;
+	const Value*				elementPrototype;
+	size_t						size;
+};
+
+using IntListValuePtr = std::shared_ptr<IntListValue>;
+using IntListValueConstPtr = std::shared_ptr<const IntListValue>;
+using DoubleListValuePtr = std::shared_ptr<DoubleListValue>;
+using DoubleListValueConstPtr = std::shared_ptr<const DoubleListValue>;
+using IntSequenceValuePtr = std::shared_ptr<IntSequenceValue>;
+using IntSequenceValueConstPtr = std::shared_ptr<const IntSequenceValue>;
+using DoubleSequenceValuePtr = std::shared_ptr<DoubleSequenceValue>;
+using DoubleSequenceValueConstPtr = std::shared_ptr<const DoubleSequenceValue>;
+using FlattenedListValuePtr = std::shared_ptr<FlattenedListValue>;
+using FlattenedListValueConstPtr = std::shared_ptr<const FlattenedListValue>;
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "NE_OutputSlot.hpp"
 #include "NE_Debug.hpp"
 #include "NE_MemoryStream.hpp"
+#include "NE_EvaluationPlan.hpp"
 
 namespace NE
 {
@@ -23,7 +24,10 @@ Node::Node () :
 	nodeId (NullNodeId),
 	inputSlots (),
 	outputSlots (),
-	nodeEvaluator (nullptr)
+	nodeEvaluator (nullptr),
+	traversalStamp (),
+	valueStamp (),
+	evaluationPlanIndex (InvalidEvaluationPlanIndex)
 {
 
 }
@@ -87,42 +91,52 @@ size_t Node::GetOutputSlotCount () const
 
 void Node::EnumerateInputSlots (const std::function<bool (InputSlotPtr)>& processor)
 {
-	inputSlots.Enumerate (processor);
+	ForEachInputSlot (processor);
 }
 
 void Node::EnumerateOutputSlots (const std::function<bool (OutputSlotPtr)>& processor)
 {
-	outputSlots.Enumerate (processor);
+	ForEachOutputSlot (processor);
 }
 
 void Node::EnumerateInputSlots (const std::function<bool (InputSlotConstPtr)>& processor) const
 {
-	inputSlots.Enumerate (processor);
+	ForEachInputSlot (processor);
 }
 
 void Node::EnumerateOutputSlots (const std::function<bool (OutputSlotConstPtr)>& processor) const
 {
-	outputSlots.Enumerate (processor);
+	ForEachOutputSlot (processor);
 }
 
-ValueConstPtr Node::Evaluate (EvaluationEnv& env) const
+ValueHandle Node::Evaluate (EvaluationEnv& env) const
 {
-	if (DBGERROR (nodeEvaluator == nullptr)) {
+	const NodeEvaluator* evaluator = GetEvaluator (env);
+	if (DBGERROR (evaluator == nullptr)) {
 		return nullptr;
 	}
 
-	CalculationStatus calcStatus = GetCalculationStatus ();
+	// values calculated by the running pass are found without a cache lookup
+	ValueHandle passValue = nullptr;
+	bool isPassValue = evaluator->GetPassNodeValue (*this, passValue);
+	CalculationStatus calcStatus = (isPassValue ? CalculationStatus::Calculated : GetCalculationStatus (*evaluator));
 	if (calcStatus == CalculationStatus::Calculated) {
-		return nodeEvaluator->GetCalculatedNodeValue (nodeId);
+		EvaluationProfiler* evaluationProfiler = evaluator->GetEvaluationProfiler ();
+		if (evaluationProfiler != nullptr) {
+			evaluationProfiler->RecordCacheHit (nodeId);
+		}
+		return (isPassValue ? passValue : GetOrRecalculateValue (env));
 	}
 
 	if (calcStatus != CalculationStatus::NeedToCalculate) {
 		return nullptr;
 	}
 
-	ValueConstPtr value = Calculate (env);
-	nodeEvaluator->SetCalculatedNodeValue (nodeId, value);
-	ProcessCalculatedValue (value, env);
+	ValueHandle value = CalculateValue (env);
+	evaluator->SetCalculatedNodeValue (*this, value);
+	if (!evaluator->IsValueProcessingDeferred ()) {
+		ProcessCalculatedValue (value, env);
+	}
 
 	return value;
 }
@@ -137,7 +151,7 @@ ValueConstPtr Node::GetCalculatedValue () const
 		return nullptr;
 	}
 
-	return nodeEvaluator->GetCalculatedNodeValue (nodeId);
+	return GetOrRecalculateValue (EmptyEvaluationEnv);
 }
 
 bool Node::HasCalculatedValue () const
@@ -153,12 +167,16 @@ Node::CalculationStatus Node::GetCalculationStatus () const
 	if (DBGERROR (nodeEvaluator == nullptr)) {
 		return CalculationStatus::NeedToCalculate;
 	}
+	return GetCalculationStatus (*nodeEvaluator);
+}
 
-	if (nodeEvaluator->HasCalculatedNodeValue (nodeId)) {
+Node::CalculationStatus Node::GetCalculationStatus (const NodeEvaluator& evaluator) const
+{
+	if (evaluator.HasCalculatedNodeValue (nodeId)) {
 		return CalculationStatus::Calculated;
 	}
 
-	if (nodeEvaluator->IsCalculationEnabled () || IsForceCalculated ()) {
+	if (evaluator.IsCalculationEnabled () || IsForceCalculated ()) {
 		return CalculationStatus::NeedToCalculate;
 	} else {
 		return CalculationStatus::NeedToCalculateButDisabled;
@@ -211,12 +229,12 @@ Stream::Status Node::Write (OutputStream& outputStream) const
 	ObjectHeader header (outputStream, serializationInfo);
 	nodeId.Write (outputStream);
 	outputStream.Write (inputSlots.Count ());
-	inputSlots.Enumerate ([&] (const InputSlotConstPtr& inputSlot) {
+	inputSlots.ForEach ([&] (const InputSlotConstPtr& inputSlot) {
 		WriteDynamicObject (outputStream, inputSlot.get ());
 		return true;
 	});
 	outputStream.Write (outputSlots.Count ());
-	outputSlots.Enumerate ([&] (const OutputSlotConstPtr& outputSlot) {
+	outputSlots.ForEach ([&] (const OutputSlotConstPtr& outputSlot) {
 		WriteDynamicObject (outputStream, outputSlot.get ());
 		return true;
 	});
@@ -275,12 +293,8 @@ bool Node::RegisterOutputSlot (const OutputSlotPtr& newOutputSlot)
 	return true;
 }
 
-ValueConstPtr Node::EvaluateInputSlot (const SlotId& slotId, EvaluationEnv& env) const
+ValueHandle Node::EvaluateInputSlot (const SlotId& slotId, EvaluationEnv& env) const
 {
-	if (DBGERROR (!HasInputSlot (slotId))) {
-		return nullptr;
-	}
-
 	InputSlotConstPtr inputSlot = GetInputSlot (slotId);
 	if (DBGERROR (inputSlot == nullptr)) {
 		return nullptr;
@@ -304,6 +318,16 @@ bool Node::IsEvaluatorSet () const
 	return nodeEvaluator != nullptr;
 }
 
+const NodeEvaluator* Node::GetEvaluator (const EvaluationEnv& env) const
+{
+	// the evaluator of the environment overrides the evaluator of the node
+	const NodeEvaluator* envNodeEvaluator = env.GetNodeEvaluator ();
+	if (envNodeEvaluator != nullptr) {
+		return envNodeEvaluator;
+	}
+	return nodeEvaluator.get ();
+}
+
 void Node::ClearEvaluator ()
 {
 	nodeId = NullNodeId;
@@ -315,40 +339,174 @@ bool Node::IsForceCalculated () const
 	return false;
 }
 
+bool Node::IsThreadSafe () const
+{
+	return false;
+}
+
+bool Node::IsMemoizable () const
+{
+	return true;
+}
+
+Stream::Status Node::WriteCalculationSettings (OutputStream& outputStream) const
+{
+	return Write (outputStream);
+}
+
+ValueHandle Node::CalculateHandle (EvaluationEnv& env) const
+{
+	return Calculate (env);
+}
+
+bool Node::IsCalculatedValueProcessed () const
+{
+	return true;
+}
+
 void Node::ProcessCalculatedValue (const ValueConstPtr&, EvaluationEnv&) const
 {
 
 }
 
-ValueConstPtr Node::EvaluateInputSlot (const InputSlotConstPtr& inputSlot, EvaluationEnv& env) const
+void Node::ProcessCalculatedValue (const ValueHandle& value, EvaluationEnv& env) const
 {
-	if (DBGERROR (nodeEvaluator == nullptr)) {
+	if (IsCalculatedValueProcessed ()) {
+		ProcessCalculatedValue (value.GetValue (), env);
+	}
+}
+
+ValueHandle Node::EvaluateInputSlot (const InputSlotConstPtr& inputSlot, EvaluationEnv& env) const
+{
+	const NodeEvaluator* evaluator = GetEvaluator (env);
+	if (DBGERROR (evaluator == nullptr)) {
 		return nullptr;
 	}
 
-	if (!nodeEvaluator->HasConnectedOutputSlots (inputSlot)) {
+	OutputSlotConnectionMode outputSlotConnectionMode = inputSlot->GetOutputSlotConnectionMode ();
+	if (outputSlotConnectionMode == OutputSlotConnectionMode::Disabled) {
 		return inputSlot->GetDefaultValue ();
 	}
 
-	std::vector<OutputSlotConstPtr> connectedOutputSlots;
-	nodeEvaluator->EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
-		connectedOutputSlots.push_back (outputSlot);
-	});
-
-	OutputSlotConnectionMode outputSlotConnectionMode = inputSlot->GetOutputSlotConnectionMode ();
-	if (outputSlotConnectionMode == OutputSlotConnectionMode::Single) {
-		DBGASSERT (connectedOutputSlots.size () == 1);
-		return connectedOutputSlots[0]->Evaluate (env);
-	} else if (inputSlot->GetOutputSlotConnectionMode () == OutputSlotConnectionMode::Multiple) {
-		ListValuePtr result (new ListValue ());
-		for (const OutputSlotConstPtr& outputSlot : connectedOutputSlots) {
-			result->Push (outputSlot->Evaluate (env));
+	ValueHandle result = nullptr;
+	ListValuePtr listResult = nullptr;
+	size_t connectedOutputSlotCount = 0;
+	auto addValue = [&] (const ValueHandle& value) {
+		if (outputSlotConnectionMode == OutputSlotConnectionMode::Single) {
+			result = value;
+		} else {
+			if (listResult == nullptr) {
+				// the node may return the list, so it is not a temporary
+				listResult = ListValuePtr (new ListValue ());
+			}
+			listResult->Push (value);
 		}
+		connectedOutputSlotCount++;
+	};
+
+	// the sources of the input slot are read directly from the evaluation plan
+	// if the node is in it, the connections are enumerated only as a fallback
+	size_t planIndex = InvalidEvaluationPlanIndex;
+	const EvaluationPlan* plan = evaluator->GetEvaluationPlan (*this, planIndex);
+	bool isEnumerated = (plan != nullptr && plan->ForEachSource (planIndex, inputSlot.get (), [&] (const OutputSlotConstPtr& outputSlot) {
+		addValue (outputSlot->Evaluate (env));
+	}));
+	if (!isEnumerated) {
+		evaluator->EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+			addValue (outputSlot->Evaluate (env));
+		});
+	}
+
+	if (connectedOutputSlotCount == 0) {
+		return inputSlot->GetDefaultValue ();
+	}
+	if (outputSlotConnectionMode == OutputSlotConnectionMode::Single) {
+		DBGASSERT (connectedOutputSlotCount == 1);
 		return result;
 	}
+	return listResult;
+}
+
+ValueHandle Node::CalculateValue (EvaluationEnv& env) const
+{
+	const NodeEvaluator* evaluator = GetEvaluator (env);
+	NodeValueMemo* nodeValueMemo = evaluator->GetNodeValueMemo ();
+	if (nodeValueMemo == nullptr || !IsMemoizable ()) {
+		return CalculateAndProfile (env);
+	}
+
+	MemoryOutputStream outputStream;
+	if (!WriteFingerprintData (outputStream, env)) {
+		return CalculateAndProfile (env);
+	}
+
+	NodeValueFingerprint fingerprint (outputStream.GetBuffer ());
+	ValueHandle memoizedValue = nullptr;
+	if (nodeValueMemo->Get (fingerprint, memoizedValue)) {
+		EvaluationProfiler* evaluationProfiler = evaluator->GetEvaluationProfiler ();
+		if (evaluationProfiler != nullptr) {
+			evaluationProfiler->RecordCacheHit (nodeId);
+		}
+		return memoizedValue;
+	}
+
+	ValueHandle value = CalculateAndProfile (env);
+	if (value != nullptr) {
+		nodeValueMemo->Add (fingerprint, value);
+	}
+	return value;
+}
+
+ValueHandle Node::CalculateAndProfile (EvaluationEnv& env) const
+{
+	EvaluationProfiler* evaluationProfiler = GetEvaluator (env)->GetEvaluationProfiler ();
+	if (evaluationProfiler == nullptr) {
+		return CalculateHandle (env);
+	}
+
+	EvaluationProfiler::Clock::time_point startTime = EvaluationProfiler::Clock::now ();
+	ValueHandle value = CalculateHandle (env);
+	EvaluationProfiler::Clock::time_point endTime = EvaluationProfiler::Clock::now ();
+	evaluationProfiler->RecordCalculation (nodeId, startTime, endTime, value.GetMemorySize ());
+	return value;
+}
+
+ValueHandle Node::GetOrRecalculateValue (EvaluationEnv& env) const
+{
+	const NodeEvaluator* evaluator = GetEvaluator (env);
+	ValueHandle value = evaluator->GetCalculatedNodeValue (nodeId);
+	if (value != nullptr || !evaluator->IsCalculatedNodeValueEvicted (nodeId)) {
+		return value;
+	}
 
-	DBGBREAK ();
-	return nullptr;
+	// the value was released by the cache, it is the same as before,
+	// so it is not processed again
+	value = CalculateValue (env);
+	evaluator->SetCalculatedNodeValue (*this, value);
+	return value;
+}
+
+bool Node::WriteFingerprintData (OutputStream& outputStream, EvaluationEnv& env) const
+{
+	// the input values are represented by their content hashes, which are kept
+	// by the values, so an input value is written only once while it lives
+	const DynamicSerializationInfo* dynamicSerializationInfo = GetDynamicSerializationInfo ();
+	dynamicSerializationInfo->GetObjectId ().Write (outputStream);
+	dynamicSerializationInfo->GetObjectVersion ().Write (outputStream);
+	if (WriteCalculationSettings (outputStream) != Stream::Status::NoError) {
+		return false;
+	}
+	bool isValid = true;
+	inputSlots.Enumerate ([&] (const InputSlotConstPtr& inputSlot) {
+		ValueHandle inputValue = EvaluateInputSlot (inputSlot, env);
+		if (inputValue == nullptr) {
+			isValid = false;
+		} else {
+			outputStream.Write ((size_t) inputValue.GetContentHash ());
+		}
+		return isValid;
+	});
+	return isValid;
 }
 
 NodePtr Node::Clone (const NodeConstPtr& node)
@@ -8,8 +8,12 @@
 #include "NE_InputSlot.hpp"
 #include "NE_OutputSlot.hpp"
 #include "NE_Value.hpp"
+#include "NE_ValueHandle.hpp"
 #include "NE_EvaluationEnv.hpp"
 #include "NE_NodeValueCache.hpp"
+#include "NE_NodeValueMemo.hpp"
+#include "NE_EvaluationProfiler.hpp"
+#include "NE_Stamp.hpp"
 
 #include <memory>
 #include <functional>
@@ -18,6 +22,8 @@
 namespace NE
 {
 
+class EvaluationPlan;
+
 class NodeEvaluator
 {
 public:
@@ -27,11 +33,17 @@ public:
 	virtual void			InvalidateNodeValue (const NodeId& nodeId) const = 0;
 	virtual bool			HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const = 0;
 	virtual void			EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const = 0;
+	virtual const EvaluationPlan*	GetEvaluationPlan (const Node& node, size_t& planIndex) const = 0;
 
 	virtual bool			IsCalculationEnabled () const = 0;
 	virtual bool			HasCalculatedNodeValue (const NodeId& nodeId) const = 0;
-	virtual ValueConstPtr	GetCalculatedNodeValue (const NodeId& nodeId) const = 0;
-	virtual void			SetCalculatedNodeValue (const NodeId& nodeId, const ValueConstPtr& valuePtr) const = 0;
+	virtual ValueHandle		GetCalculatedNodeValue (const NodeId& nodeId) const = 0;
+	virtual bool			GetPassNodeValue (const Node& node, ValueHandle& value) const = 0;
+	virtual bool			IsCalculatedNodeValueEvicted (const NodeId& nodeId) const = 0;
+	virtual void			SetCalculatedNodeValue (const Node& node, const ValueHandle& value) const = 0;
+	virtual bool			IsValueProcessingDeferred () const = 0;
+	virtual NodeValueMemo*	GetNodeValueMemo () const = 0;
+	virtual EvaluationProfiler*	GetEvaluationProfiler () const = 0;
 };
 
 using NodeEvaluatorPtr = std::shared_ptr<NodeEvaluator>;
@@ -73,7 +85,17 @@ public:
 	void					EnumerateInputSlots (const std::function<bool (InputSlotConstPtr)>& processor) const;
 	void					EnumerateOutputSlots (const std::function<bool (OutputSlotConstPtr)>& processor) const;
 
-	ValueConstPtr			Evaluate (EvaluationEnv& env) const;
+	template <typename Processor>
+	void					ForEachInputSlot (Processor&& processor);
+	template <typename Processor>
+	void					ForEachOutputSlot (Processor&& processor);
+
+	template <typename Processor>
+	void					ForEachInputSlot (Processor&& processor) const;
+	template <typename Processor>
+	void					ForEachOutputSlot (Processor&& processor) const;
+
+	ValueHandle				Evaluate (EvaluationEnv& env) const;
 	ValueConstPtr			GetCalculatedValue () const;
 	bool					HasCalculatedValue () const;
 	CalculationStatus		GetCalculationStatus () const;
@@ -109,29 +131,87 @@ public:
 protected:
 	bool					RegisterInputSlot (const InputSlotPtr& newInputSlot);
 	bool					RegisterOutputSlot (const OutputSlotPtr& newOutputSlot);
-	ValueConstPtr			EvaluateInputSlot (const SlotId& slotId, EvaluationEnv& env) const;
+	ValueHandle				EvaluateInputSlot (const SlotId& slotId, EvaluationEnv& env) const;
 
 private:
 	void					SetId (const NodeId& newNodeId);
 	void					SetEvaluator (const NodeEvaluatorConstPtr& newNodeEvaluator);
 	bool					IsEvaluatorSet () const;
+	const NodeEvaluator*	GetEvaluator (const EvaluationEnv& env) const;
 	void					ClearEvaluator ();
 
 	virtual void			Initialize () = 0;
 	virtual ValueConstPtr	Calculate (EvaluationEnv& env) const = 0;
+	virtual ValueHandle		CalculateHandle (EvaluationEnv& env) const;
 
 	virtual bool			IsForceCalculated () const;
+	// thread safe nodes may be calculated on worker threads by the parallel evaluation
+	// and by evaluation snapshots, so nodes must opt in if their calculation touches
+	// nothing else than the node itself and the input values
+	virtual bool			IsThreadSafe () const;
+	// memoized values are found by the calculation settings of the node and its input
+	// values, so nodes depending on the evaluation environment must return false
+	virtual bool			IsMemoizable () const;
+	// writes every member the calculation depends on, the default writes the whole node,
+	// nodes may leave out the state of the user interface, like their position, but then
+	// the nodes deriving from them must override it again if they have own settings
+	virtual Stream::Status	WriteCalculationSettings (OutputStream& outputStream) const;
+	// the pointer overload of ProcessCalculatedValue gets inline scalars boxed, so nodes
+	// calculating scalars may return false to skip it, but then the nodes deriving from
+	// them must return true again if they process the calculated values
+	virtual bool			IsCalculatedValueProcessed () const;
 	virtual void			ProcessCalculatedValue (const ValueConstPtr& value, EvaluationEnv& env) const;
+	virtual void			ProcessCalculatedValue (const ValueHandle& value, EvaluationEnv& env) const;
 
-	ValueConstPtr			EvaluateInputSlot (const InputSlotConstPtr& inputSlot, EvaluationEnv& env) const;
+	CalculationStatus		GetCalculationStatus (const NodeEvaluator& evaluator) const;
+	ValueHandle				EvaluateInputSlot (const InputSlotConstPtr& inputSlot, EvaluationEnv& env) const;
+	ValueHandle				CalculateValue (EvaluationEnv& env) const;
+	ValueHandle				CalculateAndProfile (EvaluationEnv& env) const;
+	ValueHandle				GetOrRecalculateValue (EvaluationEnv& env) const;
+	bool					WriteFingerprintData (OutputStream& outputStream, EvaluationEnv& env) const;
 
 	NodeId					nodeId;
 	SlotList<InputSlot>		inputSlots;
 	SlotList<OutputSlot>	outputSlots;
 
 	NodeEvaluatorConstPtr	nodeEvaluator;
+	mutable Stamp			traversalStamp;
+	mutable Stamp			valueStamp;
+	mutable size_t			evaluationPlanIndex;
 };
 
+template <typename Processor>
+void Node::ForEachInputSlot (Processor&& processor)
+{
+	inputSlots.ForEach ([&] (const InputSlotPtr& inputSlot) {
+		return processor (inputSlot);
+	});
+}
+
+template <typename Processor>
+void Node::ForEachOutputSlot (Processor&& processor)
+{
+	outputSlots.ForEach ([&] (const OutputSlotPtr& outputSlot) {
+		return processor (outputSlot);
+	});
+}
+
+template <typename Processor>
+void Node::ForEachInputSlot (Processor&& processor) const
+{
+	inputSlots.ForEach ([&] (const InputSlotPtr& inputSlot) {
+		return processor (InputSlotConstPtr (inputSlot));
+	});
+}
+
+template <typename Processor>
+void Node::ForEachOutputSlot (Processor&& processor) const
+{
+	outputSlots.ForEach ([&] (const OutputSlotPtr& outputSlot) {
+		return processor (OutputSlotConstPtr (outputSlot));
+	});
+}
+
 template <class Type>
 bool Node::IsType (Node* node)
 {
@@ -47,11 +47,7 @@ const NodeId& NodeCollection::Get (size_t index) const
 
 void NodeCollection::Enumerate (const std::function<bool (const NodeId&)>& processor) const
 {
-	for (const NodeId& nodeId : nodes) {
-		if (!processor (nodeId)) {
-			return;
-		}
-	}
+	ForEach (processor);
 }
 
 void NodeCollection::Insert (const NodeId& nodeId)
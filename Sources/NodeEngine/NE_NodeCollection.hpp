@@ -24,6 +24,8 @@ public:
 	const NodeId&		Get (size_t index) const;
 
 	void				Enumerate (const std::function<bool (const NodeId&)>& processor) const;
+	template <typename Processor>
+	void				ForEach (Processor&& processor) const;
 	void				Insert (const NodeId& nodeId);
 	void				Erase (const NodeId& nodeId);
 	void				Clear ();
@@ -39,6 +41,16 @@ private:
 	std::unordered_set<NodeId>	nodeSet;
 };
 
+template <typename Processor>
+void NodeCollection::ForEach (Processor&& processor) const
+{
+	for (const NodeId& nodeId : nodes) {
+		if (!processor (nodeId)) {
+			return;
+		}
+	}
+}
+
 extern const NodeCollection EmptyNodeCollection;
 
 }
@@ -71,16 +71,12 @@ void NodeList::Clear ()
 
 void NodeList::Enumerate (const std::function<bool (NodePtr)>& processor)
 {
-	nodes.Enumerate ([&] (NodePtr& node) {
-		return processor (node);
-	});
+	ForEach (processor);
 }
 
 void NodeList::Enumerate (const std::function<bool (NodeConstPtr)>& processor) const
 {
-	nodes.Enumerate ([&] (const NodePtr& node) {
-		return processor (node);
-	});
+	ForEach (processor);
 }
 
 }
@@ -29,10 +29,31 @@ public:
 	void			Enumerate (const std::function<bool (NodePtr)>& processor);
 	void			Enumerate (const std::function<bool (NodeConstPtr)>& processor) const;
 
+	template <typename Processor>
+	void			ForEach (Processor&& processor);
+	template <typename Processor>
+	void			ForEach (Processor&& processor) const;
+
 private:
 	OrderedMap<NodeId, NodePtr>		nodes;
 };
 
+template <typename Processor>
+void NodeList::ForEach (Processor&& processor)
+{
+	nodes.ForEach ([&] (const NodePtr& node) {
+		return processor (node);
+	});
+}
+
+template <typename Processor>
+void NodeList::ForEach (Processor&& processor) const
+{
+	nodes.ForEach ([&] (const NodePtr& node) {
+		return processor (NodeConstPtr (node));
+	});
+}
+
 }
 
 #endif
@@ -6,6 +6,11 @@
 #include "NE_OutputSlot.hpp"
 #include "NE_MemoryStream.hpp"
 #include "NE_NodeManagerSerialization.hpp"
+#include "NE_ThreadPool.hpp"
+#include "NE_EvaluationSnapshot.hpp"
+
+#include <atomic>
+#include <algorithm>
 
 namespace NE
 {
@@ -52,6 +57,15 @@ public:
 		return nodeManager.EnumerateConnectedOutputSlots (inputSlot, processor);
 	}
 
+	virtual const EvaluationPlan* GetEvaluationPlan (const Node& node, size_t& planIndex) const override
+	{
+		planIndex = nodeManager.GetNodePlanIndex (node);
+		if (planIndex == InvalidEvaluationPlanIndex) {
+			return nullptr;
+		}
+		return nodeManager.evaluationPlan.get ();
+	}
+
 	virtual bool IsCalculationEnabled () const override
 	{
 		return nodeManager.IsCalculationEnabled ();
@@ -59,22 +73,141 @@ public:
 
 	virtual bool HasCalculatedNodeValue (const NodeId& nodeId) const override
 	{
+		std::unique_lock<std::mutex> lock = LockNodeValueCache ();
 		return nodeValueCache.Contains (nodeId);
 	}
 
-	virtual ValueConstPtr GetCalculatedNodeValue (const NodeId& nodeId) const override
+	virtual ValueHandle GetCalculatedNodeValue (const NodeId& nodeId) const override
 	{
+		std::unique_lock<std::mutex> lock = LockNodeValueCache ();
 		return nodeValueCache.Get (nodeId);
 	}
 
-	virtual void SetCalculatedNodeValue (const NodeId& nodeId, const ValueConstPtr& valuePtr) const override
+	virtual bool GetPassNodeValue (const Node& node, ValueHandle& value) const override
+	{
+		// values calculated by the running pass are stored by their plan indices
+		if (nodeManager.passValues == nullptr) {
+			return false;
+		}
+		size_t planIndex = nodeManager.GetNodePlanIndex (node);
+		if (planIndex >= nodeManager.passValues->size () || (*nodeManager.passValues)[planIndex] == nullptr) {
+			return false;
+		}
+		value = (*nodeManager.passValues)[planIndex];
+		return true;
+	}
+
+	virtual bool IsCalculatedNodeValueEvicted (const NodeId& nodeId) const override
+	{
+		std::unique_lock<std::mutex> lock = LockNodeValueCache ();
+		return nodeValueCache.IsEvicted (nodeId);
+	}
+
+	virtual void SetCalculatedNodeValue (const Node& node, const ValueHandle& value) const override
+	{
+		// a value that may be evicted is not kept by the pass, otherwise
+		// the pass would hold it beyond the memory budget of the cache
+		bool isEvictable = nodeManager.IsNodeValueEvictable (node);
+		if (nodeManager.passValues != nullptr && (!isEvictable || nodeValueCache.GetMemoryBudget () == 0)) {
+			size_t planIndex = nodeManager.GetNodePlanIndex (node);
+			if (planIndex < nodeManager.passValues->size ()) {
+				(*nodeManager.passValues)[planIndex] = value;
+			}
+		}
+
+		const NodeId& nodeId = node.GetId ();
+		std::unique_lock<std::mutex> lock = LockNodeValueCache ();
+		if (nodeValueCache.Contains (nodeId)) {
+			nodeValueCache.Restore (nodeId, value);
+		} else {
+			nodeValueCache.Add (nodeId, value, isEvictable);
+		}
+	}
+
+	virtual bool IsValueProcessingDeferred () const override
+	{
+		// the parallel evaluation processes the values on the calling thread after the pass
+		return nodeManager.isParallelEvaluationInProgress;
+	}
+
+	virtual NodeValueMemo* GetNodeValueMemo () const override
 	{
-		nodeValueCache.Add (nodeId, valuePtr);
+		if (nodeManager.nodeValueMemo->GetMemoryBudget () == 0) {
+			return nullptr;
+		}
+		return nodeManager.nodeValueMemo.get ();
+	}
+
+	virtual EvaluationProfiler* GetEvaluationProfiler () const override
+	{
+		if (!nodeManager.evaluationProfiler->IsEnabled ()) {
+			return nullptr;
+		}
+		return nodeManager.evaluationProfiler.get ();
 	}
 
 private:
+	std::unique_lock<std::mutex> LockNodeValueCache () const
+	{
+		// the cache is accessed from more threads only by the parallel evaluation
+		std::unique_lock<std::mutex> lock (nodeValueCacheMutex, std::defer_lock);
+		if (nodeManager.isParallelEvaluationInProgress) {
+			lock.lock ();
+		}
+		return lock;
+	}
+
 	const NodeManager&	nodeManager;
 	NodeValueCache&		nodeValueCache;
+	mutable std::mutex	nodeValueCacheMutex;
+};
+
+class NodeManagerTopologicalGraph : public TopologicalOrder::Graph
+{
+public:
+	NodeManagerTopologicalGraph (const NodeManager& nodeManager) :
+		nodeManager (nodeManager)
+	{
+
+	}
+
+	virtual void EnumerateSuccessors (const NodeId& nodeId, const std::function<void (const NodeId&)>& processor) const override
+	{
+		NodeConstPtr node = nodeManager.GetNode (nodeId);
+		nodeManager.EnumerateDependentNodes (node, processor);
+	}
+
+	virtual void EnumeratePredecessors (const NodeId& nodeId, const std::function<void (const NodeId&)>& processor) const override
+	{
+		NodeConstPtr node = nodeManager.GetNode (nodeId);
+		node->ForEachInputSlot ([&] (InputSlotConstPtr inputSlot) {
+			nodeManager.ForEachConnectedOutputSlot (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+				processor (outputSlot->GetOwnerNodeId ());
+			});
+			return true;
+		});
+	}
+
+private:
+	const NodeManager& nodeManager;
+};
+
+class NodeManagerEvaluationPlanGraph : public EvaluationPlan::Graph
+{
+public:
+	NodeManagerEvaluationPlanGraph (const ConnectionManager& connectionManager) :
+		connectionManager (connectionManager)
+	{
+
+	}
+
+	virtual void EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const override
+	{
+		connectionManager.EnumerateConnectedOutputSlots (inputSlot, processor);
+	}
+
+private:
+	const ConnectionManager& connectionManager;
 };
 
 OutputSlotList::OutputSlotList ()
@@ -107,15 +240,80 @@ bool InputSlotList::IsEmpty () const
 	return GetSize () == 0;
 }
 
+NodeManager::EvaluationPass::EvaluationPass () :
+	planIndices (),
+	position (0),
+	planStamp (),
+	invalidationStamp (),
+	isInProgress (false)
+{
+
+}
+
+void NodeManager::EvaluationPass::Start (const std::vector<size_t>& newPlanIndices, const Stamp& newPlanStamp, const Stamp& newInvalidationStamp)
+{
+	planIndices = newPlanIndices;
+	position = 0;
+	planStamp = newPlanStamp;
+	invalidationStamp = newInvalidationStamp;
+	isInProgress = true;
+}
+
+void NodeManager::EvaluationPass::Cancel ()
+{
+	planIndices.clear ();
+	position = 0;
+	isInProgress = false;
+}
+
+void NodeManager::EvaluationPass::Advance (size_t count)
+{
+	DBGASSERT (position + count <= planIndices.size ());
+	position += count;
+}
+
+bool NodeManager::EvaluationPass::IsInProgress () const
+{
+	return isInProgress;
+}
+
+bool NodeManager::EvaluationPass::IsInProgress (const Stamp& currentPlanStamp, const Stamp& currentInvalidationStamp) const
+{
+	return isInProgress && planStamp == currentPlanStamp && invalidationStamp == currentInvalidationStamp;
+}
+
+const std::vector<size_t>& NodeManager::EvaluationPass::GetPlanIndices () const
+{
+	return planIndices;
+}
+
+size_t NodeManager::EvaluationPass::GetPosition () const
+{
+	return position;
+}
+
 NodeManager::NodeManager () :
 	idGenerator (),
 	nodeList (),
 	connectionManager (),
 	nodeGroupList (),
+	topologicalOrder (),
 	updateMode (UpdateMode::Automatic),
+	evaluationMode (EvaluationMode::Serial),
+	isEvaluationArenaEnabled (false),
+	evaluationPlan (new EvaluationPlan ()),
+	evaluationPass (),
+	invalidationStamp (),
 	nodeValueCache (),
+	nodeValueMemo (new NodeValueMemo (0)),
+	evaluationProfiler (new EvaluationProfiler ()),
 	nodeEvaluator (nullptr),
-	isForceCalculate (false)
+	isForceCalculate (false),
+	isParallelEvaluationInProgress (false),
+	passValues (nullptr),
+	traversalStamp (),
+	traversalDepth (0),
+	threadPool (nullptr)
 {
 	nodeEvaluator.reset (new NodeManagerNodeEvaluator (*this, nodeValueCache));
 }
@@ -131,9 +329,13 @@ void NodeManager::Clear ()
 	nodeList.Clear ();
 	connectionManager.Clear ();
 	nodeGroupList.Clear ();
+	topologicalOrder.Clear ();
 	updateMode = UpdateMode::Automatic;
 
+	InvalidateEvaluationPlan ();
+	evaluationPass.Cancel ();
 	nodeValueCache.Clear ();
+	nodeValueMemo->Clear ();
 	nodeEvaluator.reset (new NodeManagerNodeEvaluator (*this, nodeValueCache));
 	isForceCalculate = false;
 }
@@ -158,6 +360,19 @@ size_t NodeManager::GetConnectionCount () const
 	return connectionManager.GetConnectionCount ();
 }
 
+GraphStatistics NodeManager::GetGraphStatistics () const
+{
+	// the plan is not built here, so the depth is reported only if the plan
+	// is up to date, the other values are maintained incrementally
+	bool isDepthKnown = evaluationPlan->IsValid ();
+	size_t depth = (isDepthKnown ? evaluationPlan->GetDepth () : 0);
+	size_t valueCacheMemorySize = nodeValueCache.GetStatistics ().GetMemorySize ();
+	GraphMemoryStatistics memoryStatistics (connectionManager.GetMemorySize (), evaluationPlan->GetMemorySize (), valueCacheMemorySize, nodeValueMemo->GetMemoryUsage ());
+	size_t maxFanIn = connectionManager.GetMaxConnectedOutputSlotCount ();
+	size_t maxFanOut = connectionManager.GetMaxConnectedInputSlotCount ();
+	return GraphStatistics (nodeList.Count (), connectionManager.GetConnectionCount (), nodeGroupList.Count (), maxFanIn, maxFanOut, isDepthKnown, depth, memoryStatistics);
+}
+
 void NodeManager::EnumerateNodes (const std::function<bool (NodePtr)>& processor)
 {
 	nodeList.Enumerate (processor);
@@ -209,16 +424,20 @@ bool NodeManager::DeleteNode (const NodePtr& node)
 	nodeGroupList.RemoveNodeFromGroup (node->GetId ());
 	node->InvalidateValue ();
 
-	node->EnumerateInputSlots ([&] (InputSlotConstPtr inputSlot) {
+	node->ForEachInputSlot ([&] (InputSlotConstPtr inputSlot) {
 		connectionManager.DisconnectAllOutputSlotsFromInputSlot (inputSlot);
+		connectionManager.UnregisterInputSlot (inputSlot);
 		return true;
 	});
 
-	node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
+	node->ForEachOutputSlot ([&] (OutputSlotConstPtr outputSlot) {
 		connectionManager.DisconnectAllInputSlotsFromOutputSlot (outputSlot);
+		connectionManager.UnregisterOutputSlot (outputSlot);
 		return true;
 	});
 
+	topologicalOrder.DeleteNode (node->GetId ());
+	InvalidateEvaluationPlan ();
 	nodeList.DeleteNode (node->GetId ());
 	node->ClearEvaluator ();
 
@@ -254,18 +473,8 @@ bool NodeManager::CanConnectOutputSlotToInputSlot (const OutputSlotConstPtr& out
 		return false;
 	}
 
-	bool willCreateCycle = false;
-	if (outputNode == inputNode) {
-		willCreateCycle = true;
-	} else {
-		EnumerateDependentNodesRecursive (inputNode, [&] (const NodeConstPtr& dependentNode) {
-			if (outputNode == dependentNode) {
-				willCreateCycle = true;
-			}
-		});
-	}
-
-	if (willCreateCycle) {
+	NodeManagerTopologicalGraph graph (*this);
+	if (!topologicalOrder.CanAddEdge (graph, outputNode->GetId (), inputNode->GetId ())) {
 		return false;
 	}
 
@@ -324,7 +533,13 @@ bool NodeManager::ConnectOutputSlotToInputSlot (const OutputSlotConstPtr& output
 		return false;
 	}
 
+	NodeManagerTopologicalGraph graph (*this);
+	if (DBGERROR (!topologicalOrder.AddEdge (graph, outputSlot->GetOwnerNodeId (), inputSlot->GetOwnerNodeId ()))) {
+		return false;
+	}
+
 	InvalidateNodeValue (GetNode (inputSlot->GetOwnerNodeId ()));
+	InvalidateEvaluationPlan ();
 	return connectionManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot);
 }
 
@@ -373,6 +588,7 @@ bool NodeManager::DisconnectOutputSlotFromInputSlot (const OutputSlotConstPtr& o
 	}
 
 	InvalidateNodeValue (GetNode (inputSlot->GetOwnerNodeId ()));
+	InvalidateEvaluationPlan ();
 	return connectionManager.DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot);
 }
 
@@ -445,12 +661,14 @@ bool NodeManager::DisconnectOutputSlotFromInputSlots (const OutputSlotConstPtr&
 bool NodeManager::DisconnectAllInputSlotsFromOutputSlot (const OutputSlotConstPtr& outputSlot)
 {
 	InvalidateNodeValue (GetNode (outputSlot->GetOwnerNodeId ()));
+	InvalidateEvaluationPlan ();
 	return connectionManager.DisconnectAllInputSlotsFromOutputSlot (outputSlot);
 }
 
 bool NodeManager::DisconnectAllOutputSlotsFromInputSlot (const InputSlotConstPtr& inputSlot)
 {
 	InvalidateNodeValue (GetNode (inputSlot->GetOwnerNodeId ()));
+	InvalidateEvaluationPlan ();
 	return connectionManager.DisconnectAllOutputSlotsFromInputSlot (inputSlot);
 }
 
@@ -486,46 +704,257 @@ void NodeManager::EnumerateConnectedInputSlots (const OutputSlotConstPtr& output
 
 void NodeManager::EnumerateConnections (const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const
 {
-	nodeList.Enumerate ([&] (const NodeConstPtr& node) {
-		node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
-			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
-				processor (outputSlot, inputSlot);
-			});
-			return true;
-		});
-		return true;
-	});
+	ForEachConnection (processor);
 }
 
 void NodeManager::EnumerateConnections (const NodeCollection& nodes, const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const
 {
-	nodes.Enumerate ([&] (const NodeId& nodeId) {
-		NodeConstPtr node = GetNode (nodeId);
-		node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
-			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
-				if (nodes.Contains (inputSlot->GetOwnerNodeId ())) {
-					processor (outputSlot, inputSlot);
-				}
-			});
-			return true;
-		});
-		return true;
-	});
+	ForEachConnection (nodes, processor);
 }
 
 void NodeManager::EvaluateAllNodes (EvaluationEnv& env) const
 {
-	EnumerateNodes ([&] (NodeConstPtr node) {
-		node->Evaluate (env);
+	evaluationPass.Cancel ();
+	EvaluationEnv passEnv = CreateEvaluationPassEnv (env);
+	const EvaluationPlan& plan = GetEvaluationPlan ();
+	std::vector<ValueHandle> values;
+	ValueGuard<std::vector<ValueHandle>*> passValuesGuard (passValues, &values);
+	if (evaluationMode == EvaluationMode::Parallel) {
+		std::vector<size_t> planIndices (plan.GetNodeCount ());
+		for (size_t planIndex = 0; planIndex < plan.GetNodeCount (); planIndex++) {
+			planIndices[planIndex] = planIndex;
+		}
+		values.resize (plan.GetNodeCount ());
+		EvaluateNodesParallel (planIndices, passEnv);
+		return;
+	}
+	for (size_t planIndex = 0; planIndex < plan.GetNodeCount (); planIndex++) {
+		const NodeConstPtr& node = plan.GetNode (planIndex);
+		if (node->GetCalculationStatus () == Node::CalculationStatus::NeedToCalculate) {
+			if (values.empty ()) {
+				values.resize (plan.GetNodeCount ());
+			}
+			node->Evaluate (passEnv);
+		}
+	}
+}
+
+EvaluationProgress NodeManager::EvaluateAllNodes (EvaluationEnv& env, std::chrono::microseconds timeBudget) const
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now ();
+	EvaluationEnv passEnv = CreateEvaluationPassEnv (env);
+	const EvaluationPlan& plan = GetEvaluationPlan ();
+
+	// the pass is restarted whenever the plan is rebuilt or a value is invalidated since
+	// it was started, so nodes are never evaluated from a stale list; values calculated
+	// by the cancelled pass and not invalidated since are reused from the cache
+	if (!evaluationPass.IsInProgress (plan.GetBuildStamp (), invalidationStamp)) {
+		std::vector<size_t> planIndices;
+		for (size_t planIndex = 0; planIndex < plan.GetNodeCount (); planIndex++) {
+			if (plan.GetNode (planIndex)->GetCalculationStatus () == Node::CalculationStatus::NeedToCalculate) {
+				planIndices.push_back (planIndex);
+			}
+		}
+		evaluationPass.Start (planIndices, plan.GetBuildStamp (), invalidationStamp);
+	}
+
+	const std::vector<size_t>& planIndices = evaluationPass.GetPlanIndices ();
+	size_t sliceBegin = evaluationPass.GetPosition ();
+	std::vector<ValueHandle> values;
+	ValueGuard<std::vector<ValueHandle>*> passValuesGuard (passValues, &values);
+	if (sliceBegin < planIndices.size ()) {
+		values.resize (plan.GetNodeCount ());
+	}
+	size_t batchSize = 1;
+	if (evaluationMode == EvaluationMode::Parallel) {
+		batchSize = ThreadPool::GetDefaultThreadCount ();
+	}
+	while (evaluationPass.GetPosition () < planIndices.size ()) {
+		size_t batchBegin = evaluationPass.GetPosition ();
+		size_t batchEnd = std::min (batchBegin + batchSize, planIndices.size ());
+		if (batchSize == 1) {
+			const NodeConstPtr& node = plan.GetNode (planIndices[batchBegin]);
+			if (node->GetCalculationStatus () == Node::CalculationStatus::NeedToCalculate) {
+				node->Evaluate (passEnv);
+			}
+		} else {
+			std::vector<size_t> batch (planIndices.begin () + batchBegin, planIndices.begin () + batchEnd);
+			EvaluateNodesParallel (batch, passEnv);
+		}
+		evaluationPass.Advance (batchEnd - batchBegin);
+		if (std::chrono::steady_clock::now () - startTime >= timeBudget) {
+			break;
+		}
+	}
+
+	std::vector<NodeId> calculatedNodes;
+	calculatedNodes.reserve (evaluationPass.GetPosition () - sliceBegin);
+	for (size_t position = sliceBegin; position < evaluationPass.GetPosition (); position++) {
+		calculatedNodes.push_back (plan.GetNode (planIndices[position])->GetId ());
+	}
+	EvaluationProgress progress (evaluationPass.GetPosition (), planIndices.size (), calculatedNodes);
+	if (progress.IsFinished ()) {
+		evaluationPass.Cancel ();
+	}
+	return progress;
+}
+
+bool NodeManager::IsEvaluationInProgress () const
+{
+	return evaluationPass.IsInProgress ();
+}
+
+void NodeManager::CancelEvaluation () const
+{
+	evaluationPass.Cancel ();
+}
+
+bool NodeManager::CreateEvaluationSnapshot (EvaluationSnapshot& snapshot) const
+{
+	// the snapshot shares the nodes and the plan, and gets the values of the nodes it
+	// depends on, so creating it needs no copy of the graph; evicted values are
+	// recalculated by the snapshot, so their sources are collected, too
+	const EvaluationPlan& plan = GetEvaluationPlan ();
+	std::vector<size_t> planIndices;
+	std::vector<Stamp> valueStamps;
+	std::vector<bool> isVisited (plan.GetNodeCount (), false);
+	for (size_t planIndex = 0; planIndex < plan.GetNodeCount (); planIndex++) {
+		const NodeConstPtr& node = plan.GetNode (planIndex);
+		if (node->GetCalculationStatus () != Node::CalculationStatus::NeedToCalculate) {
+			continue;
+		}
+		if (!node->IsThreadSafe ()) {
+			return false;
+		}
+		planIndices.push_back (planIndex);
+		valueStamps.push_back (node->valueStamp);
+		isVisited[planIndex] = true;
+	}
+
+	std::unordered_map<NodeId, ValueHandle> values;
+	std::vector<size_t> planIndicesToVisit;
+	for (size_t planIndex : planIndices) {
+		plan.EnumeratePredecessors (planIndex, [&] (size_t predecessorPlanIndex) {
+			planIndicesToVisit.push_back (predecessorPlanIndex);
+		});
+	}
+	while (!planIndicesToVisit.empty ()) {
+		size_t planIndex = planIndicesToVisit.back ();
+		planIndicesToVisit.pop_back ();
+		if (isVisited[planIndex]) {
+			continue;
+		}
+		isVisited[planIndex] = true;
+		const NodeId& nodeId = plan.GetNode (planIndex)->GetId ();
+		if (!nodeValueCache.Contains (nodeId)) {
+			continue;
+		}
+		if (nodeValueCache.IsEvicted (nodeId)) {
+			plan.EnumeratePredecessors (planIndex, [&] (size_t predecessorPlanIndex) {
+				planIndicesToVisit.push_back (predecessorPlanIndex);
+			});
+			continue;
+		}
+		values.insert ({ nodeId, nodeValueCache.Get (nodeId) });
+	}
+
+	snapshot.sourceNodeManager = this;
+	snapshot.plan = evaluationPlan;
+	snapshot.planIndices.swap (planIndices);
+	snapshot.valueStamps.swap (valueStamps);
+	snapshot.values.swap (values);
+	snapshot.nodePlanIndices.clear ();
+	snapshot.isCalculationEnabled = IsCalculationEnabled ();
+	snapshot.nodeValueMemo = (nodeValueMemo->GetMemoryBudget () > 0 ? nodeValueMemo : nullptr);
+	snapshot.evaluationProfiler = (evaluationProfiler->IsEnabled () ? evaluationProfiler : nullptr);
+	snapshot.position = 0;
+	return true;
+}
+
+NodeCollection NodeManager::PublishEvaluationSnapshot (const EvaluationSnapshot& snapshot, EvaluationEnv& env) const
+{
+	NodeCollection publishedNodes;
+	if (DBGERROR (snapshot.sourceNodeManager != this)) {
+		return publishedNodes;
+	}
+
+	// a value is published only if the node is not invalidated, deleted or
+	// replaced since the snapshot was created, so stale values never get back
+	for (size_t index = 0; index < snapshot.planIndices.size (); index++) {
+		const NodeConstPtr& node = snapshot.plan->GetNode (snapshot.planIndices[index]);
+		const NodeId& nodeId = node->GetId ();
+		if (!ContainsNode (nodeId) || GetNode (nodeId) != node || snapshot.valueStamps[index] != node->valueStamp) {
+			continue;
+		}
+		auto foundValue = snapshot.values.find (nodeId);
+		if (nodeValueCache.Contains (nodeId) || foundValue == snapshot.values.end ()) {
+			continue;
+		}
+		nodeValueCache.Add (nodeId, foundValue->second, IsNodeValueEvictable (*node));
+		node->ProcessCalculatedValue (foundValue->second, env);
+		publishedNodes.Insert (nodeId);
+	}
+	return publishedNodes;
+}
+
+void NodeManager::EvaluateNodes (const NodeCollection& nodes, EvaluationEnv& env) const
+{
+	const EvaluationPlan& plan = GetEvaluationPlan ();
+	std::vector<bool> isVisited (plan.GetNodeCount (), false);
+	std::vector<size_t> planIndices;
+	std::vector<size_t> planIndicesToVisit;
+	nodes.ForEach ([&] (const NodeId& nodeId) {
+		NodeConstPtr node = GetNode (nodeId);
+		if (DBGERROR (node == nullptr)) {
+			return true;
+		}
+		planIndicesToVisit.push_back (node->evaluationPlanIndex);
 		return true;
 	});
+
+	while (!planIndicesToVisit.empty ()) {
+		size_t planIndex = planIndicesToVisit.back ();
+		planIndicesToVisit.pop_back ();
+		if (isVisited[planIndex]) {
+			continue;
+		}
+		isVisited[planIndex] = true;
+		if (plan.GetNode (planIndex)->GetCalculationStatus () != Node::CalculationStatus::NeedToCalculate) {
+			continue;
+		}
+		planIndices.push_back (planIndex);
+		plan.EnumeratePredecessors (planIndex, [&] (size_t predecessorPlanIndex) {
+			if (!isVisited[predecessorPlanIndex]) {
+				planIndicesToVisit.push_back (predecessorPlanIndex);
+			}
+		});
+	}
+
+	if (planIndices.empty ()) {
+		return;
+	}
+
+	std::sort (planIndices.begin (), planIndices.end ());
+	EvaluationEnv passEnv = CreateEvaluationPassEnv (env);
+	std::vector<ValueHandle> values (plan.GetNodeCount ());
+	ValueGuard<std::vector<ValueHandle>*> passValuesGuard (passValues, &values);
+	if (evaluationMode == EvaluationMode::Parallel) {
+		EvaluateNodesParallel (planIndices, passEnv);
+		return;
+	}
+	for (size_t planIndex : planIndices) {
+		const NodeConstPtr& node = plan.GetNode (planIndex);
+		if (node->GetCalculationStatus () == Node::CalculationStatus::NeedToCalculate) {
+			node->Evaluate (passEnv);
+		}
+	}
 }
 
 void NodeManager::ForceEvaluateAllNodes (EvaluationEnv& env) const
 {
 	ValueGuard<bool> isForceCalculateGuard (isForceCalculate, true);
 	std::vector<NodeConstPtr> nodesToRecalculate;
-	EnumerateNodes ([&] (NodeConstPtr node) {
+	ForEachNode ([&] (NodeConstPtr node) {
 		Node::CalculationStatus calcStatus = node->GetCalculationStatus ();
 		DBGASSERT (calcStatus != Node::CalculationStatus::NeedToCalculateButDisabled);
 		if (calcStatus == Node::CalculationStatus::NeedToCalculate) {
@@ -547,22 +976,25 @@ void NodeManager::InvalidateNodeValue (const NodeId& nodeId) const
 
 void NodeManager::InvalidateNodeValue (const NodeConstPtr& node) const
 {
+	invalidationStamp.Update ();
 	const NodeId& nodeId = node->GetId ();
+	node->valueStamp = invalidationStamp;
 	if (nodeValueCache.Contains (nodeId)) {
 		nodeValueCache.Remove (nodeId);
 	}
-	EnumerateDependentNodes (node, [&] (const NodeConstPtr& dependentNode) {
-		InvalidateNodeValue (dependentNode);
+	EnumerateDependentNodesRecursive (node, [&] (const NodeId& dependentNodeId) {
+		GetNode (dependentNodeId)->valueStamp = invalidationStamp;
+		if (nodeValueCache.Contains (dependentNodeId)) {
+			nodeValueCache.Remove (dependentNodeId);
+		}
 	});
 }
 
 void NodeManager::EnumerateDependentNodes (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
 {
-	node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
-		if (connectionManager.HasConnectedInputSlots (outputSlot)) {
-			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
-				processor (inputSlot->GetOwnerNodeId ());
-			});
+	node->ForEachOutputSlot ([&] (OutputSlotConstPtr outputSlot) {
+		for (size_t inputSlotIndex : connectionManager.GetConnectedInputSlotIndices (outputSlot)) {
+			processor (connectionManager.GetInputSlot (inputSlotIndex)->GetOwnerNodeId ());
 		}
 		return true;
 	});
@@ -570,11 +1002,47 @@ void NodeManager::EnumerateDependentNodes (const NodeConstPtr& node, const std::
 
 void NodeManager::EnumerateDependentNodesRecursive (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
 {
-	EnumerateDependentNodes (node, [&] (const NodeId& dependentNodeId) {
-		NodeConstPtr dependentNode = GetNode (dependentNodeId);
-		processor (dependentNodeId);
-		EnumerateDependentNodesRecursive (dependentNode, processor);
-	});
+	// every traversal gets a new stamp, and a node is visited only if its stamp differs
+	// from the current one, so the cost depends only on the size of the dependent cone;
+	// a traversal started by the processor overwrites the stamps of the outer one, so
+	// nested traversals save the stamps of the visited nodes and restore them at the end
+	traversalStamp.Update ();
+	Stamp currentStamp = traversalStamp;
+	bool isNested = (traversalDepth > 0);
+	ValueGuard<size_t> traversalDepthGuard (traversalDepth, traversalDepth + 1);
+
+	std::vector<NodeConstPtr> visitedNodes;
+	std::vector<Stamp> savedStamps;
+	auto MarkVisited = [&] (const NodeConstPtr& visitedNode) {
+		if (isNested) {
+			visitedNodes.push_back (visitedNode);
+			savedStamps.push_back (visitedNode->traversalStamp);
+		}
+		visitedNode->traversalStamp = currentStamp;
+	};
+
+	MarkVisited (node);
+	std::vector<NodeConstPtr> nodesToVisit = { node };
+	while (!nodesToVisit.empty ()) {
+		NodeConstPtr currentNode = nodesToVisit.back ();
+		nodesToVisit.pop_back ();
+		currentNode->ForEachOutputSlot ([&] (const OutputSlotConstPtr& outputSlot) {
+			for (size_t inputSlotIndex : connectionManager.GetConnectedInputSlotIndices (outputSlot)) {
+				NodeConstPtr dependentNode = GetNode (connectionManager.GetInputSlot (inputSlotIndex)->GetOwnerNodeId ());
+				if (dependentNode->traversalStamp == currentStamp) {
+					continue;
+				}
+				MarkVisited (dependentNode);
+				processor (dependentNode->GetId ());
+				nodesToVisit.push_back (dependentNode);
+			}
+			return true;
+		});
+	}
+
+	for (size_t index = 0; index < visitedNodes.size (); index++) {
+		visitedNodes[index]->traversalStamp = savedStamps[index];
+	}
 }
 
 void NodeManager::EnumerateDependentNodes (const NodePtr& node, const std::function<void (const NodePtr&)>& processor)
@@ -677,6 +1145,91 @@ void NodeManager::SetUpdateMode (UpdateMode newUpdateMode)
 	updateMode = newUpdateMode;
 }
 
+NodeManager::EvaluationMode NodeManager::GetEvaluationMode () const
+{
+	return evaluationMode;
+}
+
+void NodeManager::SetEvaluationMode (EvaluationMode newEvaluationMode)
+{
+	evaluationMode = newEvaluationMode;
+}
+
+bool NodeManager::IsEvaluationArenaEnabled () const
+{
+	return isEvaluationArenaEnabled;
+}
+
+void NodeManager::SetEvaluationArenaEnabled (bool newIsEvaluationArenaEnabled)
+{
+	isEvaluationArenaEnabled = newIsEvaluationArenaEnabled;
+}
+
+size_t NodeManager::GetValueMemoBudget () const
+{
+	return nodeValueMemo->GetMemoryBudget ();
+}
+
+void NodeManager::SetValueMemoBudget (size_t newValueMemoBudget)
+{
+	nodeValueMemo->SetMemoryBudget (newValueMemoBudget);
+}
+
+size_t NodeManager::GetValueMemoUsage () const
+{
+	return nodeValueMemo->GetMemoryUsage ();
+}
+
+void NodeManager::ClearValueMemo () const
+{
+	nodeValueMemo->Clear ();
+}
+
+size_t NodeManager::GetValueCacheBudget () const
+{
+	return nodeValueCache.GetMemoryBudget ();
+}
+
+void NodeManager::SetValueCacheBudget (size_t newValueCacheBudget)
+{
+	nodeValueCache.SetMemoryBudget (newValueCacheBudget);
+}
+
+NodeValueCacheStatistics NodeManager::GetValueCacheStatistics () const
+{
+	return nodeValueCache.GetStatistics ();
+}
+
+Stream::Status NodeManager::ReadValueMemo (InputStream& inputStream) const
+{
+	return nodeValueMemo->Read (inputStream);
+}
+
+Stream::Status NodeManager::WriteValueMemo (OutputStream& outputStream) const
+{
+	return nodeValueMemo->Write (outputStream);
+}
+
+bool NodeManager::IsProfilingEnabled () const
+{
+	return evaluationProfiler->IsEnabled ();
+}
+
+void NodeManager::SetProfilingEnabled (bool newIsProfilingEnabled)
+{
+	evaluationProfiler->SetEnabled (newIsProfilingEnabled);
+}
+
+const EvaluationProfiler& NodeManager::GetEvaluationProfiler () const
+{
+	return *evaluationProfiler;
+}
+
+void NodeManager::ClearEvaluationProfiler ()
+{
+	evaluationProfiler->Clear ();
+}
+
 Stream::Status NodeManager::Read (InputStream& inputStream)
 {
 	return NodeManagerSerialization::Read (*this, inputStream);
@@ -747,6 +1300,10 @@ NE::NodePtr NodeManager::AddNode (const NodePtr& node, IdPolicy idPolicy, InitPo
 
 	node->SetId (nodeId);
 	node->SetEvaluator (nodeEvaluator);
+	node->traversalStamp = Stamp ();
+	node->evaluationPlanIndex = InvalidEvaluationPlanIndex;
+	invalidationStamp.Update ();
+	node->valueStamp = invalidationStamp;
 	if (initPolicy == InitPolicy::Initialize) {
 		node->Initialize ();
 	}
@@ -754,6 +1311,16 @@ NE::NodePtr NodeManager::AddNode (const NodePtr& node, IdPolicy idPolicy, InitPo
 	if (DBGERROR (!nodeList.AddNode (node->GetId (), node))) {
 		return nullptr;
 	}
+	node->ForEachInputSlot ([&] (InputSlotConstPtr inputSlot) {
+		connectionManager.RegisterInputSlot (inputSlot);
+		return true;
+	});
+	node->ForEachOutputSlot ([&] (OutputSlotConstPtr outputSlot) {
+		connectionManager.RegisterOutputSlot (outputSlot);
+		return true;
+	});
+	topologicalOrder.AddNode (node->GetId ());
+	InvalidateEvaluationPlan ();
 
 	return node;
 }
@@ -786,4 +1353,150 @@ NE::NodeGroupPtr NodeManager::AddNodeGroup (const NodeGroupPtr& group, IdPolicy
 	return group;
 }
 
+const EvaluationPlan& NodeManager::GetEvaluationPlan () const
+{
+	if (evaluationPlan->IsValid ()) {
+		return *evaluationPlan;
+	}
+
+	std::vector<NodeConstPtr> sortedNodes;
+	sortedNodes.reserve (nodeList.Count ());
+	ForEachNode ([&] (NodeConstPtr node) {
+		sortedNodes.push_back (node);
+		return true;
+	});
+	std::sort (sortedNodes.begin (), sortedNodes.end (), [&] (const NodeConstPtr& a, const NodeConstPtr& b) {
+		return topologicalOrder.GetOrder (a->GetId ()) < topologicalOrder.GetOrder (b->GetId ());
+	});
+
+	NodeManagerEvaluationPlanGraph graph (connectionManager);
+	evaluationPlan->Build (sortedNodes, graph);
+	for (size_t nodeIndex = 0; nodeIndex < sortedNodes.size (); nodeIndex++) {
+		sortedNodes[nodeIndex]->evaluationPlanIndex = nodeIndex;
+	}
+
+	return *evaluationPlan;
+}
+
+void NodeManager::InvalidateEvaluationPlan () const
+{
+	// the plan may be shared with evaluation snapshots, in this case it is
+	// replaced instead of modified, the stamp continues from the old plan
+	if (evaluationPlan.use_count () > 1) {
+		evaluationPlan.reset (new EvaluationPlan (evaluationPlan->GetBuildStamp ()));
+	}
+	evaluationPlan->Invalidate ();
+}
+
+bool NodeManager::IsNodeValueEvictable (const Node& node) const
+{
+	// values of thread unsafe nodes and nodes without connected
+	// output slots (viewers and other sinks) are always kept
+	if (!node.IsThreadSafe ()) {
+		return false;
+	}
+	bool hasConnectedOutputSlots = false;
+	node.ForEachOutputSlot ([&] (const OutputSlotConstPtr& outputSlot) {
+		hasConnectedOutputSlots = HasConnectedInputSlots (outputSlot);
+		return !hasConnectedOutputSlots;
+	});
+	return hasConnectedOutputSlots;
+}
+
+size_t NodeManager::GetNodePlanIndex (const Node& node) const
+{
+	size_t planIndex = node.evaluationPlanIndex;
+	if (!evaluationPlan->IsValid () || planIndex >= evaluationPlan->GetNodeCount () || evaluationPlan->GetNode (planIndex).get () != &node) {
+		return InvalidEvaluationPlanIndex;
+	}
+	return planIndex;
+}
+
+EvaluationEnv NodeManager::CreateEvaluationPassEnv (const EvaluationEnv& env) const
+{
+	// the arena lives until the end of the pass, the values kept after
+	// the pass are copied out of it by the nodes
+	EvaluationEnv passEnv (env);
+	if (isEvaluationArenaEnabled && !env.HasArena ()) {
+		passEnv.SetArena (EvaluationArenaPtr (new EvaluationArena ()));
+	}
+	return passEnv;
+}
+
+void NodeManager::EvaluateNodesParallel (const std::vector<size_t>& planIndices, EvaluationEnv& env) const
+{
+	const EvaluationPlan& plan = GetEvaluationPlan ();
+	std::vector<NodeConstPtr> nodesToCalculate;
+	std::vector<size_t> planIndexToTaskIndex (plan.GetNodeCount (), InvalidEvaluationPlanIndex);
+	for (size_t planIndex : planIndices) {
+		const NodeConstPtr& node = plan.GetNode (planIndex);
+		if (node->GetCalculationStatus () == Node::CalculationStatus::NeedToCalculate) {
+			planIndexToTaskIndex[planIndex] = nodesToCalculate.size ();
+			nodesToCalculate.push_back (node);
+		}
+	}
+	if (nodesToCalculate.empty ()) {
+		return;
+	}
+
+	size_t nodeCount = nodesToCalculate.size ();
+	std::vector<std::vector<size_t>> successors (nodeCount);
+	std::unique_ptr<std::atomic<size_t>[]> remainingPredecessors (new std::atomic<size_t>[nodeCount]);
+	for (size_t nodeIndex = 0; nodeIndex < nodeCount; nodeIndex++) {
+		size_t predecessorCount = 0;
+		plan.EnumeratePredecessors (nodesToCalculate[nodeIndex]->evaluationPlanIndex, [&] (size_t predecessorPlanIndex) {
+			size_t predecessorIndex = planIndexToTaskIndex[predecessorPlanIndex];
+			if (predecessorIndex != InvalidEvaluationPlanIndex) {
+				successors[predecessorIndex].push_back (nodeIndex);
+				predecessorCount++;
+			}
+		});
+		remainingPredecessors[nodeIndex] = predecessorCount;
+	}
+
+	if (threadPool == nullptr) {
+		threadPool.reset (new ThreadPool (ThreadPool::GetDefaultThreadCount ()));
+	}
+
+	std::vector<ValueHandle> calculatedValues (nodeCount);
+	std::function<ThreadPool::Task (size_t)> createTask = [&] (size_t nodeIndex) -> ThreadPool::Task {
+		return [&, nodeIndex] (size_t threadIndex) {
+			calculatedValues[nodeIndex] = nodesToCalculate[nodeIndex]->Evaluate (env);
+			for (size_t successorIndex : successors[nodeIndex]) {
+				if (--remainingPredecessors[successorIndex] > 0) {
+					continue;
+				}
+				if (nodesToCalculate[successorIndex]->IsThreadSafe ()) {
+					threadPool->Spawn (threadIndex, createTask (successorIndex));
+				} else {
+					threadPool->SpawnOnCallerThread (createTask (successorIndex));
+				}
+			}
+		};
+	};
+
+	std::vector<ThreadPool::Task> tasks;
+	std::vector<ThreadPool::Task> callerThreadTasks;
+	for (size_t nodeIndex = 0; nodeIndex < nodeCount; nodeIndex++) {
+		if (remainingPredecessors[nodeIndex] > 0) {
+			continue;
+		}
+		if (nodesToCalculate[nodeIndex]->IsThreadSafe ()) {
+			tasks.push_back (createTask (nodeIndex));
+		} else {
+			callerThreadTasks.push_back (createTask (nodeIndex));
+		}
+	}
+	{
+		ValueGuard<bool> isParallelEvaluationInProgressGuard (isParallelEvaluationInProgress, true);
+		threadPool->Execute (tasks, callerThreadTasks);
+	}
+
+	// the processing of the values may touch the user interface, so
+	// it runs on the calling thread in the order of the evaluation plan
+	for (size_t nodeIndex = 0; nodeIndex < nodeCount; nodeIndex++) {
+		nodesToCalculate[nodeIndex]->ProcessCalculatedValue (calculatedValues[nodeIndex], env);
+	}
+}
+
 }
@@ -12,12 +12,24 @@
 #include "NE_NodeList.hpp"
 #include "NE_NodeGroupList.hpp"
 #include "NE_NodeValueCache.hpp"
+#include "NE_NodeValueMemo.hpp"
+#include "NE_EvaluationProfiler.hpp"
 #include "NE_UniqueIdGenerator.hpp"
+#include "NE_Stamp.hpp"
+#include "NE_TopologicalOrder.hpp"
+#include "NE_EvaluationPlan.hpp"
+#include "NE_EvaluationProgress.hpp"
+#include "NE_GraphStatistics.hpp"
 #include <functional>
+#include <memory>
+#include <chrono>
 
 namespace NE
 {
 
+class ThreadPool;
+class EvaluationSnapshot;
+
 class OutputSlotList
 {
 public:
@@ -45,6 +57,7 @@ class NodeManager
 	SERIALIZABLE;
 	friend class NodeManagerMerge;
 	friend class NodeManagerSerialization;
+	friend class NodeManagerNodeEvaluator;
 
 public:
 	enum class UpdateMode
@@ -53,6 +66,12 @@ public:
 		Manual		= 1
 	};
 
+	enum class EvaluationMode
+	{
+		Serial		= 0,
+		Parallel	= 1
+	};
+
 	NodeManager ();
 	NodeManager (const NodeManager& src) = delete;
 	NodeManager (NodeManager&& src) = delete;
@@ -66,10 +85,16 @@ public:
 	size_t					GetNodeCount () const;
 	size_t					GetNodeGroupCount () const;
 	size_t					GetConnectionCount () const;
+	GraphStatistics			GetGraphStatistics () const;
 
 	void					EnumerateNodes (const std::function<bool (NodePtr)>& processor);
 	void					EnumerateNodes (const std::function<bool (NodeConstPtr)>& processor) const;
 
+	template <typename Processor>
+	void					ForEachNode (Processor&& processor);
+	template <typename Processor>
+	void					ForEachNode (Processor&& processor) const;
+
 	bool					ContainsNode (const NodeId& id) const;
 	NodeConstPtr			GetNode (const NodeId& id) const;
 
@@ -102,8 +127,23 @@ public:
 	void					EnumerateConnections (const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const;
 	void					EnumerateConnections (const NodeCollection& nodes, const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const;
 
+	template <typename Processor>
+	void					ForEachConnectedOutputSlot (const InputSlotConstPtr& inputSlot, Processor&& processor) const;
+	template <typename Processor>
+	void					ForEachConnectedInputSlot (const OutputSlotConstPtr& outputSlot, Processor&& processor) const;
+	template <typename Processor>
+	void					ForEachConnection (Processor&& processor) const;
+	template <typename Processor>
+	void					ForEachConnection (const NodeCollection& nodes, Processor&& processor) const;
+
 	void					EvaluateAllNodes (EvaluationEnv& env) const;
+	EvaluationProgress		EvaluateAllNodes (EvaluationEnv& env, std::chrono::microseconds timeBudget) const;
+	bool					IsEvaluationInProgress () const;
+	void					CancelEvaluation () const;
+	bool					CreateEvaluationSnapshot (EvaluationSnapshot& snapshot) const;
+	NodeCollection			PublishEvaluationSnapshot (const EvaluationSnapshot& snapshot, EvaluationEnv& env) const;
 	void					ForceEvaluateAllNodes (EvaluationEnv& env) const;
+	void					EvaluateNodes (const NodeCollection& nodes, EvaluationEnv& env) const;
 	void					InvalidateNodeValue (const NodeId& nodeId) const;
 	void					InvalidateNodeValue (const NodeConstPtr& node) const;
 	
@@ -133,6 +173,23 @@ public:
 	bool					IsCalculationEnabled () const;
 	UpdateMode				GetUpdateMode () const;
 	void					SetUpdateMode (UpdateMode newUpdateMode);
+	EvaluationMode			GetEvaluationMode () const;
+	void					SetEvaluationMode (EvaluationMode newEvaluationMode);
+	bool					IsEvaluationArenaEnabled () const;
+	void					SetEvaluationArenaEnabled (bool newIsEvaluationArenaEnabled);
+	size_t					GetValueCacheBudget () const;
+	void					SetValueCacheBudget (size_t newValueCacheBudget);
+	NodeValueCacheStatistics	GetValueCacheStatistics () const;
+	size_t					GetValueMemoBudget () const;
+	void					SetValueMemoBudget (size_t newValueMemoBudget);
+	size_t					GetValueMemoUsage () const;
+	void					ClearValueMemo () const;
+	Stream::Status			ReadValueMemo (InputStream& inputStream) const;
+	Stream::Status			WriteValueMemo (OutputStream& outputStream) const;
+	bool					IsProfilingEnabled () const;
+	void					SetProfilingEnabled (bool newIsProfilingEnabled);
+	const EvaluationProfiler&	GetEvaluationProfiler () const;
+	void					ClearEvaluationProfiler ();
 
 	Stream::Status			Read (InputStream& inputStream);
 	Stream::Status			Write (OutputStream& outputStream) const;
@@ -142,6 +199,28 @@ public:
 	static bool				WriteToBuffer (const NodeManager& nodeManager, std::vector<char>& buffer);
 
 private:
+	class EvaluationPass
+	{
+	public:
+		EvaluationPass ();
+
+		void						Start (const std::vector<size_t>& newPlanIndices, const Stamp& newPlanStamp, const Stamp& newInvalidationStamp);
+		void						Cancel ();
+		void						Advance (size_t count);
+
+		bool						IsInProgress () const;
+		bool						IsInProgress (const Stamp& currentPlanStamp, const Stamp& currentInvalidationStamp) const;
+		const std::vector<size_t>&	GetPlanIndices () const;
+		size_t						GetPosition () const;
+
+	private:
+		std::vector<size_t>		planIndices;
+		size_t					position;
+		Stamp					planStamp;
+		Stamp					invalidationStamp;
+		bool					isInProgress;
+	};
+
 	enum class IdPolicy
 	{
 		KeepOriginal,
@@ -154,21 +233,96 @@ private:
 		DoNotInitialize
 	};
 
-	NodePtr				AddNode (const NodePtr& node, IdPolicy idHandling, InitPolicy initPolicy);
-	NodeGroupPtr		AddNodeGroup (const NodeGroupPtr& group, IdPolicy idHandling);
-	void				MakeNodesAndGroupsSorted ();
+	NodePtr					AddNode (const NodePtr& node, IdPolicy idHandling, InitPolicy initPolicy);
+	NodeGroupPtr			AddNodeGroup (const NodeGroupPtr& group, IdPolicy idHandling);
+	void					MakeNodesAndGroupsSorted ();
+
+	const EvaluationPlan&	GetEvaluationPlan () const;
+	void					InvalidateEvaluationPlan () const;
+	bool					IsNodeValueEvictable (const Node& node) const;
+	size_t					GetNodePlanIndex (const Node& node) const;
+	void					EvaluateNodesParallel (const std::vector<size_t>& planIndices, EvaluationEnv& env) const;
+	EvaluationEnv			CreateEvaluationPassEnv (const EvaluationEnv& env) const;
 
 	UniqueIdGenerator						idGenerator;
 	NodeList								nodeList;
 	ConnectionManager						connectionManager;
 	NodeGroupList							nodeGroupList;
+	TopologicalOrder						topologicalOrder;
 	UpdateMode								updateMode;
+	EvaluationMode							evaluationMode;
+	bool									isEvaluationArenaEnabled;
 
+	mutable std::shared_ptr<EvaluationPlan>	evaluationPlan;
+	mutable EvaluationPass					evaluationPass;
+	mutable Stamp							invalidationStamp;
 	mutable NodeValueCache					nodeValueCache;
+	std::shared_ptr<NodeValueMemo>			nodeValueMemo;
+	std::shared_ptr<EvaluationProfiler>		evaluationProfiler;
 	mutable NodeEvaluatorConstPtr			nodeEvaluator;
 	mutable bool							isForceCalculate;
+	mutable bool							isParallelEvaluationInProgress;
+	mutable std::vector<ValueHandle>*		passValues;
+	mutable Stamp							traversalStamp;
+	mutable size_t							traversalDepth;
+	mutable std::unique_ptr<ThreadPool>		threadPool;
 };
 
+template <typename Processor>
+void NodeManager::ForEachNode (Processor&& processor)
+{
+	nodeList.ForEach (processor);
+}
+
+template <typename Processor>
+void NodeManager::ForEachNode (Processor&& processor) const
+{
+	nodeList.ForEach (processor);
+}
+
+template <typename Processor>
+void NodeManager::ForEachConnectedOutputSlot (const InputSlotConstPtr& inputSlot, Processor&& processor) const
+{
+	connectionManager.ForEachConnectedOutputSlot (inputSlot, processor);
+}
+
+template <typename Processor>
+void NodeManager::ForEachConnectedInputSlot (const OutputSlotConstPtr& outputSlot, Processor&& processor) const
+{
+	connectionManager.ForEachConnectedInputSlot (outputSlot, processor);
+}
+
+template <typename Processor>
+void NodeManager::ForEachConnection (Processor&& processor) const
+{
+	nodeList.ForEach ([&] (const NodeConstPtr& node) {
+		node->ForEachOutputSlot ([&] (const OutputSlotConstPtr& outputSlot) {
+			connectionManager.ForEachConnectedInputSlot (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+				processor (outputSlot, inputSlot);
+			});
+			return true;
+		});
+		return true;
+	});
+}
+
+template <typename Processor>
+void NodeManager::ForEachConnection (const NodeCollection& nodes, Processor&& processor) const
+{
+	nodes.ForEach ([&] (const NodeId& nodeId) {
+		NodeConstPtr node = GetNode (nodeId);
+		node->ForEachOutputSlot ([&] (const OutputSlotConstPtr& outputSlot) {
+			connectionManager.ForEachConnectedInputSlot (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+				if (nodes.Contains (inputSlot->GetOwnerNodeId ())) {
+					processor (outputSlot, inputSlot);
+				}
+			});
+			return true;
+		});
+		return true;
+	});
+}
+
 }
 
 #endif
@@ -119,7 +119,7 @@ void EmptyUpdateEventHandler::BeforeNodeDelete (const NodeId&)
 static std::vector<SlotInfo> GetConnectedOutputSlots (const NodeManager& nodeManager, const InputSlotConstPtr& inputSlot)
 {
 	std::vector<SlotInfo> result;
-	nodeManager.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+	nodeManager.ForEachConnectedOutputSlot (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
 		result.push_back (SlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ()));
 	});
 	return result;
@@ -129,7 +129,7 @@ bool NodeManagerMerge::AppendNodeManager (const NodeManager& source, NodeManager
 {
 	// collect nodes to create
 	NodeCollection nodesToClone;
-	source.EnumerateNodes ([&] (NodeConstPtr node) {
+	source.ForEachNode ([&] (NodeConstPtr node) {
 		NodeId nodeId = node->GetId ();
 		if (!nodeFilter.NeedToProcessSourceNode (nodeId)) {
 			return true;
@@ -140,7 +140,7 @@ bool NodeManagerMerge::AppendNodeManager (const NodeManager& source, NodeManager
 
 	// add nodes
 	std::unordered_map<NodeId, NodeId> oldToNewNodeIdTable;
-	nodesToClone.Enumerate ([&] (const NodeId& nodeId) {
+	nodesToClone.ForEach ([&] (const NodeId& nodeId) {
 		NodeConstPtr sourceNode = source.GetNode (nodeId);
 		NodePtr targetNode = Node::Clone (sourceNode);
 		target.AddNode (targetNode, NodeManager::IdPolicy::GenerateNew, NodeManager::InitPolicy::DoNotInitialize);
@@ -151,7 +151,7 @@ bool NodeManagerMerge::AppendNodeManager (const NodeManager& source, NodeManager
 
 	// maintain connections between added nodes
 	bool success = true;
-	source.EnumerateConnections (nodesToClone, [&] (const OutputSlotConstPtr& oldOutputSlot, const InputSlotConstPtr& oldInputSlot) {
+	source.ForEachConnection (nodesToClone, [&] (const OutputSlotConstPtr& oldOutputSlot, const InputSlotConstPtr& oldInputSlot) {
 		NodeConstPtr outputNode = target.GetNode (oldToNewNodeIdTable[oldOutputSlot->GetOwnerNodeId ()]);
 		NodeConstPtr inputNode = target.GetNode (oldToNewNodeIdTable[oldInputSlot->GetOwnerNodeId ()]);
 		if (DBGERROR (outputNode == nullptr || inputNode == nullptr)) {
@@ -178,7 +178,7 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 	// collect nodes to create or delete
 	std::vector<NodeId> nodesToCreate;
 	std::vector<NodeId> nodesToDelete;
-	source.EnumerateNodes ([&] (NodeConstPtr sourceNode) {
+	source.ForEachNode ([&] (NodeConstPtr sourceNode) {
 		if (target.ContainsNode (sourceNode->GetId ())) {
 			NodeConstPtr targetNode = target.GetNode (sourceNode->GetId ());
 			if (!Node::IsEqual (sourceNode, targetNode)) {
@@ -190,7 +190,7 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 		}
 		return true;
 	});
-	target.EnumerateNodes ([&] (NodeConstPtr targetNode) {
+	target.ForEachNode ([&] (NodeConstPtr targetNode) {
 		if (!source.ContainsNode (targetNode->GetId ())) {
 			nodesToDelete.push_back (targetNode->GetId ());
 		}
@@ -209,12 +209,12 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 
 	// collect input slots with changed connections
 	std::unordered_map<InputSlotConstPtr, std::vector<SlotInfo>> inputSlotsToReconnect;
-	target.EnumerateNodes ([&] (NodeConstPtr targetNode) {
+	target.ForEachNode ([&] (NodeConstPtr targetNode) {
 		if (!source.ContainsNode (targetNode->GetId ())) {
 			return true;
 		}
 		NodeConstPtr sourceNode = source.GetNode (targetNode->GetId ());
-		targetNode->EnumerateInputSlots ([&] (InputSlotConstPtr targetInputSlot) {
+		targetNode->ForEachInputSlot ([&] (InputSlotConstPtr targetInputSlot) {
 			if (!sourceNode->HasInputSlot (targetInputSlot->GetId ())) {
 				return true;
 			}
@@ -247,7 +247,7 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 		NodeGroupPtr targetGroup (NodeGroup::Clone (sourceGroup));
 		target.AddNodeGroup (targetGroup, NodeManager::IdPolicy::KeepOriginal);
 		const NodeCollection& sourceGroupNodes = source.GetGroupNodes (sourceGroup->GetId ());
-		sourceGroupNodes.Enumerate ([&] (const NodeId& sourceNodeId) {
+		sourceGroupNodes.ForEach ([&] (const NodeId& sourceNodeId) {
 			if (target.ContainsNode (sourceNodeId)) {
 				target.AddNodeToGroup (targetGroup->GetId (), sourceNodeId);
 			}
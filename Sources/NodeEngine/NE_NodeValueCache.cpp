@@ -4,7 +4,60 @@
 namespace NE
 {
 
-NodeValueCache::NodeValueCache ()
+NodeValueCacheStatistics::NodeValueCacheStatistics () :
+	NodeValueCacheStatistics (0, 0, 0, 0, 0)
+{
+
+}
+
+NodeValueCacheStatistics::NodeValueCacheStatistics (size_t hitCount, size_t missCount, size_t evictionCount, size_t valueCount, size_t memorySize) :
+	hitCount (hitCount),
+	missCount (missCount),
+	evictionCount (evictionCount),
+	valueCount (valueCount),
+	memorySize (memorySize)
+{
+
+}
+
+NodeValueCacheStatistics::~NodeValueCacheStatistics ()
+{
+
+}
+
+size_t NodeValueCacheStatistics::GetHitCount () const
+{
+	return hitCount;
+}
+
+size_t NodeValueCacheStatistics::GetMissCount () const
+{
+	return missCount;
+}
+
+size_t NodeValueCacheStatistics::GetEvictionCount () const
+{
+	return evictionCount;
+}
+
+size_t NodeValueCacheStatistics::GetValueCount () const
+{
+	return valueCount;
+}
+
+size_t NodeValueCacheStatistics::GetMemorySize () const
+{
+	return memorySize;
+}
+
+NodeValueCache::NodeValueCache () :
+	cache (),
+	evictableNodes (),
+	memoryBudget (0),
+	memorySize (0),
+	hitCount (0),
+	missCount (0),
+	evictionCount (0)
 {
 
 }
@@ -14,27 +67,70 @@ NodeValueCache::~NodeValueCache ()
 
 }
 
-bool NodeValueCache::Add (const NodeId& id, const ValueConstPtr& value)
+bool NodeValueCache::Add (const NodeId& id, const ValueHandle& value)
+{
+	return Add (id, value, false);
+}
+
+bool NodeValueCache::Add (const NodeId& id, const ValueHandle& value, bool isEvictable)
 {
 	if (DBGERROR (Contains (id))) {
 		return false;
 	}
-	cache.insert ({ id, value });
+	Entry entry = { value, value.GetMemorySize (), isEvictable, false, evictableNodes.end () };
+	if (isEvictable) {
+		entry.evictableIterator = evictableNodes.insert (evictableNodes.end (), id);
+	}
+	cache.insert ({ id, entry });
+	memorySize += entry.memorySize;
+	EvictValues ();
+	return true;
+}
+
+bool NodeValueCache::Restore (const NodeId& id, const ValueHandle& value)
+{
+	auto found = cache.find (id);
+	if (DBGERROR (found == cache.end ())) {
+		return false;
+	}
+	Entry& entry = found->second;
+	if (!entry.isEvicted) {
+		return false;
+	}
+	entry.value = value;
+	entry.memorySize = value.GetMemorySize ();
+	entry.isEvicted = false;
+	entry.evictableIterator = evictableNodes.insert (evictableNodes.end (), id);
+	memorySize += entry.memorySize;
+	EvictValues ();
 	return true;
 }
 
 bool NodeValueCache::Remove (const NodeId& id)
 {
-	if (DBGERROR (!Contains (id))) {
+	auto found = cache.find (id);
+	if (DBGERROR (found == cache.end ())) {
 		return false;
 	}
-	cache.erase (id);
+	Entry& entry = found->second;
+	if (entry.isEvictable && !entry.isEvicted) {
+		evictableNodes.erase (entry.evictableIterator);
+	}
+	if (!entry.isEvicted) {
+		memorySize -= entry.memorySize;
+	}
+	cache.erase (found);
 	return true;
 }
 
 void NodeValueCache::Clear ()
 {
-	return cache.clear ();
+	cache.clear ();
+	evictableNodes.clear ();
+	memorySize = 0;
+	hitCount = 0;
+	missCount = 0;
+	evictionCount = 0;
 }
 
 bool NodeValueCache::Contains (const NodeId& id) const
@@ -42,9 +138,61 @@ bool NodeValueCache::Contains (const NodeId& id) const
 	return cache.find (id) != cache.end ();
 }
 
-const ValueConstPtr& NodeValueCache::Get (const NodeId& id) const
+bool NodeValueCache::IsEvicted (const NodeId& id) const
+{
+	auto found = cache.find (id);
+	if (found == cache.end ()) {
+		return false;
+	}
+	return found->second.isEvicted;
+}
+
+const ValueHandle& NodeValueCache::Get (const NodeId& id) const
 {
-	return cache.at (id);
+	const Entry& entry = cache.at (id);
+	if (entry.isEvicted) {
+		missCount++;
+	} else {
+		hitCount++;
+		if (entry.isEvictable) {
+			evictableNodes.splice (evictableNodes.end (), evictableNodes, entry.evictableIterator);
+		}
+	}
+	return entry.value;
+}
+
+size_t NodeValueCache::GetMemoryBudget () const
+{
+	return memoryBudget;
+}
+
+void NodeValueCache::SetMemoryBudget (size_t newMemoryBudget)
+{
+	memoryBudget = newMemoryBudget;
+	EvictValues ();
+}
+
+NodeValueCacheStatistics NodeValueCache::GetStatistics () const
+{
+	return NodeValueCacheStatistics (hitCount, missCount, evictionCount, cache.size (), memorySize);
+}
+
+void NodeValueCache::EvictValues ()
+{
+	// only evictable values are released, the node stays calculated and
+	// its value is calculated again when it is needed the next time
+	if (memoryBudget == 0) {
+		return;
+	}
+	while (memorySize > memoryBudget && !evictableNodes.empty ()) {
+		Entry& entry = cache.at (evictableNodes.front ());
+		entry.value = nullptr;
+		entry.isEvicted = true;
+		entry.evictableIterator = evictableNodes.end ();
+		memorySize -= entry.memorySize;
+		evictableNodes.pop_front ();
+		evictionCount++;
+	}
 }
 
 }
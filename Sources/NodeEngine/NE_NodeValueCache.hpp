@@ -2,27 +2,75 @@
 #define NE_NODEVALUECACHE_HPP
 
 #include "NE_NodeId.hpp"
-#include "NE_Value.hpp"
+#include "NE_ValueHandle.hpp"
 #include <unordered_map>
+#include <list>
 
 namespace NE
 {
 
+class NodeValueCacheStatistics
+{
+public:
+	NodeValueCacheStatistics ();
+	NodeValueCacheStatistics (size_t hitCount, size_t missCount, size_t evictionCount, size_t valueCount, size_t memorySize);
+	~NodeValueCacheStatistics ();
+
+	size_t	GetHitCount () const;
+	size_t	GetMissCount () const;
+	size_t	GetEvictionCount () const;
+	size_t	GetValueCount () const;
+	size_t	GetMemorySize () const;
+
+private:
+	size_t	hitCount;
+	size_t	missCount;
+	size_t	evictionCount;
+	size_t	valueCount;
+	size_t	memorySize;
+};
+
 class NodeValueCache
 {
 public:
 	NodeValueCache ();
 	~NodeValueCache ();
 
-	bool					Add (const NodeId& id, const ValueConstPtr& value);
-	bool					Remove (const NodeId& id);
-	void					Clear ();
+	bool						Add (const NodeId& id, const ValueHandle& value);
+	bool						Add (const NodeId& id, const ValueHandle& value, bool isEvictable);
+	bool						Restore (const NodeId& id, const ValueHandle& value);
+	bool						Remove (const NodeId& id);
+	void						Clear ();
 	
-	bool					Contains (const NodeId& id) const;
-	const ValueConstPtr&	Get (const NodeId& id) const;
+	bool						Contains (const NodeId& id) const;
+	bool						IsEvicted (const NodeId& id) const;
+	const ValueHandle&			Get (const NodeId& id) const;
+
+	size_t						GetMemoryBudget () const;
+	void						SetMemoryBudget (size_t newMemoryBudget);
+	NodeValueCacheStatistics	GetStatistics () const;
 
 private:
-	std::unordered_map<NodeId, ValueConstPtr>	cache;
+	using NodeIdIterator = std::list<NodeId>::iterator;
+
+	struct Entry
+	{
+		ValueHandle		value;
+		size_t			memorySize;
+		bool			isEvictable;
+		bool			isEvicted;
+		NodeIdIterator	evictableIterator;
+	};
+
+	void									EvictValues ();
+
+	std::unordered_map<NodeId, Entry>		cache;
+	mutable std::list<NodeId>				evictableNodes;
+	size_t									memoryBudget;
+	size_t									memorySize;
+	mutable size_t							hitCount;
+	mutable size_t							missCount;
+	size_t									evictionCount;
 };
 
 }
@@ -0,0 +1,196 @@
+#include "NE_NodeValueMemo.hpp"
+#include "NE_Debug.hpp"
+#include "NE_Utils.hpp"
+
+namespace NE
+{
+
+SERIALIZATION_INFO (NodeValueMemo, 3);
+
+static const size_t MemoEntryOverhead = 128;
+
+static uint64_t CalculateFnvHash (const std::vector<char>& data)
+{
+	return CalculateFnvHash (data.data (), data.size ());
+}
+
+static Stream::Status SkipLegacyFingerprint (InputStream& inputStream)
+{
+	// the first version stored only two hashes and the data size
+	size_t hashPart = 0;
+	for (size_t i = 0; i < 4; i++) {
+		inputStream.Read (hashPart);
+	}
+	size_t dataSize = 0;
+	inputStream.Read (dataSize);
+	return inputStream.GetStatus ();
+}
+
+NodeValueFingerprint::NodeValueFingerprint () :
+	hash (CalculateFnvHash (std::vector<char> ())),
+	data (new std::vector<char> ())
+{
+
+}
+
+NodeValueFingerprint::NodeValueFingerprint (const std::vector<char>& data) :
+	hash (CalculateFnvHash (data)),
+	data (new std::vector<char> (data))
+{
+
+}
+
+NodeValueFingerprint::~NodeValueFingerprint ()
+{
+
+}
+
+bool NodeValueFingerprint::operator== (const NodeValueFingerprint& rhs) const
+{
+	return hash == rhs.hash && (data == rhs.data || *data == *rhs.data);
+}
+
+bool NodeValueFingerprint::operator!= (const NodeValueFingerprint& rhs) const
+{
+	return !operator== (rhs);
+}
+
+size_t NodeValueFingerprint::GenerateHashValue () const
+{
+	return (size_t) hash;
+}
+
+size_t NodeValueFingerprint::GetMemorySize () const
+{
+	return sizeof (NodeValueFingerprint) + data->size ();
+}
+
+Stream::Status NodeValueFingerprint::Read (InputStream& inputStream)
+{
+	size_t dataSize = 0;
+	if (inputStream.Read (dataSize) != Stream::Status::NoError) {
+		return inputStream.GetStatus ();
+	}
+	std::vector<char> newData (dataSize);
+	for (char& byte : newData) {
+		inputStream.Read (byte);
+	}
+	hash = CalculateFnvHash (newData);
+	data.reset (new std::vector<char> (std::move (newData)));
+	return inputStream.GetStatus ();
+}
+
+Stream::Status NodeValueFingerprint::Write (OutputStream& outputStream) const
+{
+	outputStream.Write (data->size ());
+	for (char byte : *data) {
+		outputStream.Write (byte);
+	}
+	return outputStream.GetStatus ();
+}
+
+NodeValueMemo::NodeValueMemo (size_t memoryBudget) :
+	mutex (),
+	cache (memoryBudget)
+{
+
+}
+
+NodeValueMemo::~NodeValueMemo ()
+{
+
+}
+
+size_t NodeValueMemo::GetMemoryBudget () const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return cache.GetMaxSize ();
+}
+
+void NodeValueMemo::SetMemoryBudget (size_t newMemoryBudget)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	cache.SetMaxSize (newMemoryBudget);
+}
+
+size_t NodeValueMemo::GetMemoryUsage () const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return cache.GetSize ();
+}
+
+size_t NodeValueMemo::GetValueCount () const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return cache.Count ();
+}
+
+void NodeValueMemo::Clear ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	cache.Clear ();
+}
+
+bool NodeValueMemo::Get (const NodeValueFingerprint& fingerprint, ValueHandle& value)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	if (!cache.Contains (fingerprint)) {
+		return false;
+	}
+	value = cache.Get (fingerprint);
+	return true;
+}
+
+bool NodeValueMemo::Add (const NodeValueFingerprint& fingerprint, const ValueHandle& value)
+{
+	if (DBGERROR (value == nullptr)) {
+		return false;
+	}
+
+	size_t valueSize = value.GetMemorySize () + fingerprint.GetMemorySize () + MemoEntryOverhead;
+	std::lock_guard<std::mutex> lock (mutex);
+	return cache.Add (fingerprint, value, valueSize);
+}
+
+Stream::Status NodeValueMemo::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	size_t valueCount = 0;
+	inputStream.Read (valueCount);
+	for (size_t i = 0; i < valueCount; i++) {
+		// values of the first version can't be verified, and the fingerprints before the
+		// third version hold the whole node and input values, so they are skipped
+		NodeValueFingerprint fingerprint;
+		bool isLegacy = (header.GetVersion () < 2);
+		Stream::Status fingerprintStatus = (isLegacy ? SkipLegacyFingerprint (inputStream) : fingerprint.Read (inputStream));
+		if (fingerprintStatus != Stream::Status::NoError) {
+			return Stream::Status::Error;
+		}
+		ValueConstPtr value (ReadDynamicObject<Value> (inputStream));
+		if (value == nullptr || inputStream.GetStatus () != Stream::Status::NoError) {
+			return Stream::Status::Error;
+		}
+		if (header.GetVersion () >= 3) {
+			Add (fingerprint, value);
+		}
+	}
+	return inputStream.GetStatus ();
+}
+
+Stream::Status NodeValueMemo::Write (OutputStream& outputStream) const
+{
+	// values are written from the least recently used one, so reading
+	// them back in the same order restores the eviction order
+	std::lock_guard<std::mutex> lock (mutex);
+	ObjectHeader header (outputStream, serializationInfo);
+	outputStream.Write (cache.Count ());
+	cache.Enumerate ([&] (const NodeValueFingerprint& fingerprint, const ValueHandle& value) {
+		// inline scalars are boxed only for writing them
+		ValueConstPtr boxedValue = value.GetValue ();
+		fingerprint.Write (outputStream);
+		WriteDynamicObject (outputStream, boxedValue.get ());
+	});
+	return outputStream.GetStatus ();
+}
+
+}
@@ -0,0 +1,86 @@
+#ifndef NE_NODEVALUEMEMO_HPP
+#define NE_NODEVALUEMEMO_HPP
+
+#include "NE_ValueHandle.hpp"
+#include "NE_Cache.hpp"
+#include "NE_Serializable.hpp"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+namespace NE
+{
+
+// the fingerprint keeps the whole data it is created from, so values
+// are found only for the same data, not just for the same hash
+class NodeValueFingerprint
+{
+public:
+	NodeValueFingerprint ();
+	NodeValueFingerprint (const std::vector<char>& data);
+	~NodeValueFingerprint ();
+
+	bool				operator== (const NodeValueFingerprint& rhs) const;
+	bool				operator!= (const NodeValueFingerprint& rhs) const;
+
+	size_t				GenerateHashValue () const;
+	size_t				GetMemorySize () const;
+
+	Stream::Status		Read (InputStream& inputStream);
+	Stream::Status		Write (OutputStream& outputStream) const;
+
+private:
+	uint64_t									hash;
+	std::shared_ptr<const std::vector<char>>	data;
+};
+
+}
+
+namespace std
+{
+	template <>
+	struct hash<NE::NodeValueFingerprint>
+	{
+		size_t operator() (const NE::NodeValueFingerprint& fingerprint) const noexcept
+		{
+			return fingerprint.GenerateHashValue ();
+		}
+	};
+}
+
+namespace NE
+{
+
+class NodeValueMemo
+{
+	SERIALIZABLE;
+
+public:
+	NodeValueMemo (size_t memoryBudget);
+	NodeValueMemo (const NodeValueMemo& src) = delete;
+	~NodeValueMemo ();
+
+	NodeValueMemo&	operator= (const NodeValueMemo& rhs) = delete;
+
+	size_t			GetMemoryBudget () const;
+	void			SetMemoryBudget (size_t newMemoryBudget);
+	size_t			GetMemoryUsage () const;
+	size_t			GetValueCount () const;
+	void			Clear ();
+
+	bool			Get (const NodeValueFingerprint& fingerprint, ValueHandle& value);
+	bool			Add (const NodeValueFingerprint& fingerprint, const ValueHandle& value);
+
+	Stream::Status	Read (InputStream& inputStream);
+	Stream::Status	Write (OutputStream& outputStream) const;
+
+private:
+	mutable std::mutex								mutex;
+	Cache<NodeValueFingerprint, ValueHandle>		cache;
+};
+
+}
+
+#endif
@@ -4,7 +4,7 @@
 #include "NE_Debug.hpp"
 
 #include <utility>
-#include <list>
+#include <vector>
 #include <unordered_map>
 #include <functional>
 #include <algorithm>
@@ -12,6 +12,9 @@
 namespace NE
 {
 
+// values are stored in a vector in insertion order, erased values leave a tombstone
+// behind, tombstones are removed when they make up more than half of the storage,
+// inserting into the middle moves the entries only until the nearest tombstone
 template <typename Key, typename Value>
 class OrderedMap
 {
@@ -41,40 +44,56 @@ public:
 	void			Enumerate (const std::function<bool (Value&)>& processor);
 	void			Enumerate (const std::function<bool (const Value&)>& processor) const;
 
-private:
-	using KeyValue	= std::pair<Key, Value>;
-	using List		= std::list<KeyValue>;
-	using Iterator	= typename List::iterator;
+	template <typename Processor>
+	void			ForEach (Processor&& processor);
+	template <typename Processor>
+	void			ForEach (Processor&& processor) const;
 
-	List								valueList;
-	std::unordered_map<Key, Iterator>	keyToValueMap;
+private:
+	struct Entry
+	{
+		Key		key;
+		Value	value;
+		bool	isErased;
+	};
+
+	static const size_t MaxShiftDistance = 64;
+
+	void			InsertAtIndex (const Key& key, const Value& value, size_t index);
+	size_t			FindErasedIndex (size_t index) const;
+	void			UpdateIndices (size_t fromIndex, size_t toIndex);
+	void			Compact ();
+
+	std::vector<Entry>					entries;
+	size_t								erasedCount;
+	std::unordered_map<Key, size_t>		keyToIndexMap;
 };
 
 template <typename Key, typename Value>
 OrderedMap<Key, Value>::OrderedMap () :
-	valueList (),
-	keyToValueMap ()
+	entries (),
+	erasedCount (0),
+	keyToIndexMap ()
 {
 
 }
 
 template <typename Key, typename Value>
 OrderedMap<Key, Value>::OrderedMap (const OrderedMap& rhs) :
-	valueList (rhs.valueList),
-	keyToValueMap ()
+	entries (rhs.entries),
+	erasedCount (rhs.erasedCount),
+	keyToIndexMap (rhs.keyToIndexMap)
 {
-	for (auto it = valueList.begin (); it != valueList.end (); ++it) {
-		const KeyValue& keyValue = *it;
-		keyToValueMap.insert ({ keyValue.first, it });
-	}
+
 }
 
 template <typename Key, typename Value>
 OrderedMap<Key, Value>::OrderedMap (OrderedMap&& rhs) :
-	valueList (std::move (rhs.valueList)),
-	keyToValueMap (std::move (rhs.keyToValueMap))
+	entries (std::move (rhs.entries)),
+	erasedCount (rhs.erasedCount),
+	keyToIndexMap (std::move (rhs.keyToIndexMap))
 {
-	
+	rhs.Clear ();
 }
 
 template <typename Key, typename Value>
@@ -87,12 +106,9 @@ template <typename Key, typename Value>
 OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (const OrderedMap& rhs)
 {
 	if (this != &rhs) {
-		valueList = rhs.valueList;
-		keyToValueMap.clear ();
-		for (auto it = valueList.begin (); it != valueList.end (); ++it) {
-			const KeyValue& keyValue = *it;
-			keyToValueMap.insert ({ keyValue.first, it });
-		}
+		entries = rhs.entries;
+		erasedCount = rhs.erasedCount;
+		keyToIndexMap = rhs.keyToIndexMap;
 	}
 	return *this;
 }
@@ -101,8 +117,10 @@ template <typename Key, typename Value>
 OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (OrderedMap&& rhs)
 {
 	if (this != &rhs) {
-		valueList = std::move (rhs.valueList);
-		keyToValueMap = std::move (rhs.keyToValueMap);
+		entries = std::move (rhs.entries);
+		erasedCount = rhs.erasedCount;
+		keyToIndexMap = std::move (rhs.keyToIndexMap);
+		rhs.Clear ();
 	}
 	return *this;
 }
@@ -110,131 +128,245 @@ OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (OrderedMap&& rhs)
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::IsEmpty () const
 {
-	return keyToValueMap.empty ();
+	return keyToIndexMap.empty ();
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::Contains (const Key& key) const
 {
-	return keyToValueMap.find (key) != keyToValueMap.end ();
+	return keyToIndexMap.find (key) != keyToIndexMap.end ();
 }
 
 template <typename Key, typename Value>
 size_t OrderedMap<Key, Value>::Count () const
 {
-	return keyToValueMap.size ();
+	return keyToIndexMap.size ();
 }
 
 template <typename Key, typename Value>
 Value& OrderedMap<Key, Value>::GetValue (const Key& key)
 {
-	Iterator& iterator = keyToValueMap.at (key);
-	KeyValue& keyValue = *iterator;
-	return keyValue.second;
+	return entries[keyToIndexMap.at (key)].value;
 }
 
 template <typename Key, typename Value>
 const Value& OrderedMap<Key, Value>::GetValue (const Key& key) const
 {
-	const Iterator& iterator = keyToValueMap.at (key);
-	const KeyValue& keyValue = *iterator;
-	return keyValue.second;
+	return entries[keyToIndexMap.at (key)].value;
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::Insert (const Key& key, const Value& value)
 {
-	if (DBGERROR (keyToValueMap.find (key) != keyToValueMap.end ())) {
+	if (DBGERROR (keyToIndexMap.find (key) != keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto inserted = valueList.insert (valueList.end (), { key, value } );
-	keyToValueMap.insert ({ key, inserted });
+	keyToIndexMap.insert ({ key, entries.size () });
+	entries.push_back ({ key, value, false });
 	return true;
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::InsertBefore (const Key& key, const Value& value, const Key& nextKey)
 {
-	if (DBGERROR (keyToValueMap.find (key) != keyToValueMap.end ())) {
+	if (DBGERROR (keyToIndexMap.find (key) != keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto foundNextValue = keyToValueMap.find (nextKey);
-	if (DBGERROR (foundNextValue == keyToValueMap.end ())) {
+	auto foundNextValue = keyToIndexMap.find (nextKey);
+	if (DBGERROR (foundNextValue == keyToIndexMap.end ())) {
 		return false;
 	}
-	
-	auto inserted = valueList.insert (foundNextValue->second, { key, value });
-	keyToValueMap.insert ({ key, inserted });
+
+	InsertAtIndex (key, value, foundNextValue->second);
 	return true;
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::InsertAfter (const Key& key, const Value& value, const Key& prevKey)
 {
-	if (DBGERROR (keyToValueMap.find (key) != keyToValueMap.end ())) {
+	if (DBGERROR (keyToIndexMap.find (key) != keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto foundPrevValue = keyToValueMap.find (prevKey);
-	if (DBGERROR (foundPrevValue == keyToValueMap.end ())) {
+	auto foundPrevValue = keyToIndexMap.find (prevKey);
+	if (DBGERROR (foundPrevValue == keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto inserted = valueList.insert (std::next (foundPrevValue->second), { key, value });
-	keyToValueMap.insert ({ key, inserted });
+	InsertAtIndex (key, value, foundPrevValue->second + 1);
 	return true;
 }
 
 template <typename Key, typename Value>
 void OrderedMap<Key, Value>::MakeSorted ()
 {
-	valueList.sort ([&] (const KeyValue& a, const KeyValue& b) {
-		return a.first < b.first;
+	Compact ();
+	std::stable_sort (entries.begin (), entries.end (), [&] (const Entry& a, const Entry& b) {
+		return a.key < b.key;
 	});
+	UpdateIndices (0, entries.size ());
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::Erase (const Key& key)
 {
-	auto foundInMap = keyToValueMap.find (key);
-	if (DBGERROR (foundInMap == keyToValueMap.end ())) {
+	auto foundInMap = keyToIndexMap.find (key);
+	if (DBGERROR (foundInMap == keyToIndexMap.end ())) {
 		return false;
 	}
 
-	valueList.erase (foundInMap->second);
-	keyToValueMap.erase (key);
+	Entry& entry = entries[foundInMap->second];
+	entry.value = Value ();
+	entry.isErased = true;
+	erasedCount++;
+	keyToIndexMap.erase (foundInMap);
+
+	while (!entries.empty () && entries.back ().isErased) {
+		entries.pop_back ();
+		erasedCount--;
+	}
+	if (erasedCount > entries.size () / 2) {
+		Compact ();
+	}
 	return true;
 }
 
 template <typename Key, typename Value>
 void OrderedMap<Key, Value>::Clear ()
 {
-	valueList.clear ();
-	keyToValueMap.clear ();
+	entries.clear ();
+	erasedCount = 0;
+	keyToIndexMap.clear ();
 }
 
 template <typename Key, typename Value>
 void OrderedMap<Key, Value>::Enumerate (const std::function<bool (Value&)>& processor)
 {
-	for (KeyValue& keyValue : valueList) {
-		if (!processor (keyValue.second)) {
+	ForEach (processor);
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::Enumerate (const std::function<bool (const Value&)>& processor) const
+{
+	ForEach (processor);
+}
+
+template <typename Key, typename Value>
+template <typename Processor>
+void OrderedMap<Key, Value>::ForEach (Processor&& processor)
+{
+	for (size_t i = 0; i < entries.size (); ++i) {
+		Entry& entry = entries[i];
+		if (entry.isErased) {
+			continue;
+		}
+		if (!processor (entry.value)) {
 			break;
 		}
 	}
 }
 
 template <typename Key, typename Value>
-void OrderedMap<Key, Value>::Enumerate (const std::function<bool (const Value&)>& processor) const
+template <typename Processor>
+void OrderedMap<Key, Value>::ForEach (Processor&& processor) const
 {
-	for (const KeyValue& keyValue : valueList) {
-		if (!processor (keyValue.second)) {
+	for (size_t i = 0; i < entries.size (); ++i) {
+		const Entry& entry = entries[i];
+		if (entry.isErased) {
+			continue;
+		}
+		if (!processor (entry.value)) {
 			break;
 		}
 	}
 }
 
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::InsertAtIndex (const Key& key, const Value& value, size_t index)
+{
+	if (index == entries.size ()) {
+		keyToIndexMap.insert ({ key, index });
+		entries.push_back ({ key, value, false });
+		return;
+	}
+
+	size_t erasedIndex = FindErasedIndex (index);
+	if (erasedIndex == entries.size ()) {
+		// make room for the following inserts, so they don't have to move the whole storage
+		size_t gapSize = entries.size () / 16 + 1;
+		if (gapSize > MaxShiftDistance) {
+			gapSize = MaxShiftDistance;
+		}
+		entries.insert (entries.begin () + index, gapSize, { key, Value (), true });
+		erasedCount += gapSize;
+		UpdateIndices (index + gapSize, entries.size ());
+		erasedIndex = index;
+	}
+
+	size_t insertIndex = index;
+	if (erasedIndex >= index) {
+		std::move_backward (entries.begin () + index, entries.begin () + erasedIndex, entries.begin () + erasedIndex + 1);
+		UpdateIndices (index + 1, erasedIndex + 1);
+	} else {
+		std::move (entries.begin () + erasedIndex + 1, entries.begin () + index, entries.begin () + erasedIndex);
+		UpdateIndices (erasedIndex, index - 1);
+		insertIndex = index - 1;
+	}
+
+	entries[insertIndex] = { key, value, false };
+	erasedCount--;
+	keyToIndexMap.insert ({ key, insertIndex });
+}
+
+template <typename Key, typename Value>
+size_t OrderedMap<Key, Value>::FindErasedIndex (size_t index) const
+{
+	if (erasedCount == 0) {
+		return entries.size ();
+	}
+	for (size_t distance = 0; distance <= MaxShiftDistance; ++distance) {
+		if (distance > 0 && distance <= index && entries[index - distance].isErased) {
+			return index - distance;
+		}
+		if (index + distance < entries.size () && entries[index + distance].isErased) {
+			return index + distance;
+		}
+	}
+	return entries.size ();
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::UpdateIndices (size_t fromIndex, size_t toIndex)
+{
+	for (size_t i = fromIndex; i < toIndex; ++i) {
+		const Entry& entry = entries[i];
+		if (!entry.isErased) {
+			keyToIndexMap.find (entry.key)->second = i;
+		}
+	}
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::Compact ()
+{
+	if (erasedCount == 0) {
+		return;
+	}
+
+	size_t firstErasedIndex = 0;
+	while (!entries[firstErasedIndex].isErased) {
+		firstErasedIndex++;
+	}
+	auto newEnd = std::remove_if (entries.begin () + firstErasedIndex, entries.end (), [&] (const Entry& entry) {
+		return entry.isErased;
+	});
+	entries.erase (newEnd, entries.end ());
+	erasedCount = 0;
+	UpdateIndices (firstErasedIndex, entries.size ());
+}
+
 }
 
 #endif
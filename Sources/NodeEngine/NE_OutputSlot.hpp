@@ -2,7 +2,7 @@
 #define NE_OUTPUTSLOT_HPP
 
 #include "NE_Slot.hpp"
-#include "NE_Value.hpp"
+#include "NE_ValueHandle.hpp"
 
 namespace NE
 {
@@ -16,13 +16,13 @@ public:
 	OutputSlot (const SlotId& id);
 	virtual ~OutputSlot ();
 
-	virtual ValueConstPtr	Evaluate (EvaluationEnv& env) const;
+	virtual ValueHandle		Evaluate (EvaluationEnv& env) const;
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
 
 protected:
-	ValueConstPtr			EvaluateOwnerNode (EvaluationEnv& env) const;
+	ValueHandle				EvaluateOwnerNode (EvaluationEnv& env) const;
 };
 
 }
@@ -17,19 +17,16 @@ public:
 		if (DBGERROR (serializationInfo == nullptr)) {
 			return;
 		}
-		const ObjectId& objectId = serializationInfo->GetObjectId ();
-		if (DBGERROR (objectMap.find (objectId) != objectMap.end ())) {
-			return;
-		}
-		objectMap.insert ({ objectId, serializationInfo });
+		DBGVERIFY (objectMap.insert ({ serializationInfo->GetObjectId (), serializationInfo }).second);
 	}
 
 	const DynamicSerializationInfo* GetSerializationInfo (const ObjectId& objectId)
 	{
-		if (DBGERROR (objectMap.find (objectId) == objectMap.end ())) {
+		auto found = objectMap.find (objectId);
+		if (DBGERROR (found == objectMap.end ())) {
 			return nullptr;
 		}
-		return objectMap[objectId];
+		return found->second;
 	}
 
 private:
@@ -44,7 +41,7 @@ static ObjectRegistry& GetObjectRegistry ()
 
 
 ObjectId::ObjectId () :
-	id ("")
+	id ()
 {
 
 }
@@ -62,18 +59,20 @@ ObjectId::~ObjectId ()
 
 size_t ObjectId::GenerateHashValue () const
 {
-	return std::hash<std::string> {} (id);
+	return id.GenerateHashValue ();
 }
 
 Stream::Status ObjectId::Read (InputStream& inputStream)
 {
-	inputStream.Read (id);
+	std::string idString;
+	inputStream.Read (idString);
+	id = InternedString (idString);
 	return inputStream.GetStatus ();
 }
 
 Stream::Status ObjectId::Write (OutputStream& outputStream) const
 {
-	outputStream.Write (id);
+	outputStream.Write (id.Get ());
 	return outputStream.GetStatus ();
 }
 
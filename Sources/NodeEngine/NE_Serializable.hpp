@@ -3,6 +3,7 @@
 
 #include "NE_Stream.hpp"
 #include "NE_Debug.hpp"
+#include "NE_InternedString.hpp"
 
 namespace NE
 {
@@ -23,7 +24,7 @@ public:
 	bool				operator!= (const ObjectId& rhs) const;
 
 private:
-	std::string id;
+	InternedString		id;
 };
 
 class ObjectVersion
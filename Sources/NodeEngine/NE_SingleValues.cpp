@@ -80,6 +80,11 @@ std::wstring StringValue::ToString (const StringConverter&) const
 	return val;
 }
 
+size_t StringValue::GetMemorySize () const
+{
+	return GenericValue<std::wstring>::GetMemorySize () + val.capacity () * sizeof (wchar_t);
+}
+
 Stream::Status StringValue::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
@@ -10,6 +10,7 @@ namespace NE
 class BooleanValue : public GenericValue<bool>
 {
 	DYNAMIC_SERIALIZABLE (BooleanValue);
+	VALUE_TYPE_INFO (BooleanValue);
 
 public:
 	BooleanValue ();
@@ -48,6 +49,7 @@ class IntValue : public NumberValue,
 				 public GenericValue<int>
 {
 	DYNAMIC_SERIALIZABLE (IntValue);
+	VALUE_TYPE_INFO (IntValue);
 
 public:
 	IntValue ();
@@ -69,6 +71,7 @@ class FloatValue :	public NumberValue,
 					public GenericValue<float>
 {
 	DYNAMIC_SERIALIZABLE (FloatValue);
+	VALUE_TYPE_INFO (FloatValue);
 
 public:
 	FloatValue ();
@@ -90,6 +93,7 @@ class DoubleValue : public NumberValue,
 					public GenericValue<double>
 {
 	DYNAMIC_SERIALIZABLE (DoubleValue);
+	VALUE_TYPE_INFO (DoubleValue);
 
 public:
 	DoubleValue ();
@@ -110,6 +114,7 @@ public:
 class StringValue : public GenericValue<std::wstring>
 {
 	DYNAMIC_SERIALIZABLE (StringValue);
+	VALUE_TYPE_INFO (StringValue);
 
 public:
 	StringValue ();
@@ -118,6 +123,7 @@ public:
 
 	virtual ValuePtr		Clone () const override;
 	virtual std::wstring	ToString (const StringConverter& stringConverter) const override;
+	virtual size_t			GetMemorySize () const override;
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
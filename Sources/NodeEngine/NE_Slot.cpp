@@ -2,21 +2,27 @@
 #include "NE_Node.hpp"
 #include "NE_Debug.hpp"
 
+#include <limits>
+
 namespace NE
 {
 
 SERIALIZATION_INFO (Slot, 1);
 
+const size_t InvalidSlotIndex = std::numeric_limits<size_t>::max ();
+
 Slot::Slot () :
 	slotId (""),
-	ownerNode (nullptr)
+	ownerNode (nullptr),
+	slotIndex (InvalidSlotIndex)
 {
 
 }
 
 Slot::Slot (const SlotId& slotId) :
 	slotId (slotId),
-	ownerNode (nullptr)
+	ownerNode (nullptr),
+	slotIndex (InvalidSlotIndex)
 {
 
 }
@@ -53,6 +59,11 @@ bool Slot::SetOwnerNode (Node* newOwnerNode)
 	return true;
 }
 
+size_t Slot::GetSlotIndex () const
+{
+	return slotIndex;
+}
+
 Stream::Status Slot::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
@@ -10,9 +10,12 @@
 namespace NE
 {
 
+extern const size_t InvalidSlotIndex;
+
 class Slot : public DynamicSerializable
 {
 	SERIALIZABLE;
+	template <class SlotConstPtrType> friend class SlotIndexTable;
 
 public:
 	Slot ();
@@ -25,13 +28,17 @@ public:
 	bool					HasOwnerNode () const;
 	NodeId					GetOwnerNodeId () const;
 	bool					SetOwnerNode (Node* newOwnerNode);
+	size_t					GetSlotIndex () const;
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
 
 protected:
-	SlotId	slotId;
-	Node*	ownerNode;
+	SlotId			slotId;
+	Node*			ownerNode;
+
+private:
+	mutable size_t	slotIndex;
 };
 
 }
@@ -24,7 +24,7 @@ SlotId::~SlotId ()
 
 size_t SlotId::GenerateHashValue () const
 {
-	return std::hash<std::string> {} (id);
+	return id.GenerateHashValue ();
 }
 
 bool SlotId::operator< (const SlotId& rhs) const
@@ -50,14 +50,16 @@ bool SlotId::operator!= (const SlotId& rhs) const
 Stream::Status SlotId::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
-	inputStream.Read (id);
+	std::string idString;
+	inputStream.Read (idString);
+	id = InternedString (idString);
 	return inputStream.GetStatus ();
 }
 
 Stream::Status SlotId::Write (OutputStream& outputStream) const
 {
 	ObjectHeader header (outputStream, serializationInfo);
-	outputStream.Write (id);
+	outputStream.Write (id.Get ());
 	return outputStream.GetStatus ();
 }
 
@@ -2,6 +2,7 @@
 #define NE_SLOTID_HPP
 
 #include "NE_Serializable.hpp"
+#include "NE_InternedString.hpp"
 
 #include <string>
 
@@ -28,7 +29,7 @@ public:
 	Stream::Status	Write (OutputStream& outputStream) const;
 
 private:
-	std::string id;
+	InternedString	id;
 };
 
 extern const SlotId NullSlotId;
@@ -0,0 +1,126 @@
+#ifndef NE_SLOTINDEXTABLE_HPP
+#define NE_SLOTINDEXTABLE_HPP
+
+#include "NE_Debug.hpp"
+#include "NE_Slot.hpp"
+#include <vector>
+
+namespace NE
+{
+
+// assigns dense indices to slots, the index is stored in the slot itself,
+// so finding a slot needs no hashing, the indices of removed slots are reused
+template <class SlotConstPtrType>
+class SlotIndexTable
+{
+public:
+	SlotIndexTable ();
+	SlotIndexTable (const SlotIndexTable& src) = delete;
+	~SlotIndexTable ();
+
+	SlotIndexTable&				operator= (const SlotIndexTable& rhs) = delete;
+
+	void						Clear ();
+	size_t						GetSize () const;
+	size_t						GetMemorySize () const;
+
+	size_t						Add (const SlotConstPtrType& slot);
+	void						Remove (const SlotConstPtrType& slot);
+	size_t						Find (const SlotConstPtrType& slot) const;
+	const SlotConstPtrType&		Get (size_t index) const;
+
+private:
+	std::vector<SlotConstPtrType>	slots;
+	std::vector<size_t>				freeIndices;
+};
+
+template <class SlotConstPtrType>
+SlotIndexTable<SlotConstPtrType>::SlotIndexTable () :
+	slots (),
+	freeIndices ()
+{
+
+}
+
+template <class SlotConstPtrType>
+SlotIndexTable<SlotConstPtrType>::~SlotIndexTable ()
+{
+	Clear ();
+}
+
+template <class SlotConstPtrType>
+void SlotIndexTable<SlotConstPtrType>::Clear ()
+{
+	for (const SlotConstPtrType& slot : slots) {
+		if (slot != nullptr) {
+			slot->slotIndex = InvalidSlotIndex;
+		}
+	}
+	slots.clear ();
+	freeIndices.clear ();
+}
+
+template <class SlotConstPtrType>
+size_t SlotIndexTable<SlotConstPtrType>::GetSize () const
+{
+	return slots.size ();
+}
+
+template <class SlotConstPtrType>
+size_t SlotIndexTable<SlotConstPtrType>::GetMemorySize () const
+{
+	return sizeof (SlotIndexTable) + slots.capacity () * sizeof (SlotConstPtrType) + freeIndices.capacity () * sizeof (size_t);
+}
+
+template <class SlotConstPtrType>
+size_t SlotIndexTable<SlotConstPtrType>::Add (const SlotConstPtrType& slot)
+{
+	size_t foundIndex = Find (slot);
+	if (foundIndex != InvalidSlotIndex) {
+		return foundIndex;
+	}
+	size_t index = slots.size ();
+	if (!freeIndices.empty ()) {
+		index = freeIndices.back ();
+		freeIndices.pop_back ();
+		slots[index] = slot;
+	} else {
+		slots.push_back (slot);
+	}
+	slot->slotIndex = index;
+	return index;
+}
+
+template <class SlotConstPtrType>
+void SlotIndexTable<SlotConstPtrType>::Remove (const SlotConstPtrType& slot)
+{
+	size_t index = Find (slot);
+	if (index == InvalidSlotIndex) {
+		return;
+	}
+	slot->slotIndex = InvalidSlotIndex;
+	slots[index] = nullptr;
+	freeIndices.push_back (index);
+}
+
+template <class SlotConstPtrType>
+size_t SlotIndexTable<SlotConstPtrType>::Find (const SlotConstPtrType& slot) const
+{
+	// the slot may have been indexed by another table, so the stored index is verified
+	size_t index = slot->slotIndex;
+	if (index >= slots.size () || slots[index] != slot) {
+		return InvalidSlotIndex;
+	}
+	return index;
+}
+
+template <class SlotConstPtrType>
+const SlotConstPtrType& SlotIndexTable<SlotConstPtrType>::Get (size_t index) const
+{
+	DBGASSERT (index < slots.size ());
+	return slots[index];
+}
+
+}
+
+#endif
@@ -34,6 +34,11 @@ public:
 	void								Enumerate (const std::function<bool (std::shared_ptr<SlotType>&)>& processor);
 	void								Enumerate (const std::function<bool (const std::shared_ptr<const SlotType>&)>& processor) const;
 
+	template <typename Processor>
+	void								ForEach (Processor&& processor);
+	template <typename Processor>
+	void								ForEach (Processor&& processor) const;
+
 private:
 	OrderedMap<SlotId, std::shared_ptr<SlotType>>	slots;
 };
@@ -102,17 +107,27 @@ bool SlotList<SlotType>::IsEmpty () const
 template <class SlotType>
 void SlotList<SlotType>::Enumerate (const std::function<bool (std::shared_ptr<SlotType>&)>& processor)
 {
-	slots.Enumerate ([&] (std::shared_ptr<SlotType>& slot) {
-		return processor (slot);
-	});
+	ForEach (processor);
 }
 
 template <class SlotType>
 void SlotList<SlotType>::Enumerate (const std::function<bool (const std::shared_ptr<const SlotType>&)>& processor) const
 {
-	slots.Enumerate ([&] (const std::shared_ptr<SlotType>& slot) {
-		return processor (slot);
-	});
+	ForEach (processor);
+}
+
+template <class SlotType>
+template <typename Processor>
+void SlotList<SlotType>::ForEach (Processor&& processor)
+{
+	slots.ForEach (processor);
+}
+
+template <class SlotType>
+template <typename Processor>
+void SlotList<SlotType>::ForEach (Processor&& processor) const
+{
+	slots.ForEach (processor);
 }
 
 }
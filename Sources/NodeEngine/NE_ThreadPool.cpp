@@ -0,0 +1,201 @@
+#include "NE_ThreadPool.hpp"
+#include "NE_Debug.hpp"
+
+namespace NE
+{
+
+ThreadPool::TaskQueue::TaskQueue () :
+	mutex (),
+	tasks ()
+{
+
+}
+
+ThreadPool::TaskQueue::~TaskQueue ()
+{
+
+}
+
+void ThreadPool::TaskQueue::PushBack (const Task& task)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	tasks.push_back (task);
+}
+
+bool ThreadPool::TaskQueue::PopBack (Task& task)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	if (tasks.empty ()) {
+		return false;
+	}
+	task = std::move (tasks.back ());
+	tasks.pop_back ();
+	return true;
+}
+
+bool ThreadPool::TaskQueue::PopFront (Task& task)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	if (tasks.empty ()) {
+		return false;
+	}
+	task = std::move (tasks.front ());
+	tasks.pop_front ();
+	return true;
+}
+
+ThreadPool::ThreadPool (size_t threadCount) :
+	queues (),
+	callerThreadQueue (),
+	threads (),
+	waitMutex (),
+	workerCondition (),
+	callerCondition (),
+	queuedTaskCount (0),
+	callerThreadTaskCount (0),
+	pendingTaskCount (0),
+	isStopped (false)
+{
+	if (DBGERROR (threadCount == 0)) {
+		threadCount = 1;
+	}
+	for (size_t i = 0; i < threadCount; i++) {
+		queues.push_back (std::unique_ptr<TaskQueue> (new TaskQueue ()));
+	}
+	for (size_t i = 1; i < threadCount; i++) {
+		threads.push_back (std::thread (&ThreadPool::WorkerThread, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool ()
+{
+	{
+		std::lock_guard<std::mutex> lock (waitMutex);
+		isStopped = true;
+	}
+	workerCondition.notify_all ();
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+}
+
+size_t ThreadPool::GetThreadCount () const
+{
+	return queues.size ();
+}
+
+void ThreadPool::Execute (const std::vector<Task>& tasks, const std::vector<Task>& callerThreadTasks)
+{
+	for (const Task& task : tasks) {
+		Spawn (0, task);
+	}
+	for (const Task& task : callerThreadTasks) {
+		SpawnOnCallerThread (task);
+	}
+
+	while (true) {
+		Task task;
+		if (FindTask (0, task)) {
+			RunTask (0, task);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock (waitMutex);
+		callerCondition.wait (lock, [&] () {
+			return pendingTaskCount == 0 || callerThreadTaskCount > 0;
+		});
+		if (pendingTaskCount == 0) {
+			break;
+		}
+	}
+}
+
+void ThreadPool::Spawn (size_t threadIndex, const Task& task)
+{
+	pendingTaskCount++;
+	queuedTaskCount++;
+	queues[threadIndex]->PushBack (task);
+	NotifyWaitingThreads (false);
+}
+
+void ThreadPool::SpawnOnCallerThread (const Task& task)
+{
+	pendingTaskCount++;
+	callerThreadTaskCount++;
+	callerThreadQueue.PushBack (task);
+	NotifyWaitingThreads (true);
+}
+
+size_t ThreadPool::GetDefaultThreadCount ()
+{
+	size_t threadCount = std::thread::hardware_concurrency ();
+	if (threadCount == 0) {
+		return 1;
+	}
+	return threadCount;
+}
+
+void ThreadPool::WorkerThread (size_t threadIndex)
+{
+	while (true) {
+		Task task;
+		if (FindTask (threadIndex, task)) {
+			RunTask (threadIndex, task);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock (waitMutex);
+		workerCondition.wait (lock, [&] () {
+			return isStopped || queuedTaskCount > 0;
+		});
+		if (isStopped) {
+			break;
+		}
+	}
+}
+
+bool ThreadPool::FindTask (size_t threadIndex, Task& task)
+{
+	if (threadIndex == 0 && callerThreadTaskCount > 0) {
+		if (callerThreadQueue.PopFront (task)) {
+			callerThreadTaskCount--;
+			return true;
+		}
+	}
+	if (queuedTaskCount == 0) {
+		return false;
+	}
+	if (queues[threadIndex]->PopBack (task)) {
+		queuedTaskCount--;
+		return true;
+	}
+	size_t queueCount = queues.size ();
+	for (size_t i = 1; i < queueCount; i++) {
+		size_t victimIndex = (threadIndex + i) % queueCount;
+		if (queues[victimIndex]->PopFront (task)) {
+			queuedTaskCount--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::RunTask (size_t threadIndex, const Task& task)
+{
+	task (threadIndex);
+	if (--pendingTaskCount == 0) {
+		NotifyWaitingThreads (true);
+	}
+}
+
+void ThreadPool::NotifyWaitingThreads (bool notifyCallerThread)
+{
+	{
+		std::lock_guard<std::mutex> lock (waitMutex);
+	}
+	if (notifyCallerThread) {
+		callerCondition.notify_one ();
+	} else {
+		workerCondition.notify_one ();
+	}
+}
+
+}
@@ -0,0 +1,71 @@
+#ifndef NE_THREADPOOL_HPP
+#define NE_THREADPOOL_HPP
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace NE
+{
+
+class ThreadPool
+{
+public:
+	using Task = std::function<void (size_t)>;
+
+	ThreadPool (size_t threadCount);
+	ThreadPool (const ThreadPool& src) = delete;
+	~ThreadPool ();
+
+	ThreadPool&		operator= (const ThreadPool& rhs) = delete;
+
+	size_t			GetThreadCount () const;
+
+	void			Execute (const std::vector<Task>& tasks, const std::vector<Task>& callerThreadTasks);
+	void			Spawn (size_t threadIndex, const Task& task);
+	void			SpawnOnCallerThread (const Task& task);
+
+	static size_t	GetDefaultThreadCount ();
+
+private:
+	class TaskQueue
+	{
+	public:
+		TaskQueue ();
+		~TaskQueue ();
+
+		void	PushBack (const Task& task);
+		bool	PopBack (Task& task);
+		bool	PopFront (Task& task);
+
+	private:
+		std::mutex			mutex;
+		std::deque<Task>	tasks;
+	};
+
+	void			WorkerThread (size_t threadIndex);
+	bool			FindTask (size_t threadIndex, Task& task);
+	void			RunTask (size_t threadIndex, const Task& task);
+	void			NotifyWaitingThreads (bool notifyCallerThread);
+
+	std::vector<std::unique_ptr<TaskQueue>>		queues;
+	TaskQueue									callerThreadQueue;
+	std::vector<std::thread>					threads;
+
+	std::mutex									waitMutex;
+	std::condition_variable						workerCondition;
+	std::condition_variable						callerCondition;
+	std::atomic<size_t>							queuedTaskCount;
+	std::atomic<size_t>							callerThreadTaskCount;
+	std::atomic<size_t>							pendingTaskCount;
+	bool										isStopped;
+};
+
+}
+
+#endif
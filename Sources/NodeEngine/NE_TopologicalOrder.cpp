@@ -0,0 +1,171 @@
+#include "NE_TopologicalOrder.hpp"
+#include "NE_Debug.hpp"
+
+#include <unordered_set>
+#include <algorithm>
+
+namespace NE
+{
+
+TopologicalOrder::Graph::Graph ()
+{
+
+}
+
+TopologicalOrder::Graph::~Graph ()
+{
+
+}
+
+TopologicalOrder::TopologicalOrder () :
+	nodeToOrder (),
+	nextOrder (0)
+{
+
+}
+
+TopologicalOrder::~TopologicalOrder ()
+{
+
+}
+
+void TopologicalOrder::Clear ()
+{
+	nodeToOrder.clear ();
+	nextOrder = 0;
+}
+
+bool TopologicalOrder::Contains (const NodeId& nodeId) const
+{
+	return nodeToOrder.find (nodeId) != nodeToOrder.end ();
+}
+
+size_t TopologicalOrder::GetOrder (const NodeId& nodeId) const
+{
+	return nodeToOrder.at (nodeId);
+}
+
+bool TopologicalOrder::AddNode (const NodeId& nodeId)
+{
+	if (DBGERROR (Contains (nodeId))) {
+		return false;
+	}
+	nodeToOrder.insert ({ nodeId, nextOrder++ });
+	return true;
+}
+
+bool TopologicalOrder::DeleteNode (const NodeId& nodeId)
+{
+	if (DBGERROR (!Contains (nodeId))) {
+		return false;
+	}
+	nodeToOrder.erase (nodeId);
+	return true;
+}
+
+bool TopologicalOrder::CanAddEdge (const Graph& graph, const NodeId& begNodeId, const NodeId& endNodeId) const
+{
+	if (begNodeId == endNodeId) {
+		return false;
+	}
+
+	size_t begOrder = GetOrder (begNodeId);
+	size_t endOrder = GetOrder (endNodeId);
+	if (begOrder < endOrder) {
+		return true;
+	}
+
+	// only the nodes between the two orders can be on a path back to the begin node
+	std::vector<NodeId> forwardNodes;
+	return SearchForward (graph, endNodeId, begOrder, forwardNodes);
+}
+
+bool TopologicalOrder::AddEdge (const Graph& graph, const NodeId& begNodeId, const NodeId& endNodeId)
+{
+	if (DBGERROR (begNodeId == endNodeId)) {
+		return false;
+	}
+
+	size_t begOrder = GetOrder (begNodeId);
+	size_t endOrder = GetOrder (endNodeId);
+	if (begOrder < endOrder) {
+		return true;
+	}
+
+	std::vector<NodeId> forwardNodes;
+	if (DBGERROR (!SearchForward (graph, endNodeId, begOrder, forwardNodes))) {
+		return false;
+	}
+
+	std::vector<NodeId> backwardNodes;
+	SearchBackward (graph, begNodeId, endOrder, backwardNodes);
+
+	SortByOrder (forwardNodes);
+	SortByOrder (backwardNodes);
+
+	std::vector<size_t> orders;
+	for (const NodeId& nodeId : backwardNodes) {
+		orders.push_back (GetOrder (nodeId));
+	}
+	for (const NodeId& nodeId : forwardNodes) {
+		orders.push_back (GetOrder (nodeId));
+	}
+	std::sort (orders.begin (), orders.end ());
+
+	size_t orderIndex = 0;
+	for (const NodeId& nodeId : backwardNodes) {
+		nodeToOrder[nodeId] = orders[orderIndex++];
+	}
+	for (const NodeId& nodeId : forwardNodes) {
+		nodeToOrder[nodeId] = orders[orderIndex++];
+	}
+
+	return true;
+}
+
+bool TopologicalOrder::SearchForward (const Graph& graph, const NodeId& startNodeId, size_t upperBound, std::vector<NodeId>& visitedNodes) const
+{
+	std::unordered_set<NodeId> visitedNodeSet = { startNodeId };
+	std::vector<NodeId> nodesToVisit = { startNodeId };
+	bool foundUpperBound = false;
+	while (!nodesToVisit.empty () && !foundUpperBound) {
+		NodeId currentNodeId = nodesToVisit.back ();
+		nodesToVisit.pop_back ();
+		visitedNodes.push_back (currentNodeId);
+		graph.EnumerateSuccessors (currentNodeId, [&] (const NodeId& successorNodeId) {
+			size_t successorOrder = GetOrder (successorNodeId);
+			if (successorOrder == upperBound) {
+				foundUpperBound = true;
+			} else if (successorOrder < upperBound && visitedNodeSet.insert (successorNodeId).second) {
+				nodesToVisit.push_back (successorNodeId);
+			}
+		});
+	}
+	return !foundUpperBound;
+}
+
+void TopologicalOrder::SearchBackward (const Graph& graph, const NodeId& startNodeId, size_t lowerBound, std::vector<NodeId>& visitedNodes) const
+{
+	std::unordered_set<NodeId> visitedNodeSet = { startNodeId };
+	std::vector<NodeId> nodesToVisit = { startNodeId };
+	while (!nodesToVisit.empty ()) {
+		NodeId currentNodeId = nodesToVisit.back ();
+		nodesToVisit.pop_back ();
+		visitedNodes.push_back (currentNodeId);
+		graph.EnumeratePredecessors (currentNodeId, [&] (const NodeId& predecessorNodeId) {
+			size_t predecessorOrder = GetOrder (predecessorNodeId);
+			if (predecessorOrder > lowerBound && visitedNodeSet.insert (predecessorNodeId).second) {
+				nodesToVisit.push_back (predecessorNodeId);
+			}
+		});
+	}
+}
+
+void TopologicalOrder::SortByOrder (std::vector<NodeId>& nodes) const
+{
+	std::sort (nodes.begin (), nodes.end (), [&] (const NodeId& a, const NodeId& b) {
+		return GetOrder (a) < GetOrder (b);
+	});
+}
+
+}
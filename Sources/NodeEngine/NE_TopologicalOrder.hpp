@@ -0,0 +1,50 @@
+#ifndef NE_TOPOLOGICALORDER_HPP
+#define NE_TOPOLOGICALORDER_HPP
+
+#include "NE_NodeId.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace NE
+{
+
+class TopologicalOrder
+{
+public:
+	class Graph
+	{
+	public:
+		Graph ();
+		virtual ~Graph ();
+
+		virtual void	EnumerateSuccessors (const NodeId& nodeId, const std::function<void (const NodeId&)>& processor) const = 0;
+		virtual void	EnumeratePredecessors (const NodeId& nodeId, const std::function<void (const NodeId&)>& processor) const = 0;
+	};
+
+	TopologicalOrder ();
+	~TopologicalOrder ();
+
+	void		Clear ();
+	bool		Contains (const NodeId& nodeId) const;
+	size_t		GetOrder (const NodeId& nodeId) const;
+
+	bool		AddNode (const NodeId& nodeId);
+	bool		DeleteNode (const NodeId& nodeId);
+
+	bool		CanAddEdge (const Graph& graph, const NodeId& begNodeId, const NodeId& endNodeId) const;
+	bool		AddEdge (const Graph& graph, const NodeId& begNodeId, const NodeId& endNodeId);
+
+private:
+	bool		SearchForward (const Graph& graph, const NodeId& startNodeId, size_t upperBound, std::vector<NodeId>& visitedNodes) const;
+	void		SearchBackward (const Graph& graph, const NodeId& startNodeId, size_t lowerBound, std::vector<NodeId>& visitedNodes) const;
+	void		SortByOrder (std::vector<NodeId>& nodes) const;
+
+	std::unordered_map<NodeId, size_t>	nodeToOrder;
+	size_t								nextOrder;
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define NE_UTILS_HPP
 
 #include <string>
+#include <cstdint>
 
 namespace NE
 {
@@ -27,6 +28,19 @@ private:
 	T	origValue;
 };
 
+static const uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+
+// 64 bit FNV-1a hash, more buffers can be hashed together by passing the previous hash
+inline uint64_t CalculateFnvHash (const void* data, size_t size, uint64_t hash = FnvOffsetBasis)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*> (data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
 }
 
 #endif
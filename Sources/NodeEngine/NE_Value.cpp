@@ -1,5 +1,9 @@
 #include "NE_Value.hpp"
 #include "NE_Debug.hpp"
+#include "NE_Utils.hpp"
+#include "NE_MemoryStream.hpp"
+
+#include <algorithm>
 
 namespace NE
 {
@@ -8,7 +12,33 @@ SERIALIZATION_INFO (Value, 1);
 SERIALIZATION_INFO (SingleValue, 1);
 DYNAMIC_SERIALIZATION_INFO (ListValue, 1, "{95418CFC-BAE7-4FB3-8ED5-E6EC3AB930AC}");
 
-Value::Value ()
+ValueTypeInfo::ValueTypeInfo (const std::type_info& typeInfo) :
+	typeInfo (typeInfo),
+	offsets ()
+{
+	for (std::atomic<std::ptrdiff_t>& offset : offsets) {
+		offset.store (UnknownOffset);
+	}
+}
+
+ValueTypeInfo::~ValueTypeInfo ()
+{
+
+}
+
+bool ValueTypeInfo::IsTypeOf (const Value* val) const
+{
+	return typeid (*val) == typeInfo;
+}
+
+size_t ValueTypeInfo::GenerateTypeId ()
+{
+	static std::atomic<size_t> nextTypeId (0);
+	return nextTypeId++;
+}
+
+Value::Value () :
+	contentHash (0)
 {
 
 }
@@ -18,6 +48,37 @@ Value::~Value ()
 
 }
 
+size_t Value::GetMemorySize () const
+{
+	return sizeof (Value);
+}
+
+const ValueTypeInfo& Value::GetValueTypeInfo () const
+{
+	static const ValueTypeInfo valueTypeInfo (typeid (Value));
+	return valueTypeInfo;
+}
+
+uint64_t Value::GetContentHash () const
+{
+	// threads requesting the hash at the same time may calculate it more times,
+	// but they get the same result, zero means that it is not calculated yet
+	uint64_t hash = contentHash.load (std::memory_order_relaxed);
+	if (hash == 0) {
+		hash = std::max (CalculateContentHash (), (uint64_t) 1);
+		contentHash.store (hash, std::memory_order_relaxed);
+	}
+	return hash;
+}
+
+uint64_t Value::CalculateContentHash () const
+{
+	MemoryOutputStream outputStream;
+	WriteDynamicObject (outputStream, this);
+	const std::vector<char>& buffer = outputStream.GetBuffer ();
+	return CalculateFnvHash (buffer.data (), buffer.size ());
+}
+
 Stream::Status Value::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
@@ -54,6 +115,73 @@ Stream::Status SingleValue::Write (OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+ListValueSummary::ListValueSummary () :
+	leafPrototype (nullptr),
+	isHomogeneous (true),
+	depth (1),
+	leafCount (0)
+{
+
+}
+
+ListValueSummary::ListValueSummary (const Value* leafPrototype, size_t depth, size_t leafCount) :
+	leafPrototype (leafPrototype),
+	isHomogeneous (leafPrototype != nullptr),
+	depth (depth),
+	leafCount (leafCount)
+{
+
+}
+
+ListValueSummary::~ListValueSummary ()
+{
+
+}
+
+const Value* ListValueSummary::GetLeafPrototype () const
+{
+	if (!isHomogeneous) {
+		return nullptr;
+	}
+	return leafPrototype;
+}
+
+size_t ListValueSummary::GetDepth () const
+{
+	return depth;
+}
+
+size_t ListValueSummary::GetLeafCount () const
+{
+	return leafCount;
+}
+
+void ListValueSummary::Add (const ValueConstPtr& value)
+{
+	const Value* valueLeafPrototype = value.get ();
+	size_t valueDepth = 0;
+	size_t valueLeafCount = 1;
+	if (Value::IsType<IListValue> (value)) {
+		ListValueSummary valueSummary = Value::Cast<IListValue> (value.get ())->GetSummary ();
+		valueLeafPrototype = valueSummary.GetLeafPrototype ();
+		valueDepth = valueSummary.GetDepth ();
+		valueLeafCount = valueSummary.GetLeafCount ();
+	}
+
+	depth = std::max (depth, valueDepth + 1);
+	leafCount += valueLeafCount;
+	if (!isHomogeneous) {
+		return;
+	}
+	if (valueLeafPrototype == nullptr) {
+		isHomogeneous = false;
+	} else if (leafPrototype == nullptr) {
+		leafPrototype = valueLeafPrototype;
+	} else if (typeid (*leafPrototype) != typeid (*valueLeafPrototype)) {
+		isHomogeneous = false;
+	}
+}
+
 IListValue::IListValue ()
 {
 
@@ -64,15 +192,55 @@ IListValue::~IListValue ()
 
 }
 
-ListValue::ListValue ()
+const Value* IListValue::GetElementPrototype () const
+{
+	return nullptr;
+}
+
+ListValueSummary IListValue::GetSummary () const
+{
+	// an empty list has no leaves, so its element type must not make it homogeneous
+	if (GetSize () == 0) {
+		return ListValueSummary (nullptr, 1, 0);
+	}
+
+	const Value* elementPrototype = GetElementPrototype ();
+	if (elementPrototype != nullptr) {
+		return ListValueSummary (elementPrototype, 1, GetSize ());
+	}
+
+	// the enumerated values may be temporary, so the leaf prototype can't be kept
+	ListValueSummary summary;
+	Enumerate ([&] (const ValueConstPtr& value) {
+		summary.Add (value);
+		return true;
+	});
+	return ListValueSummary (nullptr, summary.GetDepth (), summary.GetLeafCount ());
+}
+
+ListValue::ListValue () :
+	values (),
+	summary ()
 {
 
 }
 
 ListValue::ListValue (const std::vector<ValueConstPtr>& values) :
-	values (values)
+	values (values),
+	summary ()
 {
+	for (const ValueConstPtr& value : values) {
+		summary.Add (value);
+	}
+}
 
+ListValue::ListValue (std::vector<ValueConstPtr>&& values) :
+	values (std::move (values)),
+	summary ()
+{
+	for (const ValueConstPtr& value : this->values) {
+		summary.Add (value);
+	}
 }
 
 ListValue::~ListValue ()
@@ -119,6 +287,29 @@ std::wstring ListValue::ToString (const StringConverter& stringConverter) const
 	return stringConverter.ListToString (enumerator);
 }
 
+size_t ListValue::GetMemorySize () const
+{
+	size_t memorySize = sizeof (ListValue) + values.capacity () * sizeof (ValueConstPtr);
+	for (const ValueConstPtr& value : values) {
+		if (value != nullptr) {
+			memorySize += value->GetMemorySize ();
+		}
+	}
+	return memorySize;
+}
+
+uint64_t ListValue::CalculateContentHash () const
+{
+	// the elements keep their own hashes, so the list is not written again
+	size_t valueCount = values.size ();
+	uint64_t hash = CalculateFnvHash (&valueCount, sizeof (valueCount));
+	for (const ValueConstPtr& value : values) {
+		uint64_t valueHash = (value != nullptr ? value->GetContentHash () : 0);
+		hash = CalculateFnvHash (&valueHash, sizeof (valueHash), hash);
+	}
+	return hash;
+}
+
 Stream::Status ListValue::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
@@ -128,7 +319,7 @@ Stream::Status ListValue::Read (InputStream& inputStream)
 	for (size_t i = 0; i < valueCount; i++) {
 		ValuePtr value (ReadDynamicObject<Value> (inputStream));
 		if (DBGVERIFY (value != nullptr)) {
-			values.push_back (value);
+			Push (value);
 		}
 	}
 	return inputStream.GetStatus ();
@@ -150,7 +341,7 @@ size_t ListValue::GetSize () const
 	return values.size ();
 }
 
-const ValueConstPtr& ListValue::GetValue (size_t index) const
+ValueConstPtr ListValue::GetElement (size_t index) const
 {
 	return values[index];
 }
@@ -165,9 +356,25 @@ bool ListValue::Enumerate (const std::function<bool (const ValueConstPtr&)>& pro
 	return true;
 }
 
+ListValueSummary ListValue::GetSummary () const
+{
+	return summary;
+}
+
+const ValueConstPtr& ListValue::GetValue (size_t index) const
+{
+	return values[index];
+}
+
 void ListValue::Push (const ValueConstPtr& value)
 {
 	values.push_back (value);
+	summary.Add (value);
+}
+
+const std::vector<ValueConstPtr>& ListValue::GetValues () const
+{
+	return values;
 }
 
 ValueToListValueAdapter::ValueToListValueAdapter (const ValueConstPtr& val) :
@@ -181,7 +388,7 @@ size_t ValueToListValueAdapter::GetSize () const
 	return 1;
 }
 
-const ValueConstPtr& ValueToListValueAdapter::GetValue (size_t) const
+ValueConstPtr ValueToListValueAdapter::GetElement (size_t) const
 {
 	return val;
 }
@@ -191,6 +398,11 @@ bool ValueToListValueAdapter::Enumerate (const std::function<bool (const ValueCo
 	return processor (val);
 }
 
+const ValueConstPtr& ValueToListValueAdapter::GetValue (size_t) const
+{
+	return val;
+}
+
 bool IsSingleValue (const ValueConstPtr& value)
 {
 	return Value::IsType<SingleValue> (value);
@@ -198,19 +410,19 @@ bool IsSingleValue (const ValueConstPtr& value)
 
 bool IsListValue (const ValueConstPtr& value)
 {
-	return Value::IsType<ListValue> (value);
+	return Value::IsType<IListValue> (value);
 }
 
 ValueConstPtr CreateSingleValue (const ValueConstPtr& value)
 {
 	if (Value::IsType<SingleValue> (value)) {
 		return value;
-	} else if (Value::IsType<ListValue> (value)) {
-		ListValueConstPtr listVal = Value::Cast<ListValue> (value);
+	} else if (Value::IsType<IListValue> (value)) {
+		const IListValue* listVal = Value::Cast<IListValue> (value.get ());
 		if (listVal->GetSize () != 1) {
 			return nullptr;
 		}
-		return listVal->GetValue (0);
+		return listVal->GetElement (0);
 	}
 
 	DBGBREAK ();
@@ -222,8 +434,8 @@ IListValueConstPtr CreateListValue (const ValueConstPtr& value)
 {
 	if (Value::IsType<SingleValue> (value)) {
 		return std::make_shared<ValueToListValueAdapter> (value);
-	} else if (Value::IsType<ListValue> (value)) {
-		return std::dynamic_pointer_cast<const IListValue> (value);
+	} else if (Value::IsType<IListValue> (value)) {
+		return Value::Cast<IListValue> (value);
 	}
 
 	DBGBREAK ();
@@ -232,30 +444,95 @@ IListValueConstPtr CreateListValue (const ValueConstPtr& value)
 
 bool FlatEnumerate (const ValueConstPtr& value, const std::function<bool (const ValueConstPtr&)>& processor)
 {
-	if (value == nullptr) {
+	class ListFrame
+	{
+	public:
+		ListFrame (const ValueConstPtr& listValue) :
+			listValue (listValue),
+			list (Value::Cast<IListValue> (listValue.get ())),
+			values (nullptr),
+			index (0),
+			size (list->GetSize ())
+		{
+			const ListValue* boxedList = Value::Cast<ListValue> (listValue.get ());
+			if (boxedList != nullptr) {
+				values = &boxedList->GetValues ();
+			}
+		}
+
+		ValueConstPtr			listValue;
+		const IListValue*		list;
+		const std::vector<ValueConstPtr>*	values;
+		size_t					index;
+		size_t					size;
+	};
+
+	if (!Value::IsType<IListValue> (value)) {
 		return processor (value);
 	}
-	IListValueConstPtr listValue = CreateListValue (value);
-	return listValue->Enumerate ([&] (const ValueConstPtr& innerValue) {
-		if (Value::IsType<SingleValue> (innerValue)) {
-			if (!processor (innerValue)) {
+
+	std::vector<ListFrame> frames;
+	frames.push_back (ListFrame (value));
+	while (!frames.empty ()) {
+		ListFrame& frame = frames.back ();
+		if (frame.list->GetElementPrototype () != nullptr) {
+			// typed lists are flat, they enumerate their own elements
+			ValueConstPtr listValue = frame.listValue;
+			frames.pop_back ();
+			if (!Value::Cast<IListValue> (listValue.get ())->Enumerate (processor)) {
+				return false;
+			}
+			continue;
+		}
+		if (frame.index >= frame.size) {
+			frames.pop_back ();
+			continue;
+		}
+		size_t index = frame.index++;
+		if (frame.values != nullptr) {
+			const ValueConstPtr& innerValue = (*frame.values)[index];
+			if (Value::IsType<IListValue> (innerValue)) {
+				frames.push_back (ListFrame (innerValue));
+			} else if (!processor (innerValue)) {
 				return false;
 			}
 		} else {
-			return FlatEnumerate (innerValue, processor);
+			ValueConstPtr innerValue = frame.list->GetElement (index);
+			if (Value::IsType<IListValue> (innerValue)) {
+				frames.push_back (ListFrame (innerValue));
+			} else if (!processor (innerValue)) {
+				return false;
+			}
 		}
+	}
+	return true;
+}
+
+size_t GetFlatValueCount (const ValueConstPtr& value)
+{
+	if (!Value::IsType<IListValue> (value)) {
+		return 1;
+	}
+	return Value::Cast<IListValue> (value.get ())->GetSummary ().GetLeafCount ();
+}
+
+void FlatCollect (const ValueConstPtr& value, std::vector<ValueConstPtr>& result)
+{
+	result.reserve (result.size () + GetFlatValueCount (value));
+	FlatEnumerate (value, [&] (const ValueConstPtr& innerValue) {
+		result.push_back (innerValue);
 		return true;
 	});
 }
 
 ValueConstPtr FlattenValue (const ValueConstPtr& value)
 {
-	ListValuePtr listValue (new ListValue ());
-	FlatEnumerate (value, [&] (const ValueConstPtr& value) {
-		listValue->Push (value);
-		return true;
-	});
-	return listValue;
+	if (Value::IsType<IListValue> (value) && Value::Cast<IListValue> (value.get ())->GetElementPrototype () != nullptr) {
+		return value;
+	}
+	std::vector<ValueConstPtr> values;
+	FlatCollect (value, values);
+	return ValueConstPtr (new ListValue (std::move (values)));
 }
 
 }
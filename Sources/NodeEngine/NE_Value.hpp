@@ -8,6 +8,10 @@
 #include <memory>
 #include <string>
 #include <functional>
+#include <typeinfo>
+#include <atomic>
+#include <limits>
+#include <cstdint>
 
 namespace NE
 {
@@ -28,6 +32,46 @@ class IListValue;
 using IListValuePtr = std::shared_ptr<IListValue>;
 using IListValueConstPtr = std::shared_ptr<const IListValue>;
 
+// remembers the result of casts for one value class, so they cost an array lookup instead of a dynamic_cast
+class ValueTypeInfo
+{
+public:
+	static const size_t MaxCachedTypeCount = 64;
+
+	ValueTypeInfo (const std::type_info& typeInfo);
+	ValueTypeInfo (const ValueTypeInfo& src) = delete;
+	~ValueTypeInfo ();
+
+	ValueTypeInfo&	operator= (const ValueTypeInfo& rhs) = delete;
+
+	bool			IsTypeOf (const Value* val) const;
+
+	template <class Type>
+	const Type*		Cast (const Value* val) const;
+
+	template <class Type>
+	static size_t	GetTypeId ();
+
+private:
+	static const std::ptrdiff_t UnknownOffset = std::numeric_limits<std::ptrdiff_t>::min ();
+	static const std::ptrdiff_t InvalidOffset = std::numeric_limits<std::ptrdiff_t>::min () + 1;
+
+	static size_t	GenerateTypeId ();
+
+	const std::type_info&						typeInfo;
+	mutable std::atomic<std::ptrdiff_t>			offsets[MaxCachedTypeCount];
+};
+
+// a value class without this macro is still handled correctly, but every cast falls back to dynamic_cast
+#define VALUE_TYPE_INFO(ClassName)															\
+public:																						\
+virtual const NE::ValueTypeInfo& GetValueTypeInfo () const override						\
+{																							\
+	static const NE::ValueTypeInfo valueTypeInfo (typeid (ClassName));						\
+	return valueTypeInfo;																	\
+}																							\
+private:																					\
+
 class Value : public DynamicSerializable
 {
 	SERIALIZABLE;
@@ -39,6 +83,13 @@ public:
 
 	virtual ValuePtr		Clone () const = 0;
 	virtual std::wstring	ToString (const StringConverter& stringConverter) const = 0;
+	virtual size_t			GetMemorySize () const;
+
+	virtual const ValueTypeInfo&	GetValueTypeInfo () const;
+
+	// the hash is calculated on the first request and kept by the value,
+	// so the value must not be modified after the hash is requested
+	uint64_t				GetContentHash () const;
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
@@ -63,48 +114,106 @@ public:
 
 	template <class Type>
 	static std::shared_ptr<const Type> Cast (const ValueConstPtr& val);
+
+protected:
+	virtual uint64_t		CalculateContentHash () const;
+
+private:
+	template <class Type>
+	static const Type* CastValue (const Value* val);
+
+	mutable std::atomic<uint64_t>	contentHash;
 };
 
+template <class Type>
+const Type* ValueTypeInfo::Cast (const Value* val) const
+{
+	size_t typeId = GetTypeId<Type> ();
+	if (typeId >= MaxCachedTypeCount) {
+		return dynamic_cast<const Type*> (val);
+	}
+
+	// the offset of a base class only depends on the class of the value, so it can be shared between threads
+	std::ptrdiff_t offset = offsets[typeId].load (std::memory_order_relaxed);
+	if (offset == UnknownOffset) {
+		const Type* result = dynamic_cast<const Type*> (val);
+		offset = (result == nullptr) ? InvalidOffset : reinterpret_cast<const char*> (result) - reinterpret_cast<const char*> (val);
+		offsets[typeId].store (offset, std::memory_order_relaxed);
+	}
+	if (offset == InvalidOffset) {
+		return nullptr;
+	}
+	return reinterpret_cast<const Type*> (reinterpret_cast<const char*> (val) + offset);
+}
+
+template <class Type>
+size_t ValueTypeInfo::GetTypeId ()
+{
+	static const size_t typeId = GenerateTypeId ();
+	return typeId;
+}
+
+template <class Type>
+const Type* Value::CastValue (const Value* val)
+{
+	if (val == nullptr) {
+		return nullptr;
+	}
+	const ValueTypeInfo& valueTypeInfo = val->GetValueTypeInfo ();
+	if (!valueTypeInfo.IsTypeOf (val)) {
+		return dynamic_cast<const Type*> (val);
+	}
+	return valueTypeInfo.Cast<Type> (val);
+}
+
 template <class Type>
 bool Value::IsType (Value* val)
 {
-	return dynamic_cast<Type*> (val) != nullptr;
+	return CastValue<Type> (val) != nullptr;
 }
 
 template <class Type>
 bool Value::IsType (const ValuePtr& val)
 {
-	return dynamic_cast<Type*> (val.get ()) != nullptr;
+	return CastValue<Type> (val.get ()) != nullptr;
 }
 
 template <class Type>
 bool Value::IsType (const ValueConstPtr& val)
 {
-	return dynamic_cast<const Type*> (val.get ()) != nullptr;
+	return CastValue<Type> (val.get ()) != nullptr;
 }
 
 template <class Type>
 Type* Value::Cast (Value* val)
 {
-	return dynamic_cast<Type*> (val);
+	return const_cast<Type*> (CastValue<Type> (val));
 }
 
 template <class Type>
 const Type* Value::Cast (const Value* val)
 {
-	return dynamic_cast<const Type*> (val);
+	return CastValue<Type> (val);
 }
 
 template <class Type>
 std::shared_ptr<Type> Value::Cast (const ValuePtr& val)
 {
-	return std::dynamic_pointer_cast<Type> (val);
+	const Type* result = CastValue<Type> (val.get ());
+	if (result == nullptr) {
+		return nullptr;
+	}
+	return std::shared_ptr<Type> (val, const_cast<Type*> (result));
 }
 
 template <class Type>
 std::shared_ptr<const Type> Value::Cast (const ValueConstPtr& val)
 {
-	return std::dynamic_pointer_cast<const Type> (val);
+	const Type* result = CastValue<Type> (val.get ());
+	if (result == nullptr) {
+		return nullptr;
+	}
+	return std::shared_ptr<const Type> (val, result);
 }
 
 class SingleValue : public Value
@@ -119,6 +228,29 @@ public:
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
 };
 
+// the leaf prototype is set only if every leaf of the list has the same class
+class ListValueSummary
+{
+public:
+	ListValueSummary ();
+	ListValueSummary (const Value* leafPrototype, size_t depth, size_t leafCount);
+	~ListValueSummary ();
+
+	const Value*	GetLeafPrototype () const;
+	size_t			GetDepth () const;
+	size_t			GetLeafCount () const;
+
+	void			Add (const ValueConstPtr& value);
+
+private:
+	const Value*	leafPrototype;
+	bool			isHomogeneous;
+	size_t			depth;
+	size_t			leafCount;
+};
+
+// lists storing their elements unboxed create the element value in GetElement,
+// boxed lists also provide GetValue to access the stored value without a copy
 class IListValue
 {
 public:
@@ -126,33 +258,45 @@ public:
 	virtual ~IListValue ();
 
 	virtual size_t					GetSize () const = 0;
-	virtual const ValueConstPtr&	GetValue (size_t index) const = 0;
+	virtual ValueConstPtr			GetElement (size_t index) const = 0;
 	virtual bool					Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const = 0;
+	virtual const Value*			GetElementPrototype () const;
+	virtual ListValueSummary		GetSummary () const;
 };
 
 class ListValue :	public Value,
 					public IListValue
 {
 	DYNAMIC_SERIALIZABLE (ListValue);
+	VALUE_TYPE_INFO (ListValue);
 
 public:
 	ListValue ();
 	ListValue (const std::vector<ValueConstPtr>& values);
+	ListValue (std::vector<ValueConstPtr>&& values);
 	virtual ~ListValue ();
 
 	virtual ValuePtr				Clone () const override;
 	virtual std::wstring			ToString (const StringConverter& stringConverter) const override;
+	virtual size_t					GetMemorySize () const override;
 	virtual Stream::Status			Read (InputStream& inputStream) override;
 	virtual Stream::Status			Write (OutputStream& outputStream) const override;
 
 	virtual size_t					GetSize () const override;
-	virtual const ValueConstPtr&	GetValue (size_t index) const override;
+	virtual ValueConstPtr			GetElement (size_t index) const override;
 	virtual bool					Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const override;
+	virtual ListValueSummary		GetSummary () const override;
 
+	const ValueConstPtr&			GetValue (size_t index) const;
 	void							Push (const ValueConstPtr& value);
-	
+	const std::vector<ValueConstPtr>&	GetValues () const;
+
+protected:
+	virtual uint64_t				CalculateContentHash () const override;
+
 private:
 	std::vector<ValueConstPtr>	values;
+	ListValueSummary			summary;
 };
 
 class ValueToListValueAdapter : public IListValue
@@ -161,9 +305,11 @@ public:
 	ValueToListValueAdapter (const ValueConstPtr& val);
 
 	virtual size_t					GetSize () const override;
-	virtual const ValueConstPtr&	GetValue (size_t index) const override;
+	virtual ValueConstPtr			GetElement (size_t index) const override;
 	virtual bool					Enumerate (const std::function<bool (const ValueConstPtr&)>& processor) const override;
 
+	const ValueConstPtr&			GetValue (size_t index) const;
+
 private:
 	const ValueConstPtr& val;
 };
@@ -174,9 +320,16 @@ bool IsSingleType (const ValueConstPtr& val)
 	if (Value::IsType<Type> (val)) {
 		return true;
 	}
-	if (Value::IsType<ListValue> (val)) {
-		const ListValue* listVal = Value::Cast<ListValue> (val.get ());
-		if (listVal->GetSize () == 1 && Value::IsType<Type> (listVal->GetValue (0))) {
+	if (Value::IsType<IListValue> (val)) {
+		const IListValue* listVal = Value::Cast<IListValue> (val.get ());
+		if (listVal->GetSize () != 1) {
+			return false;
+		}
+		const Value* elementPrototype = listVal->GetElementPrototype ();
+		if (elementPrototype != nullptr) {
+			return Value::Cast<Type> (elementPrototype) != nullptr;
+		}
+		if (Value::IsType<Type> (listVal->GetElement (0))) {
 			return true;
 		}
 	}
@@ -189,11 +342,19 @@ bool IsComplexType (const ValueConstPtr& val)
 	if (Value::IsType<Type> (val)) {
 		return true;
 	}
-	if (Value::IsType<ListValue> (val)) {
-		ListValueConstPtr listVal = Value::Cast<ListValue> (val);
+	if (Value::IsType<IListValue> (val)) {
+		const IListValue* listVal = Value::Cast<IListValue> (val.get ());
 		if (listVal->GetSize () == 0) {
 			return false;
 		}
+		const Value* elementPrototype = listVal->GetElementPrototype ();
+		if (elementPrototype != nullptr) {
+			return Value::Cast<Type> (elementPrototype) != nullptr;
+		}
+		const Value* leafPrototype = listVal->GetSummary ().GetLeafPrototype ();
+		if (leafPrototype != nullptr) {
+			return Value::Cast<Type> (leafPrototype) != nullptr;
+		}
 		bool isType = true;
 		listVal->Enumerate ([&] (const ValueConstPtr& innerVal) {
 			if (!IsComplexType<Type> (innerVal)) {
@@ -212,7 +373,10 @@ bool				IsListValue (const ValueConstPtr& value);
 ValueConstPtr		CreateSingleValue (const ValueConstPtr& value);
 IListValueConstPtr	CreateListValue (const ValueConstPtr& value);
 
+// the nested lists are walked without recursion, a single value is the only leaf of itself
 bool				FlatEnumerate (const ValueConstPtr& value, const std::function<bool (const ValueConstPtr&)>& processor);
+size_t				GetFlatValueCount (const ValueConstPtr& value);
+void				FlatCollect (const ValueConstPtr& value, std::vector<ValueConstPtr>& result);
 ValueConstPtr		FlattenValue (const ValueConstPtr& value);
 
 }
@@ -4,6 +4,7 @@
 #include "NE_Debug.hpp"
 
 #include <algorithm>
+#include <limits>
 
 namespace NE
 {
@@ -18,6 +19,44 @@ ValueCombination::~ValueCombination ()
 
 }
 
+ListValueView::ListValueView () :
+	singleValue (nullptr),
+	listValue (nullptr)
+{
+
+}
+
+ListValueView::ListValueView (const ValueConstPtr& value) :
+	singleValue (nullptr),
+	listValue (nullptr)
+{
+	if (Value::IsType<SingleValue> (value)) {
+		singleValue = &value;
+	} else if (Value::IsType<IListValue> (value)) {
+		listValue = Value::Cast<IListValue> (value.get ());
+	} else {
+		DBGBREAK ();
+	}
+}
+
+size_t ListValueView::GetSize () const
+{
+	if (singleValue != nullptr) {
+		return 1;
+	} else if (listValue != nullptr) {
+		return listValue->GetSize ();
+	}
+	return 0;
+}
+
+ValueConstPtr ListValueView::GetValue (size_t index) const
+{
+	if (singleValue != nullptr) {
+		return *singleValue;
+	}
+	return listValue->GetElement (index);
+}
+
 static bool EnumerateShortestCombinations (	const std::vector<IListValueConstPtr>& values,
 											const std::function<bool (const ValueCombination&)>& processor)
 {
@@ -36,9 +75,9 @@ static bool EnumerateShortestCombinations (	const std::vector<IListValueConstPtr
 			return values.size ();
 		}
 
-		virtual const ValueConstPtr& GetValue (size_t valueIndex) const override
+		virtual ValueConstPtr GetValue (size_t valueIndex) const override
 		{
-			return values[valueIndex]->GetValue (combinationIndex);
+			return values[valueIndex]->GetElement (combinationIndex);
 		}
 
 	private:
@@ -80,13 +119,13 @@ static bool EnumerateLongestCombinations (	const std::vector<IListValueConstPtr>
 			return values.size ();
 		}
 
-		virtual const ValueConstPtr& GetValue (size_t valueIndex) const override
+		virtual ValueConstPtr GetValue (size_t valueIndex) const override
 		{
 			const IListValueConstPtr& value = values[valueIndex];
 			if (combinationIndex < value->GetSize ()) {
-				return value->GetValue (combinationIndex);
+				return value->GetElement (combinationIndex);
 			} else {
-				return value->GetValue (value->GetSize () - 1);
+				return value->GetElement (value->GetSize () - 1);
 			}
 		}
 
@@ -129,9 +168,9 @@ static bool EnumerateCrossProductCombinations (	const std::vector<IListValueCons
 			return values.size ();
 		}
 
-		virtual const ValueConstPtr& GetValue (size_t valueIndex) const override
+		virtual ValueConstPtr GetValue (size_t valueIndex) const override
 		{
-			return values[valueIndex]->GetValue (indices[valueIndex]);
+			return values[valueIndex]->GetElement (indices[valueIndex]);
 		}
 
 	private:
@@ -2,9 +2,12 @@
 #define NE_VALUECOMBINATION_HPP
 
 #include "NE_Value.hpp"
+#include "NE_Debug.hpp"
 
 #include <functional>
 #include <vector>
+#include <array>
+#include <algorithm>
 
 namespace NE
 {
@@ -23,12 +26,271 @@ public:
 	virtual ~ValueCombination ();
 
 	virtual size_t					GetSize () const = 0;
-	virtual const ValueConstPtr&	GetValue (size_t index) const = 0;
+	virtual ValueConstPtr			GetValue (size_t index) const = 0;
 };
 
 bool CombineValues (ValueCombinationMode combinationMode, const std::vector<ValueConstPtr>& values,
 					const std::function<bool (const ValueCombination&)>& processor);
 
+template <size_t ValueCount>
+using CombinationIndices = std::array<size_t, ValueCount>;
+
+template <size_t ValueCount>
+class CombinationBlock
+{
+public:
+	CombinationBlock ();
+
+	CombinationIndices<ValueCount>	firstIndices;
+	CombinationIndices<ValueCount>	strides;
+	size_t							count;
+};
+
+template <size_t ValueCount>
+class ValueCombinationIterator
+{
+public:
+	ValueCombinationIterator (ValueCombinationMode combinationMode, const CombinationIndices<ValueCount>& sizes);
+
+	bool		IsValid () const;
+	size_t		GetCombinationCount () const;
+
+	template <class Processor>
+	bool		Enumerate (const Processor& processor) const;
+
+	template <class Processor>
+	bool		EnumerateBlocks (const Processor& processor) const;
+
+private:
+	template <class Processor>
+	bool		EnumerateLongestBlocks (const Processor& processor) const;
+
+	template <class Processor>
+	bool		EnumerateCrossProductBlocks (const Processor& processor) const;
+
+	ValueCombinationMode			combinationMode;
+	CombinationIndices<ValueCount>	sizes;
+};
+
+// does not own the value, it has to outlive the view
+class ListValueView
+{
+public:
+	ListValueView ();
+	ListValueView (const ValueConstPtr& value);
+
+	size_t					GetSize () const;
+	ValueConstPtr			GetValue (size_t index) const;
+
+private:
+	const ValueConstPtr*	singleValue;
+	const IListValue*		listValue;
+};
+
+template <size_t ValueCount>
+class ListValueCombination
+{
+public:
+	ListValueCombination (const std::array<ListValueView, ValueCount>& lists, const CombinationIndices<ValueCount>& indices);
+
+	size_t			GetSize () const;
+	ValueConstPtr	GetValue (size_t valueIndex) const;
+
+private:
+	const std::array<ListValueView, ValueCount>&	lists;
+	const CombinationIndices<ValueCount>&			indices;
+};
+
+template <size_t ValueCount>
+CombinationBlock<ValueCount>::CombinationBlock () :
+	firstIndices (),
+	strides (),
+	count (0)
+{
+	firstIndices.fill (0);
+	strides.fill (0);
+}
+
+template <size_t ValueCount>
+ValueCombinationIterator<ValueCount>::ValueCombinationIterator (ValueCombinationMode combinationMode, const CombinationIndices<ValueCount>& sizes) :
+	combinationMode (combinationMode),
+	sizes (sizes)
+{
+	static_assert (ValueCount > 0, "at least one value is needed for combination");
+}
+
+template <size_t ValueCount>
+bool ValueCombinationIterator<ValueCount>::IsValid () const
+{
+	for (size_t size : sizes) {
+		if (size == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <size_t ValueCount>
+size_t ValueCombinationIterator<ValueCount>::GetCombinationCount () const
+{
+	if (!IsValid ()) {
+		return 0;
+	}
+	if (combinationMode == ValueCombinationMode::Shortest) {
+		return *std::min_element (sizes.begin (), sizes.end ());
+	} else if (combinationMode == ValueCombinationMode::Longest) {
+		return *std::max_element (sizes.begin (), sizes.end ());
+	} else if (combinationMode == ValueCombinationMode::CrossProduct) {
+		size_t combinationCount = 1;
+		for (size_t size : sizes) {
+			combinationCount *= size;
+		}
+		return combinationCount;
+	}
+	return 0;
+}
+
+template <size_t ValueCount>
+template <class Processor>
+bool ValueCombinationIterator<ValueCount>::Enumerate (const Processor& processor) const
+{
+	CombinationIndices<ValueCount> indices;
+	return EnumerateBlocks ([&] (const CombinationBlock<ValueCount>& block) {
+		indices = block.firstIndices;
+		for (size_t i = 0; i < block.count; ++i) {
+			if (!processor (indices)) {
+				return false;
+			}
+			for (size_t valueIndex = 0; valueIndex < ValueCount; ++valueIndex) {
+				indices[valueIndex] += block.strides[valueIndex];
+			}
+		}
+		return true;
+	});
+}
+
+template <size_t ValueCount>
+template <class Processor>
+bool ValueCombinationIterator<ValueCount>::EnumerateBlocks (const Processor& processor) const
+{
+	if (!IsValid ()) {
+		return false;
+	}
+	if (combinationMode == ValueCombinationMode::Shortest) {
+		CombinationBlock<ValueCount> block;
+		block.strides.fill (1);
+		block.count = GetCombinationCount ();
+		return processor (block);
+	} else if (combinationMode == ValueCombinationMode::Longest) {
+		return EnumerateLongestBlocks (processor);
+	} else if (combinationMode == ValueCombinationMode::CrossProduct) {
+		return EnumerateCrossProductBlocks (processor);
+	}
+	return false;
+}
+
+template <size_t ValueCount>
+template <class Processor>
+bool ValueCombinationIterator<ValueCount>::EnumerateLongestBlocks (const Processor& processor) const
+{
+	// every block ends where the next list runs out, from then on its last element is repeated
+	size_t maxSize = GetCombinationCount ();
+	size_t blockStart = 0;
+	while (blockStart < maxSize) {
+		CombinationBlock<ValueCount> block;
+		size_t blockEnd = maxSize;
+		for (size_t valueIndex = 0; valueIndex < ValueCount; ++valueIndex) {
+			size_t size = sizes[valueIndex];
+			if (blockStart < size) {
+				block.firstIndices[valueIndex] = blockStart;
+				block.strides[valueIndex] = 1;
+				blockEnd = std::min (blockEnd, size);
+			} else {
+				block.firstIndices[valueIndex] = size - 1;
+				block.strides[valueIndex] = 0;
+			}
+		}
+		block.count = blockEnd - blockStart;
+		if (!processor (block)) {
+			return false;
+		}
+		blockStart = blockEnd;
+	}
+	return true;
+}
+
+template <size_t ValueCount>
+template <class Processor>
+bool ValueCombinationIterator<ValueCount>::EnumerateCrossProductBlocks (const Processor& processor) const
+{
+	// the last value changes the fastest, so every block runs through the last list
+	CombinationBlock<ValueCount> block;
+	block.strides[ValueCount - 1] = 1;
+	block.count = sizes[ValueCount - 1];
+	while (true) {
+		if (!processor (block)) {
+			return false;
+		}
+		size_t valueIndex = ValueCount - 1;
+		while (valueIndex > 0) {
+			valueIndex -= 1;
+			if (block.firstIndices[valueIndex] + 1 < sizes[valueIndex]) {
+				block.firstIndices[valueIndex] += 1;
+				break;
+			}
+			block.firstIndices[valueIndex] = 0;
+			if (valueIndex == 0) {
+				return true;
+			}
+		}
+		if (ValueCount == 1) {
+			return true;
+		}
+	}
+}
+
+template <size_t ValueCount>
+ListValueCombination<ValueCount>::ListValueCombination (const std::array<ListValueView, ValueCount>& lists, const CombinationIndices<ValueCount>& indices) :
+	lists (lists),
+	indices (indices)
+{
+
+}
+
+template <size_t ValueCount>
+size_t ListValueCombination<ValueCount>::GetSize () const
+{
+	return ValueCount;
+}
+
+template <size_t ValueCount>
+ValueConstPtr ListValueCombination<ValueCount>::GetValue (size_t valueIndex) const
+{
+	return lists[valueIndex].GetValue (indices[valueIndex]);
+}
+
+template <size_t ValueCount, class Processor>
+bool CombineValues (ValueCombinationMode combinationMode, const std::array<ValueConstPtr, ValueCount>& values, const Processor& processor)
+{
+	std::array<ListValueView, ValueCount> lists;
+	CombinationIndices<ValueCount> sizes;
+	for (size_t valueIndex = 0; valueIndex < ValueCount; ++valueIndex) {
+		if (DBGERROR (values[valueIndex] == nullptr)) {
+			return false;
+		}
+		lists[valueIndex] = ListValueView (values[valueIndex]);
+		sizes[valueIndex] = lists[valueIndex].GetSize ();
+		if (DBGERROR (sizes[valueIndex] == 0)) {
+			return false;
+		}
+	}
+	ValueCombinationIterator<ValueCount> iterator (combinationMode, sizes);
+	return iterator.Enumerate ([&] (const CombinationIndices<ValueCount>& indices) {
+		ListValueCombination<ValueCount> combination (lists, indices);
+		return processor (combination);
+	});
+}
+
 }
 
 #endif
@@ -0,0 +1,242 @@
+#include "NE_ValueHandle.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_Debug.hpp"
+#include "NE_Utils.hpp"
+
+namespace NE
+{
+
+ValueHandle::ValueHandle () :
+	kind (Kind::Null),
+	scalar (),
+	object (nullptr)
+{
+
+}
+
+ValueHandle::ValueHandle (std::nullptr_t) :
+	ValueHandle ()
+{
+
+}
+
+ValueHandle::ValueHandle (bool val) :
+	kind (Kind::Boolean),
+	scalar (),
+	object (nullptr)
+{
+	scalar.booleanValue = val;
+}
+
+ValueHandle::ValueHandle (int val) :
+	kind (Kind::Integer),
+	scalar (),
+	object (nullptr)
+{
+	scalar.integerValue = val;
+}
+
+ValueHandle::ValueHandle (float val) :
+	kind (Kind::Float),
+	scalar (),
+	object (nullptr)
+{
+	scalar.floatValue = val;
+}
+
+ValueHandle::ValueHandle (double val) :
+	kind (Kind::Double),
+	scalar (),
+	object (nullptr)
+{
+	scalar.doubleValue = val;
+}
+
+ValueHandle::~ValueHandle ()
+{
+
+}
+
+ValueHandle::operator ValueConstPtr () const
+{
+	return GetValue ();
+}
+
+bool ValueHandle::operator== (std::nullptr_t) const
+{
+	return kind == Kind::Null;
+}
+
+bool ValueHandle::operator!= (std::nullptr_t) const
+{
+	return kind != Kind::Null;
+}
+
+ValueHandle::Kind ValueHandle::GetKind () const
+{
+	return kind;
+}
+
+bool ValueHandle::IsNull () const
+{
+	return kind == Kind::Null;
+}
+
+bool ValueHandle::IsScalar () const
+{
+	return kind != Kind::Null && kind != Kind::Object;
+}
+
+bool ValueHandle::IsNumber () const
+{
+	switch (kind) {
+		case Kind::Null:
+		case Kind::Boolean:
+			return false;
+		case Kind::Integer:
+		case Kind::Float:
+		case Kind::Double:
+			return true;
+		case Kind::Object:
+			return Value::IsType<NumberValue> (object);
+	}
+	DBGBREAK ();
+	return false;
+}
+
+ValueConstPtr ValueHandle::GetValue () const
+{
+	if (IsScalar ()) {
+		return CreateBoxedValue ();
+	}
+	return object;
+}
+
+const Value* ValueHandle::GetObject () const
+{
+	if (kind != Kind::Object) {
+		return nullptr;
+	}
+	return object.get ();
+}
+
+bool ValueHandle::ToBoolean () const
+{
+	if (kind == Kind::Boolean) {
+		return scalar.booleanValue;
+	}
+	if (DBGERROR (!Value::IsType<BooleanValue> (object))) {
+		return false;
+	}
+	return BooleanValue::Get (object);
+}
+
+int ValueHandle::ToInteger () const
+{
+	switch (kind) {
+		case Kind::Integer:
+			return scalar.integerValue;
+		case Kind::Float:
+			return (int) scalar.floatValue;
+		case Kind::Double:
+			return (int) scalar.doubleValue;
+		case Kind::Object:
+			if (DBGERROR (!Value::IsType<NumberValue> (object))) {
+				return 0;
+			}
+			return NumberValue::ToInteger (object);
+		default:
+			DBGBREAK ();
+			return 0;
+	}
+}
+
+float ValueHandle::ToFloat () const
+{
+	switch (kind) {
+		case Kind::Integer:
+			return (float) scalar.integerValue;
+		case Kind::Float:
+			return scalar.floatValue;
+		case Kind::Double:
+			return (float) scalar.doubleValue;
+		case Kind::Object:
+			if (DBGERROR (!Value::IsType<NumberValue> (object))) {
+				return 0.0f;
+			}
+			return NumberValue::ToFloat (object);
+		default:
+			DBGBREAK ();
+			return 0.0f;
+	}
+}
+
+double ValueHandle::ToDouble () const
+{
+	switch (kind) {
+		case Kind::Integer:
+			return (double) scalar.integerValue;
+		case Kind::Float:
+			return (double) scalar.floatValue;
+		case Kind::Double:
+			return scalar.doubleValue;
+		case Kind::Object:
+			if (DBGERROR (!Value::IsType<NumberValue> (object))) {
+				return 0.0;
+			}
+			return NumberValue::ToDouble (object);
+		default:
+			DBGBREAK ();
+			return 0.0;
+	}
+}
+
+size_t ValueHandle::GetMemorySize () const
+{
+	// inline scalars don't own any memory outside of the handle
+	if (object == nullptr) {
+		return 0;
+	}
+	return object->GetMemorySize ();
+}
+
+uint64_t ValueHandle::GetContentHash () const
+{
+	// inline scalars are hashed by their kind and bits, so they need no boxing
+	uint64_t hash = CalculateFnvHash (&kind, sizeof (kind));
+	switch (kind) {
+		case Kind::Null:
+			return hash;
+		case Kind::Boolean:
+			return CalculateFnvHash (&scalar.booleanValue, sizeof (scalar.booleanValue), hash);
+		case Kind::Integer:
+			return CalculateFnvHash (&scalar.integerValue, sizeof (scalar.integerValue), hash);
+		case Kind::Float:
+			return CalculateFnvHash (&scalar.floatValue, sizeof (scalar.floatValue), hash);
+		case Kind::Double:
+			return CalculateFnvHash (&scalar.doubleValue, sizeof (scalar.doubleValue), hash);
+		case Kind::Object:
+			return object->GetContentHash ();
+	}
+	DBGBREAK ();
+	return hash;
+}
+
+ValueConstPtr ValueHandle::CreateBoxedValue () const
+{
+	switch (kind) {
+		case Kind::Boolean:
+			return ValueConstPtr (new BooleanValue (scalar.booleanValue));
+		case Kind::Integer:
+			return ValueConstPtr (new IntValue (scalar.integerValue));
+		case Kind::Float:
+			return ValueConstPtr (new FloatValue (scalar.floatValue));
+		case Kind::Double:
+			return ValueConstPtr (new DoubleValue (scalar.doubleValue));
+		default:
+			DBGBREAK ();
+			return nullptr;
+	}
+}
+
+}
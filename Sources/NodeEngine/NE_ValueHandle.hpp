@@ -0,0 +1,86 @@
+#ifndef NE_VALUEHANDLE_HPP
+#define NE_VALUEHANDLE_HPP
+
+#include "NE_Value.hpp"
+
+#include <cstddef>
+
+namespace NE
+{
+
+// holds boolean and number scalars inline without heap allocation,
+// every other value is held by its shared pointer, a scalar is boxed
+// only when a value pointer is requested, the boxed value is not kept,
+// so the handle is never modified and can be shared between threads
+class ValueHandle
+{
+public:
+	enum class Kind
+	{
+		Null,
+		Boolean,
+		Integer,
+		Float,
+		Double,
+		Object
+	};
+
+	ValueHandle ();
+	ValueHandle (std::nullptr_t);
+	explicit ValueHandle (bool val);
+	explicit ValueHandle (int val);
+	explicit ValueHandle (float val);
+	explicit ValueHandle (double val);
+	template <typename Type>
+	ValueHandle (const std::shared_ptr<Type>& val);
+	~ValueHandle ();
+
+	operator ValueConstPtr () const;
+
+	bool				operator== (std::nullptr_t) const;
+	bool				operator!= (std::nullptr_t) const;
+
+	Kind				GetKind () const;
+	bool				IsNull () const;
+	bool				IsScalar () const;
+	bool				IsNumber () const;
+
+	ValueConstPtr		GetValue () const;
+	const Value*		GetObject () const;
+
+	bool				ToBoolean () const;
+	int					ToInteger () const;
+	float				ToFloat () const;
+	double				ToDouble () const;
+
+	size_t				GetMemorySize () const;
+	uint64_t			GetContentHash () const;
+
+private:
+	ValueConstPtr		CreateBoxedValue () const;
+
+	union Scalar
+	{
+		bool	booleanValue;
+		int		integerValue;
+		float	floatValue;
+		double	doubleValue;
+	};
+
+	Kind			kind;
+	Scalar			scalar;
+	ValueConstPtr	object;
+};
+
+template <typename Type>
+ValueHandle::ValueHandle (const std::shared_ptr<Type>& val) :
+	kind (val != nullptr ? Kind::Object : Kind::Null),
+	scalar (),
+	object (val)
+{
+
+}
+
+}
+
+#endif
@@ -0,0 +1,238 @@
+#include "BenchmarkNodes.hpp"
+#include "NE_SingleValues.hpp"
+
+#include <cmath>
+
+DYNAMIC_SERIALIZATION_INFO (IncreaseNode, 1, "{8E1C6D0F-6B63-4E4B-9B0E-2D4C8A8E3B51}");
+DYNAMIC_SERIALIZATION_INFO (ScalarIncreaseNode, 1, "{3B7D1E92-5A4C-4F86-B0D3-6E28C9A471F5}");
+DYNAMIC_SERIALIZATION_INFO (AverageNode, 1, "{0F6B3C5E-2E57-4C1A-8D8A-7B3E64A1C9D2}");
+DYNAMIC_SERIALIZATION_INFO (WorkloadNode, 1, "{5D2A9E47-83C1-4F0B-A6E2-91B7C4D3F018}");
+
+IncreaseNode::IncreaseNode () :
+	Node ()
+{
+
+}
+
+void IncreaseNode::Initialize ()
+{
+	RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("in"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+	RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+}
+
+bool IncreaseNode::IsThreadSafe () const
+{
+	return true;
+}
+
+ValueConstPtr IncreaseNode::Calculate (NE::EvaluationEnv& env) const
+{
+	ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+	return ValuePtr (new IntValue (IntValue::Get (in) + 1));
+}
+
+Stream::Status IncreaseNode::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Node::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status IncreaseNode::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Node::Write (outputStream);
+	return outputStream.GetStatus ();
+}
+
+ScalarIncreaseNode::ScalarIncreaseNode () :
+	Node ()
+{
+
+}
+
+void ScalarIncreaseNode::Initialize ()
+{
+	RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("in"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+	RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+}
+
+bool ScalarIncreaseNode::IsThreadSafe () const
+{
+	return true;
+}
+
+bool ScalarIncreaseNode::IsCalculatedValueProcessed () const
+{
+	return false;
+}
+
+ValueConstPtr ScalarIncreaseNode::Calculate (NE::EvaluationEnv& env) const
+{
+	return CalculateHandle (env);
+}
+
+ValueHandle ScalarIncreaseNode::CalculateHandle (NE::EvaluationEnv& env) const
+{
+	ValueHandle in = EvaluateInputSlot (SlotId ("in"), env);
+	return ValueHandle (in.ToInteger () + 1);
+}
+
+Stream::Status ScalarIncreaseNode::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Node::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status ScalarIncreaseNode::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Node::Write (outputStream);
+	return outputStream.GetStatus ();
+}
+
+AverageNode::AverageNode () :
+	Node ()
+{
+
+}
+
+void AverageNode::Initialize ()
+{
+	RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("a"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+	RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("b"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+	RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+}
+
+bool AverageNode::IsThreadSafe () const
+{
+	return true;
+}
+
+ValueConstPtr AverageNode::Calculate (NE::EvaluationEnv& env) const
+{
+	ValueConstPtr a = EvaluateInputSlot (SlotId ("a"), env);
+	ValueConstPtr b = EvaluateInputSlot (SlotId ("b"), env);
+	return ValuePtr (new IntValue ((IntValue::Get (a) + IntValue::Get (b)) / 2));
+}
+
+Stream::Status AverageNode::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Node::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status AverageNode::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Node::Write (outputStream);
+	return outputStream.GetStatus ();
+}
+
+WorkloadNode::WorkloadNode () :
+	WorkloadNode (0)
+{
+
+}
+
+WorkloadNode::WorkloadNode (size_t iterationCount) :
+	Node (),
+	iterationCount (iterationCount)
+{
+
+}
+
+void WorkloadNode::Initialize ()
+{
+	RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("a"), ValuePtr (new DoubleValue (1.0)), OutputSlotConnectionMode::Single)));
+	RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("b"), ValuePtr (new DoubleValue (1.0)), OutputSlotConnectionMode::Single)));
+	RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+}
+
+bool WorkloadNode::IsThreadSafe () const
+{
+	return true;
+}
+
+ValueConstPtr WorkloadNode::Calculate (NE::EvaluationEnv& env) const
+{
+	ValueConstPtr a = EvaluateInputSlot (SlotId ("a"), env);
+	ValueConstPtr b = EvaluateInputSlot (SlotId ("b"), env);
+	double result = DoubleValue::Get (a) + DoubleValue::Get (b);
+	for (size_t i = 0; i < iterationCount; ++i) {
+		result = std::sqrt (result * result + 1.0) * 0.5;
+	}
+	return ValuePtr (new DoubleValue (result));
+}
+
+Stream::Status WorkloadNode::Read (InputStream& inputStream)
+{
+	ObjectHeader header (inputStream);
+	Node::Read (inputStream);
+	inputStream.Read (iterationCount);
+	return inputStream.GetStatus ();
+}
+
+Stream::Status WorkloadNode::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	Node::Write (outputStream);
+	outputStream.Write (iterationCount);
+	return outputStream.GetStatus ();
+}
+
+std::vector<NodePtr> BuildDiamondGraph (NodeManager& manager, size_t layerCount)
+{
+	std::vector<NodePtr> nodes;
+	NodePtr rootNode = manager.AddNode (NodePtr (new IncreaseNode ()));
+	NodePtr lastNode = rootNode;
+	nodes.push_back (rootNode);
+	for (size_t i = 0; i < layerCount; ++i) {
+		NodePtr branchNode1 = manager.AddNode (NodePtr (new IncreaseNode ()));
+		NodePtr branchNode2 = manager.AddNode (NodePtr (new IncreaseNode ()));
+		NodePtr joinNode = manager.AddNode (NodePtr (new AverageNode ()));
+		manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), branchNode1->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), branchNode2->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (branchNode1->GetOutputSlot (SlotId ("out")), joinNode->GetInputSlot (SlotId ("a")));
+		manager.ConnectOutputSlotToInputSlot (branchNode2->GetOutputSlot (SlotId ("out")), joinNode->GetInputSlot (SlotId ("b")));
+		nodes.push_back (branchNode1);
+		nodes.push_back (branchNode2);
+		nodes.push_back (joinNode);
+		lastNode = joinNode;
+	}
+	return nodes;
+}
+
+std::vector<NodePtr> BuildChain (NodeManager& manager, size_t length, bool isScalar)
+{
+	std::vector<NodePtr> nodes;
+	for (size_t i = 0; i < length; ++i) {
+		NodePtr node = manager.AddNode (isScalar ? NodePtr (new ScalarIncreaseNode ()) : NodePtr (new IncreaseNode ()));
+		if (!nodes.empty ()) {
+			manager.ConnectOutputSlotToInputSlot (nodes.back ()->GetOutputSlot (SlotId ("out")), node->GetInputSlot (SlotId ("in")));
+		}
+		nodes.push_back (node);
+	}
+	return nodes;
+}
+
+std::vector<NodePtr> BuildWideGraph (NodeManager& manager, size_t width, size_t depth, size_t iterationCount)
+{
+	std::vector<NodePtr> lastLayer;
+	for (size_t i = 0; i < width; ++i) {
+		lastLayer.push_back (manager.AddNode (NodePtr (new WorkloadNode (iterationCount))));
+	}
+	for (size_t layer = 1; layer < depth; ++layer) {
+		std::vector<NodePtr> newLayer;
+		for (size_t i = 0; i < width; ++i) {
+			NodePtr node = manager.AddNode (NodePtr (new WorkloadNode (iterationCount)));
+			manager.ConnectOutputSlotToInputSlot (lastLayer[i]->GetOutputSlot (SlotId ("out")), node->GetInputSlot (SlotId ("a")));
+			manager.ConnectOutputSlotToInputSlot (lastLayer[(i + 1) % width]->GetOutputSlot (SlotId ("out")), node->GetInputSlot (SlotId ("b")));
+			newLayer.push_back (node);
+		}
+		lastLayer = newLayer;
+	}
+	return lastLayer;
+}
@@ -0,0 +1,89 @@
+#ifndef BENCHMARKNODES_HPP
+#define BENCHMARKNODES_HPP
+
+#include "NE_NodeManager.hpp"
+#include "NE_Node.hpp"
+
+using namespace NE;
+
+class IncreaseNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (IncreaseNode);
+
+public:
+	IncreaseNode ();
+
+	virtual void				Initialize () override;
+	virtual bool				IsThreadSafe () const override;
+	virtual ValueConstPtr		Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+class ScalarIncreaseNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (ScalarIncreaseNode);
+
+public:
+	ScalarIncreaseNode ();
+
+	virtual void				Initialize () override;
+	virtual bool				IsThreadSafe () const override;
+	virtual bool				IsCalculatedValueProcessed () const override;
+	virtual ValueConstPtr		Calculate (NE::EvaluationEnv& env) const override;
+	virtual ValueHandle			CalculateHandle (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+class AverageNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (AverageNode);
+
+public:
+	AverageNode ();
+
+	virtual void				Initialize () override;
+	virtual bool				IsThreadSafe () const override;
+	virtual ValueConstPtr		Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+class WorkloadNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (WorkloadNode);
+
+public:
+	WorkloadNode ();
+	WorkloadNode (size_t iterationCount);
+
+	virtual void				Initialize () override;
+	virtual bool				IsThreadSafe () const override;
+	virtual ValueConstPtr		Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+
+private:
+	size_t	iterationCount;
+};
+
+//      +-> b -+
+// r ---+      +-> j ... (layerCount times)
+//      +-> b -+
+// returns the nodes in creation order, the first one is the root
+std::vector<NodePtr> BuildDiamondGraph (NodeManager& manager, size_t layerCount);
+
+// a chain of increase nodes, the scalar version passes the values in handles,
+// returns the nodes in creation order, the first one is the root
+std::vector<NodePtr> BuildChain (NodeManager& manager, size_t length, bool isScalar);
+
+// depth layers of width workload nodes, every node reads its own and its
+// right neighbour's predecessor, returns the nodes of the last layer
+std::vector<NodePtr> BuildWideGraph (NodeManager& manager, size_t width, size_t depth, size_t iterationCount);
+
+#endif
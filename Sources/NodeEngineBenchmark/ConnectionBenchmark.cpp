@@ -0,0 +1,131 @@
+#include "SimpleBenchmark.hpp"
+#include "BenchmarkNodes.hpp"
+
+namespace ConnectionBenchmark
+{
+
+BENCHMARK (DiamondGraphCycleCheckBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t layerCount = 64; layerCount <= 4096; layerCount *= 2) {
+		NodeManager manager;
+		std::vector<NodePtr> nodes = BuildDiamondGraph (manager, layerCount);
+		const NodePtr& firstNode = nodes.front ();
+		const NodePtr& lastNode = nodes.back ();
+		NodePtr newNode = manager.AddNode (NodePtr (new IncreaseNode ()));
+
+		bool canConnect = false;
+		double forwardMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			canConnect = manager.CanConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), newNode->GetInputSlot (SlotId ("in")));
+		});
+		Report ("CanConnect (forward)", manager.GetNodeCount (), forwardMilliseconds);
+
+		double cycleMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			canConnect = manager.CanConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), firstNode->GetInputSlot (SlotId ("in")));
+		});
+		Report ("CanConnect (cycle)", manager.GetNodeCount (), cycleMilliseconds);
+	}
+}
+
+BENCHMARK (ReversedChainConnectionBenchmark)
+{
+	for (size_t nodeCount = 256; nodeCount <= 2048; nodeCount *= 2) {
+		NodeManager manager;
+		std::vector<NodePtr> nodes;
+		for (size_t i = 0; i < nodeCount; ++i) {
+			nodes.push_back (manager.AddNode (NodePtr (new IncreaseNode ())));
+		}
+		SimpleBenchmark::Timer timer;
+		for (size_t i = nodeCount - 1; i > 0; --i) {
+			manager.ConnectOutputSlotToInputSlot (nodes[i]->GetOutputSlot (SlotId ("out")), nodes[i - 1]->GetInputSlot (SlotId ("in")));
+		}
+		Report ("Connect (reversed chain)", nodeCount, timer.GetElapsedMilliseconds ());
+	}
+}
+
+BENCHMARK (ConnectionQueryBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t nodeCount = 1024; nodeCount <= 16384; nodeCount *= 4) {
+		NodeManager manager;
+		std::vector<NodePtr> nodes = BuildChain (manager, nodeCount, false);
+		std::vector<OutputSlotConstPtr> outputSlots;
+		std::vector<InputSlotConstPtr> inputSlots;
+		for (const NodePtr& node : nodes) {
+			outputSlots.push_back (node->GetOutputSlot (SlotId ("out")));
+			inputSlots.push_back (node->GetInputSlot (SlotId ("in")));
+		}
+
+		size_t connectionCount = 0;
+		double degreeMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (const OutputSlotConstPtr& outputSlot : outputSlots) {
+				connectionCount += manager.GetConnectedInputSlotCount (outputSlot);
+			}
+		});
+		Report ("Degree", nodeCount, degreeMilliseconds);
+
+		double enumerateMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (const InputSlotConstPtr& inputSlot : inputSlots) {
+				manager.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr&) {
+					connectionCount++;
+				});
+			}
+		});
+		Report ("Enumerate", nodeCount, enumerateMilliseconds);
+
+		double dependentMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.EnumerateDependentNodesRecursive (nodes.front (), [&] (const NodeId&) {
+				connectionCount++;
+			});
+		});
+		Report ("DependentNodes", nodeCount, dependentMilliseconds);
+	}
+}
+
+BENCHMARK (GraphStatisticsBenchmark)
+{
+	const size_t repeatCount = 1000;
+	for (size_t nodeCount = 1000; nodeCount <= 100000; nodeCount *= 10) {
+		NodeManager manager;
+		std::vector<NodePtr> nodes = BuildChain (manager, nodeCount, false);
+
+		size_t connectionCount = 0;
+		double countMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			connectionCount += manager.GetConnectionCount ();
+		});
+		Report ("GetConnectionCount", nodeCount, countMilliseconds);
+
+		// the depth is known only after the evaluation has built the plan
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		double statisticsMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			connectionCount += manager.GetGraphStatistics ().GetConnectionCount ();
+		});
+		Report ("GetGraphStatistics", nodeCount, statisticsMilliseconds);
+
+		// every edit invalidates the evaluation plan, the query doesn't rebuild it
+		const size_t editRepeatCount = 20;
+		NodePtr editNode = manager.AddNode (NodePtr (new IncreaseNode ()));
+		OutputSlotConstPtr editOutputSlot = nodes.back ()->GetOutputSlot (SlotId ("out"));
+		InputSlotConstPtr editInputSlot = editNode->GetInputSlot (SlotId ("in"));
+		double editMilliseconds = SimpleBenchmark::Measure (editRepeatCount, [&] () {
+			manager.ConnectOutputSlotToInputSlot (editOutputSlot, editInputSlot);
+			manager.DisconnectOutputSlotFromInputSlot (editOutputSlot, editInputSlot);
+		});
+		Report ("Edit", nodeCount, editMilliseconds);
+
+		double editStatisticsMilliseconds = SimpleBenchmark::Measure (editRepeatCount, [&] () {
+			manager.ConnectOutputSlotToInputSlot (editOutputSlot, editInputSlot);
+			manager.DisconnectOutputSlotFromInputSlot (editOutputSlot, editInputSlot);
+			connectionCount += manager.GetGraphStatistics ().GetConnectionCount ();
+		});
+		Report ("Edit + GetGraphStatistics", nodeCount, editStatisticsMilliseconds);
+
+		double writeMilliseconds = SimpleBenchmark::Measure (1, [&] () {
+			std::vector<char> buffer;
+			NodeManager::WriteToBuffer (manager, buffer);
+		});
+		Report ("WriteToBuffer", nodeCount, writeMilliseconds);
+	}
+}
+
+}
@@ -0,0 +1,113 @@
+#include "SimpleBenchmark.hpp"
+#include "NE_EvaluationEnv.hpp"
+#include "NE_NodeManager.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_Value.hpp"
+#include "BI_BuiltInSlotIds.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_BinaryOperationNodes.hpp"
+
+#include <thread>
+
+using namespace NE;
+
+namespace EvaluationArenaBenchmark
+{
+
+// simulates one evaluation pass that builds a list of boxed values
+static double BuildListValue (EvaluationEnv& env, size_t size)
+{
+	ListValuePtr list = env.CreateTemporary<ListValue> ();
+	for (size_t i = 0; i < size; ++i) {
+		list->Push (env.CreateTemporary<DoubleValue> ((double) i));
+	}
+	return DoubleValue::Get (list->GetValue (size - 1));
+}
+
+static double MeasureConcurrentPasses (size_t threadCount, size_t size, bool useArena)
+{
+	SimpleBenchmark::Timer timer;
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadCount; ++i) {
+		threads.push_back (std::thread ([=] () {
+			EvaluationEnv env (nullptr, useArena ? EvaluationArenaPtr (new EvaluationArena ()) : nullptr);
+			BuildListValue (env, size);
+		}));
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+	return timer.GetElapsedMilliseconds ();
+}
+
+// a chain of list builder and addition nodes, every node produces a list of the given size
+static NodePtr BuildListChain (NodeManager& manager, size_t length, size_t size)
+{
+	NodePtr sequence = manager.AddNode (NodePtr (new BI::DoubleIncrementedNode (LocString (L"Sequence"), NUIE::Point (0.0, 0.0))));
+	sequence->SetInputSlotDefaultValue (BI::CountSlotId, ValuePtr (new IntValue ((int) size)));
+	NodePtr previous = sequence;
+	for (size_t i = 0; i < length; ++i) {
+		NodePtr list = manager.AddNode (NodePtr (new BI::ListBuilderNode (LocString (L"List"), NUIE::Point (0.0, 0.0))));
+		NodePtr addition = manager.AddNode (NodePtr (new BI::AdditionNode (LocString (L"Addition"), NUIE::Point (0.0, 0.0))));
+		manager.ConnectOutputSlotToInputSlot (previous->GetOutputSlot (BI::OutSlotId), list->GetInputSlot (BI::InSlotId));
+		manager.ConnectOutputSlotToInputSlot (list->GetOutputSlot (BI::OutSlotId), addition->GetInputSlot (BI::ASlotId));
+		manager.ConnectOutputSlotToInputSlot (sequence->GetOutputSlot (BI::OutSlotId), addition->GetInputSlot (BI::BSlotId));
+		previous = addition;
+	}
+	return sequence;
+}
+
+BENCHMARK (EvaluationArenaBenchmark)
+{
+	const size_t repeatCount = 10;
+	const size_t threadCount = 4;
+	for (size_t size = 10000; size <= 1000000; size *= 10) {
+		double heapMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			BuildListValue (EmptyEvaluationEnv, size);
+		});
+		Report ("Heap", size, heapMilliseconds);
+
+		EvaluationArenaStatistics statistics;
+		double arenaMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			EvaluationArenaPtr arena (new EvaluationArena ());
+			EvaluationEnv env (nullptr, arena);
+			BuildListValue (env, size);
+			statistics = arena->GetStatistics ();
+		});
+		Report ("Arena", size, arenaMilliseconds);
+		ReportCount ("ArenaAllocations", size, statistics.GetAllocationCount ());
+		ReportCount ("ArenaChunkAllocations", size, statistics.GetChunkCount ());
+
+		double concurrentHeapMilliseconds = 0.0;
+		double concurrentArenaMilliseconds = 0.0;
+		for (size_t i = 0; i < repeatCount; ++i) {
+			concurrentHeapMilliseconds += MeasureConcurrentPasses (threadCount, size, false);
+			concurrentArenaMilliseconds += MeasureConcurrentPasses (threadCount, size, true);
+		}
+		Report ("ConcurrentHeap", size, concurrentHeapMilliseconds / (double) repeatCount);
+		Report ("ConcurrentArena", size, concurrentArenaMilliseconds / (double) repeatCount);
+	}
+}
+
+BENCHMARK (ListNodeEvaluationArenaBenchmark)
+{
+	const size_t repeatCount = 10;
+	const size_t length = 20;
+	for (size_t size = 1000; size <= 100000; size *= 10) {
+		for (bool useArena : { false, true }) {
+			NodeManager manager;
+			manager.SetEvaluationArenaEnabled (useArena);
+			NodePtr sequence = BuildListChain (manager, length, size);
+			double milliseconds = 0.0;
+			for (size_t i = 0; i < repeatCount; ++i) {
+				sequence->InvalidateValue ();
+				SimpleBenchmark::Timer timer;
+				manager.EvaluateAllNodes (EmptyEvaluationEnv);
+				milliseconds += timer.GetElapsedMilliseconds ();
+			}
+			Report (useArena ? "Arena" : "Heap", size, milliseconds / (double) repeatCount);
+		}
+	}
+}
+
+}
@@ -0,0 +1,104 @@
+#include "SimpleBenchmark.hpp"
+#include "BenchmarkNodes.hpp"
+
+namespace EvaluationBenchmark
+{
+
+static double MeasureEvaluation (NodeManager& manager, const std::vector<NodePtr>& nodes, size_t repeatCount)
+{
+	double milliseconds = 0.0;
+	for (size_t i = 0; i < repeatCount; ++i) {
+		for (const NodePtr& node : nodes) {
+			node->InvalidateValue ();
+		}
+		SimpleBenchmark::Timer timer;
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		milliseconds += timer.GetElapsedMilliseconds ();
+	}
+	return milliseconds / (double) repeatCount;
+}
+
+BENCHMARK (DiamondGraphEvaluationBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t layerCount = 256; layerCount <= 4096; layerCount *= 4) {
+		NodeManager manager;
+		NodePtr rootNode = BuildDiamondGraph (manager, layerCount).front ();
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+
+		double recalculateMilliseconds = 0.0;
+		for (size_t i = 0; i < repeatCount; ++i) {
+			rootNode->InvalidateValue ();
+			SimpleBenchmark::Timer timer;
+			manager.EvaluateAllNodes (EmptyEvaluationEnv);
+			recalculateMilliseconds += timer.GetElapsedMilliseconds ();
+		}
+		Report ("Recalculate", manager.GetNodeCount (), recalculateMilliseconds / (double) repeatCount);
+
+		double steadyMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		});
+		Report ("SteadyState", manager.GetNodeCount (), steadyMilliseconds);
+	}
+}
+
+BENCHMARK (ScalarChainEvaluationBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t length = 1000; length <= 100000; length *= 10) {
+		NodeManager boxedManager;
+		std::vector<NodePtr> boxedNodes = BuildChain (boxedManager, length, false);
+		Report ("Boxed", length, MeasureEvaluation (boxedManager, { boxedNodes.front () }, repeatCount));
+
+		NodeManager scalarManager;
+		std::vector<NodePtr> scalarNodes = BuildChain (scalarManager, length, true);
+		Report ("Handle", length, MeasureEvaluation (scalarManager, { scalarNodes.front () }, repeatCount));
+	}
+}
+
+BENCHMARK (WideGraphEvaluationBenchmark)
+{
+	const size_t repeatCount = 5;
+	const size_t depth = 8;
+	const size_t iterationCount = 2000;
+	for (size_t width = 64; width <= 1024; width *= 2) {
+		NodeManager manager;
+		BuildWideGraph (manager, width, depth, iterationCount);
+		std::vector<NodePtr> nodes;
+		manager.EnumerateNodes ([&] (NodePtr node) {
+			nodes.push_back (node);
+			return true;
+		});
+
+		manager.SetEvaluationMode (NodeManager::EvaluationMode::Serial);
+		double serialMilliseconds = MeasureEvaluation (manager, nodes, repeatCount);
+		Report ("Serial", manager.GetNodeCount (), serialMilliseconds);
+
+		manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+		double parallelMilliseconds = MeasureEvaluation (manager, nodes, repeatCount);
+		Report ("Parallel", manager.GetNodeCount (), parallelMilliseconds);
+	}
+}
+
+BENCHMARK (WideGraphCheapNodeEvaluationBenchmark)
+{
+	const size_t repeatCount = 5;
+	const size_t depth = 8;
+	for (size_t width = 256; width <= 4096; width *= 4) {
+		NodeManager manager;
+		BuildWideGraph (manager, width, depth, 0);
+		std::vector<NodePtr> nodes;
+		manager.EnumerateNodes ([&] (NodePtr node) {
+			nodes.push_back (node);
+			return true;
+		});
+
+		manager.SetEvaluationMode (NodeManager::EvaluationMode::Serial);
+		Report ("Serial", manager.GetNodeCount (), MeasureEvaluation (manager, nodes, repeatCount));
+
+		manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+		Report ("Parallel", manager.GetNodeCount (), MeasureEvaluation (manager, nodes, repeatCount));
+	}
+}
+
+}
@@ -0,0 +1,24 @@
+#include "SimpleBenchmark.hpp"
+#include "BenchmarkNodes.hpp"
+#include "NE_EvaluationSnapshot.hpp"
+
+namespace EvaluationSnapshotBenchmark
+{
+
+BENCHMARK (DiamondGraphSnapshotBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t layerCount = 64; layerCount <= 4096; layerCount *= 2) {
+		NodeManager manager;
+		NodePtr lastNode = BuildDiamondGraph (manager, layerCount).back ();
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		lastNode->InvalidateValue ();
+		double milliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			EvaluationSnapshot snapshot;
+			manager.CreateEvaluationSnapshot (snapshot);
+		});
+		Report ("CreateEvaluationSnapshot", manager.GetNodeCount (), milliseconds);
+	}
+}
+
+}
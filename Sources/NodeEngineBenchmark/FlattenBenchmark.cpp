@@ -0,0 +1,82 @@
+#include "SimpleBenchmark.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_Value.hpp"
+
+using namespace NE;
+
+namespace FlattenBenchmark
+{
+
+// every inner list contains a boxed and a typed part
+static ValueConstPtr BuildNestedList (size_t size)
+{
+	const size_t innerSize = 100;
+	ListValuePtr outerList (new ListValue ());
+	for (size_t i = 0; i < size; i += innerSize) {
+		ListValuePtr innerList (new ListValue ());
+		std::vector<double> typedValues;
+		for (size_t j = 0; j < innerSize; j++) {
+			if (j % 2 == 0) {
+				innerList->Push (ValueConstPtr (new DoubleValue ((double) (i + j))));
+			} else {
+				typedValues.push_back ((double) (i + j));
+			}
+		}
+		innerList->Push (ValueConstPtr (new DoubleListValue (std::move (typedValues))));
+		outerList->Push (innerList);
+	}
+	return outerList;
+}
+
+static double SumValues (const IListValue* list)
+{
+	double sum = 0.0;
+	list->Enumerate ([&] (const ValueConstPtr& value) {
+		sum += DoubleValue::Get (value);
+		return true;
+	});
+	return sum;
+}
+
+BENCHMARK (FlattenBenchmark)
+{
+	const size_t repeatCount = 10;
+	for (size_t size = 10000; size <= 1000000; size *= 10) {
+		ValueConstPtr nestedList = BuildNestedList (size);
+
+		double pushMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			ListValuePtr list (new ListValue ());
+			FlatEnumerate (nestedList, [&] (const ValueConstPtr& value) {
+				list->Push (value);
+				return true;
+			});
+		});
+		Report ("Push", size, pushMilliseconds);
+
+		double collectMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			FlattenValue (nestedList);
+		});
+		Report ("Collect", size, collectMilliseconds);
+
+		double viewMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			FlattenedListValue view (nestedList);
+		});
+		Report ("View", size, viewMilliseconds);
+
+		ValueConstPtr collected = FlattenValue (nestedList);
+		double collectedReadMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			SumValues (Value::Cast<ListValue> (collected.get ()));
+		});
+		Report ("CollectedRead", size, collectedReadMilliseconds);
+
+		FlattenedListValue view (nestedList);
+		double viewReadMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			SumValues (&view);
+		});
+		Report ("ViewRead", size, viewReadMilliseconds);
+		ReportCount ("ViewSegments", size, view.GetSegmentCount ());
+	}
+}
+
+}
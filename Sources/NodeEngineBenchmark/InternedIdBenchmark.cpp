@@ -0,0 +1,80 @@
+#include "SimpleBenchmark.hpp"
+#include "NE_SlotId.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_MemoryStream.hpp"
+
+#include <unordered_map>
+#include <map>
+
+using namespace NE;
+
+namespace InternedIdBenchmark
+{
+
+static std::vector<SlotId> CreateSlotIds (size_t size)
+{
+	std::vector<SlotId> slotIds;
+	for (size_t i = 0; i < size; ++i) {
+		slotIds.push_back (SlotId ("slot_" + std::to_string (i)));
+	}
+	return slotIds;
+}
+
+BENCHMARK (InternedIdBenchmark)
+{
+	const size_t repeatCount = 10;
+	for (size_t size = 1000; size <= 100000; size *= 10) {
+		std::vector<SlotId> slotIds = CreateSlotIds (size);
+
+		std::unordered_map<SlotId, size_t> hashMap;
+		std::map<SlotId, size_t> orderedMap;
+		for (size_t i = 0; i < size; ++i) {
+			hashMap.insert ({ slotIds[i], i });
+			orderedMap.insert ({ slotIds[i], i });
+		}
+
+		size_t found = 0;
+		double hashLookupMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (const SlotId& slotId : slotIds) {
+				found += hashMap.find (slotId)->second;
+			}
+		});
+		Report ("HashLookup", size, hashLookupMilliseconds);
+
+		double orderedLookupMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (const SlotId& slotId : slotIds) {
+				found += orderedMap.find (slotId)->second;
+			}
+		});
+		Report ("OrderedLookup", size, orderedLookupMilliseconds);
+
+		double compareMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (size_t i = 0; i < size; ++i) {
+				if (slotIds[i] == slotIds[size - i - 1]) {
+					found++;
+				}
+			}
+		});
+		Report ("Compare", size, compareMilliseconds);
+
+		double constructMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			CreateSlotIds (size);
+		});
+		Report ("Construct", size, constructMilliseconds);
+
+		MemoryOutputStream outputStream;
+		for (size_t i = 0; i < size; ++i) {
+			WriteDynamicObject (outputStream, ValuePtr (new IntValue ((int) i)).get ());
+		}
+		double readDynamicMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			MemoryInputStream inputStream (outputStream.GetBuffer ());
+			for (size_t i = 0; i < size; ++i) {
+				ValuePtr value (ReadDynamicObject<Value> (inputStream));
+			}
+		});
+		Report ("ReadDynamicObject", size, readDynamicMilliseconds);
+		ReportCount ("Found", size, found);
+	}
+}
+
+}
@@ -0,0 +1,54 @@
+#include "SimpleBenchmark.hpp"
+#include "BenchmarkNodes.hpp"
+
+namespace InvalidationBenchmark
+{
+
+BENCHMARK (DiamondGraphInvalidationBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t layerCount = 64; layerCount <= 4096; layerCount *= 2) {
+		NodeManager manager;
+		NodePtr rootNode = BuildDiamondGraph (manager, layerCount).front ();
+		double milliseconds = 0.0;
+		for (size_t i = 0; i < repeatCount; ++i) {
+			manager.EvaluateAllNodes (EmptyEvaluationEnv);
+			SimpleBenchmark::Timer timer;
+			rootNode->InvalidateValue ();
+			milliseconds += timer.GetElapsedMilliseconds ();
+		}
+		Report ("InvalidateValue", manager.GetNodeCount (), milliseconds / (double) repeatCount);
+	}
+}
+
+BENCHMARK (LeafInvalidationBenchmark)
+{
+	// the dependent cone of the last node is empty, so the cost must not grow with the graph
+	const size_t repeatCount = 1000;
+	for (size_t layerCount = 64; layerCount <= 65536; layerCount *= 4) {
+		NodeManager manager;
+		NodePtr leafNode = BuildDiamondGraph (manager, layerCount).back ();
+		double milliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			leafNode->InvalidateValue ();
+		});
+		Report ("InvalidateValue (leaf)", manager.GetNodeCount (), milliseconds);
+	}
+}
+
+BENCHMARK (DiamondGraphDependentNodesBenchmark)
+{
+	const size_t repeatCount = 20;
+	for (size_t layerCount = 64; layerCount <= 4096; layerCount *= 2) {
+		NodeManager manager;
+		NodePtr rootNode = BuildDiamondGraph (manager, layerCount).front ();
+		size_t dependentCount = 0;
+		double milliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.EnumerateDependentNodesRecursive (rootNode, [&] (const NodeId&) {
+				dependentCount++;
+			});
+		});
+		Report ("EnumerateDependentNodesRecursive", manager.GetNodeCount (), milliseconds);
+	}
+}
+
+}
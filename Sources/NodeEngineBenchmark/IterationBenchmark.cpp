@@ -0,0 +1,81 @@
+#include "SimpleBenchmark.hpp"
+#include "BenchmarkNodes.hpp"
+
+using namespace NE;
+
+namespace IterationBenchmark
+{
+
+BENCHMARK (IterationBenchmark)
+{
+	const size_t repeatCount = 10;
+	for (size_t size = 1000; size <= 100000; size *= 10) {
+		NodeManager manager;
+		BuildChain (manager, size, false);
+		const NodeManager& constManager = manager;
+
+		size_t count = 0;
+		double enumerateNodesMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			constManager.EnumerateNodes ([&] (NodeConstPtr) {
+				count++;
+				return true;
+			});
+		});
+		Report ("EnumerateNodes", size, enumerateNodesMilliseconds);
+
+		double forEachNodeMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			constManager.ForEachNode ([&] (const NodeConstPtr&) {
+				count++;
+				return true;
+			});
+		});
+		Report ("ForEachNode", size, forEachNodeMilliseconds);
+
+		double forEachMutableNodeMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.ForEachNode ([&] (const NodePtr&) {
+				count++;
+				return true;
+			});
+		});
+		Report ("ForEachMutableNode", size, forEachMutableNodeMilliseconds);
+
+		double enumerateSlotsMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.EnumerateNodes ([&] (NodePtr node) {
+				node->EnumerateInputSlots ([&] (InputSlotPtr) {
+					count++;
+					return true;
+				});
+				return true;
+			});
+		});
+		Report ("EnumerateSlots", size, enumerateSlotsMilliseconds);
+
+		double forEachSlotMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.ForEachNode ([&] (const NodePtr& node) {
+				node->ForEachInputSlot ([&] (const InputSlotPtr&) {
+					count++;
+					return true;
+				});
+				return true;
+			});
+		});
+		Report ("ForEachSlot", size, forEachSlotMilliseconds);
+
+		double enumerateConnectionsMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.EnumerateConnections ([&] (const OutputSlotConstPtr&, const InputSlotConstPtr&) {
+				count++;
+			});
+		});
+		Report ("EnumerateConnections", size, enumerateConnectionsMilliseconds);
+
+		double forEachConnectionMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			manager.ForEachConnection ([&] (const OutputSlotConstPtr&, const InputSlotConstPtr&) {
+				count++;
+			});
+		});
+		Report ("ForEachConnection", size, forEachConnectionMilliseconds);
+		ReportCount ("Visited", size, count);
+	}
+}
+
+}
@@ -0,0 +1,97 @@
+#include "SimpleBenchmark.hpp"
+#include "NE_OrderedMap.hpp"
+
+#include <memory>
+
+using namespace NE;
+
+namespace OrderedMapBenchmark
+{
+
+using Map = OrderedMap<size_t, std::shared_ptr<size_t>>;
+
+static void FillMap (Map& map, size_t size)
+{
+	for (size_t i = 0; i < size; ++i) {
+		map.Insert (i, std::shared_ptr<size_t> (new size_t (i)));
+	}
+}
+
+static size_t SumValues (const Map& map)
+{
+	size_t sum = 0;
+	map.Enumerate ([&] (const std::shared_ptr<size_t>& value) {
+		sum += *value;
+		return true;
+	});
+	return sum;
+}
+
+BENCHMARK (OrderedMapBenchmark)
+{
+	const size_t repeatCount = 10;
+	const size_t middleInsertCount = 1000;
+	for (size_t size = 1000; size <= 100000; size *= 10) {
+		double insertMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			Map map;
+			FillMap (map, size);
+		});
+		Report ("Insert", size, insertMilliseconds);
+
+		Map map;
+		FillMap (map, size);
+		size_t sum = 0;
+		double enumerateMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			sum += SumValues (map);
+		});
+		Report ("Enumerate", size, enumerateMilliseconds);
+
+		double lookupMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (size_t i = 0; i < size; ++i) {
+				sum += *map.GetValue (i);
+			}
+		});
+		Report ("Lookup", size, lookupMilliseconds);
+
+		double copyMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			Map copied = map;
+		});
+		Report ("Copy", size, copyMilliseconds);
+
+		double eraseMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			Map erased = map;
+			for (size_t i = 0; i < size; i += 2) {
+				erased.Erase (i);
+			}
+		});
+		Report ("Copy and erase half", size, eraseMilliseconds - copyMilliseconds);
+
+		Map halfErased = map;
+		for (size_t i = 0; i < size; i += 2) {
+			halfErased.Erase (i);
+		}
+		double erasedEnumerateMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			sum += SumValues (halfErased);
+		});
+		Report ("Enumerate after erase", size, erasedEnumerateMilliseconds);
+
+		double insertBeforeMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			Map inserted = map;
+			for (size_t i = 0; i < middleInsertCount; ++i) {
+				inserted.InsertBefore (size + i, nullptr, size / 2);
+			}
+		});
+		Report ("Copy and insert 1000 before middle", size, insertBeforeMilliseconds - copyMilliseconds);
+
+		double insertIntoErasedMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			Map inserted = halfErased;
+			for (size_t i = 1; i < size; i += 2) {
+				inserted.InsertBefore (size + i, nullptr, i);
+			}
+		});
+		Report ("Copy and insert into erased places", size, insertIntoErasedMilliseconds);
+		ReportCount ("Sum", size, sum);
+	}
+}
+
+}
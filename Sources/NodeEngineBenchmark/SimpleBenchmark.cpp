@@ -0,0 +1,100 @@
+#include "SimpleBenchmark.hpp"
+
+#include <iomanip>
+
+namespace SimpleBenchmark
+{
+
+Timer::Timer () :
+	start (std::chrono::steady_clock::now ())
+{
+
+}
+
+void Timer::Restart ()
+{
+	start = std::chrono::steady_clock::now ();
+}
+
+double Timer::GetElapsedMilliseconds () const
+{
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now () - start;
+	return elapsed.count ();
+}
+
+Benchmark::Benchmark (const std::string& benchmarkName) :
+	benchmarkName (benchmarkName)
+{
+
+}
+
+Benchmark::~Benchmark ()
+{
+
+}
+
+void Benchmark::Run ()
+{
+	std::cout << "[ RUNNING ] " << benchmarkName << std::endl;
+	RunBenchmark ();
+	std::cout << "[ ------- ] " << benchmarkName << std::endl;
+}
+
+const std::string& Benchmark::GetName () const
+{
+	return benchmarkName;
+}
+
+void Benchmark::Report (const std::string& caseName, size_t size, double milliseconds)
+{
+	std::cout << "[ MEASURE ] " << std::left << std::setw (40) << caseName;
+	std::cout << " size: " << std::right << std::setw (10) << size;
+	std::cout << " time: " << std::fixed << std::setprecision (4) << std::setw (12) << milliseconds << " ms" << std::endl;
+}
+
+void Benchmark::ReportCount (const std::string& caseName, size_t size, size_t count)
+{
+	std::cout << "[ COUNT   ] " << std::left << std::setw (40) << caseName;
+	std::cout << " size: " << std::right << std::setw (10) << size;
+	std::cout << " count: " << std::setw (11) << count << std::endl;
+}
+
+Suite::Suite ()
+{
+
+}
+
+void Suite::Run (const std::string& filter)
+{
+	for (const std::shared_ptr<Benchmark>& benchmark : benchmarks) {
+		if (!filter.empty () && benchmark->GetName ().find (filter) == std::string::npos) {
+			continue;
+		}
+		benchmark->Run ();
+	}
+}
+
+void Suite::AddBenchmark (Benchmark* benchmark)
+{
+	benchmarks.push_back (std::shared_ptr<Benchmark> (benchmark));
+}
+
+Suite& Suite::Get ()
+{
+	static Suite suite;
+	return suite;
+}
+
+void RunBenchmarks (const std::string& filter)
+{
+	Suite& suite = Suite::Get ();
+	suite.Run (filter);
+}
+
+void RegisterBenchmark (Benchmark* benchmark)
+{
+	Suite& suite = Suite::Get ();
+	suite.AddBenchmark (benchmark);
+}
+
+}
@@ -0,0 +1,89 @@
+#ifndef SIMPLEBENCHMARK_HPP
+#define SIMPLEBENCHMARK_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+
+namespace SimpleBenchmark
+{
+
+class Timer
+{
+public:
+	Timer ();
+
+	void	Restart ();
+	double	GetElapsedMilliseconds () const;
+
+private:
+	std::chrono::steady_clock::time_point start;
+};
+
+class Benchmark
+{
+public:
+	Benchmark (const std::string& benchmarkName);
+	virtual ~Benchmark ();
+
+	void				Run ();
+	const std::string&	GetName () const;
+
+protected:
+	void				Report (const std::string& caseName, size_t size, double milliseconds);
+	void				ReportCount (const std::string& caseName, size_t size, size_t count);
+	virtual void		RunBenchmark () = 0;
+
+	std::string			benchmarkName;
+};
+
+class Suite
+{
+public:
+	Suite ();
+
+	void			Run (const std::string& filter);
+	void			AddBenchmark (Benchmark* benchmark);
+
+	static Suite&	Get ();
+
+private:
+	std::vector<std::shared_ptr<Benchmark>> benchmarks;
+};
+
+template <typename Function>
+double Measure (size_t repeatCount, const Function& function)
+{
+	Timer timer;
+	for (size_t i = 0; i < repeatCount; ++i) {
+		function ();
+	}
+	return timer.GetElapsedMilliseconds () / (double) repeatCount;
+}
+
+void	RunBenchmarks (const std::string& filter);
+void	RegisterBenchmark (Benchmark* benchmark);
+
+}
+
+#define BENCHMARK(BENCHMARKNAME)												\
+class BENCHMARKNAME##_Benchmark : public SimpleBenchmark::Benchmark {			\
+public:																			\
+	BENCHMARKNAME##_Benchmark () :												\
+		SimpleBenchmark::Benchmark (#BENCHMARKNAME)								\
+	{																			\
+	}																			\
+	virtual void RunBenchmark () override;										\
+};																				\
+static class BENCHMARKNAME##_Registrator {										\
+	public:																		\
+		BENCHMARKNAME##_Registrator ()											\
+		{																		\
+			SimpleBenchmark::RegisterBenchmark (new BENCHMARKNAME##_Benchmark ());	\
+		}																		\
+} BENCHMARKNAME##_RegistratorInstance;											\
+void BENCHMARKNAME##_Benchmark::RunBenchmark ()
+
+#endif
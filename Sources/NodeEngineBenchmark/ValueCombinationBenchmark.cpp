@@ -0,0 +1,74 @@
+#include "SimpleBenchmark.hpp"
+#include "NE_ValueCombination.hpp"
+#include "NE_ListValues.hpp"
+
+using namespace NE;
+
+namespace ValueCombinationBenchmark
+{
+
+static DoubleListValuePtr CreateList (size_t size)
+{
+	std::vector<double> values (size);
+	for (size_t i = 0; i < size; ++i) {
+		values[i] = (double) i;
+	}
+	return DoubleListValuePtr (new DoubleListValue (std::move (values)));
+}
+
+BENCHMARK (ValueCombinationBenchmark)
+{
+	const size_t repeatCount = 3;
+	std::vector<std::pair<std::string, ValueCombinationMode>> combinationModes = {
+		{ "Shortest", ValueCombinationMode::Shortest },
+		{ "Longest", ValueCombinationMode::Longest },
+		{ "CrossProduct", ValueCombinationMode::CrossProduct }
+	};
+	for (const auto& combinationMode : combinationModes) {
+		for (size_t size = 1000; size <= 1000000; size *= 10) {
+			// cross product combines a short list with a long one to get the same combination count
+			size_t aSize = (combinationMode.second == ValueCombinationMode::CrossProduct) ? size / 1000 : size;
+			size_t bSize = (combinationMode.second == ValueCombinationMode::CrossProduct) ? 1000 : size / 2;
+			DoubleListValuePtr aList = CreateList (aSize);
+			DoubleListValuePtr bList = CreateList (bSize);
+
+			double sum = 0.0;
+			double legacyMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+				CombineValues (combinationMode.second, { aList, bList }, [&] (const ValueCombination& combination) {
+					sum += NumberValue::ToDouble (combination.GetValue (0)) * NumberValue::ToDouble (combination.GetValue (1));
+					return true;
+				});
+			});
+			Report (combinationMode.first + " Legacy", size, legacyMilliseconds);
+
+			double templatedMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+				CombineValues<2> (combinationMode.second, {{ aList, bList }}, [&] (const ListValueCombination<2>& combination) {
+					sum += NumberValue::ToDouble (combination.GetValue (0)) * NumberValue::ToDouble (combination.GetValue (1));
+					return true;
+				});
+			});
+			Report (combinationMode.first + " Templated", size, templatedMilliseconds);
+
+			const double* a = aList->GetValues ().data ();
+			const double* b = bList->GetValues ().data ();
+			double blocksMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+				ValueCombinationIterator<2> iterator (combinationMode.second, {{ aSize, bSize }});
+				iterator.EnumerateBlocks ([&] (const CombinationBlock<2>& block) {
+					const double* aBlock = a + block.firstIndices[0];
+					const double* bBlock = b + block.firstIndices[1];
+					for (size_t i = 0; i < block.count; ++i) {
+						sum += aBlock[i * block.strides[0]] * bBlock[i * block.strides[1]];
+					}
+					return true;
+				});
+			});
+			Report (combinationMode.first + " Blocks", size, blocksMilliseconds);
+
+			if (sum < 0.0) {
+				Report ("Invalid", size, sum);
+			}
+		}
+	}
+}
+
+}
@@ -0,0 +1,48 @@
+#include "SimpleBenchmark.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_ListValues.hpp"
+
+using namespace NE;
+
+namespace ValueTypeBenchmark
+{
+
+BENCHMARK (ValueTypeBenchmark)
+{
+	const size_t repeatCount = 5;
+	for (size_t size = 10000; size <= 1000000; size *= 10) {
+		std::vector<ValueConstPtr> values;
+		for (size_t i = 0; i < size; ++i) {
+			if (i % 2 == 0) {
+				values.push_back (ValueConstPtr (new IntValue ((int) i)));
+			} else {
+				values.push_back (ValueConstPtr (new DoubleValue ((double) i)));
+			}
+		}
+
+		double sum = 0.0;
+		double dynamicCastMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (const ValueConstPtr& value : values) {
+				if (dynamic_cast<const IListValue*> (value.get ()) == nullptr) {
+					sum += dynamic_cast<const NumberValue*> (value.get ())->ToDouble ();
+				}
+			}
+		});
+		Report ("DynamicCast", size, dynamicCastMilliseconds);
+
+		double typeInfoMilliseconds = SimpleBenchmark::Measure (repeatCount, [&] () {
+			for (const ValueConstPtr& value : values) {
+				if (!Value::IsType<IListValue> (value)) {
+					sum += NumberValue::ToDouble (value);
+				}
+			}
+		});
+		Report ("ValueTypeInfo", size, typeInfoMilliseconds);
+
+		if (sum < 0.0) {
+			Report ("Invalid", size, sum);
+		}
+	}
+}
+
+}
@@ -2,6 +2,7 @@
 #include "NUIE_NodeUIManager.hpp"
 #include "BI_BinaryOperationNodes.hpp"
 #include "BI_InputUINodes.hpp"
+#include "NE_ListValues.hpp"
 #include "TestUtils.hpp"
 
 using namespace NE;
@@ -46,7 +47,7 @@ TEST (TestAdditionNodeWithList)
 	uiManager.ConnectOutputSlotToInputSlot (val2->GetUIOutputSlot (SlotId ("out")), op->GetUIInputSlot (SlotId ("b")));
 
 	ValueConstPtr val = op->Evaluate (EmptyEvaluationEnv);
-	ASSERT (Value::IsType<ListValue> (val));
+	ASSERT (Value::IsType<DoubleSequenceValue> (val));
 	ASSERT (IsComplexType<NumberValue> (val));
 	std::vector<double> values;
 	FlatEnumerate (val, [&] (const ValueConstPtr& v) {
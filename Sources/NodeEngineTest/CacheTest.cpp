@@ -108,4 +108,43 @@ TEST (CacheWithControllerLarge)
 	ASSERT (controller.disposeCount == 100);
 }
 
+TEST (CacheLeastRecentlyUsedTest)
+{
+	Cache<int, std::string> cache (3);
+	ASSERT (cache.Add (1, "1"));
+	ASSERT (cache.Add (2, "2"));
+	ASSERT (cache.Add (3, "3"));
+	ASSERT (cache.Get (1) == "1");
+	ASSERT (cache.Add (4, "4"));
+	ASSERT (cache.Contains (1));
+	ASSERT (!cache.Contains (2));
+	ASSERT (cache.Contains (3));
+	ASSERT (cache.Contains (4));
+}
+
+TEST (CacheSizeTest)
+{
+	TestController controller;
+	Cache<int, std::string> cache (10, &controller);
+	ASSERT (cache.Add (1, "1", 4));
+	ASSERT (cache.Add (2, "2", 4));
+	ASSERT (cache.GetSize () == 8);
+	ASSERT (!cache.Add (3, "3", 11));
+	ASSERT (cache.Add (3, "3", 7));
+	ASSERT (!cache.Contains (1));
+	ASSERT (!cache.Contains (2));
+	ASSERT (cache.Contains (3));
+	ASSERT (cache.Count () == 1);
+	ASSERT (cache.GetSize () == 7);
+	ASSERT (controller.disposeCount == 2);
+
+	ASSERT (cache.Add (4, "4", 2));
+	cache.SetMaxSize (5);
+	ASSERT (cache.GetMaxSize () == 5);
+	ASSERT (!cache.Contains (3));
+	ASSERT (cache.Contains (4));
+	ASSERT (cache.GetSize () == 2);
+	ASSERT (controller.disposeCount == 3);
+}
+
 }
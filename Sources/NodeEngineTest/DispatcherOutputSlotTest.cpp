@@ -83,6 +83,11 @@ public:
 
 	}
 
+	virtual void OnEvaluationProgress (const NE::EvaluationProgress&) override
+	{
+
+	}
+
 	virtual void OnValuesRecalculated () override
 	{
 
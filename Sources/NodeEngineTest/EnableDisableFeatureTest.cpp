@@ -49,6 +49,11 @@ public:
 	virtual void OnEvaluationEnd () override
 	{
 
+	}
+
+	virtual void OnEvaluationProgress (const NE::EvaluationProgress&) override
+	{
+
 	}
 	
 	virtual void OnValuesRecalculated () override
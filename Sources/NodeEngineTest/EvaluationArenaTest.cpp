@@ -0,0 +1,261 @@
+#include "SimpleTest.hpp"
+#include "NE_EvaluationArena.hpp"
+#include "NE_EvaluationEnv.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_NodeManager.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_BinaryOperationNodes.hpp"
+#include "TestUtils.hpp"
+
+#include <thread>
+
+using namespace NE;
+using namespace NUIE;
+using namespace BI;
+
+namespace EvaluationArenaTest
+{
+
+static std::vector<double> GetNumbers (const ValueConstPtr& value)
+{
+	std::vector<double> numbers;
+	FlatEnumerate (value, [&] (const ValueConstPtr& innerValue) {
+		numbers.push_back (NumberValue::ToDouble (innerValue));
+		return true;
+	});
+	return numbers;
+}
+
+class ArenaListNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (ArenaListNode);
+
+public:
+	ArenaListNode () :
+		Node (),
+		createdValue (nullptr),
+		hadArena (false)
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		std::shared_ptr<IntListValue> temporaryValue = env.CreateTemporary<IntListValue> (std::vector<int> ({ 1, 2, 3 }));
+		ValueConstPtr value (new IntListValue (temporaryValue->GetValues ()));
+		createdValue = value.get ();
+		hadArena = env.HasArena ();
+		return value;
+	}
+
+	virtual Stream::Status Read (InputStream&) override
+	{
+		return Stream::Status::NoError;
+	}
+
+	virtual Stream::Status Write (OutputStream&) const override
+	{
+		return Stream::Status::NoError;
+	}
+
+	mutable const Value*	createdValue;
+	mutable bool			hadArena;
+};
+
+DYNAMIC_SERIALIZATION_INFO (ArenaListNode, 1, "{5B0E6C71-3F2D-4E8A-9C14-7A2D81B6E4F3}");
+
+TEST (ArenaAllocationTest)
+{
+	EvaluationArena arena (1024);
+	std::vector<ValueConstPtr> values;
+	for (int i = 0; i < 100; i++) {
+		values.push_back (arena.Create<IntValue> (i));
+	}
+	for (int i = 0; i < 100; i++) {
+		ASSERT (IntValue::Get (values[i]) == i);
+	}
+
+	EvaluationArenaStatistics statistics = arena.GetStatistics ();
+	ASSERT (statistics.GetAllocationCount () == 100);
+	ASSERT (statistics.GetChunkCount () > 1);
+	ASSERT (statistics.GetChunkCount () < 100);
+	ASSERT (statistics.GetAllocatedSize () >= 100 * sizeof (IntValue));
+
+	void* largeBlock = arena.Allocate (4096);
+	ASSERT (largeBlock != nullptr);
+	ASSERT (arena.GetStatistics ().GetChunkCount () == statistics.GetChunkCount () + 1);
+	EvaluationArena::Deallocate (largeBlock);
+}
+
+TEST (ArenaValueOutlivesArenaTest)
+{
+	ValueConstPtr intValue = nullptr;
+	ListValuePtr listValue = nullptr;
+	{
+		EvaluationArena arena;
+		intValue = arena.Create<IntValue> (42);
+		listValue = arena.Create<ListValue> ();
+		listValue->Push (arena.Create<DoubleValue> (1.5));
+		listValue->Push (arena.Create<DoubleListValue> (std::vector<double> ({ 2.0, 3.0 })));
+	}
+	ASSERT (IntValue::Get (intValue) == 42);
+	ASSERT (GetNumbers (listValue) == std::vector<double> ({ 1.5, 2.0, 3.0 }));
+	ASSERT (Value::IsType<DoubleListValue> (listValue->GetValue (1)));
+}
+
+TEST (ArenaMultiThreadTest)
+{
+	EvaluationArena arena (512);
+	const size_t threadCount = 4;
+	const size_t valueCount = 2000;
+	std::vector<std::vector<ValueConstPtr>> threadValues (threadCount);
+	std::vector<std::thread> threads;
+	for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+		threads.push_back (std::thread ([&, threadIndex] () {
+			for (size_t i = 0; i < valueCount; i++) {
+				ValueConstPtr value = arena.Create<IntValue> ((int) i);
+				if (i % 2 == 0) {
+					threadValues[threadIndex].push_back (value);
+				}
+			}
+		}));
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+
+	ASSERT (arena.GetStatistics ().GetAllocationCount () == threadCount * valueCount);
+	for (const std::vector<ValueConstPtr>& values : threadValues) {
+		ASSERT (values.size () == valueCount / 2);
+		for (size_t i = 0; i < values.size (); i++) {
+			ASSERT (IntValue::Get (values[i]) == (int) i * 2);
+		}
+	}
+}
+
+TEST (EvaluationEnvCreateTest)
+{
+	ValueConstPtr heapValue = EmptyEvaluationEnv.CreateTemporary<DoubleValue> (1.0);
+	ASSERT (!EmptyEvaluationEnv.HasArena ());
+	ASSERT (DoubleValue::Get (heapValue) == 1.0);
+
+	EvaluationArenaPtr arena (new EvaluationArena ());
+	EvaluationEnv arenaEnv (nullptr, arena);
+	ASSERT (arenaEnv.HasArena ());
+	ValueConstPtr arenaValue = arenaEnv.CreateTemporary<DoubleValue> (2.0);
+	ASSERT (DoubleValue::Get (arenaValue) == 2.0);
+	ASSERT (arena->GetStatistics ().GetAllocationCount () == 1);
+}
+
+TEST (ArenaNodeEvaluationTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	UINodePtr sequence = uiManager.AddNode (UINodePtr (new DoubleIncrementedNode (LocString (L"Sequence"), Point (0, 0))));
+	UINodePtr list = uiManager.AddNode (UINodePtr (new ListBuilderNode (LocString (L"List"), Point (0, 0))));
+	UINodePtr addition = uiManager.AddNode (UINodePtr (new AdditionNode (LocString (L"Addition"), Point (0, 0))));
+	uiManager.ConnectOutputSlotToInputSlot (sequence->GetUIOutputSlot (SlotId ("out")), list->GetUIInputSlot (SlotId ("in")));
+	uiManager.ConnectOutputSlotToInputSlot (list->GetUIOutputSlot (SlotId ("out")), addition->GetUIInputSlot (SlotId ("a")));
+	uiManager.ConnectOutputSlotToInputSlot (sequence->GetUIOutputSlot (SlotId ("out")), addition->GetUIInputSlot (SlotId ("b")));
+
+	std::vector<double> expected = GetNumbers (addition->Evaluate (EmptyEvaluationEnv));
+	ASSERT (expected.size () == 10);
+	sequence->InvalidateValue ();
+
+	EvaluationArenaPtr arena (new EvaluationArena ());
+	{
+		EvaluationEnv arenaEnv (nullptr, arena);
+		ASSERT (GetNumbers (addition->Evaluate (arenaEnv)) == expected);
+	}
+	// the calculated values are created on the heap, so they don't use the arena
+	ASSERT (arena->GetStatistics ().GetAllocationCount () == 0);
+	arena.reset ();
+
+	// the cached values stay valid after the arena is released
+	ASSERT (GetNumbers (addition->GetCalculatedValue ()) == expected);
+	ASSERT (GetNumbers (list->GetCalculatedValue ()) == GetNumbers (sequence->GetCalculatedValue ()));
+}
+
+TEST (ArenaTemporaryValueTest)
+{
+	NodeManager manager;
+	std::shared_ptr<ArenaListNode> node (new ArenaListNode ());
+	ASSERT (manager.AddNode (node) != nullptr);
+
+	ASSERT (GetNumbers (node->Evaluate (EmptyEvaluationEnv)) == std::vector<double> ({ 1.0, 2.0, 3.0 }));
+	ASSERT (!node->hadArena);
+	ASSERT (node->GetCalculatedValue ().get () == node->createdValue);
+
+	EvaluationArenaPtr arena (new EvaluationArena ());
+	node->InvalidateValue ();
+	{
+		EvaluationEnv arenaEnv (nullptr, arena);
+		node->Evaluate (arenaEnv);
+	}
+	ASSERT (node->hadArena);
+	ASSERT (arena->GetStatistics ().GetAllocationCount () == 1);
+
+	// only the temporary value is in the arena, the cache holds the calculated value itself
+	ValueConstPtr cachedValue = node->GetCalculatedValue ();
+	ASSERT (cachedValue.get () == node->createdValue);
+	arena.reset ();
+	ASSERT (GetNumbers (cachedValue) == std::vector<double> ({ 1.0, 2.0, 3.0 }));
+}
+
+TEST (NodeManagerEvaluationArenaTest)
+{
+	NodeManager manager;
+	ASSERT (!manager.IsEvaluationArenaEnabled ());
+	std::shared_ptr<ArenaListNode> node (new ArenaListNode ());
+	ASSERT (manager.AddNode (node) != nullptr);
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (!node->hadArena);
+	ASSERT (node->GetCalculatedValue ().get () == node->createdValue);
+
+	manager.SetEvaluationArenaEnabled (true);
+	node->InvalidateValue ();
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (node->hadArena);
+	ASSERT (!EmptyEvaluationEnv.HasArena ());
+	ASSERT (node->GetCalculatedValue ().get () == node->createdValue);
+	ASSERT (GetNumbers (node->GetCalculatedValue ()) == std::vector<double> ({ 1.0, 2.0, 3.0 }));
+}
+
+TEST (NodeUIManagerEvaluationArenaTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	UINodePtr sequence = uiManager.AddNode (UINodePtr (new DoubleIncrementedNode (LocString (L"Sequence"), Point (0, 0))));
+	UINodePtr list = uiManager.AddNode (UINodePtr (new ListBuilderNode (LocString (L"List"), Point (0, 0))));
+	UINodePtr addition = uiManager.AddNode (UINodePtr (new AdditionNode (LocString (L"Addition"), Point (0, 0))));
+	uiManager.ConnectOutputSlotToInputSlot (sequence->GetUIOutputSlot (SlotId ("out")), list->GetUIInputSlot (SlotId ("in")));
+	uiManager.ConnectOutputSlotToInputSlot (list->GetUIOutputSlot (SlotId ("out")), addition->GetUIInputSlot (SlotId ("a")));
+	uiManager.ConnectOutputSlotToInputSlot (sequence->GetUIOutputSlot (SlotId ("out")), addition->GetUIInputSlot (SlotId ("b")));
+
+	uiManager.Update (env);
+	std::vector<double> expected = GetNumbers (addition->GetCalculatedValue ());
+	ASSERT (expected.size () == 10);
+
+	ASSERT (!uiManager.IsEvaluationArenaEnabled ());
+	uiManager.SetEvaluationArenaEnabled (true);
+	ASSERT (uiManager.IsEvaluationArenaEnabled ());
+	sequence->InvalidateValue ();
+	uiManager.RequestRecalculate ();
+	uiManager.Update (env);
+
+	// the arena of the pass is released by now, the cached values are on the heap
+	ASSERT (GetNumbers (addition->GetCalculatedValue ()) == expected);
+	ASSERT (GetNumbers (list->GetCalculatedValue ()) == GetNumbers (sequence->GetCalculatedValue ()));
+}
+
+}
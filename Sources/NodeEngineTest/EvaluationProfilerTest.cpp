@@ -0,0 +1,141 @@
+#include "SimpleTest.hpp"
+#include "NE_NodeManager.hpp"
+#include "NE_Node.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_EvaluationProfiler.hpp"
+#include "TestNodes.hpp"
+
+using namespace NE;
+
+namespace EvaluationProfilerTest
+{
+
+class SourceNode : public SerializableTestNode
+{
+public:
+	SourceNode (int value) :
+		SerializableTestNode (),
+		value (value)
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv&) const override
+	{
+		return ValuePtr (new IntValue (value));
+	}
+
+	int value;
+};
+
+class AddOneNode : public SerializableTestNode
+{
+public:
+	AddOneNode () :
+		SerializableTestNode ()
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("in"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		return ValuePtr (new IntValue (IntValue::Get (in) + 1));
+	}
+};
+
+class Chain
+{
+public:
+	Chain (NodeManager& manager) :
+		source (new SourceNode (1)),
+		first (new AddOneNode ()),
+		second (new AddOneNode ())
+	{
+		manager.AddNode (source);
+		manager.AddNode (first);
+		manager.AddNode (second);
+		manager.ConnectOutputSlotToInputSlot (source->GetOutputSlot (SlotId ("out")), first->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (first->GetOutputSlot (SlotId ("out")), second->GetInputSlot (SlotId ("in")));
+	}
+
+	std::shared_ptr<SourceNode>		source;
+	std::shared_ptr<AddOneNode>		first;
+	std::shared_ptr<AddOneNode>		second;
+};
+
+TEST (EvaluationProfilerDisabledTest)
+{
+	NodeManager manager;
+	Chain chain (manager);
+	ASSERT (!manager.IsProfilingEnabled ());
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (!manager.GetEvaluationProfiler ().HasNodeProfile (chain.second->GetId ()));
+	ASSERT (manager.GetEvaluationProfiler ().ExportChromeTrace ().find ("\"ph\"") == std::string::npos);
+}
+
+TEST (EvaluationProfilerNodeProfileTest)
+{
+	NodeManager manager;
+	Chain chain (manager);
+	manager.SetProfilingEnabled (true);
+	ASSERT (manager.IsProfilingEnabled ());
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	const EvaluationProfiler& profiler = manager.GetEvaluationProfiler ();
+	ASSERT (profiler.HasNodeProfile (chain.source->GetId ()));
+	ASSERT (profiler.HasNodeProfile (chain.second->GetId ()));
+
+	NodeEvaluationProfile sourceProfile = profiler.GetNodeProfile (chain.source->GetId ());
+	ASSERT (sourceProfile.GetCalculationCount () == 1);
+	ASSERT (sourceProfile.GetValueSize () == IntValue (1).GetMemorySize ());
+
+	size_t firstCacheHitCount = profiler.GetNodeProfile (chain.first->GetId ()).GetCacheHitCount ();
+	chain.second->InvalidateValue ();
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (profiler.GetNodeProfile (chain.second->GetId ()).GetCalculationCount () == 2);
+	ASSERT (profiler.GetNodeProfile (chain.first->GetId ()).GetCalculationCount () == 1);
+	ASSERT (profiler.GetNodeProfile (chain.first->GetId ()).GetCacheHitCount () == firstCacheHitCount + 1);
+
+	size_t profileCount = 0;
+	profiler.EnumerateNodeProfiles ([&] (const NodeId&, const NodeEvaluationProfile&) {
+		profileCount++;
+	});
+	ASSERT (profileCount == 3);
+
+	manager.ClearEvaluationProfiler ();
+	ASSERT (!profiler.HasNodeProfile (chain.source->GetId ()));
+}
+
+TEST (EvaluationProfilerChromeTraceTest)
+{
+	NodeManager manager;
+	Chain chain (manager);
+	manager.SetProfilingEnabled (true);
+	manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+
+	std::string trace = manager.GetEvaluationProfiler ().ExportChromeTrace ([&] (const NodeId& nodeId) {
+		return nodeId == chain.second->GetId () ? std::wstring (L"Second \"Node\"") : std::wstring (L"Other");
+	});
+	ASSERT (trace.find ("{\"traceEvents\":[") == 0);
+	ASSERT (trace.find ("\"name\":\"Second \\\"Node\\\"\"") != std::string::npos);
+	ASSERT (trace.find ("\"ph\":\"X\"") != std::string::npos);
+	ASSERT (trace.find ("\"displayTimeUnit\":\"ms\"") != std::string::npos);
+}
+
+}
@@ -0,0 +1,428 @@
+#include "SimpleTest.hpp"
+#include "NE_NodeManager.hpp"
+#include "NE_Node.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_EvaluationSnapshot.hpp"
+#include "NE_BackgroundEvaluator.hpp"
+
+#include <thread>
+#include <atomic>
+
+using namespace NE;
+
+namespace EvaluationSnapshotTest
+{
+
+static int calculationCount = 0;
+
+class SourceNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (SourceNode);
+
+public:
+	SourceNode () :
+		SourceNode (0)
+	{
+
+	}
+
+	SourceNode (int value) :
+		Node (),
+		value (value)
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual bool IsThreadSafe () const override
+	{
+		return true;
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv&) const override
+	{
+		calculationCount++;
+		return ValuePtr (new IntValue (value));
+	}
+
+	virtual void ProcessCalculatedValue (const ValueConstPtr&, NE::EvaluationEnv&) const override
+	{
+		processCount++;
+	}
+
+	virtual Stream::Status Read (InputStream& inputStream) override
+	{
+		ObjectHeader header (inputStream);
+		Node::Read (inputStream);
+		inputStream.Read (value);
+		return inputStream.GetStatus ();
+	}
+
+	virtual Stream::Status Write (OutputStream& outputStream) const override
+	{
+		ObjectHeader header (outputStream, serializationInfo);
+		Node::Write (outputStream);
+		outputStream.Write (value);
+		return outputStream.GetStatus ();
+	}
+
+	int			value;
+	mutable int	processCount = 0;
+};
+
+class AddOneNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (AddOneNode);
+
+public:
+	AddOneNode () :
+		Node ()
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("in"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual bool IsThreadSafe () const override
+	{
+		return true;
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		calculationCount++;
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		return ValuePtr (new IntValue (IntValue::Get (in) + 1));
+	}
+
+	virtual void ProcessCalculatedValue (const ValueConstPtr&, NE::EvaluationEnv&) const override
+	{
+		processCount++;
+	}
+
+	virtual Stream::Status Read (InputStream& inputStream) override
+	{
+		ObjectHeader header (inputStream);
+		Node::Read (inputStream);
+		return inputStream.GetStatus ();
+	}
+
+	virtual Stream::Status Write (OutputStream& outputStream) const override
+	{
+		ObjectHeader header (outputStream, serializationInfo);
+		Node::Write (outputStream);
+		return outputStream.GetStatus ();
+	}
+
+	mutable int	processCount = 0;
+};
+
+class ThreadUnsafeAddOneNode : public AddOneNode
+{
+	DYNAMIC_SERIALIZABLE (ThreadUnsafeAddOneNode);
+
+public:
+	ThreadUnsafeAddOneNode () :
+		AddOneNode ()
+	{
+
+	}
+
+private:
+	virtual bool IsThreadSafe () const override
+	{
+		return false;
+	}
+};
+
+static std::atomic<bool> isBlockingStarted (false);
+static std::atomic<bool> isBlockingReleased (false);
+
+class BlockingAddOneNode : public AddOneNode
+{
+	DYNAMIC_SERIALIZABLE (BlockingAddOneNode);
+
+public:
+	BlockingAddOneNode () :
+		AddOneNode ()
+	{
+
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		isBlockingStarted = true;
+		while (!isBlockingReleased) {
+			std::this_thread::yield ();
+		}
+		return AddOneNode::Calculate (env);
+	}
+};
+
+class TestEvaluationData : public EvaluationData
+{
+public:
+	TestEvaluationData (int value) :
+		value (value)
+	{
+
+	}
+
+	int value;
+};
+
+class AddEnvValueNode : public AddOneNode
+{
+	DYNAMIC_SERIALIZABLE (AddEnvValueNode);
+
+public:
+	AddEnvValueNode () :
+		AddOneNode ()
+	{
+
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		return ValuePtr (new IntValue (IntValue::Get (in) + env.GetData<TestEvaluationData> ()->value));
+	}
+};
+
+DYNAMIC_SERIALIZATION_INFO (SourceNode, 1, "{4B0F3C1E-7D2A-4E59-9A61-C3E8F2B7D104}");
+DYNAMIC_SERIALIZATION_INFO (AddOneNode, 1, "{9E27A6D3-51C8-4B0F-8E4A-6F1D2C9B3A75}");
+DYNAMIC_SERIALIZATION_INFO (ThreadUnsafeAddOneNode, 1, "{D83C5B1A-2F6E-4A97-B04C-17E9A5F26C38}");
+DYNAMIC_SERIALIZATION_INFO (BlockingAddOneNode, 1, "{6A1E9D42-C37B-4F85-A2D0-8B5C14E7F963}");
+DYNAMIC_SERIALIZATION_INFO (AddEnvValueNode, 1, "{F25B8C07-94DA-4E31-B6C8-0D7A3E5F1B29}");
+
+class TwoChains
+{
+public:
+	TwoChains (NodeManager& manager) :
+		sources (),
+		nodes ()
+	{
+		for (int i = 0; i < 2; i++) {
+			std::shared_ptr<SourceNode> source (new SourceNode (i * 10));
+			manager.AddNode (source);
+			sources.push_back (source);
+			NodePtr lastNode = source;
+			for (int j = 0; j < 3; j++) {
+				std::shared_ptr<AddOneNode> node (new AddOneNode ());
+				manager.AddNode (node);
+				manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), node->GetInputSlot (SlotId ("in")));
+				nodes.push_back (node);
+				lastNode = node;
+			}
+		}
+	}
+
+	std::vector<std::shared_ptr<SourceNode>>	sources;
+	std::vector<std::shared_ptr<AddOneNode>>	nodes;
+};
+
+static bool EvaluateSnapshot (EvaluationSnapshot& snapshot)
+{
+	EvaluationProgress progress = snapshot.Evaluate (EmptyEvaluationEnv, std::chrono::hours (1));
+	return progress.IsFinished ();
+}
+
+TEST (EvaluationSnapshotPublishTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+
+	calculationCount = 0;
+	EvaluationSnapshot snapshot;
+	ASSERT (manager.CreateEvaluationSnapshot (snapshot));
+	ASSERT (snapshot.GetNodeCount () == manager.GetNodeCount ());
+	ASSERT (EvaluateSnapshot (snapshot));
+	ASSERT (calculationCount == 8);
+	ASSERT (!chains.nodes[2]->HasCalculatedValue ());
+	ASSERT (chains.nodes[2]->processCount == 0);
+
+	NodeCollection publishedNodes = manager.PublishEvaluationSnapshot (snapshot, EmptyEvaluationEnv);
+	ASSERT (publishedNodes.Count () == 8);
+	ASSERT (IntValue::Get (chains.nodes[2]->GetCalculatedValue ()) == 3);
+	ASSERT (IntValue::Get (chains.nodes[5]->GetCalculatedValue ()) == 13);
+	ASSERT (chains.nodes[2]->processCount == 1);
+	ASSERT (chains.sources[1]->processCount == 1);
+
+	calculationCount = 0;
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (calculationCount == 0);
+}
+
+TEST (EvaluationSnapshotReuseCachedValuesTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+
+	chains.sources[1]->value = 20;
+	chains.sources[1]->InvalidateValue ();
+
+	calculationCount = 0;
+	EvaluationSnapshot snapshot;
+	ASSERT (manager.CreateEvaluationSnapshot (snapshot));
+	ASSERT (EvaluateSnapshot (snapshot));
+	ASSERT (calculationCount == 4);
+
+	NodeCollection publishedNodes = manager.PublishEvaluationSnapshot (snapshot, EmptyEvaluationEnv);
+	ASSERT (publishedNodes.Count () == 4);
+	ASSERT (!publishedNodes.Contains (chains.nodes[0]->GetId ()));
+	ASSERT (IntValue::Get (chains.nodes[5]->GetCalculatedValue ()) == 23);
+}
+
+TEST (EvaluationSnapshotStaleValuesTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+
+	EvaluationSnapshot snapshot;
+	ASSERT (manager.CreateEvaluationSnapshot (snapshot));
+	ASSERT (EvaluateSnapshot (snapshot));
+
+	chains.sources[0]->value = 100;
+	chains.sources[0]->InvalidateValue ();
+	manager.DeleteNode (chains.nodes[5]);
+
+	NodeCollection publishedNodes = manager.PublishEvaluationSnapshot (snapshot, EmptyEvaluationEnv);
+	ASSERT (publishedNodes.Count () == 3);
+	ASSERT (publishedNodes.Contains (chains.sources[1]->GetId ()));
+	ASSERT (publishedNodes.Contains (chains.nodes[3]->GetId ()));
+	ASSERT (publishedNodes.Contains (chains.nodes[4]->GetId ()));
+	ASSERT (!chains.nodes[2]->HasCalculatedValue ());
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (chains.nodes[2]->GetCalculatedValue ()) == 103);
+}
+
+TEST (EvaluationSnapshotReplacedNodeTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+
+	EvaluationSnapshot snapshot;
+	ASSERT (manager.CreateEvaluationSnapshot (snapshot));
+	ASSERT (EvaluateSnapshot (snapshot));
+
+	NodeManager replacedManager;
+	ASSERT (NodeManager::Clone (manager, replacedManager));
+	manager.Clear ();
+	ASSERT (NodeManager::Clone (replacedManager, manager));
+
+	NodeCollection publishedNodes = manager.PublishEvaluationSnapshot (snapshot, EmptyEvaluationEnv);
+	ASSERT (publishedNodes.IsEmpty ());
+}
+
+TEST (EvaluationSnapshotThreadUnsafeNodeTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+	std::shared_ptr<ThreadUnsafeAddOneNode> unsafeNode (new ThreadUnsafeAddOneNode ());
+	manager.AddNode (unsafeNode);
+
+	EvaluationSnapshot snapshot;
+	ASSERT (!manager.CreateEvaluationSnapshot (snapshot));
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	chains.sources[0]->InvalidateValue ();
+	EvaluationSnapshot snapshot2;
+	ASSERT (manager.CreateEvaluationSnapshot (snapshot2));
+}
+
+TEST (BackgroundEvaluatorTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+
+	BackgroundEvaluator evaluator;
+	ASSERT (!evaluator.IsRunning ());
+	std::unique_ptr<EvaluationSnapshot> snapshot (new EvaluationSnapshot ());
+	ASSERT (manager.CreateEvaluationSnapshot (*snapshot));
+	ASSERT (evaluator.Start (std::move (snapshot), nullptr));
+	ASSERT (evaluator.IsRunning ());
+	while (!evaluator.IsFinished ()) {
+		std::this_thread::yield ();
+	}
+
+	std::unique_ptr<EvaluationSnapshot> result = evaluator.Finish ();
+	ASSERT (result != nullptr);
+	ASSERT (!evaluator.IsRunning ());
+	NodeCollection publishedNodes = manager.PublishEvaluationSnapshot (*result, EmptyEvaluationEnv);
+	ASSERT (publishedNodes.Count () == 8);
+	ASSERT (IntValue::Get (chains.nodes[5]->GetCalculatedValue ()) == 13);
+
+	chains.sources[0]->InvalidateValue ();
+	snapshot.reset (new EvaluationSnapshot ());
+	ASSERT (manager.CreateEvaluationSnapshot (*snapshot));
+	ASSERT (evaluator.Start (std::move (snapshot), nullptr));
+	evaluator.Cancel ();
+	result = evaluator.Finish ();
+	ASSERT (result != nullptr);
+	publishedNodes = manager.PublishEvaluationSnapshot (*result, EmptyEvaluationEnv);
+	ASSERT (publishedNodes.Count () <= 4);
+}
+
+TEST (BackgroundEvaluatorModifyWhileRunningTest)
+{
+	NodeManager manager;
+	TwoChains chains (manager);
+	std::shared_ptr<BlockingAddOneNode> blockingNode (new BlockingAddOneNode ());
+	std::shared_ptr<AddEnvValueNode> envNode (new AddEnvValueNode ());
+	manager.AddNode (blockingNode);
+	manager.AddNode (envNode);
+	manager.ConnectOutputSlotToInputSlot (chains.nodes[2]->GetOutputSlot (SlotId ("out")), blockingNode->GetInputSlot (SlotId ("in")));
+	manager.ConnectOutputSlotToInputSlot (blockingNode->GetOutputSlot (SlotId ("out")), envNode->GetInputSlot (SlotId ("in")));
+
+	std::shared_ptr<TestEvaluationData> liveData (new TestEvaluationData (100));
+	EvaluationEnv liveEnv (liveData);
+
+	isBlockingStarted = false;
+	isBlockingReleased = false;
+	BackgroundEvaluator evaluator;
+	std::unique_ptr<EvaluationSnapshot> snapshot (new EvaluationSnapshot ());
+	ASSERT (manager.CreateEvaluationSnapshot (*snapshot));
+	ASSERT (evaluator.Start (std::move (snapshot), EvaluationDataPtr (new TestEvaluationData (10))));
+	while (!isBlockingStarted) {
+		std::this_thread::yield ();
+	}
+
+	liveData->value = 200;
+	std::shared_ptr<AddOneNode> newNode (new AddOneNode ());
+	manager.AddNode (newNode);
+	manager.ConnectOutputSlotToInputSlot (chains.nodes[0]->GetOutputSlot (SlotId ("out")), newNode->GetInputSlot (SlotId ("in")));
+	manager.DisconnectOutputSlotFromInputSlot (chains.nodes[3]->GetOutputSlot (SlotId ("out")), chains.nodes[4]->GetInputSlot (SlotId ("in")));
+	manager.EvaluateNodes (NodeCollection ({ chains.nodes[5]->GetId () }), liveEnv);
+	ASSERT (IntValue::Get (chains.nodes[5]->GetCalculatedValue ()) == 2);
+	ASSERT (!envNode->HasCalculatedValue ());
+
+	isBlockingReleased = true;
+	std::unique_ptr<EvaluationSnapshot> result = evaluator.Finish ();
+	ASSERT (result != nullptr);
+	NodeCollection publishedNodes = manager.PublishEvaluationSnapshot (*result, liveEnv);
+	ASSERT (publishedNodes.Count () == 8);
+	ASSERT (!publishedNodes.Contains (chains.nodes[4]->GetId ()));
+	ASSERT (!publishedNodes.Contains (chains.nodes[5]->GetId ()));
+	ASSERT (!publishedNodes.Contains (newNode->GetId ()));
+	ASSERT (IntValue::Get (chains.nodes[4]->GetCalculatedValue ()) == 1);
+	ASSERT (IntValue::Get (chains.nodes[5]->GetCalculatedValue ()) == 2);
+	ASSERT (IntValue::Get (envNode->GetCalculatedValue ()) == 14);
+
+	manager.EvaluateAllNodes (liveEnv);
+	ASSERT (IntValue::Get (newNode->GetCalculatedValue ()) == 2);
+	ASSERT (IntValue::Get (envNode->GetCalculatedValue ()) == 14);
+}
+
+}
@@ -0,0 +1,377 @@
+#include "SimpleTest.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_ValueCombination.hpp"
+#include "NE_MemoryStream.hpp"
+
+using namespace NE;
+
+namespace ListValuesTest
+{
+
+static ValuePtr WriteAndReadValue (const ValueConstPtr& val, size_t& bufferSize)
+{
+	MemoryOutputStream outputStream;
+	WriteDynamicObject (outputStream, val.get ());
+	bufferSize = outputStream.GetBuffer ().size ();
+
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	return ValuePtr (ReadDynamicObject<Value> (inputStream));
+}
+
+TEST (DoubleListValueTest)
+{
+	DoubleListValuePtr listValue (new DoubleListValue ({ 1.0, 2.5, 4.0 }));
+	ASSERT (listValue->GetSize () == 3);
+	ASSERT (listValue->Get (1) == 2.5);
+	ASSERT (listValue->ToInteger (2) == 4);
+	ASSERT (Value::IsType<DoubleValue> (listValue->GetElement (1)));
+	ASSERT (DoubleValue::Get (listValue->GetElement (1)) == 2.5);
+
+	ASSERT (IsListValue (listValue));
+	ASSERT (!IsSingleValue (listValue));
+	ASSERT (IsComplexType<DoubleValue> (listValue));
+	ASSERT (IsComplexType<NumberValue> (listValue));
+	ASSERT (!IsComplexType<IntValue> (listValue));
+	ASSERT (!IsSingleType<DoubleValue> (listValue));
+	ASSERT (!IsComplexType<DoubleValue> (ValueConstPtr (new DoubleListValue ())));
+
+	double sum = 0.0;
+	ASSERT (FlatEnumerate (listValue, [&] (const ValueConstPtr& value) {
+		sum += DoubleValue::Get (value);
+		return true;
+	}));
+	ASSERT (sum == 7.5);
+	ASSERT (FlattenValue (listValue) == listValue);
+
+	ValuePtr cloned = listValue->Clone ();
+	ASSERT (Value::IsType<DoubleListValue> (cloned));
+	ASSERT (Value::Cast<DoubleListValue> (cloned)->GetValues () == listValue->GetValues ());
+}
+
+TEST (BoxedListValueAccessTest)
+{
+	ListValuePtr listValue (new ListValue ());
+	listValue->Push (ValuePtr (new IntValue (1)));
+	listValue->Push (ValuePtr (new DoubleValue (2.5)));
+	ASSERT (&listValue->GetValue (1) == &listValue->GetValues ()[1]);
+	ASSERT (listValue->GetElement (1) == listValue->GetValue (1));
+
+	ValueConstPtr singleValue (new IntValue (3));
+	ValueToListValueAdapter adapter (singleValue);
+	ASSERT (&adapter.GetValue (0) == &singleValue);
+	ASSERT (adapter.GetElement (0) == singleValue);
+}
+
+TEST (IntListValueSingleTest)
+{
+	ValueConstPtr listValue (new IntListValue ({ 42 }));
+	ASSERT (IsSingleType<IntValue> (listValue));
+	ASSERT (IsSingleType<NumberValue> (listValue));
+	ASSERT (!IsSingleType<DoubleValue> (listValue));
+	ValueConstPtr singleValue = CreateSingleValue (listValue);
+	ASSERT (Value::IsType<IntValue> (singleValue));
+	ASSERT (IntValue::Get (singleValue) == 42);
+}
+
+TEST (ListValueSerializationTest)
+{
+	std::vector<double> values;
+	ListValuePtr boxedValue (new ListValue ());
+	for (int i = 0; i < 100; i++) {
+		values.push_back (i * 0.5);
+		boxedValue->Push (ValuePtr (new DoubleValue (i * 0.5)));
+	}
+	ValueConstPtr listValue (new DoubleListValue (values));
+
+	size_t bufferSize = 0;
+	ValuePtr readValue = WriteAndReadValue (listValue, bufferSize);
+	ASSERT (Value::IsType<DoubleListValue> (readValue));
+	ASSERT (Value::Cast<DoubleListValue> (readValue)->GetValues () == values);
+
+	size_t boxedBufferSize = 0;
+	WriteAndReadValue (boxedValue, boxedBufferSize);
+	ASSERT (bufferSize * 4 < boxedBufferSize);
+	ASSERT (listValue->GetMemorySize () * 4 < boxedValue->GetMemorySize ());
+
+	ValueConstPtr intListValue (new IntListValue ({ 1, -2, 3 }));
+	ValuePtr readIntValue = WriteAndReadValue (intListValue, bufferSize);
+	ASSERT (Value::IsType<IntListValue> (readIntValue));
+	ASSERT (Value::Cast<IntListValue> (readIntValue)->GetValues () == std::vector<int> ({ 1, -2, 3 }));
+}
+
+TEST (ListValueCombinationTest)
+{
+	ValueConstPtr doubleList (new DoubleListValue ({ 1.0, 2.0, 3.0 }));
+	ListValuePtr boxedList (new ListValue ());
+	boxedList->Push (ValuePtr (new IntValue (10)));
+	boxedList->Push (ValuePtr (new IntValue (20)));
+
+	std::vector<double> results;
+	ASSERT (CombineValues (ValueCombinationMode::Longest, { doubleList, boxedList }, [&] (const ValueCombination& combination) {
+		results.push_back (NumberValue::ToDouble (combination.GetValue (0)) + NumberValue::ToDouble (combination.GetValue (1)));
+		return true;
+	}));
+	ASSERT (results == std::vector<double> ({ 11.0, 22.0, 23.0 }));
+}
+
+TEST (SequenceValueTest)
+{
+	DoubleSequenceValuePtr sequence (new DoubleSequenceValue (1.0, 0.5, 5));
+	ASSERT (sequence->GetSize () == 5);
+	ASSERT (sequence->Get (4) == 3.0);
+	ASSERT (DoubleValue::Get (sequence->GetElement (2)) == 2.0);
+	ASSERT (IsComplexType<DoubleValue> (sequence));
+	ASSERT (FlattenValue (sequence) == sequence);
+
+	std::vector<double> values;
+	ASSERT (FlatEnumerate (sequence, [&] (const ValueConstPtr& value) {
+		values.push_back (DoubleValue::Get (value));
+		return true;
+	}));
+	ASSERT (values == std::vector<double> ({ 1.0, 1.5, 2.0, 2.5, 3.0 }));
+
+	IntSequenceValuePtr bigSequence (new IntSequenceValue (-3, 2, 10000000));
+	ASSERT (bigSequence->GetSize () == 10000000);
+	ASSERT (bigSequence->Get (9999999) == -3 + 9999999 * 2);
+	ASSERT (bigSequence->GetMemorySize () < 100);
+	ASSERT (IsComplexType<IntValue> (bigSequence));
+}
+
+TEST (SequenceValueSerializationTest)
+{
+	size_t bufferSize = 0;
+	ValuePtr readValue = WriteAndReadValue (ValueConstPtr (new IntSequenceValue (5, -1, 1000000)), bufferSize);
+	ASSERT (bufferSize < 100);
+	ASSERT (Value::IsType<IntSequenceValue> (readValue));
+	IntSequenceValueConstPtr readSequence = Value::Cast<IntSequenceValue> (readValue);
+	ASSERT (readSequence->GetStart () == 5);
+	ASSERT (readSequence->GetStep () == -1);
+	ASSERT (readSequence->GetSize () == 1000000);
+
+	ValuePtr readDoubleValue = WriteAndReadValue (ValueConstPtr (new DoubleSequenceValue (0.25, 0.125, 3)), bufferSize);
+	ASSERT (Value::IsType<DoubleSequenceValue> (readDoubleValue));
+	ASSERT (Value::Cast<DoubleSequenceValue> (readDoubleValue)->Get (2) == 0.5);
+
+	ValuePtr cloned = readDoubleValue->Clone ();
+	ASSERT (Value::IsType<DoubleSequenceValue> (cloned));
+	ASSERT (Value::Cast<DoubleSequenceValue> (cloned)->GetSize () == 3);
+}
+
+TEST (ListValueSummaryTest)
+{
+	ListValuePtr emptyList (new ListValue ());
+	ASSERT (emptyList->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (emptyList->GetSummary ().GetDepth () == 1);
+	ASSERT (emptyList->GetSummary ().GetLeafCount () == 0);
+
+	ListValuePtr innerList (new ListValue ());
+	innerList->Push (ValuePtr (new IntValue (1)));
+	innerList->Push (ValuePtr (new IntValue (2)));
+	ListValuePtr outerList (new ListValue ());
+	outerList->Push (innerList);
+	outerList->Push (ValuePtr (new IntValue (3)));
+	outerList->Push (ValuePtr (new IntListValue ({ 4, 5, 6 })));
+
+	ListValueSummary summary = outerList->GetSummary ();
+	ASSERT (summary.GetLeafPrototype () != nullptr);
+	ASSERT (Value::Cast<IntValue> (summary.GetLeafPrototype ()) != nullptr);
+	ASSERT (summary.GetDepth () == 2);
+	ASSERT (summary.GetLeafCount () == 6);
+	ASSERT (IsComplexType<IntValue> (outerList));
+	ASSERT (IsComplexType<NumberValue> (outerList));
+	ASSERT (!IsComplexType<DoubleValue> (outerList));
+
+	outerList->Push (ValuePtr (new DoubleListValue ({ 7.0 })));
+	ASSERT (outerList->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (outerList->GetSummary ().GetLeafCount () == 7);
+	ASSERT (IsComplexType<NumberValue> (outerList));
+	ASSERT (!IsComplexType<IntValue> (outerList));
+
+	outerList->Push (emptyList);
+	ASSERT (!IsComplexType<NumberValue> (outerList));
+
+	ListValuePtr deepList (new ListValue ({ outerList }));
+	ASSERT (deepList->GetSummary ().GetDepth () == 3);
+}
+
+TEST (EmptyColumnarListSummaryTest)
+{
+	IntListValuePtr emptyIntList (new IntListValue (std::vector<int> ()));
+	ASSERT (emptyIntList->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (emptyIntList->GetSummary ().GetLeafCount () == 0);
+	ASSERT (!IsComplexType<NumberValue> (emptyIntList));
+
+	ListValuePtr intListHolder (new ListValue ());
+	intListHolder->Push (emptyIntList);
+	ASSERT (intListHolder->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (!IsComplexType<NumberValue> (intListHolder));
+
+	intListHolder->Push (ValuePtr (new IntValue (1)));
+	ASSERT (intListHolder->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (!IsComplexType<NumberValue> (intListHolder));
+
+	IntSequenceValuePtr emptySequence (new IntSequenceValue (0, 1, 0));
+	ASSERT (emptySequence->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (!IsComplexType<NumberValue> (emptySequence));
+
+	ListValuePtr sequenceHolder (new ListValue ());
+	sequenceHolder->Push (emptySequence);
+	ASSERT (sequenceHolder->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (sequenceHolder->GetSummary ().GetLeafCount () == 0);
+	ASSERT (!IsComplexType<NumberValue> (sequenceHolder));
+
+	FlattenedListValuePtr emptyView (new FlattenedListValue (sequenceHolder));
+	ASSERT (emptyView->GetSize () == 0);
+	ASSERT (emptyView->GetSummary ().GetLeafPrototype () == nullptr);
+	ASSERT (!IsComplexType<NumberValue> (emptyView));
+}
+
+TEST (ListValueSummarySerializationTest)
+{
+	ListValuePtr innerList (new ListValue ());
+	innerList->Push (ValuePtr (new DoubleValue (1.0)));
+	ListValuePtr outerList (new ListValue ());
+	outerList->Push (innerList);
+	outerList->Push (ValuePtr (new DoubleValue (2.0)));
+
+	size_t bufferSize = 0;
+	ValuePtr readValue = WriteAndReadValue (outerList, bufferSize);
+	ListValueSummary summary = Value::Cast<ListValue> (readValue)->GetSummary ();
+	ASSERT (Value::Cast<DoubleValue> (summary.GetLeafPrototype ()) != nullptr);
+	ASSERT (summary.GetDepth () == 2);
+	ASSERT (summary.GetLeafCount () == 2);
+
+	ValuePtr cloned = readValue->Clone ();
+	ASSERT (Value::Cast<ListValue> (cloned)->GetSummary ().GetLeafPrototype () != Value::Cast<ListValue> (readValue)->GetSummary ().GetLeafPrototype ());
+	ASSERT (Value::Cast<DoubleValue> (Value::Cast<ListValue> (cloned)->GetSummary ().GetLeafPrototype ()) != nullptr);
+}
+
+static std::vector<int> GetIntegers (const ValueConstPtr& value)
+{
+	std::vector<int> integers;
+	FlatEnumerate (value, [&] (const ValueConstPtr& innerValue) {
+		integers.push_back (IntValue::Get (innerValue));
+		return true;
+	});
+	return integers;
+}
+
+static ListValuePtr CreateNestedList ()
+{
+	ListValuePtr innerList (new ListValue ());
+	innerList->Push (ValuePtr (new IntValue (2)));
+	innerList->Push (ValuePtr (new IntListValue ({ 3, 4 })));
+	innerList->Push (ValuePtr (new ListValue ()));
+	innerList->Push (ValuePtr (new IntValue (5)));
+	ListValuePtr outerList (new ListValue ());
+	outerList->Push (ValuePtr (new IntValue (1)));
+	outerList->Push (innerList);
+	outerList->Push (ValuePtr (new IntSequenceValue (6, 1, 2)));
+	outerList->Push (ValuePtr (new IntValue (8)));
+	return outerList;
+}
+
+TEST (FlatCollectTest)
+{
+	ListValuePtr nestedList = CreateNestedList ();
+	ASSERT (GetFlatValueCount (nestedList) == 8);
+	ASSERT (GetFlatValueCount (ValueConstPtr (new IntValue (1))) == 1);
+
+	std::vector<ValueConstPtr> values;
+	FlatCollect (nestedList, values);
+	ASSERT (values.size () == 8);
+	ASSERT (values.capacity () == 8);
+	for (size_t i = 0; i < values.size (); i++) {
+		ASSERT (IntValue::Get (values[i]) == (int) i + 1);
+	}
+
+	ValueConstPtr flattened = FlattenValue (nestedList);
+	ASSERT (Value::IsType<ListValue> (flattened));
+	ASSERT (GetIntegers (flattened) == GetIntegers (nestedList));
+	ASSERT (Value::Cast<ListValue> (flattened)->GetSummary ().GetDepth () == 1);
+
+	size_t enumerated = 0;
+	ASSERT (!FlatEnumerate (nestedList, [&] (const ValueConstPtr&) {
+		enumerated++;
+		return enumerated < 4;
+	}));
+	ASSERT (enumerated == 4);
+}
+
+TEST (DeepNestedFlattenTest)
+{
+	const size_t depth = 10000;
+	ValuePtr nestedValue (new IntValue (0));
+	for (size_t i = 1; i <= depth; i++) {
+		ListValuePtr list (new ListValue ());
+		list->Push (nestedValue);
+		list->Push (ValuePtr (new IntValue ((int) i)));
+		nestedValue = list;
+	}
+
+	ASSERT (GetFlatValueCount (nestedValue) == depth + 1);
+	std::vector<ValueConstPtr> values;
+	FlatCollect (nestedValue, values);
+	ASSERT (values.size () == depth + 1);
+	for (size_t i = 0; i < values.size (); i++) {
+		ASSERT (IntValue::Get (values[i]) == (int) i);
+	}
+
+	FlattenedListValue view (nestedValue);
+	ASSERT (view.GetSize () == depth + 1);
+	ASSERT (IntValue::Get (view.GetElement (depth)) == (int) depth);
+}
+
+TEST (FlattenedListValueTest)
+{
+	ListValuePtr nestedList = CreateNestedList ();
+	FlattenedListValuePtr view (new FlattenedListValue (nestedList));
+	ASSERT (view->GetSize () == 8);
+	ASSERT (view->GetSegmentCount () == 6);
+	ASSERT (view->GetSource () == nestedList);
+	ASSERT (view->GetElementPrototype () == nullptr);
+	ASSERT (view->GetSummary ().GetDepth () == 1);
+	ASSERT (view->GetSummary ().GetLeafCount () == 8);
+	ASSERT (view->GetSummary ().GetLeafPrototype () == nullptr);
+	for (size_t i = 0; i < view->GetSize (); i++) {
+		ASSERT (IntValue::Get (view->GetElement (i)) == (int) i + 1);
+	}
+	ASSERT (GetIntegers (view) == GetIntegers (nestedList));
+	ASSERT (view->GetElement (0) == nestedList->GetValue (0));
+	ASSERT (view->GetMemorySize () < nestedList->GetMemorySize ());
+
+	FlattenedListValue typedView (ValueConstPtr (new ListValue ({ ValuePtr (new IntListValue ({ 1, 2 })), ValuePtr (new IntListValue ({ 3 })) })));
+	ASSERT (typedView.GetSize () == 3);
+	ASSERT (Value::Cast<IntValue> (typedView.GetElementPrototype ()) != nullptr);
+
+	FlattenedListValuePtr boxedView (new FlattenedListValue (ValueConstPtr (new ListValue ({ ValuePtr (new IntValue (1)), ValuePtr (new ListValue ({ ValuePtr (new IntValue (2)) })) }))));
+	ASSERT (boxedView->GetElementPrototype () == nullptr);
+	ASSERT (Value::Cast<IntValue> (boxedView->GetSummary ().GetLeafPrototype ()) != nullptr);
+	ASSERT (IsComplexType<IntValue> (boxedView));
+
+	FlattenedListValue singleView (ValueConstPtr (new IntValue (42)));
+	ASSERT (singleView.GetSize () == 1);
+	ASSERT (IntValue::Get (singleView.GetElement (0)) == 42);
+
+	FlattenedListValue emptyView (ValueConstPtr (new ListValue ()));
+	ASSERT (emptyView.GetSize () == 0);
+	ASSERT (emptyView.GetSegmentCount () == 0);
+}
+
+TEST (FlattenedListValueSerializationTest)
+{
+	FlattenedListValuePtr view (new FlattenedListValue (CreateNestedList ()));
+	size_t bufferSize = 0;
+	ValuePtr readValue = WriteAndReadValue (view, bufferSize);
+	ASSERT (Value::IsType<FlattenedListValue> (readValue));
+	ASSERT (Value::Cast<FlattenedListValue> (readValue)->GetSegmentCount () == 1);
+	ASSERT (GetIntegers (readValue) == GetIntegers (view));
+
+	ValuePtr cloned = view->Clone ();
+	ASSERT (Value::Cast<FlattenedListValue> (cloned)->GetSource () != view->GetSource ());
+	ASSERT (GetIntegers (cloned) == GetIntegers (view));
+	ASSERT (view->ToString (GetDefaultStringConverter ()) == readValue->ToString (GetDefaultStringConverter ()));
+}
+
+}
@@ -1,11 +1,15 @@
 #include "SimpleTest.hpp"
 #include "NE_NodeManager.hpp"
+#include "NE_ConnectionManager.hpp"
 #include "NE_Node.hpp"
 #include "NE_InputSlot.hpp"
 #include "NE_OutputSlot.hpp"
 #include "NE_SingleValues.hpp"
 #include "TestNodes.hpp"
 
+#include <random>
+#include <unordered_set>
+
 using namespace NE;
 
 namespace NodeConnectionTest
@@ -674,6 +678,87 @@ TEST (CycleDetectionTest3)
 	ASSERT (!manager.CanConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
 }
 
+TEST (CycleDetectionTest4)
+{
+	NodeManager manager;
+
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node3 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+	ASSERT (!manager.CanConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (!manager.CanConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+
+	ASSERT (manager.DisconnectOutputSlotFromInputSlot (node2->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.CanConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (!manager.CanConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+
+	ASSERT (manager.DeleteNode (node2));
+	ASSERT (manager.CanConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.CanConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (!manager.CanConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+}
+
+static bool IsNodeReachable (const NodeManager& manager, const NodeConstPtr& fromNode, const NodeConstPtr& toNode)
+{
+	std::unordered_set<NodeId> visited;
+	std::vector<NodeConstPtr> nodesToVisit = { fromNode };
+	while (!nodesToVisit.empty ()) {
+		NodeConstPtr node = nodesToVisit.back ();
+		nodesToVisit.pop_back ();
+		if (node == toNode) {
+			return true;
+		}
+		manager.EnumerateDependentNodes (node, [&] (const NodeConstPtr& dependentNode) {
+			if (visited.insert (dependentNode->GetId ()).second) {
+				nodesToVisit.push_back (dependentNode);
+			}
+		});
+	}
+	return false;
+}
+
+TEST (CycleDetectionRandomTest)
+{
+	NodeManager manager;
+
+	std::vector<NodePtr> nodes;
+	for (size_t i = 0; i < 30; i++) {
+		nodes.push_back (manager.AddNode (NodePtr (new AdderInputOutputNode (1))));
+	}
+
+	std::mt19937 randomGenerator (42);
+	std::uniform_int_distribution<size_t> nodeDistribution (0, nodes.size () - 1);
+	for (size_t i = 0; i < 2000; i++) {
+		NodePtr outputNode = nodes[nodeDistribution (randomGenerator)];
+		NodePtr inputNode = nodes[nodeDistribution (randomGenerator)];
+		OutputSlotConstPtr outputSlot = outputNode->GetOutputSlot (SlotId ("out"));
+		InputSlotConstPtr inputSlot = inputNode->GetInputSlot (SlotId ("in"));
+		if (manager.IsOutputSlotConnectedToInputSlot (outputSlot, inputSlot)) {
+			if (i % 3 == 0) {
+				ASSERT (manager.DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot));
+			}
+			continue;
+		}
+		bool expected = !IsNodeReachable (manager, inputNode, outputNode);
+		ASSERT (manager.CanConnectOutputSlotToInputSlot (outputSlot, inputSlot) == expected);
+		if (expected) {
+			ASSERT (manager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot));
+		}
+		if (i % 250 == 0) {
+			size_t nodeIndex = nodeDistribution (randomGenerator);
+			ASSERT (manager.DeleteNode (nodes[nodeIndex]));
+			nodes[nodeIndex] = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+		}
+	}
+
+	ValueConstPtr result = nodes[0]->Evaluate (EmptyEvaluationEnv);
+	ASSERT (result != nullptr);
+}
+
 TEST (HasConnectionTest)
 {
 	NodeManager manager;
@@ -690,4 +775,195 @@ TEST (HasConnectionTest)
 	ASSERT (!manager.IsOutputSlotConnectedToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
 }
 
+TEST (SlotIndexTest)
+{
+	NodeManager manager;
+
+	ASSERT (OutputSlot (SlotId ("out")).GetSlotIndex () == InvalidSlotIndex);
+
+	std::shared_ptr<AdderInputOutputNode> node1 (new AdderInputOutputNode ());
+	std::shared_ptr<AdderInputOutputNode> node2 (new AdderInputOutputNode ());
+	manager.AddNode (node1);
+	manager.AddNode (node2);
+	OutputSlotConstPtr outputSlot = node1->GetOutputSlot (SlotId ("out"));
+	InputSlotConstPtr inputSlot = node2->GetInputSlot (SlotId ("in"));
+	ASSERT (outputSlot->GetSlotIndex () != InvalidSlotIndex);
+	ASSERT (inputSlot->GetSlotIndex () != InvalidSlotIndex);
+	ASSERT (node1->GetInputSlot (SlotId ("in"))->GetSlotIndex () != inputSlot->GetSlotIndex ());
+
+	ASSERT (manager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot));
+	ASSERT (manager.GetConnectedInputSlotCount (outputSlot) == 1);
+	ASSERT (manager.GetConnectedOutputSlotCount (inputSlot) == 1);
+
+	size_t outputSlotIndex = outputSlot->GetSlotIndex ();
+	ASSERT (manager.DeleteNode (node1));
+	ASSERT (outputSlot->GetSlotIndex () == InvalidSlotIndex);
+	ASSERT (!manager.HasConnectedOutputSlots (inputSlot));
+	ASSERT (manager.GetConnectionCount () == 0);
+
+	// the index of the deleted slot is reused
+	std::shared_ptr<AdderInputOutputNode> node3 (new AdderInputOutputNode ());
+	manager.AddNode (node3);
+	ASSERT (node3->GetOutputSlot (SlotId ("out"))->GetSlotIndex () == outputSlotIndex);
+	ASSERT (!manager.HasConnectedInputSlots (node3->GetOutputSlot (SlotId ("out"))));
+	ASSERT (!manager.IsOutputSlotConnectedToInputSlot (outputSlot, inputSlot));
+
+	manager.Clear ();
+	ASSERT (inputSlot->GetSlotIndex () == InvalidSlotIndex);
+}
+
+TEST (ConnectionManagerIndexTest)
+{
+	ConnectionManager connectionManager;
+	OutputSlotPtr outputSlot (new OutputSlot (SlotId ("out")));
+	InputSlotPtr inputSlot1 (new MultiInputSlot (SlotId ("in1"), ValuePtr (new IntValue (0))));
+	InputSlotPtr inputSlot2 (new MultiInputSlot (SlotId ("in2"), ValuePtr (new IntValue (0))));
+	ASSERT (connectionManager.GetConnectedInputSlotIndices (outputSlot).empty ());
+	ASSERT (!connectionManager.HasConnectedInputSlots (outputSlot));
+
+	// slots are registered on the first connection if they were not registered before
+	ASSERT (connectionManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot1));
+	ASSERT (connectionManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot2));
+	ASSERT (connectionManager.GetConnectionCount () == 2);
+	ASSERT (connectionManager.GetConnectedInputSlotCount (outputSlot) == 2);
+
+	const std::vector<size_t>& inputSlotIndices = connectionManager.GetConnectedInputSlotIndices (outputSlot);
+	ASSERT (inputSlotIndices.size () == 2);
+	ASSERT (connectionManager.GetInputSlot (inputSlotIndices[0]) == inputSlot1);
+	ASSERT (connectionManager.GetInputSlot (inputSlotIndices[1]) == inputSlot2);
+	const std::vector<size_t>& outputSlotIndices = connectionManager.GetConnectedOutputSlotIndices (inputSlot2);
+	ASSERT (outputSlotIndices.size () == 1);
+	ASSERT (connectionManager.GetOutputSlot (outputSlotIndices[0]) == outputSlot);
+
+	ASSERT (connectionManager.DisconnectAllInputSlotsFromOutputSlot (outputSlot));
+	ASSERT (connectionManager.IsEmpty ());
+	connectionManager.UnregisterOutputSlot (outputSlot);
+	ASSERT (outputSlot->GetSlotIndex () == InvalidSlotIndex);
+	ASSERT (!connectionManager.HasConnectedInputSlots (outputSlot));
+}
+
+TEST (GraphStatisticsTest)
+{
+	NodeManager manager;
+	GraphStatistics emptyStatistics = manager.GetGraphStatistics ();
+	ASSERT (emptyStatistics.GetNodeCount () == 0);
+	ASSERT (emptyStatistics.GetConnectionCount () == 0);
+	ASSERT (emptyStatistics.GetDepth () == 0);
+	ASSERT (emptyStatistics.GetMaxFanIn () == 0);
+
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node3 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr multiNode = manager.AddNode (NodePtr (new MultiAdditionNode ()));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), multiNode->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), multiNode->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), multiNode->GetInputSlot (SlotId ("in"))));
+
+	GraphStatistics statistics = manager.GetGraphStatistics ();
+	ASSERT (statistics.GetNodeCount () == 4);
+	ASSERT (statistics.GetConnectionCount () == 5);
+	ASSERT (statistics.GetNodeGroupCount () == 0);
+	ASSERT (statistics.GetMaxFanIn () == 3);
+	ASSERT (statistics.GetMaxFanOut () == 2);
+	ASSERT (!statistics.IsDepthKnown ());
+	ASSERT (statistics.GetMemoryStatistics ().GetConnectionMemorySize () > 0);
+	ASSERT (statistics.GetMemoryStatistics ().GetValueCacheMemorySize () == 0);
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	statistics = manager.GetGraphStatistics ();
+	ASSERT (statistics.IsDepthKnown ());
+	ASSERT (statistics.GetDepth () == 4);
+	ASSERT (statistics.GetMemoryStatistics ().GetEvaluationPlanMemorySize () > 0);
+	ASSERT (statistics.GetMemoryStatistics ().GetValueCacheMemorySize () > 0);
+
+	ASSERT (manager.DisconnectOutputSlotFromInputSlot (node3->GetOutputSlot (SlotId ("out")), multiNode->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.DisconnectOutputSlotFromInputSlot (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	statistics = manager.GetGraphStatistics ();
+	ASSERT (statistics.GetConnectionCount () == 3);
+	ASSERT (statistics.GetMaxFanIn () == 2);
+	ASSERT (statistics.GetMaxFanOut () == 2);
+	ASSERT (!statistics.IsDepthKnown ());
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (manager.GetGraphStatistics ().GetDepth () == 3);
+
+	ASSERT (manager.DeleteNode (node1));
+	statistics = manager.GetGraphStatistics ();
+	ASSERT (statistics.GetNodeCount () == 3);
+	ASSERT (statistics.GetConnectionCount () == 1);
+	ASSERT (statistics.GetMaxFanIn () == 1);
+	ASSERT (statistics.GetMaxFanOut () == 1);
+	ASSERT (!statistics.IsDepthKnown ());
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (manager.GetGraphStatistics ().GetDepth () == 2);
+}
+
+TEST (ForEachVisitorTest)
+{
+	NodeManager manager;
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr multiNode = manager.AddNode (NodePtr (new MultiAdditionNode ()));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), multiNode->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), multiNode->GetInputSlot (SlotId ("in"))));
+	const NodeManager& constManager = manager;
+
+	std::vector<NodeId> enumeratedNodes;
+	constManager.EnumerateNodes ([&] (NodeConstPtr node) {
+		enumeratedNodes.push_back (node->GetId ());
+		return true;
+	});
+	std::vector<NodeId> visitedNodes;
+	constManager.ForEachNode ([&] (const NodeConstPtr& node) {
+		visitedNodes.push_back (node->GetId ());
+		return true;
+	});
+	ASSERT (visitedNodes == enumeratedNodes);
+	ASSERT (visitedNodes == std::vector<NodeId> ({ node1->GetId (), node2->GetId (), multiNode->GetId () }));
+
+	size_t visitedNodeCount = 0;
+	manager.ForEachNode ([&] (const NodePtr&) {
+		visitedNodeCount++;
+		return visitedNodeCount < 2;
+	});
+	ASSERT (visitedNodeCount == 2);
+
+	std::vector<std::pair<NodeId, NodeId>> enumeratedConnections;
+	manager.EnumerateConnections ([&] (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) {
+		enumeratedConnections.push_back ({ outputSlot->GetOwnerNodeId (), inputSlot->GetOwnerNodeId () });
+	});
+	std::vector<std::pair<NodeId, NodeId>> visitedConnections;
+	manager.ForEachConnection ([&] (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) {
+		visitedConnections.push_back ({ outputSlot->GetOwnerNodeId (), inputSlot->GetOwnerNodeId () });
+	});
+	ASSERT (visitedConnections.size () == 3);
+	ASSERT (visitedConnections == enumeratedConnections);
+
+	std::vector<NodeId> connectedNodes;
+	manager.ForEachConnectedOutputSlot (multiNode->GetInputSlot (SlotId ("in")), [&] (const OutputSlotConstPtr& outputSlot) {
+		connectedNodes.push_back (outputSlot->GetOwnerNodeId ());
+	});
+	ASSERT (connectedNodes == std::vector<NodeId> ({ node1->GetId (), node2->GetId () }));
+
+	connectedNodes.clear ();
+	manager.ForEachConnectedInputSlot (node1->GetOutputSlot (SlotId ("out")), [&] (const InputSlotConstPtr& inputSlot) {
+		connectedNodes.push_back (inputSlot->GetOwnerNodeId ());
+	});
+	ASSERT (connectedNodes == std::vector<NodeId> ({ node2->GetId (), multiNode->GetId () }));
+
+	std::vector<SlotId> slotIds;
+	NodeConstPtr constNode = node1;
+	constNode->ForEachInputSlot ([&] (const InputSlotConstPtr& inputSlot) {
+		slotIds.push_back (inputSlot->GetId ());
+		return true;
+	});
+	constNode->ForEachOutputSlot ([&] (const OutputSlotConstPtr& outputSlot) {
+		slotIds.push_back (outputSlot->GetId ());
+		return true;
+	});
+	ASSERT (slotIds == std::vector<SlotId> ({ SlotId ("in"), SlotId ("out") }));
+}
+
 }
@@ -3,6 +3,9 @@
 #include "NUIE_NodeEditor.hpp"
 #include "BI_BuiltInNodes.hpp"
 #include "TestEnvironment.hpp"
+#include "TestUtils.hpp"
+
+#include <thread>
 
 using namespace NE;
 using namespace NUIE;
@@ -80,4 +83,127 @@ TEST (NodeEditorGetInfoTest)
 	ASSERT (info.groups[0].nodesInGroup[1] == NE::NodeId (3));
 }
 
+TEST (NodeEditorVisibleNodesEvaluationScopeTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	env.nodeEditor.SetEvaluationScope (NodeEditor::EvaluationScope::VisibleNodes);
+	ASSERT (env.nodeEditor.GetEvaluationScope () == NodeEditor::EvaluationScope::VisibleNodes);
+
+	UINodePtr intNode (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1));
+	UINodePtr viewerNode1 (new MultiLineViewerNode (LocString (L"Viewer1"), Point (300.0, 100.0), 5));
+	UINodePtr viewerNode2 (new MultiLineViewerNode (LocString (L"Viewer2"), Point (5000.0, 5000.0), 5));
+	env.nodeEditor.AddNode (intNode);
+	env.nodeEditor.AddNode (viewerNode1);
+	env.nodeEditor.AddNode (viewerNode2);
+	env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode1->GetUIInputSlot (SlotId ("in")));
+	env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode2->GetUIInputSlot (SlotId ("in")));
+
+	ASSERT (intNode->HasCalculatedValue ());
+	ASSERT (viewerNode1->HasCalculatedValue ());
+	ASSERT (!viewerNode2->HasCalculatedValue ());
+
+	env.nodeEditor.SetViewBox (ViewBox (Point (-4900.0, -4900.0), 1.0));
+	ASSERT (viewerNode2->HasCalculatedValue ());
+
+	env.nodeEditor.SetEvaluationScope (NodeEditor::EvaluationScope::AllNodes);
+	ASSERT (env.nodeEditor.GetEvaluationScope () == NodeEditor::EvaluationScope::AllNodes);
+}
+
+TEST (NodeUIManagerUpdateVisibleTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+	UINodePtr intNode = uiManager.AddNode (UINodePtr (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1)));
+	UINodePtr viewerNode1 = uiManager.AddNode (UINodePtr (new MultiLineViewerNode (LocString (L"Viewer1"), Point (300.0, 100.0), 5)));
+	UINodePtr viewerNode2 = uiManager.AddNode (UINodePtr (new MultiLineViewerNode (LocString (L"Viewer2"), Point (5000.0, 5000.0), 5)));
+	uiManager.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode1->GetUIInputSlot (SlotId ("in")));
+	uiManager.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode2->GetUIInputSlot (SlotId ("in")));
+
+	NodeUIEnvironment& uiEnvironment = env;
+	uiManager.UpdateVisible (uiEnvironment, Rect (0.0, 0.0, 1000.0, 1000.0));
+	ASSERT (intNode->HasCalculatedValue ());
+	ASSERT (viewerNode1->HasCalculatedValue ());
+	ASSERT (!viewerNode2->HasCalculatedValue ());
+
+	uiManager.RequestRecalculate ();
+	uiManager.UpdateVisible (uiEnvironment, Rect (4500.0, 4500.0, 1000.0, 1000.0));
+	ASSERT (viewerNode2->HasCalculatedValue ());
+
+	// the update through the calculation environment always evaluates every node
+	uiManager.InvalidateNodeValue (intNode);
+	ASSERT (!viewerNode1->HasCalculatedValue ());
+	ASSERT (!viewerNode2->HasCalculatedValue ());
+	NodeUICalculationEnvironment& calcEnv = env;
+	uiManager.Update (calcEnv);
+	ASSERT (viewerNode1->HasCalculatedValue ());
+	ASSERT (viewerNode2->HasCalculatedValue ());
+}
+
+TEST (NodeEditorTimeBudgetedEvaluationTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	ASSERT (env.nodeEditor.GetEvaluationTimeBudget () == std::chrono::microseconds::zero ());
+
+	UINodePtr intNode (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1));
+	env.nodeEditor.AddNode (intNode);
+	for (size_t i = 0; i < 10; ++i) {
+		UINodePtr viewerNode (new MultiLineViewerNode (LocString (L"Viewer" + std::to_wstring (i)), Point (300.0, 100.0 + i * 50.0), 5));
+		env.nodeEditor.AddNode (viewerNode);
+		env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode->GetUIInputSlot (SlotId ("in")));
+	}
+	ASSERT (!env.nodeEditor.IsEvaluationInProgress ());
+
+	MemoryOutputStream outputStream;
+	ASSERT (env.nodeEditor.Save (outputStream));
+	env.nodeEditor.New ();
+	env.nodeEditor.SetEvaluationTimeBudget (std::chrono::microseconds (1));
+
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	ASSERT (env.nodeEditor.Open (inputStream));
+	ASSERT (env.nodeEditor.IsEvaluationInProgress ());
+	ASSERT (!env.GetNode (L"Viewer9")->HasCalculatedValue ());
+
+	size_t updateCount = 0;
+	while (env.nodeEditor.IsEvaluationInProgress () && updateCount < 100) {
+		env.nodeEditor.Update ();
+		updateCount++;
+	}
+	ASSERT (!env.nodeEditor.IsEvaluationInProgress ());
+	ASSERT (env.GetNode (L"Integer")->HasCalculatedValue ());
+	for (size_t i = 0; i < 10; ++i) {
+		ASSERT (env.GetNode (L"Viewer" + std::to_wstring (i))->HasCalculatedValue ());
+	}
+
+	env.nodeEditor.SetEvaluationTimeBudget (std::chrono::microseconds::zero ());
+}
+
+TEST (NodeEditorBackgroundEvaluationTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	ASSERT (env.nodeEditor.GetEvaluationThread () == NodeEditor::EvaluationThread::Foreground);
+	env.nodeEditor.SetEvaluationThread (NodeEditor::EvaluationThread::Background);
+
+	UINodePtr intNode (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1));
+	env.nodeEditor.AddNode (intNode);
+	for (size_t i = 0; i < 10; ++i) {
+		UINodePtr viewerNode (new MultiLineViewerNode (LocString (L"Viewer" + std::to_wstring (i)), Point (300.0, 100.0 + i * 50.0), 5));
+		env.nodeEditor.AddNode (viewerNode);
+		env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode->GetUIInputSlot (SlotId ("in")));
+	}
+
+	size_t updateCount = 0;
+	while (env.nodeEditor.IsEvaluationInProgress () && updateCount < 10000) {
+		std::this_thread::sleep_for (std::chrono::milliseconds (1));
+		env.nodeEditor.Update ();
+		updateCount++;
+	}
+	ASSERT (!env.nodeEditor.IsEvaluationInProgress ());
+	ASSERT (intNode->HasCalculatedValue ());
+	for (size_t i = 0; i < 10; ++i) {
+		ASSERT (env.GetNode (L"Viewer" + std::to_wstring (i))->HasCalculatedValue ());
+	}
+
+	env.nodeEditor.SetEvaluationThread (NodeEditor::EvaluationThread::Foreground);
+}
+
 }
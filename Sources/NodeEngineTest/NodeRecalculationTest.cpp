@@ -6,6 +6,8 @@
 #include "NE_SingleValues.hpp"
 #include "TestNodes.hpp"
 
+#include <map>
+
 using namespace NE;
 
 namespace NodeRecalculationTest
@@ -36,6 +38,33 @@ public:
 	mutable int calculationCounter = 0;
 };
 
+class JoinTestNode : public SerializableTestNode
+{
+public:
+	JoinTestNode () :
+		SerializableTestNode ()
+	{
+	
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("a"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("b"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		calculationCounter++;
+		ValueConstPtr a = EvaluateInputSlot (SlotId ("a"), env);
+		ValueConstPtr b = EvaluateInputSlot (SlotId ("b"), env);
+		return ValuePtr (new IntValue ((IntValue::Get (a) + IntValue::Get (b)) / 2));
+	}
+
+	mutable int calculationCounter = 0;
+};
+
 TEST (RecalculationTest)
 {
 	NodeManager manager;
@@ -120,4 +149,259 @@ TEST (RecalculationTest)
 	}
 }
 
+TEST (DiamondGraphRecalculationTest)
+{
+	//      +-> 1 -+      +-> 4 -+
+	// 0 ---+      +-> 3 -+      +-> 6 ...
+	//      +-> 2 -+      +-> 5 -+
+
+	const size_t layerCount = 200;
+
+	NodeManager manager;
+	std::shared_ptr<TestNode> rootNode (new TestNode ());
+	manager.AddNode (rootNode);
+
+	std::vector<std::shared_ptr<TestNode>> branchNodes;
+	std::vector<std::shared_ptr<JoinTestNode>> joinNodes;
+	NodeConstPtr lastNode = rootNode;
+	for (size_t i = 0; i < layerCount; ++i) {
+		std::shared_ptr<TestNode> branchNode1 (new TestNode ());
+		std::shared_ptr<TestNode> branchNode2 (new TestNode ());
+		std::shared_ptr<JoinTestNode> joinNode (new JoinTestNode ());
+		manager.AddNode (branchNode1);
+		manager.AddNode (branchNode2);
+		manager.AddNode (joinNode);
+		manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), branchNode1->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), branchNode2->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (branchNode1->GetOutputSlot (SlotId ("out")), joinNode->GetInputSlot (SlotId ("a")));
+		manager.ConnectOutputSlotToInputSlot (branchNode2->GetOutputSlot (SlotId ("out")), joinNode->GetInputSlot (SlotId ("b")));
+		branchNodes.push_back (branchNode1);
+		branchNodes.push_back (branchNode2);
+		joinNodes.push_back (joinNode);
+		lastNode = joinNode;
+	}
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (lastNode->GetCalculatedValue ()) == (int) layerCount + 1);
+
+	size_t dependentCount = 0;
+	manager.EnumerateDependentNodesRecursive (rootNode, [&] (const NodeConstPtr&) {
+		dependentCount++;
+	});
+	ASSERT (dependentCount == 3 * layerCount);
+
+	rootNode->InvalidateValue ();
+	manager.EnumerateNodes ([&] (const NodeConstPtr& node) {
+		ASSERT (!node->HasCalculatedValue ());
+		return true;
+	});
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (rootNode->calculationCounter == 2);
+	for (const std::shared_ptr<TestNode>& node : branchNodes) {
+		ASSERT (node->calculationCounter == 2);
+	}
+	for (const std::shared_ptr<JoinTestNode>& node : joinNodes) {
+		ASSERT (node->calculationCounter == 2);
+	}
+
+	joinNodes[layerCount / 2]->InvalidateValue ();
+	size_t invalidatedCount = 0;
+	manager.EnumerateNodes ([&] (const NodeConstPtr& node) {
+		if (!node->HasCalculatedValue ()) {
+			invalidatedCount++;
+		}
+		return true;
+	});
+	ASSERT (invalidatedCount == 3 * (layerCount - layerCount / 2 - 1) + 1);
+}
+
+TEST (ReentrantDependentNodeTraversalTest)
+{
+	const size_t layerCount = 10;
+
+	NodeManager manager;
+	NodePtr rootNode = manager.AddNode (NodePtr (new TestNode ()));
+	NodePtr lastNode = rootNode;
+	for (size_t i = 0; i < layerCount; ++i) {
+		NodePtr branchNode1 = manager.AddNode (NodePtr (new TestNode ()));
+		NodePtr branchNode2 = manager.AddNode (NodePtr (new TestNode ()));
+		NodePtr joinNode = manager.AddNode (NodePtr (new JoinTestNode ()));
+		manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), branchNode1->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), branchNode2->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (branchNode1->GetOutputSlot (SlotId ("out")), joinNode->GetInputSlot (SlotId ("a")));
+		manager.ConnectOutputSlotToInputSlot (branchNode2->GetOutputSlot (SlotId ("out")), joinNode->GetInputSlot (SlotId ("b")));
+		lastNode = joinNode;
+	}
+
+	// the processor starts a new traversal from every visited node
+	std::map<NodeId, size_t> visitCounts;
+	size_t innerCount = 0;
+	manager.EnumerateDependentNodesRecursive (rootNode, [&] (const NodePtr& node) {
+		visitCounts[node->GetId ()]++;
+		manager.EnumerateDependentNodesRecursive (node, [&] (const NodePtr&) {
+			innerCount++;
+		});
+	});
+	ASSERT (visitCounts.size () == 3 * layerCount);
+	for (const auto& it : visitCounts) {
+		ASSERT (it.second == 1);
+	}
+
+	size_t expectedInnerCount = 0;
+	for (size_t i = 0; i < layerCount; ++i) {
+		size_t remainingLayerCount = layerCount - i - 1;
+		expectedInnerCount += 2 * (3 * remainingLayerCount + 1) + 3 * remainingLayerCount;
+	}
+	ASSERT (innerCount == expectedInnerCount);
+}
+
+TEST (TopologicalEvaluationOrderTest)
+{
+	NodeManager manager;
+
+	std::vector<std::shared_ptr<TestNode>> nodes;
+	for (size_t i = 0; i < 5; ++i) {
+		std::shared_ptr<TestNode> node (new TestNode ());
+		manager.AddNode (node);
+		nodes.push_back (node);
+	}
+	for (size_t i = nodes.size () - 1; i > 0; --i) {
+		manager.ConnectOutputSlotToInputSlot (nodes[i]->GetOutputSlot (SlotId ("out")), nodes[i - 1]->GetInputSlot (SlotId ("in")));
+	}
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	for (size_t i = 0; i < nodes.size (); ++i) {
+		ASSERT (nodes[i]->calculationCounter == 1);
+		ASSERT (IntValue::Get (nodes[i]->GetCalculatedValue ()) == (int) (nodes.size () - i));
+	}
+
+	manager.DisconnectOutputSlotFromInputSlot (nodes[3]->GetOutputSlot (SlotId ("out")), nodes[2]->GetInputSlot (SlotId ("in")));
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (nodes[0]->GetCalculatedValue ()) == 3);
+	ASSERT (IntValue::Get (nodes[3]->GetCalculatedValue ()) == 2);
+
+	std::shared_ptr<TestNode> newNode (new TestNode ());
+	manager.AddNode (newNode);
+	manager.ConnectOutputSlotToInputSlot (nodes[3]->GetOutputSlot (SlotId ("out")), newNode->GetInputSlot (SlotId ("in")));
+	manager.ConnectOutputSlotToInputSlot (newNode->GetOutputSlot (SlotId ("out")), nodes[2]->GetInputSlot (SlotId ("in")));
+	ASSERT (!manager.CanConnectOutputSlotToInputSlot (nodes[0]->GetOutputSlot (SlotId ("out")), nodes[4]->GetInputSlot (SlotId ("in"))));
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (newNode->calculationCounter == 1);
+	ASSERT (IntValue::Get (newNode->GetCalculatedValue ()) == 3);
+	ASSERT (IntValue::Get (nodes[0]->GetCalculatedValue ()) == 6);
+
+	manager.DeleteNode (newNode);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (nodes[2]->GetCalculatedValue ()) == 1);
+	ASSERT (IntValue::Get (nodes[0]->GetCalculatedValue ()) == 3);
+}
+
+TEST (EvaluateRequestedNodesTest)
+{
+	NodeManager manager;
+
+	std::vector<std::shared_ptr<TestNode>> chain1;
+	std::vector<std::shared_ptr<TestNode>> chain2;
+	for (size_t i = 0; i < 3; ++i) {
+		chain1.push_back (std::shared_ptr<TestNode> (new TestNode ()));
+		chain2.push_back (std::shared_ptr<TestNode> (new TestNode ()));
+		manager.AddNode (chain1.back ());
+		manager.AddNode (chain2.back ());
+	}
+	for (size_t i = 1; i < 3; ++i) {
+		manager.ConnectOutputSlotToInputSlot (chain1[i - 1]->GetOutputSlot (SlotId ("out")), chain1[i]->GetInputSlot (SlotId ("in")));
+		manager.ConnectOutputSlotToInputSlot (chain2[i - 1]->GetOutputSlot (SlotId ("out")), chain2[i]->GetInputSlot (SlotId ("in")));
+	}
+
+	manager.EvaluateNodes (NodeCollection ({ chain1[1]->GetId () }), EmptyEvaluationEnv);
+	ASSERT (chain1[0]->calculationCounter == 1);
+	ASSERT (chain1[1]->calculationCounter == 1);
+	ASSERT (chain1[2]->calculationCounter == 0);
+	for (const std::shared_ptr<TestNode>& node : chain2) {
+		ASSERT (node->calculationCounter == 0);
+		ASSERT (!node->HasCalculatedValue ());
+	}
+	ASSERT (IntValue::Get (chain1[1]->GetCalculatedValue ()) == 2);
+
+	manager.EvaluateNodes (NodeCollection ({ chain1[2]->GetId (), chain2[0]->GetId () }), EmptyEvaluationEnv);
+	ASSERT (chain1[0]->calculationCounter == 1);
+	ASSERT (chain1[1]->calculationCounter == 1);
+	ASSERT (chain1[2]->calculationCounter == 1);
+	ASSERT (chain2[0]->calculationCounter == 1);
+	ASSERT (chain2[1]->calculationCounter == 0);
+	ASSERT (IntValue::Get (chain1[2]->GetCalculatedValue ()) == 3);
+
+	manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+	chain1[1]->InvalidateValue ();
+	manager.EvaluateNodes (NodeCollection ({ chain1[2]->GetId (), chain2[2]->GetId () }), EmptyEvaluationEnv);
+	ASSERT (chain1[0]->calculationCounter == 1);
+	ASSERT (chain1[1]->calculationCounter == 2);
+	ASSERT (chain1[2]->calculationCounter == 2);
+	ASSERT (chain2[0]->calculationCounter == 1);
+	ASSERT (chain2[2]->calculationCounter == 1);
+	ASSERT (IntValue::Get (chain2[2]->GetCalculatedValue ()) == 3);
+}
+
+TEST (TimeBudgetedEvaluationTest)
+{
+	NodeManager manager;
+
+	std::vector<std::shared_ptr<TestNode>> nodes;
+	for (size_t i = 0; i < 5; ++i) {
+		std::shared_ptr<TestNode> node (new TestNode ());
+		manager.AddNode (node);
+		nodes.push_back (node);
+	}
+	for (size_t i = 1; i < nodes.size (); ++i) {
+		manager.ConnectOutputSlotToInputSlot (nodes[i - 1]->GetOutputSlot (SlotId ("out")), nodes[i]->GetInputSlot (SlotId ("in")));
+	}
+
+	ASSERT (!manager.IsEvaluationInProgress ());
+	EvaluationProgress progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::microseconds::zero ());
+	ASSERT (manager.IsEvaluationInProgress ());
+	ASSERT (progress.GetEvaluatedNodeCount () == 1);
+	ASSERT (progress.GetNodeCount () == 5);
+	ASSERT (progress.GetCalculatedNodes () == std::vector<NodeId> ({ nodes[0]->GetId () }));
+	ASSERT (!progress.IsFinished ());
+	progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::microseconds::zero ());
+	ASSERT (progress.GetEvaluatedNodeCount () == 2);
+	ASSERT (progress.GetCalculatedNodes () == std::vector<NodeId> ({ nodes[1]->GetId () }));
+	ASSERT (nodes[1]->HasCalculatedValue ());
+	ASSERT (!nodes[2]->HasCalculatedValue ());
+
+	nodes[0]->InvalidateValue ();
+	progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::microseconds::zero ());
+	ASSERT (progress.GetEvaluatedNodeCount () == 1);
+	ASSERT (progress.GetNodeCount () == 5);
+	ASSERT (nodes[0]->calculationCounter == 2);
+
+	progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::microseconds::zero ());
+	ASSERT (progress.GetEvaluatedNodeCount () == 2);
+	manager.DeleteNode (nodes[3]);
+	while (!progress.IsFinished ()) {
+		progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::microseconds::zero ());
+	}
+	ASSERT (!manager.IsEvaluationInProgress ());
+	ASSERT (nodes[3]->calculationCounter == 0);
+	ASSERT (nodes[4]->calculationCounter == 1);
+	ASSERT (IntValue::Get (nodes[2]->GetCalculatedValue ()) == 3);
+	ASSERT (IntValue::Get (nodes[4]->GetCalculatedValue ()) == 1);
+
+	progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::hours (1));
+	ASSERT (progress.IsFinished ());
+	ASSERT (progress.GetNodeCount () == 0);
+	ASSERT (progress.GetCalculatedNodes ().empty ());
+
+	manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+	nodes[0]->InvalidateValue ();
+	nodes[4]->InvalidateValue ();
+	progress = manager.EvaluateAllNodes (EmptyEvaluationEnv, std::chrono::hours (1));
+	ASSERT (progress.IsFinished ());
+	ASSERT (progress.GetNodeCount () == 4);
+	ASSERT (progress.GetCalculatedNodes ().size () == 4);
+	ASSERT (nodes[2]->calculationCounter == 2);
+	ASSERT (nodes[4]->calculationCounter == 2);
+}
+
 }
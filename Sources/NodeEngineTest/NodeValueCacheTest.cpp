@@ -102,6 +102,82 @@ public:
 	}
 };
 
+class ListNode : public SerializableTestNode
+{
+public:
+	ListNode () :
+		SerializableTestNode (),
+		calculationCount (0),
+		processCount (0)
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new TestInputSlot (SlotId ("in"))));
+		RegisterOutputSlot (OutputSlotPtr (new TestOutputSlot (SlotId ("out"))));
+	}
+
+	virtual bool IsThreadSafe () const override
+	{
+		return true;
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		calculationCount++;
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		ListValuePtr result (new ListValue ());
+		if (Value::IsType<IntValue> (in)) {
+			for (int i = 0; i < 1000; i++) {
+				result->Push (ValuePtr (new IntValue (IntValue::Get (in) + i)));
+			}
+		} else {
+			Value::Cast<ListValue> (in)->Enumerate ([&] (const ValueConstPtr& value) {
+				result->Push (ValuePtr (new IntValue (IntValue::Get (value) + 1)));
+				return true;
+			});
+		}
+		return result;
+	}
+
+	virtual void ProcessCalculatedValue (const ValueConstPtr&, NE::EvaluationEnv&) const override
+	{
+		processCount++;
+	}
+
+	mutable int calculationCount;
+	mutable int processCount;
+};
+
+class SumNode : public SerializableTestNode
+{
+public:
+	SumNode () :
+		SerializableTestNode ()
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new TestInputSlot (SlotId ("in"))));
+		RegisterOutputSlot (OutputSlotPtr (new TestOutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		int sum = 0;
+		Value::Cast<ListValue> (in)->Enumerate ([&] (const ValueConstPtr& value) {
+			sum += IntValue::Get (value);
+			return true;
+		});
+		return ValuePtr (new IntValue (sum));
+	}
+};
+
 TEST (SimpleCacheTest)
 {
 	NodeManager manager;
@@ -337,4 +413,70 @@ TEST (EvaluationEnvTest)
 	}
 }
 
+TEST (MemoryBudgetCacheTest)
+{
+	// 0 -> 1 -> 2 -> 3
+
+	NodeManager manager;
+	std::shared_ptr<InputOutputNode> sourceNode (new InputOutputNode ());
+	std::shared_ptr<ListNode> listNode1 (new ListNode ());
+	std::shared_ptr<ListNode> listNode2 (new ListNode ());
+	std::shared_ptr<SumNode> sumNode (new SumNode ());
+	manager.AddNode (sourceNode);
+	manager.AddNode (listNode1);
+	manager.AddNode (listNode2);
+	manager.AddNode (sumNode);
+	manager.ConnectOutputSlotToInputSlot (sourceNode->GetOutputSlot (SlotId ("out")), listNode1->GetInputSlot (SlotId ("in")));
+	manager.ConnectOutputSlotToInputSlot (listNode1->GetOutputSlot (SlotId ("out")), listNode2->GetInputSlot (SlotId ("in")));
+	manager.ConnectOutputSlotToInputSlot (listNode2->GetOutputSlot (SlotId ("out")), sumNode->GetInputSlot (SlotId ("in")));
+
+	size_t listSize = 0;
+	{
+		NodeManager unboundedManager;
+		std::shared_ptr<InputOutputNode> node (new InputOutputNode ());
+		std::shared_ptr<ListNode> listNode (new ListNode ());
+		unboundedManager.AddNode (node);
+		unboundedManager.AddNode (listNode);
+		unboundedManager.ConnectOutputSlotToInputSlot (node->GetOutputSlot (SlotId ("out")), listNode->GetInputSlot (SlotId ("in")));
+		unboundedManager.EvaluateAllNodes (EmptyEvaluationEnv);
+		listSize = listNode->GetCalculatedValue ()->GetMemorySize ();
+		ASSERT (unboundedManager.GetValueCacheStatistics ().GetEvictionCount () == 0);
+		ASSERT (unboundedManager.GetValueCacheStatistics ().GetMemorySize () > listSize);
+	}
+
+	manager.SetValueCacheBudget (listSize + listSize / 2);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (sumNode->GetCalculatedValue ()) == 500500 + 1000);
+	NodeValueCacheStatistics statistics = manager.GetValueCacheStatistics ();
+	ASSERT (statistics.GetValueCount () == 4);
+	ASSERT (statistics.GetEvictionCount () > 0);
+	ASSERT (statistics.GetMemorySize () <= manager.GetValueCacheBudget ());
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (listNode1->calculationCount == 1);
+	ASSERT (listNode2->calculationCount == 1);
+
+	ValueConstPtr listValue = listNode1->GetCalculatedValue ();
+	ASSERT (Value::Cast<ListValue> (listValue)->GetSize () == 1000);
+	ASSERT (IntValue::Get (Value::Cast<ListValue> (listValue)->GetValue (999)) == 1000);
+	ASSERT (listNode1->calculationCount == 2);
+	ASSERT (listNode1->processCount == 1);
+	ASSERT (manager.GetValueCacheStatistics ().GetMissCount () > 0);
+	ASSERT (manager.GetValueCacheStatistics ().GetHitCount () > 0);
+
+	sourceNode->InvalidateValue ();
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (sumNode->GetCalculatedValue ()) == 500500 + 1000);
+	ASSERT (listNode1->processCount == 2);
+	ASSERT (listNode2->processCount == 2);
+
+	manager.SetValueCacheBudget (0);
+	manager.InvalidateNodeValue (sourceNode);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	size_t evictionCount = manager.GetValueCacheStatistics ().GetEvictionCount ();
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (manager.GetValueCacheStatistics ().GetEvictionCount () == evictionCount);
+	ASSERT (manager.GetValueCacheStatistics ().GetMemorySize () > 2 * listSize);
+}
+
 }
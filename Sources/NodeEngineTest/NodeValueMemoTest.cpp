@@ -0,0 +1,390 @@
+#include "SimpleTest.hpp"
+#include "NE_NodeManager.hpp"
+#include "NE_Node.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_MemoryStream.hpp"
+
+using namespace NE;
+
+namespace NodeValueMemoTest
+{
+
+static int calculationCount = 0;
+
+class SourceNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (SourceNode);
+
+public:
+	SourceNode () :
+		SourceNode (0)
+	{
+
+	}
+
+	SourceNode (int value) :
+		Node (),
+		value (value)
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv&) const override
+	{
+		calculationCount++;
+		return ValuePtr (new IntValue (value));
+	}
+
+	virtual Stream::Status Read (InputStream& inputStream) override
+	{
+		ObjectHeader header (inputStream);
+		Node::Read (inputStream);
+		inputStream.Read (value);
+		return inputStream.GetStatus ();
+	}
+
+	virtual Stream::Status Write (OutputStream& outputStream) const override
+	{
+		ObjectHeader header (outputStream, serializationInfo);
+		Node::Write (outputStream);
+		outputStream.Write (value);
+		return outputStream.GetStatus ();
+	}
+
+	void SetValue (int newValue)
+	{
+		value = newValue;
+		InvalidateValue ();
+	}
+
+private:
+	int value;
+};
+
+class AddNode : public Node
+{
+	DYNAMIC_SERIALIZABLE (AddNode);
+
+public:
+	AddNode () :
+		Node ()
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("in"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("offset"), ValuePtr (new IntValue (1)), OutputSlotConnectionMode::Single)));
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		calculationCount++;
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		ValueConstPtr offset = EvaluateInputSlot (SlotId ("offset"), env);
+		return ValuePtr (new IntValue (IntValue::Get (in) + IntValue::Get (offset)));
+	}
+
+	virtual Stream::Status Read (InputStream& inputStream) override
+	{
+		ObjectHeader header (inputStream);
+		Node::Read (inputStream);
+		return inputStream.GetStatus ();
+	}
+
+	virtual Stream::Status Write (OutputStream& outputStream) const override
+	{
+		ObjectHeader header (outputStream, serializationInfo);
+		Node::Write (outputStream);
+		return outputStream.GetStatus ();
+	}
+};
+
+class OffsetData : public EvaluationData
+{
+public:
+	OffsetData (int offset) :
+		offset (offset)
+	{
+
+	}
+
+	int offset;
+};
+
+class AddEnvOffsetNode : public AddNode
+{
+	DYNAMIC_SERIALIZABLE (AddEnvOffsetNode);
+
+public:
+	AddEnvOffsetNode () :
+		AddNode ()
+	{
+
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		calculationCount++;
+		ValueConstPtr in = EvaluateInputSlot (SlotId ("in"), env);
+		return ValuePtr (new IntValue (IntValue::Get (in) + env.GetData<OffsetData> ()->offset));
+	}
+
+private:
+	virtual bool IsMemoizable () const override
+	{
+		return false;
+	}
+};
+
+DYNAMIC_SERIALIZATION_INFO (SourceNode, 1, "{6A1E94C2-3B7D-4F08-A5C9-2D8E71B0F364}");
+DYNAMIC_SERIALIZATION_INFO (AddNode, 1, "{C2F8057B-9E14-4D6A-B3A2-81D5E6C09F47}");
+DYNAMIC_SERIALIZATION_INFO (AddEnvOffsetNode, 1, "{3D9B6E21-F840-4C5A-9B17-E6A02C85D4F3}");
+
+class Chain
+{
+public:
+	Chain (NodeManager& manager, size_t length) :
+		source (new SourceNode (0)),
+		nodes ()
+	{
+		manager.AddNode (source);
+		NodePtr lastNode = source;
+		for (size_t i = 0; i < length; i++) {
+			std::shared_ptr<AddNode> node (new AddNode ());
+			manager.AddNode (node);
+			manager.ConnectOutputSlotToInputSlot (lastNode->GetOutputSlot (SlotId ("out")), node->GetInputSlot (SlotId ("in")));
+			nodes.push_back (node);
+			lastNode = node;
+		}
+	}
+
+	int GetResult () const
+	{
+		return IntValue::Get (nodes.back ()->GetCalculatedValue ());
+	}
+
+	std::shared_ptr<SourceNode>				source;
+	std::vector<std::shared_ptr<AddNode>>	nodes;
+};
+
+TEST (NodeValueMemoDisabledTest)
+{
+	NodeManager manager;
+	ASSERT (manager.GetValueMemoBudget () == 0);
+	Chain chain (manager, 3);
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	chain.source->SetValue (5);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 8);
+
+	calculationCount = 0;
+	chain.source->SetValue (0);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 3);
+	ASSERT (calculationCount == 4);
+	ASSERT (manager.GetValueMemoUsage () == 0);
+}
+
+TEST (NodeValueMemoScrubbingTest)
+{
+	NodeManager manager;
+	manager.SetValueMemoBudget (1024 * 1024);
+	Chain chain (manager, 3);
+
+	calculationCount = 0;
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 3);
+	ASSERT (calculationCount == 4);
+
+	calculationCount = 0;
+	chain.source->SetValue (5);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 8);
+	ASSERT (calculationCount == 4);
+
+	calculationCount = 0;
+	chain.source->SetValue (0);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 3);
+	ASSERT (calculationCount == 0);
+
+	calculationCount = 0;
+	chain.nodes[1]->SetInputSlotDefaultValue (SlotId ("offset"), ValuePtr (new IntValue (10)));
+	chain.nodes[1]->InvalidateValue ();
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 12);
+	ASSERT (calculationCount == 2);
+
+	calculationCount = 0;
+	manager.ClearValueMemo ();
+	ASSERT (manager.GetValueMemoUsage () == 0);
+	chain.source->SetValue (5);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 17);
+	ASSERT (calculationCount == 4);
+}
+
+TEST (NodeValueMemoParallelTest)
+{
+	NodeManager manager;
+	manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+	manager.SetValueMemoBudget (1024 * 1024);
+	Chain chain (manager, 10);
+
+	for (int i = 0; i < 5; i++) {
+		chain.source->SetValue (i);
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		ASSERT (chain.GetResult () == i + 10);
+	}
+
+	calculationCount = 0;
+	for (int i = 0; i < 5; i++) {
+		chain.source->SetValue (i);
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		ASSERT (chain.GetResult () == i + 10);
+	}
+	ASSERT (calculationCount == 0);
+}
+
+TEST (NodeValueMemoBudgetTest)
+{
+	NodeManager manager;
+	manager.SetValueMemoBudget (8192);
+	Chain chain (manager, 5);
+
+	for (int i = 0; i < 100; i++) {
+		chain.source->SetValue (i);
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		ASSERT (chain.GetResult () == i + 5);
+		ASSERT (manager.GetValueMemoUsage () <= 8192);
+	}
+	ASSERT (manager.GetValueMemoUsage () > 0);
+
+	calculationCount = 0;
+	chain.source->SetValue (99);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (calculationCount == 0);
+
+	calculationCount = 0;
+	chain.source->SetValue (0);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (chain.GetResult () == 5);
+	ASSERT (calculationCount == 6);
+
+	manager.SetValueMemoBudget (0);
+	ASSERT (manager.GetValueMemoUsage () == 0);
+}
+
+TEST (NodeValueMemoPersistenceTest)
+{
+	MemoryOutputStream documentStream;
+	MemoryOutputStream memoStream;
+	{
+		NodeManager manager;
+		manager.SetValueMemoBudget (1024 * 1024);
+		Chain chain (manager, 3);
+		chain.source->SetValue (7);
+		manager.EvaluateAllNodes (EmptyEvaluationEnv);
+		ASSERT (manager.Write (documentStream) == Stream::Status::NoError);
+		ASSERT (manager.WriteValueMemo (memoStream) == Stream::Status::NoError);
+	}
+
+	NodeManager manager;
+	manager.SetValueMemoBudget (1024 * 1024);
+	MemoryInputStream memoInputStream (memoStream.GetBuffer ());
+	ASSERT (manager.ReadValueMemo (memoInputStream) == Stream::Status::NoError);
+	ASSERT (manager.GetValueMemoUsage () > 0);
+
+	calculationCount = 0;
+	MemoryInputStream documentInputStream (documentStream.GetBuffer ());
+	ASSERT (manager.Read (documentInputStream) == Stream::Status::NoError);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (calculationCount == 0);
+
+	bool isResultFound = false;
+	manager.EnumerateNodes ([&] (NodeConstPtr node) {
+		if (node->HasCalculatedValue () && IntValue::Get (node->GetCalculatedValue ()) == 10) {
+			isResultFound = true;
+		}
+		return !isResultFound;
+	});
+	ASSERT (isResultFound);
+
+	NodeManager smallManager;
+	smallManager.SetValueMemoBudget (200);
+	MemoryInputStream smallMemoInputStream (memoStream.GetBuffer ());
+	ASSERT (smallManager.ReadValueMemo (smallMemoInputStream) == Stream::Status::NoError);
+	ASSERT (smallManager.GetValueMemoUsage () <= 200);
+}
+
+TEST (NodeValueMemoFingerprintTest)
+{
+	NodeValueFingerprint fingerprint (std::vector<char> ({ 'a', 'b', 'c' }));
+	NodeValueFingerprint sameFingerprint (std::vector<char> ({ 'a', 'b', 'c' }));
+	NodeValueFingerprint otherFingerprint (std::vector<char> ({ 'a', 'b', 'd' }));
+	ASSERT (fingerprint == sameFingerprint);
+	ASSERT (fingerprint != otherFingerprint);
+
+	NodeValueMemo memo (1024 * 1024);
+	ASSERT (memo.Add (fingerprint, ValuePtr (new IntValue (1))));
+	ValueHandle value = nullptr;
+	ASSERT (!memo.Get (otherFingerprint, value));
+	ASSERT (memo.Get (sameFingerprint, value));
+	ASSERT (IntValue::Get (value) == 1);
+
+	MemoryOutputStream outputStream;
+	ASSERT (memo.Write (outputStream) == Stream::Status::NoError);
+	NodeValueMemo readMemo (1024 * 1024);
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	ASSERT (readMemo.Read (inputStream) == Stream::Status::NoError);
+	ASSERT (!readMemo.Get (otherFingerprint, value));
+	ASSERT (readMemo.Get (fingerprint, value));
+	ASSERT (IntValue::Get (value) == 1);
+}
+
+TEST (NodeValueMemoNotMemoizableNodeTest)
+{
+	NodeManager manager;
+	manager.SetValueMemoBudget (1024 * 1024);
+	Chain chain (manager, 1);
+	std::shared_ptr<AddEnvOffsetNode> envNode (new AddEnvOffsetNode ());
+	manager.AddNode (envNode);
+	manager.ConnectOutputSlotToInputSlot (chain.nodes[0]->GetOutputSlot (SlotId ("out")), envNode->GetInputSlot (SlotId ("in")));
+
+	EvaluationEnv firstEnv (EvaluationDataPtr (new OffsetData (10)));
+	manager.EvaluateAllNodes (firstEnv);
+	ASSERT (IntValue::Get (envNode->GetCalculatedValue ()) == 11);
+
+	calculationCount = 0;
+	EvaluationEnv secondEnv (EvaluationDataPtr (new OffsetData (20)));
+	chain.source->SetValue (0);
+	manager.EvaluateAllNodes (secondEnv);
+	ASSERT (IntValue::Get (envNode->GetCalculatedValue ()) == 21);
+	ASSERT (calculationCount == 1);
+}
+
+TEST (NodeValueMemoClearManagerTest)
+{
+	NodeManager manager;
+	manager.SetValueMemoBudget (1024 * 1024);
+	Chain chain (manager, 3);
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (manager.GetValueMemoUsage () > 0);
+
+	manager.Clear ();
+	ASSERT (manager.GetValueMemoUsage () == 0);
+	ASSERT (manager.GetValueMemoBudget () == 1024 * 1024);
+}
+
+}
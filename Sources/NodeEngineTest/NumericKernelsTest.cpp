@@ -0,0 +1,211 @@
+#include "SimpleTest.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_ValueCombination.hpp"
+#include "BI_NumericKernels.hpp"
+#include "BI_BinaryOperationNodes.hpp"
+#include "BI_UnaryOperationNodes.hpp"
+#include "TestUtils.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace NE;
+using namespace NUIE;
+using namespace BI;
+
+namespace NumericKernelsTest
+{
+
+static std::vector<double> CreateNumbers (size_t count, double offset)
+{
+	std::vector<double> numbers;
+	for (size_t i = 0; i < count; i++) {
+		numbers.push_back (offset + (double) i * 1.75 - (double) (i % 3) * 4.5);
+	}
+	return numbers;
+}
+
+static std::vector<KernelInstructionSet> GetInstructionSets ()
+{
+	std::vector<KernelInstructionSet> instructionSets = { KernelInstructionSet::Scalar };
+	if (GetKernelInstructionSet () >= KernelInstructionSet::SSE2) {
+		instructionSets.push_back (KernelInstructionSet::SSE2);
+	}
+	if (GetKernelInstructionSet () >= KernelInstructionSet::AVX) {
+		instructionSets.push_back (KernelInstructionSet::AVX);
+	}
+	return instructionSets;
+}
+
+static ValueConstPtr EvaluateOperation (const UINodePtr& node, ValueCombinationMode combinationMode, const ValueConstPtr& aValue, const ValueConstPtr& bValue)
+{
+	node->SetInputSlotDefaultValue (SlotId ("a"), aValue);
+	if (bValue != nullptr) {
+		node->SetInputSlotDefaultValue (SlotId ("b"), bValue);
+		GetValueCombinationFeature (std::dynamic_pointer_cast<BasicUINode> (node))->SetValueCombinationMode (combinationMode);
+	}
+	node->InvalidateValue ();
+	return node->Evaluate (EmptyEvaluationEnv);
+}
+
+static std::vector<double> GetNumbers (const ValueConstPtr& value)
+{
+	std::vector<double> numbers;
+	FlatEnumerate (value, [&] (const ValueConstPtr& innerValue) {
+		numbers.push_back (NumberValue::ToDouble (innerValue));
+		return true;
+	});
+	return numbers;
+}
+
+TEST (BinaryKernelInstructionSetTest)
+{
+	std::vector<BinaryKernel> kernels = { BinaryKernel::Addition, BinaryKernel::Subtraction, BinaryKernel::Multiplication, BinaryKernel::Division };
+	for (size_t count = 0; count < 19; count++) {
+		std::vector<double> a = CreateNumbers (count + 1, 1.0);
+		std::vector<double> b = CreateNumbers (count + 1, 0.5);
+		for (BinaryKernel kernel : kernels) {
+			for (size_t aStride = 0; aStride <= 1; aStride++) {
+				for (size_t bStride = 0; bStride <= 1; bStride++) {
+					std::vector<double> expected (count, 0.0);
+					CalculateBinaryKernel (KernelInstructionSet::Scalar, kernel, a.data (), aStride, b.data (), bStride, expected.data (), count);
+					for (KernelInstructionSet instructionSet : GetInstructionSets ()) {
+						std::vector<double> result (count, 0.0);
+						CalculateBinaryKernel (instructionSet, kernel, a.data (), aStride, b.data (), bStride, result.data (), count);
+						ASSERT (result == expected);
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST (UnaryKernelInstructionSetTest)
+{
+	std::vector<UnaryKernel> kernels = { UnaryKernel::Abs, UnaryKernel::Floor, UnaryKernel::Ceil, UnaryKernel::Negative, UnaryKernel::Sqrt };
+	for (size_t count = 0; count < 19; count++) {
+		std::vector<double> a = CreateNumbers (count, 0.25);
+		for (UnaryKernel kernel : kernels) {
+			std::vector<double> expected (count, 0.0);
+			CalculateUnaryKernel (KernelInstructionSet::Scalar, kernel, a.data (), expected.data (), count);
+			for (KernelInstructionSet instructionSet : GetInstructionSets ()) {
+				std::vector<double> result (count, 0.0);
+				CalculateUnaryKernel (instructionSet, kernel, a.data (), result.data (), count);
+				for (size_t i = 0; i < count; i++) {
+					ASSERT (result[i] == expected[i] || (std::isnan (result[i]) && std::isnan (expected[i])));
+				}
+			}
+		}
+	}
+}
+
+TEST (IsFiniteArrayTest)
+{
+	ASSERT (IsFiniteArray (nullptr, 0));
+	std::vector<double> values = CreateNumbers (11, 0.0);
+	ASSERT (IsFiniteArray (values.data (), values.size ()));
+	for (size_t i = 0; i < values.size (); i++) {
+		std::vector<double> invalidValues = values;
+		invalidValues[i] = (i % 2 == 0) ? std::numeric_limits<double>::infinity () : std::numeric_limits<double>::quiet_NaN ();
+		ASSERT (!IsFiniteArray (invalidValues.data (), invalidValues.size ()));
+	}
+}
+
+TEST (BinaryOperationNodeKernelTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+	UINodePtr op = uiManager.AddNode (UINodePtr (new SubtractionNode (LocString (L"Subtraction"), Point (0, 0))));
+
+	ListValuePtr boxedList (new ListValue ());
+	boxedList->Push (ValuePtr (new IntValue (3)));
+	boxedList->Push (ValuePtr (new DoubleValue (1.5)));
+	boxedList->Push (ValuePtr (new IntValue (-2)));
+	std::vector<ValueConstPtr> aValues = { ValueConstPtr (new DoubleListValue (CreateNumbers (7, 2.0))), boxedList, ValueConstPtr (new DoubleValue (10.0)) };
+	std::vector<ValueConstPtr> bValues = { ValueConstPtr (new IntListValue ({ 4, 5, 6, 7, 8 })), ValueConstPtr (new DoubleListValue (CreateNumbers (3, 1.0))) };
+	std::vector<ValueCombinationMode> combinationModes = { ValueCombinationMode::Shortest, ValueCombinationMode::Longest, ValueCombinationMode::CrossProduct };
+
+	for (const ValueConstPtr& aValue : aValues) {
+		for (const ValueConstPtr& bValue : bValues) {
+			for (ValueCombinationMode combinationMode : combinationModes) {
+				std::vector<double> expected;
+				CombineValues (combinationMode, { aValue, bValue }, [&] (const ValueCombination& combination) {
+					expected.push_back (NumberValue::ToDouble (combination.GetValue (0)) - NumberValue::ToDouble (combination.GetValue (1)));
+					return true;
+				});
+				ValueConstPtr result = EvaluateOperation (op, combinationMode, aValue, bValue);
+				ASSERT (Value::IsType<DoubleListValue> (result));
+				ASSERT (GetNumbers (result) == expected);
+			}
+		}
+	}
+}
+
+TEST (OperationNodeInvalidResultTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+	UINodePtr division = uiManager.AddNode (UINodePtr (new DivisionNode (LocString (L"Division"), Point (0, 0))));
+	UINodePtr sqrt = uiManager.AddNode (UINodePtr (new SqrtNode (LocString (L"Sqrt"), Point (0, 0))));
+
+	ValueConstPtr numbers (new DoubleListValue ({ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 }));
+	ValueConstPtr divisors (new DoubleListValue ({ 1.0, 2.0, 0.0, 4.0, 5.0, 6.0 }));
+	ASSERT (EvaluateOperation (division, ValueCombinationMode::Longest, numbers, numbers) != nullptr);
+	ASSERT (EvaluateOperation (division, ValueCombinationMode::Longest, numbers, divisors) == nullptr);
+	ASSERT (EvaluateOperation (division, ValueCombinationMode::CrossProduct, numbers, ValueConstPtr (new DoubleValue (0.0))) == nullptr);
+
+	ASSERT (GetNumbers (EvaluateOperation (sqrt, ValueCombinationMode::Longest, numbers, nullptr)).size () == 6);
+	ASSERT (EvaluateOperation (sqrt, ValueCombinationMode::Longest, ValueConstPtr (new DoubleListValue ({ 4.0, 9.0, -0.5, 1.0 })), nullptr) == nullptr);
+
+	ListValuePtr nestedList (new ListValue ());
+	nestedList->Push (numbers);
+	nestedList->Push (ValuePtr (new IntValue (16)));
+	ValueConstPtr nestedResult = EvaluateOperation (sqrt, ValueCombinationMode::Longest, nestedList, nullptr);
+	ASSERT (GetNumbers (nestedResult).size () == 7);
+	ASSERT (GetNumbers (nestedResult).back () == 4.0);
+}
+
+TEST (SequenceOperationTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+	std::vector<UINodePtr> operations = {
+		uiManager.AddNode (UINodePtr (new AdditionNode (LocString (L"Addition"), Point (0, 0)))),
+		uiManager.AddNode (UINodePtr (new SubtractionNode (LocString (L"Subtraction"), Point (0, 0)))),
+		uiManager.AddNode (UINodePtr (new MultiplicationNode (LocString (L"Multiplication"), Point (0, 0)))),
+		uiManager.AddNode (UINodePtr (new DivisionNode (LocString (L"Division"), Point (0, 0))))
+	};
+
+	ValueConstPtr sequence (new IntSequenceValue (1, 2, 6));
+	ValueConstPtr constant (new DoubleValue (4.0));
+	std::vector<ValueCombinationMode> combinationModes = { ValueCombinationMode::Shortest, ValueCombinationMode::Longest, ValueCombinationMode::CrossProduct };
+	for (const UINodePtr& operation : operations) {
+		for (ValueCombinationMode combinationMode : combinationModes) {
+			ValueConstPtr result = EvaluateOperation (operation, combinationMode, sequence, constant);
+			ValueConstPtr expected = EvaluateOperation (operation, combinationMode, ValueConstPtr (new DoubleListValue ({ 1.0, 3.0, 5.0, 7.0, 9.0, 11.0 })), constant);
+			ASSERT (Value::IsType<DoubleSequenceValue> (result));
+			ASSERT (GetNumbers (result) == GetNumbers (expected));
+		}
+	}
+
+	UINodePtr addition = operations[0];
+	UINodePtr multiplication = operations[2];
+	UINodePtr division = operations[3];
+	ValueConstPtr bigSequence (new DoubleSequenceValue (0.0, 1.0, 10000000));
+	ValueConstPtr bigResult = EvaluateOperation (addition, ValueCombinationMode::Longest, bigSequence, constant);
+	ASSERT (Value::IsType<DoubleSequenceValue> (bigResult));
+	ASSERT (Value::Cast<DoubleSequenceValue> (bigResult)->Get (9999999) == 10000003.0);
+
+	ValueConstPtr sequenceSum = EvaluateOperation (addition, ValueCombinationMode::Longest, sequence, sequence);
+	ASSERT (Value::IsType<DoubleSequenceValue> (sequenceSum));
+	ASSERT (GetNumbers (sequenceSum) == std::vector<double> ({ 2.0, 6.0, 10.0, 14.0, 18.0, 22.0 }));
+
+	ValueConstPtr shortSequence (new IntSequenceValue (0, 1, 3));
+	ASSERT (Value::IsType<DoubleListValue> (EvaluateOperation (multiplication, ValueCombinationMode::Shortest, sequence, shortSequence)));
+	ASSERT (Value::IsType<DoubleListValue> (EvaluateOperation (addition, ValueCombinationMode::Longest, sequence, shortSequence)));
+	ASSERT (Value::IsType<DoubleListValue> (EvaluateOperation (division, ValueCombinationMode::Longest, constant, sequence)));
+	ASSERT (EvaluateOperation (division, ValueCombinationMode::Longest, sequence, ValueConstPtr (new DoubleValue (0.0))) == nullptr);
+}
+
+}
@@ -1,6 +1,8 @@
 #include "SimpleTest.hpp"
 #include "NE_OrderedMap.hpp"
 
+#include <algorithm>
+
 using namespace NE;
 
 namespace OrderedMapTest
@@ -229,4 +231,114 @@ TEST (OrderedMapMakeSortedTest)
 	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "one", "two", "three", "four", "five" }));
 }
 
+TEST (OrderedMapInsertIntoErasedPlaceTest)
+{
+	OrderedMap<int, std::string> map;
+	std::vector<std::string> numbers = { "one", "two", "three", "four", "five" };
+	for (int i = 1; i <= 5; i++) {
+		ASSERT (map.Insert (i, numbers[i - 1]));
+	}
+
+	ASSERT (map.Erase (2));
+	ASSERT (map.InsertBefore (6, "six", 3));
+	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "one", "six", "three", "four", "five" }));
+
+	ASSERT (map.Erase (4));
+	ASSERT (map.InsertAfter (7, "seven", 3));
+	ASSERT (map.InsertAfter (8, "eight", 3));
+	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "one", "six", "three", "eight", "seven", "five" }));
+	ASSERT (map.GetValue (7) == "seven");
+	ASSERT (map.GetValue (5) == "five");
+	ASSERT (map.Count () == 6);
+}
+
+TEST (OrderedMapManyErasesTest)
+{
+	OrderedMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		ASSERT (map.Insert (i, i * 10));
+	}
+	for (int i = 0; i < 1000; i++) {
+		if (i % 3 != 0) {
+			ASSERT (map.Erase (i));
+		}
+	}
+	ASSERT (map.Count () == 334);
+
+	OrderedMap<int, int> copied = map;
+	std::vector<int> expected;
+	for (int i = 0; i < 1000; i += 3) {
+		expected.push_back (i * 10);
+		ASSERT (map.Contains (i));
+		ASSERT (!map.Contains (i + 1));
+		ASSERT (map.GetValue (i) == i * 10);
+		ASSERT (copied.GetValue (i) == i * 10);
+	}
+
+	std::vector<int> enumerated;
+	copied.Enumerate ([&] (const int& value) {
+		enumerated.push_back (value);
+		return true;
+	});
+	ASSERT (enumerated == expected);
+
+	ASSERT (map.InsertBefore (1, 1, 0));
+	map.MakeSorted ();
+	ASSERT (map.GetValue (0) == 0);
+	ASSERT (map.GetValue (1) == 1);
+	ASSERT (map.GetValue (3) == 30);
+
+	for (int i = 0; i < 1000; i += 3) {
+		ASSERT (map.Erase (i));
+	}
+	ASSERT (map.Count () == 1);
+	ASSERT (map.GetValue (1) == 1);
+}
+
+TEST (OrderedMapMixedOperationsTest)
+{
+	OrderedMap<int, int> map;
+	std::vector<int> reference;
+	unsigned int seed = 42;
+	auto nextRandom = [&] () {
+		seed = seed * 1103515245 + 12345;
+		return (seed / 65536) % 32768;
+	};
+
+	for (int key = 0; key < 5000; key++) {
+		unsigned int operation = nextRandom () % 4;
+		if (reference.empty () || operation == 0) {
+			ASSERT (map.Insert (key, key));
+			reference.push_back (key);
+		} else if (operation == 1) {
+			size_t index = nextRandom () % reference.size ();
+			ASSERT (map.InsertBefore (key, key, reference[index]));
+			reference.insert (reference.begin () + index, key);
+		} else if (operation == 2) {
+			size_t index = nextRandom () % reference.size ();
+			ASSERT (map.InsertAfter (key, key, reference[index]));
+			reference.insert (reference.begin () + index + 1, key);
+		} else {
+			size_t index = nextRandom () % reference.size ();
+			ASSERT (map.Erase (reference[index]));
+			reference.erase (reference.begin () + index);
+		}
+		if (key % 100 == 0) {
+			map.MakeSorted ();
+			std::sort (reference.begin (), reference.end ());
+		}
+	}
+
+	std::vector<int> enumerated;
+	map.Enumerate ([&] (const int& value) {
+		enumerated.push_back (value);
+		return true;
+	});
+	ASSERT (enumerated == reference);
+	ASSERT (map.Count () == reference.size ());
+	for (int key : reference) {
+		ASSERT (map.GetValue (key) == key);
+	}
+}
+
 }
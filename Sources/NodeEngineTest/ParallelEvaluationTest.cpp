@@ -0,0 +1,251 @@
+#include "SimpleTest.hpp"
+#include "NE_NodeManager.hpp"
+#include "NE_Node.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_SingleValues.hpp"
+#include "TestNodes.hpp"
+
+#include <thread>
+
+using namespace NE;
+
+namespace ParallelEvaluationTest
+{
+
+class SourceNode : public SerializableTestNode
+{
+public:
+	SourceNode (int value) :
+		SerializableTestNode (),
+		value (value)
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual bool IsThreadSafe () const override
+	{
+		return true;
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv&) const override
+	{
+		calculationCounter++;
+		return ValuePtr (new IntValue (value));
+	}
+
+	int			value;
+	mutable int	calculationCounter = 0;
+};
+
+class CombineNode : public SerializableTestNode
+{
+public:
+	CombineNode () :
+		SerializableTestNode ()
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("a"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("b"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv& env) const override
+	{
+		calculationCounter++;
+		calculationThreadId = std::this_thread::get_id ();
+		ValueConstPtr a = EvaluateInputSlot (SlotId ("a"), env);
+		ValueConstPtr b = EvaluateInputSlot (SlotId ("b"), env);
+		return ValuePtr (new IntValue ((IntValue::Get (a) * 3 + IntValue::Get (b)) % 1000003));
+	}
+
+	virtual void ProcessCalculatedValue (const ValueConstPtr&, NE::EvaluationEnv&) const override
+	{
+		processCounter++;
+		processThreadId = std::this_thread::get_id ();
+	}
+
+	mutable int				calculationCounter = 0;
+	mutable int				processCounter = 0;
+	mutable std::thread::id	calculationThreadId;
+	mutable std::thread::id	processThreadId;
+};
+
+class ThreadSafeCombineNode : public CombineNode
+{
+public:
+	ThreadSafeCombineNode () :
+		CombineNode ()
+	{
+
+	}
+
+	virtual bool IsThreadSafe () const override
+	{
+		return true;
+	}
+};
+
+class WideGraph
+{
+public:
+	WideGraph (NodeManager& manager, size_t width, size_t depth) :
+		sourceNodes (),
+		combineNodes ()
+	{
+		std::vector<NodePtr> lastLayer;
+		for (size_t i = 0; i < width; ++i) {
+			std::shared_ptr<SourceNode> sourceNode (new SourceNode ((int) i + 1));
+			manager.AddNode (sourceNode);
+			sourceNodes.push_back (sourceNode);
+			lastLayer.push_back (sourceNode);
+		}
+		for (size_t layer = 0; layer < depth; ++layer) {
+			std::vector<NodePtr> newLayer;
+			for (size_t i = 0; i < width; ++i) {
+				std::shared_ptr<CombineNode> combineNode;
+				if ((layer + i) % 7 == 0) {
+					combineNode.reset (new CombineNode ());
+				} else {
+					combineNode.reset (new ThreadSafeCombineNode ());
+				}
+				manager.AddNode (combineNode);
+				manager.ConnectOutputSlotToInputSlot (lastLayer[i]->GetOutputSlot (SlotId ("out")), combineNode->GetInputSlot (SlotId ("a")));
+				manager.ConnectOutputSlotToInputSlot (lastLayer[(i + 1) % width]->GetOutputSlot (SlotId ("out")), combineNode->GetInputSlot (SlotId ("b")));
+				combineNodes.push_back (combineNode);
+				newLayer.push_back (combineNode);
+			}
+			lastLayer = newLayer;
+		}
+	}
+
+	std::vector<int> GetValues () const
+	{
+		std::vector<int> values;
+		for (const std::shared_ptr<CombineNode>& node : combineNodes) {
+			values.push_back (node->HasCalculatedValue () ? IntValue::Get (node->GetCalculatedValue ()) : -1);
+		}
+		return values;
+	}
+
+	bool IsEveryNodeCalculatedOnce () const
+	{
+		for (const std::shared_ptr<SourceNode>& node : sourceNodes) {
+			if (node->calculationCounter != 1) {
+				return false;
+			}
+		}
+		for (const std::shared_ptr<CombineNode>& node : combineNodes) {
+			if (node->calculationCounter != 1) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void ResetCounters ()
+	{
+		for (const std::shared_ptr<SourceNode>& node : sourceNodes) {
+			node->calculationCounter = 0;
+		}
+		for (const std::shared_ptr<CombineNode>& node : combineNodes) {
+			node->calculationCounter = 0;
+		}
+	}
+
+	std::vector<std::shared_ptr<SourceNode>>	sourceNodes;
+	std::vector<std::shared_ptr<CombineNode>>	combineNodes;
+};
+
+TEST (ParallelEvaluationSameResultTest)
+{
+	NodeManager serialManager;
+	NodeManager parallelManager;
+	ASSERT (parallelManager.GetEvaluationMode () == NodeManager::EvaluationMode::Serial);
+	parallelManager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+
+	WideGraph serialGraph (serialManager, 64, 20);
+	WideGraph parallelGraph (parallelManager, 64, 20);
+
+	serialManager.EvaluateAllNodes (EmptyEvaluationEnv);
+	parallelManager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (serialGraph.GetValues () == parallelGraph.GetValues ());
+	ASSERT (parallelGraph.IsEveryNodeCalculatedOnce ());
+
+	parallelGraph.ResetCounters ();
+	parallelManager.EvaluateAllNodes (EmptyEvaluationEnv);
+	for (const std::shared_ptr<CombineNode>& node : parallelGraph.combineNodes) {
+		ASSERT (node->calculationCounter == 0);
+	}
+
+	serialGraph.sourceNodes[10]->value = 42;
+	serialGraph.sourceNodes[10]->InvalidateValue ();
+	parallelGraph.sourceNodes[10]->value = 42;
+	parallelGraph.sourceNodes[10]->InvalidateValue ();
+	serialManager.EvaluateAllNodes (EmptyEvaluationEnv);
+	parallelManager.EvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (serialGraph.GetValues () == parallelGraph.GetValues ());
+}
+
+TEST (ParallelEvaluationThreadUnsafeNodeTest)
+{
+	NodeManager manager;
+	manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+	WideGraph graph (manager, 32, 10);
+
+	// nodes are not thread safe unless they opt in
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	std::thread::id callerThreadId = std::this_thread::get_id ();
+	for (const std::shared_ptr<CombineNode>& node : graph.combineNodes) {
+		if (std::dynamic_pointer_cast<ThreadSafeCombineNode> (node) == nullptr) {
+			ASSERT (node->calculationThreadId == callerThreadId);
+		}
+	}
+}
+
+TEST (ParallelEvaluationProcessOnCallerThreadTest)
+{
+	NodeManager manager;
+	manager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+	WideGraph graph (manager, 32, 10);
+
+	manager.EvaluateAllNodes (EmptyEvaluationEnv);
+	std::thread::id callerThreadId = std::this_thread::get_id ();
+	for (const std::shared_ptr<CombineNode>& node : graph.combineNodes) {
+		ASSERT (node->processCounter == 1);
+		ASSERT (node->processThreadId == callerThreadId);
+	}
+}
+
+TEST (ParallelEvaluationManualUpdateTest)
+{
+	NodeManager serialManager;
+	NodeManager parallelManager;
+	serialManager.SetUpdateMode (NodeManager::UpdateMode::Manual);
+	parallelManager.SetUpdateMode (NodeManager::UpdateMode::Manual);
+	parallelManager.SetEvaluationMode (NodeManager::EvaluationMode::Parallel);
+
+	WideGraph serialGraph (serialManager, 16, 8);
+	WideGraph parallelGraph (parallelManager, 16, 8);
+
+	parallelManager.EvaluateAllNodes (EmptyEvaluationEnv);
+	for (const std::shared_ptr<CombineNode>& node : parallelGraph.combineNodes) {
+		ASSERT (!node->HasCalculatedValue ());
+	}
+
+	serialManager.ForceEvaluateAllNodes (EmptyEvaluationEnv);
+	parallelManager.ForceEvaluateAllNodes (EmptyEvaluationEnv);
+	ASSERT (serialGraph.GetValues () == parallelGraph.GetValues ());
+	ASSERT (parallelGraph.IsEveryNodeCalculatedOnce ());
+}
+
+}
@@ -1,5 +1,7 @@
 #include "SimpleTest.hpp"
 #include "NE_Serializable.hpp"
+#include "NE_InternedString.hpp"
+#include "NE_SlotId.hpp"
 #include "NE_SingleValues.hpp"
 #include "NE_MemoryStream.hpp"
 
@@ -285,4 +287,60 @@ TEST (ValueTest)
 	ASSERT (DoubleValue::Get (doubleVal) == DoubleValue::Get (newListVal->GetValue (1)));
 }
 
+TEST (InternedStringTest)
+{
+	InternedString empty;
+	InternedString alma ("alma");
+	InternedString alma2 (std::string ("al") + "ma");
+	InternedString korte ("korte");
+
+	ASSERT (empty.Get ().empty ());
+	ASSERT (empty == InternedString (""));
+	ASSERT (alma == alma2);
+	ASSERT (&alma.Get () == &alma2.Get ());
+	ASSERT (alma.GenerateHashValue () == alma2.GenerateHashValue ());
+	ASSERT (alma != korte);
+	ASSERT (alma < korte);
+	ASSERT (korte > alma);
+	ASSERT (!(alma < alma2));
+	ASSERT (!(alma > alma2));
+
+	size_t internedStringCount = InternedString::GetInternedStringCount ();
+	InternedString alma3 ("alma");
+	ASSERT (InternedString::GetInternedStringCount () == internedStringCount);
+}
+
+TEST (InternedIdSerializationTest)
+{
+	SlotId slotId ("alma");
+	ObjectId objectId ("{7CB03170-3A8D-43EC-9806-F423A39F07DA}");
+
+	MemoryOutputStream outputStream;
+	slotId.Write (outputStream);
+	objectId.Write (outputStream);
+
+	{
+		// ids are stored as plain strings
+		MemoryInputStream inputStream (outputStream.GetBuffer ());
+		ObjectHeader header (inputStream);
+		std::string slotIdString;
+		std::string objectIdString;
+		inputStream.Read (slotIdString);
+		inputStream.Read (objectIdString);
+		ASSERT (slotIdString == "alma");
+		ASSERT (objectIdString == "{7CB03170-3A8D-43EC-9806-F423A39F07DA}");
+	}
+
+	{
+		MemoryInputStream inputStream (outputStream.GetBuffer ());
+		SlotId readSlotId;
+		ObjectId readObjectId;
+		ASSERT (readSlotId.Read (inputStream) == Stream::Status::NoError);
+		ASSERT (readObjectId.Read (inputStream) == Stream::Status::NoError);
+		ASSERT (readSlotId == slotId);
+		ASSERT (readSlotId.GenerateHashValue () == slotId.GenerateHashValue ());
+		ASSERT (readObjectId == objectId);
+	}
+}
+
 }
@@ -263,6 +263,11 @@ void TestNodeUIEnvironment::OnEvaluationEnd ()
 
 }
 
+void TestNodeUIEnvironment::OnEvaluationProgress (const NE::EvaluationProgress&)
+{
+
+}
+
 void TestNodeUIEnvironment::OnValuesRecalculated ()
 {
 
@@ -47,6 +47,7 @@ public:
 	virtual EvaluationEnv&			GetEvaluationEnv () override;
 	virtual void					OnEvaluationBegin () override;
 	virtual void					OnEvaluationEnd () override;
+	virtual void					OnEvaluationProgress (const NE::EvaluationProgress& progress) override;
 	virtual void					OnValuesRecalculated () override;
 	virtual void					OnRedrawRequested () override;
 	virtual EventHandler&			GetEventHandler () override;
@@ -53,6 +53,11 @@ void TestUIEnvironment::OnEvaluationEnd ()
 
 }
 
+void TestUIEnvironment::OnEvaluationProgress (const NE::EvaluationProgress&)
+{
+
+}
+
 void TestUIEnvironment::OnValuesRecalculated ()
 {
 
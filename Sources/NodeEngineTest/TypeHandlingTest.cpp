@@ -132,7 +132,7 @@ public:
 		
 		}
 
-		virtual ValueConstPtr Evaluate (NE::EvaluationEnv& env) const override
+		virtual ValueHandle Evaluate (NE::EvaluationEnv& env) const override
 		{
 			ValueConstPtr ownerVal = EvaluateOwnerNode (env);
 			const GenericValue<ABPair>* pair = Value::Cast<ABPairValue> (ownerVal.get ());
@@ -149,7 +149,7 @@ public:
 		
 		}
 
-		virtual ValueConstPtr Evaluate (NE::EvaluationEnv& env) const override
+		virtual ValueHandle Evaluate (NE::EvaluationEnv& env) const override
 		{
 			ValueConstPtr ownerVal = EvaluateOwnerNode (env);
 			const GenericValue<ABPair>* pair = Value::Cast<ABPairValue> (ownerVal.get ());
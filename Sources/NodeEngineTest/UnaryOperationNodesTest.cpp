@@ -2,6 +2,7 @@
 #include "NUIE_NodeUIManager.hpp"
 #include "BI_UnaryOperationNodes.hpp"
 #include "BI_InputUINodes.hpp"
+#include "NE_ListValues.hpp"
 #include "TestUtils.hpp"
 
 using namespace NE;
@@ -44,7 +45,7 @@ TEST (TestAbsoluteNodeWithList)
 	uiManager.ConnectOutputSlotToInputSlot (listVal->GetUIOutputSlot (SlotId ("out")), op->GetUIInputSlot (SlotId ("a")));
 
 	ValueConstPtr value = op->Evaluate (EmptyEvaluationEnv);
-	ASSERT (Value::IsType<ListValue> (value));
+	ASSERT (Value::IsType<DoubleListValue> (value));
 	std::vector<double> values;
 	FlatEnumerate (value, [&] (const ValueConstPtr& v) {
 		values.push_back (NumberValue::ToDouble (v));
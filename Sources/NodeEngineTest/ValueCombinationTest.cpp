@@ -8,6 +8,48 @@ using namespace NE;
 namespace ValueCombinationTest
 {
 
+static ValueConstPtr CreateIntList (size_t size, int offset)
+{
+	if (size == 1) {
+		return ValueConstPtr (new IntValue (offset));
+	}
+	ListValuePtr list (new ListValue ());
+	for (size_t i = 0; i < size; i++) {
+		list->Push (ValuePtr (new IntValue (offset + (int) i)));
+	}
+	return list;
+}
+
+template <size_t ValueCount>
+static std::vector<std::vector<int>> GetLegacyCombinations (ValueCombinationMode combinationMode, const std::array<ValueConstPtr, ValueCount>& values)
+{
+	std::vector<std::vector<int>> combinations;
+	CombineValues (combinationMode, std::vector<ValueConstPtr> (values.begin (), values.end ()), [&] (const ValueCombination& current) {
+		std::vector<int> combination;
+		for (size_t i = 0; i < current.GetSize (); i++) {
+			combination.push_back (IntValue::Get (current.GetValue (i)));
+		}
+		combinations.push_back (combination);
+		return true;
+	});
+	return combinations;
+}
+
+template <size_t ValueCount>
+static std::vector<std::vector<int>> GetCombinations (ValueCombinationMode combinationMode, const std::array<ValueConstPtr, ValueCount>& values)
+{
+	std::vector<std::vector<int>> combinations;
+	CombineValues (combinationMode, values, [&] (const ListValueCombination<ValueCount>& current) {
+		std::vector<int> combination;
+		for (size_t i = 0; i < current.GetSize (); i++) {
+			combination.push_back (IntValue::Get (current.GetValue (i)));
+		}
+		combinations.push_back (combination);
+		return true;
+	});
+	return combinations;
+}
+
 TEST (DegenerateCaseTests)
 {
 	{
@@ -343,4 +385,73 @@ TEST (ValueCombinationTest3)
 	}
 }
 
+TEST (CombinationIteratorTest)
+{
+	std::vector<ValueCombinationMode> combinationModes = { ValueCombinationMode::Shortest, ValueCombinationMode::Longest, ValueCombinationMode::CrossProduct };
+	for (ValueCombinationMode combinationMode : combinationModes) {
+		for (size_t aSize = 1; aSize <= 4; aSize++) {
+			for (size_t bSize = 1; bSize <= 4; bSize++) {
+				std::array<ValueConstPtr, 2> values = {{ CreateIntList (aSize, 0), CreateIntList (bSize, 10) }};
+				ASSERT (GetCombinations (combinationMode, values) == GetLegacyCombinations (combinationMode, values));
+				for (size_t cSize = 1; cSize <= 3; cSize++) {
+					std::array<ValueConstPtr, 3> values3 = {{ CreateIntList (aSize, 0), CreateIntList (bSize, 10), CreateIntList (cSize, 20) }};
+					ASSERT (GetCombinations (combinationMode, values3) == GetLegacyCombinations (combinationMode, values3));
+				}
+			}
+		}
+		std::array<ValueConstPtr, 1> values1 = {{ CreateIntList (5, 0) }};
+		ASSERT (GetCombinations (combinationMode, values1) == GetLegacyCombinations (combinationMode, values1));
+	}
+}
+
+TEST (CombinationIteratorBlocksTest)
+{
+	{
+		ValueCombinationIterator<2> iterator (ValueCombinationMode::Longest, {{ 5, 2 }});
+		std::vector<CombinationBlock<2>> blocks;
+		ASSERT (iterator.EnumerateBlocks ([&] (const CombinationBlock<2>& block) {
+			blocks.push_back (block);
+			return true;
+		}));
+		ASSERT (iterator.GetCombinationCount () == 5);
+		ASSERT (blocks.size () == 2);
+		ASSERT (blocks[0].count == 2);
+		ASSERT (blocks[1].firstIndices == CombinationIndices<2> ({{ 2, 1 }}));
+		ASSERT (blocks[1].strides == CombinationIndices<2> ({{ 1, 0 }}));
+		ASSERT (blocks[1].count == 3);
+	}
+	{
+		ValueCombinationIterator<3> iterator (ValueCombinationMode::CrossProduct, {{ 2, 3, 4 }});
+		size_t blockCount = 0;
+		size_t combinationCount = 0;
+		ASSERT (iterator.EnumerateBlocks ([&] (const CombinationBlock<3>& block) {
+			blockCount += 1;
+			combinationCount += block.count;
+			return true;
+		}));
+		ASSERT (iterator.GetCombinationCount () == 24);
+		ASSERT (blockCount == 6);
+		ASSERT (combinationCount == 24);
+	}
+	{
+		ValueCombinationIterator<2> iterator (ValueCombinationMode::Shortest, {{ 3, 0 }});
+		ASSERT (!iterator.IsValid ());
+		ASSERT (iterator.GetCombinationCount () == 0);
+		ASSERT (!iterator.Enumerate ([&] (const CombinationIndices<2>&) {
+			return true;
+		}));
+	}
+}
+
+TEST (CombinationIteratorStoppingTest)
+{
+	ValueCombinationIterator<2> iterator (ValueCombinationMode::CrossProduct, {{ 3, 3 }});
+	size_t count = 0;
+	ASSERT (!iterator.Enumerate ([&] (const CombinationIndices<2>&) {
+		count += 1;
+		return count < 4;
+	}));
+	ASSERT (count == 4);
+}
+
 }
@@ -0,0 +1,148 @@
+#include "SimpleTest.hpp"
+#include "NE_ValueHandle.hpp"
+#include "NE_SingleValues.hpp"
+#include "NE_ListValues.hpp"
+#include "NE_NodeValueCache.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_BinaryOperationNodes.hpp"
+#include "BI_UnaryOperationNodes.hpp"
+#include "TestUtils.hpp"
+
+using namespace NE;
+using namespace NUIE;
+using namespace BI;
+
+namespace ValueHandleTest
+{
+
+TEST (ScalarValueHandleTest)
+{
+	ValueHandle nullHandle;
+	ASSERT (nullHandle.IsNull ());
+	ASSERT (nullHandle == nullptr);
+	ASSERT (!nullHandle.IsNumber ());
+	ASSERT ((ValueConstPtr) nullHandle == nullptr);
+
+	ValueHandle boolHandle (true);
+	ASSERT (boolHandle.GetKind () == ValueHandle::Kind::Boolean);
+	ASSERT (boolHandle.IsScalar ());
+	ASSERT (!boolHandle.IsNumber ());
+	ASSERT (boolHandle.ToBoolean ());
+	ASSERT (BooleanValue::Get (boolHandle) == true);
+
+	ValueHandle intHandle (42);
+	ASSERT (intHandle.GetKind () == ValueHandle::Kind::Integer);
+	ASSERT (intHandle.IsNumber ());
+	ASSERT (intHandle.ToDouble () == 42.0);
+	ASSERT (Value::IsType<IntValue> (intHandle));
+	ASSERT (IntValue::Get (intHandle) == 42);
+
+	ValueHandle floatHandle (2.5f);
+	ASSERT (floatHandle.GetKind () == ValueHandle::Kind::Float);
+	ASSERT (floatHandle.ToInteger () == 2);
+	ASSERT (Value::IsType<FloatValue> (floatHandle));
+
+	ValueHandle doubleHandle (-1.25);
+	ASSERT (doubleHandle.GetKind () == ValueHandle::Kind::Double);
+	ASSERT (doubleHandle.ToFloat () == -1.25f);
+	ASSERT (doubleHandle.GetMemorySize () == 0);
+	ASSERT (DoubleValue::Get (doubleHandle) == -1.25);
+	ASSERT (IsSingleType<DoubleValue> (doubleHandle));
+}
+
+TEST (BoxedValueHandleTest)
+{
+	ValueHandle intHandle (42);
+	ASSERT (intHandle.GetMemorySize () == 0);
+	ValueConstPtr boxedValue = intHandle.GetValue ();
+	ASSERT (IntValue::Get (boxedValue) == 42);
+	ASSERT (intHandle.GetKind () == ValueHandle::Kind::Integer);
+	ASSERT (intHandle.GetObject () == nullptr);
+	ASSERT (intHandle.GetMemorySize () == 0);
+
+	ValueHandle copiedHandle = intHandle;
+	ASSERT (IntValue::Get (copiedHandle.GetValue ()) == 42);
+	ASSERT (copiedHandle.GetValue () != boxedValue);
+
+	ValueHandle doubleHandle (1.5);
+	ValueHandle copiedDoubleHandle = doubleHandle;
+	ASSERT (DoubleValue::Get (copiedDoubleHandle.GetValue ()) == 1.5);
+	ASSERT (copiedDoubleHandle.ToDouble () == 1.5);
+}
+
+TEST (ObjectValueHandleTest)
+{
+	ValueConstPtr doubleValue (new DoubleValue (3.5));
+	ValueHandle doubleHandle (doubleValue);
+	ASSERT (doubleHandle.GetKind () == ValueHandle::Kind::Object);
+	ASSERT (!doubleHandle.IsScalar ());
+	ASSERT (doubleHandle.IsNumber ());
+	ASSERT (doubleHandle.ToDouble () == 3.5);
+	ASSERT (doubleHandle.GetValue () == doubleValue);
+	ASSERT (doubleHandle.GetObject () == doubleValue.get ());
+	ASSERT (doubleHandle.GetMemorySize () == doubleValue->GetMemorySize ());
+
+	ValueHandle listHandle = DoubleListValuePtr (new DoubleListValue ({ 1.0, 2.0 }));
+	ASSERT (listHandle.GetKind () == ValueHandle::Kind::Object);
+	ASSERT (!listHandle.IsNumber ());
+	ASSERT (IsComplexType<DoubleValue> (listHandle));
+
+	ValueHandle emptyHandle = ValuePtr (nullptr);
+	ASSERT (emptyHandle.IsNull ());
+}
+
+TEST (ValueHandleCacheTest)
+{
+	NodeValueCache cache;
+	ASSERT (cache.Add (NodeId (1), ValueHandle (1.5)));
+	ASSERT (cache.Add (NodeId (2), ValueConstPtr (new DoubleValue (2.5))));
+	ASSERT (cache.Get (NodeId (1)).GetKind () == ValueHandle::Kind::Double);
+	ASSERT (cache.Get (NodeId (1)).ToDouble () == 1.5);
+	ASSERT (cache.Get (NodeId (2)).GetKind () == ValueHandle::Kind::Object);
+	ASSERT (cache.GetStatistics ().GetMemorySize () == cache.Get (NodeId (2)).GetMemorySize ());
+}
+
+TEST (ScalarEvaluationTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	UINodePtr val1 = uiManager.AddNode (UINodePtr (new DoubleUpDownNode (LocString (L"Value1"), Point (0, 0), 2.0, 1.0)));
+	UINodePtr val2 = uiManager.AddNode (UINodePtr (new IntegerUpDownNode (LocString (L"Value2"), Point (0, 0), 3, 1)));
+	UINodePtr add = uiManager.AddNode (UINodePtr (new AdditionNode (LocString (L"Addition"), Point (0, 0))));
+	UINodePtr negative = uiManager.AddNode (UINodePtr (new NegativeNode (LocString (L"Negative"), Point (0, 0))));
+	uiManager.ConnectOutputSlotToInputSlot (val1->GetUIOutputSlot (SlotId ("out")), add->GetUIInputSlot (SlotId ("a")));
+	uiManager.ConnectOutputSlotToInputSlot (val2->GetUIOutputSlot (SlotId ("out")), add->GetUIInputSlot (SlotId ("b")));
+	uiManager.ConnectOutputSlotToInputSlot (add->GetUIOutputSlot (SlotId ("result")), negative->GetUIInputSlot (SlotId ("a")));
+
+	ValueHandle result = negative->Evaluate (EmptyEvaluationEnv);
+	ASSERT (result.GetKind () == ValueHandle::Kind::Double);
+	ASSERT (result.ToDouble () == -5.0);
+	ASSERT (add->Evaluate (EmptyEvaluationEnv).GetKind () == ValueHandle::Kind::Double);
+	ASSERT (add->Evaluate (EmptyEvaluationEnv).GetMemorySize () == 0);
+	ASSERT (IsEqual (DoubleValue::Get (negative->GetCalculatedValue ()), -5.0));
+
+	ValueConstPtr boxedResult = add->Evaluate (EmptyEvaluationEnv);
+	ASSERT (Value::IsType<DoubleValue> (boxedResult));
+	ASSERT (DoubleValue::Get (boxedResult) == 5.0);
+}
+
+
+TEST (ValueHandleContentHashTest)
+{
+	ASSERT (ValueHandle (5).GetContentHash () == ValueHandle (5).GetContentHash ());
+	ASSERT (ValueHandle (5).GetContentHash () != ValueHandle (6).GetContentHash ());
+	ASSERT (ValueHandle (5).GetContentHash () != ValueHandle (5.0).GetContentHash ());
+
+	ListValuePtr list (new ListValue ());
+	list->Push (ValueConstPtr (new IntValue (5)));
+	ListValuePtr sameList (new ListValue ());
+	sameList->Push (ValueConstPtr (new IntValue (5)));
+	ListValuePtr otherList (new ListValue ());
+	otherList->Push (ValueConstPtr (new StringValue (L"5")));
+	ASSERT (ValueHandle (list).GetContentHash () == ValueHandle (sameList).GetContentHash ());
+	ASSERT (ValueHandle (list).GetContentHash () != ValueHandle (otherList).GetContentHash ());
+}
+
+}
@@ -78,6 +78,39 @@ public:
 	}
 };
 
+class Marker
+{
+public:
+	virtual ~Marker ()
+	{
+
+	}
+};
+
+class MarkedIntValue :	public IntValue,
+						public Marker
+{
+public:
+	MarkedIntValue (int val) :
+		IntValue (val)
+	{
+
+	}
+};
+
+class MarkedAValue :	public AValue,
+						public Marker
+{
+	VALUE_TYPE_INFO (MarkedAValue);
+
+public:
+	MarkedAValue (const A& val) :
+		AValue (val)
+	{
+
+	}
+};
+
 DYNAMIC_SERIALIZATION_INFO (AValue, 1, "{789CD6F8-A998-4A94-8B0A-96B5FD0925F4}");
 DYNAMIC_SERIALIZATION_INFO (AListValue, 1, "{7427D535-508F-44E5-A076-3FAF1A35A413}");
 
@@ -209,4 +242,51 @@ TEST (FlattenTest)
 	ASSERT (IntValue::Get (flattenList->GetValue (2)) == 3);
 }
 
+TEST (ValueTypeInfoTest)
+{
+	ValuePtr intValue (new IntValue (5));
+	ValueConstPtr doubleValue (new DoubleValue (2.5));
+	for (int i = 0; i < 3; i++) {
+		ASSERT (Value::IsType<IntValue> (intValue));
+		ASSERT (Value::IsType<NumberValue> (intValue));
+		ASSERT (Value::IsType<SingleValue> (intValue));
+		ASSERT (Value::IsType<GenericValue<int>> (intValue));
+		ASSERT (!Value::IsType<DoubleValue> (intValue));
+		ASSERT (!Value::IsType<IListValue> (intValue));
+		ASSERT (!Value::IsType<Marker> (intValue));
+		ASSERT (NumberValue::ToDouble (doubleValue) == 2.5);
+		ASSERT (Value::Cast<NumberValue> (doubleValue)->ToInteger () == 2);
+	}
+
+	std::shared_ptr<const NumberValue> numberValue = Value::Cast<NumberValue> (doubleValue);
+	ASSERT (numberValue.get () == dynamic_cast<const NumberValue*> (doubleValue.get ()));
+	ASSERT (numberValue.use_count () == doubleValue.use_count ());
+	ASSERT (Value::Cast<IntValue> (doubleValue) == nullptr);
+	ASSERT (!Value::IsType<IntValue> (ValuePtr ()));
+	ASSERT (Value::Cast<IntValue> (ValueConstPtr ()) == nullptr);
+}
+
+TEST (ValueTypeInfoHostClassTest)
+{
+	ValuePtr markedIntValue (new MarkedIntValue (3));
+	ASSERT (Value::IsType<IntValue> (markedIntValue));
+	ASSERT (Value::IsType<NumberValue> (markedIntValue));
+	ASSERT (Value::IsType<Marker> (markedIntValue));
+	ASSERT (Value::IsType<MarkedIntValue> (markedIntValue));
+	ASSERT (!Value::IsType<MarkedIntValue> (ValuePtr (new IntValue (3))));
+	ASSERT (NumberValue::ToInteger (markedIntValue) == 3);
+
+	ValuePtr markedAValue (new MarkedAValue (A (7)));
+	ValuePtr aValue (new AValue (A (8)));
+	for (int i = 0; i < 3; i++) {
+		ASSERT (Value::IsType<AValue> (markedAValue));
+		ASSERT (Value::IsType<Marker> (markedAValue));
+		ASSERT (Value::IsType<MarkedAValue> (markedAValue));
+		ASSERT (Value::Cast<Marker> (markedAValue).get () == dynamic_cast<Marker*> (markedAValue.get ()));
+		ASSERT (AValue::Get (markedAValue) == A (7));
+		ASSERT (!Value::IsType<Marker> (aValue));
+		ASSERT (!Value::IsType<MarkedAValue> (aValue));
+	}
+}
+
 }
@@ -10,6 +10,13 @@
 namespace NUIE
 {
 
+bool IsFileExists (const std::wstring& fileName)
+{
+	std::ifstream file;
+	file.open (NE::WStringToString (fileName), std::ios::binary);
+	return file.is_open ();
+}
+
 bool ReadBufferFromFile (const std::wstring& fileName, std::vector<char>& buffer)
 {
 	std::ifstream file;
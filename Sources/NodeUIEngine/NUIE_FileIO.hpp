@@ -7,6 +7,7 @@
 namespace NUIE
 {
 
+bool	IsFileExists (const std::wstring& fileName);
 bool	ReadBufferFromFile (const std::wstring& fileName, std::vector<char>& buffer);
 bool	WriteBufferToFile (const std::wstring& fileName, const std::vector<char>& buffer);
 
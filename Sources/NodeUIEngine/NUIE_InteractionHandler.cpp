@@ -364,6 +364,7 @@ EventHandlerResult NodeInputEventHandler::ForwardEventToNode (const std::functio
 	}
 
 	if (DBGVERIFY (uiNode != nullptr)) {
+		uiManager.StopBackgroundEvaluation ();
 		handlerResult = forwardEvent ();
 		if (handlerResult == EventHandlerResult::EventHandled) {
 			uiManager.InvalidateNodeValue (uiNode);
@@ -10,12 +10,15 @@ namespace NUIE
 {
 
 static const std::string NodeEditorFileMarker = "NodeEditorFile";
+static const std::string ValueMemoFileMarker = "NodeEditorValueMemo";
+static const std::wstring ValueMemoFileExtension = L".memo";
 
 NodeEditor::NodeEditor (NodeUIEnvironment& uiEnvironment) :
 	uiManager (uiEnvironment),
 	interactionHandler (uiManager),
 	mouseEventTranslator (interactionHandler),
-	uiEnvironment (uiEnvironment)
+	uiEnvironment (uiEnvironment),
+	evaluationScope (EvaluationScope::AllNodes)
 {
 
 }
@@ -101,9 +104,118 @@ void NodeEditor::SetUpdateMode (UpdateMode newUpdateMode)
 	}
 }
 
+NodeEditor::EvaluationScope NodeEditor::GetEvaluationScope () const
+{
+	return evaluationScope;
+}
+
+void NodeEditor::SetEvaluationScope (EvaluationScope newEvaluationScope)
+{
+	evaluationScope = newEvaluationScope;
+	uiManager.RequestRecalculate ();
+	Update ();
+}
+
+std::chrono::microseconds NodeEditor::GetEvaluationTimeBudget () const
+{
+	return uiManager.GetEvaluationTimeBudget ();
+}
+
+void NodeEditor::SetEvaluationTimeBudget (std::chrono::microseconds newEvaluationTimeBudget)
+{
+	uiManager.SetEvaluationTimeBudget (newEvaluationTimeBudget);
+}
+
+NodeEditor::EvaluationThread NodeEditor::GetEvaluationThread () const
+{
+	switch (uiManager.GetEvaluationThread ()) {
+		case NodeUIManager::EvaluationThread::Foreground:
+			return EvaluationThread::Foreground;
+		case NodeUIManager::EvaluationThread::Background:
+			return EvaluationThread::Background;
+	}
+	DBGBREAK ();
+	return EvaluationThread::Foreground;
+}
+
+void NodeEditor::SetEvaluationThread (EvaluationThread newEvaluationThread)
+{
+	switch (newEvaluationThread) {
+		case EvaluationThread::Foreground:
+			uiManager.SetEvaluationThread (NodeUIManager::EvaluationThread::Foreground);
+			break;
+		case EvaluationThread::Background:
+			uiManager.SetEvaluationThread (NodeUIManager::EvaluationThread::Background);
+			break;
+		default:
+			DBGBREAK ();
+			break;
+	}
+}
+
+bool NodeEditor::IsEvaluationInProgress () const
+{
+	return uiManager.IsEvaluationInProgress ();
+}
+
+size_t NodeEditor::GetValueCacheBudget () const
+{
+	return uiManager.GetValueCacheBudget ();
+}
+
+void NodeEditor::SetValueCacheBudget (size_t newValueCacheBudget)
+{
+	uiManager.SetValueCacheBudget (newValueCacheBudget);
+}
+
+NE::NodeValueCacheStatistics NodeEditor::GetValueCacheStatistics () const
+{
+	return uiManager.GetValueCacheStatistics ();
+}
+
+size_t NodeEditor::GetValueMemoBudget () const
+{
+	return uiManager.GetValueMemoBudget ();
+}
+
+void NodeEditor::SetValueMemoBudget (size_t newValueMemoBudget)
+{
+	uiManager.SetValueMemoBudget (newValueMemoBudget);
+}
+
+bool NodeEditor::IsProfilingEnabled () const
+{
+	return uiManager.IsProfilingEnabled ();
+}
+
+void NodeEditor::SetProfilingEnabled (bool newIsProfilingEnabled)
+{
+	uiManager.SetProfilingEnabled (newIsProfilingEnabled);
+}
+
+const NE::EvaluationProfiler& NodeEditor::GetEvaluationProfiler () const
+{
+	return uiManager.GetEvaluationProfiler ();
+}
+
+void NodeEditor::ClearEvaluationProfiler ()
+{
+	uiManager.ClearEvaluationProfiler ();
+}
+
+std::string NodeEditor::ExportChromeTrace () const
+{
+	return uiManager.ExportChromeTrace ();
+}
+
 void NodeEditor::Update ()
 {
-	uiManager.Update (uiEnvironment);
+	if (evaluationScope == EvaluationScope::VisibleNodes) {
+		const DrawingContext& drawingContext = uiEnvironment.GetDrawingContext ();
+		uiManager.UpdateVisible (uiEnvironment, Rect (0.0, 0.0, drawingContext.GetWidth (), drawingContext.GetHeight ()));
+	} else {
+		uiManager.Update (uiEnvironment);
+	}
 }
 
 void NodeEditor::ManualUpdate ()
@@ -202,6 +314,11 @@ bool NodeEditor::Open (const std::wstring& fileName)
 		return false;
 	}
 
+	// the memo is read first, so the first evaluation can already use it
+	if (GetValueMemoBudget () > 0) {
+		OpenValueMemo (fileName + ValueMemoFileExtension);
+	}
+
 	NE::MemoryInputStream inputStream (buffer);
 	return Open (inputStream);
 }
@@ -241,6 +358,10 @@ bool NodeEditor::Save (const std::wstring& fileName)
 		return false;
 	}
 
+	if (GetValueMemoBudget () > 0) {
+		SaveValueMemo (fileName + ValueMemoFileExtension);
+	}
+
 	return true;
 }
 
@@ -260,6 +381,50 @@ bool NodeEditor::NeedToSave () const
 	return uiManager.NeedToSave ();
 }
 
+bool NodeEditor::OpenValueMemo (const std::wstring& fileName)
+{
+	if (!IsFileExists (fileName)) {
+		return false;
+	}
+
+	std::vector<char> buffer;
+	if (DBGERROR (!ReadBufferFromFile (fileName, buffer))) {
+		return false;
+	}
+
+	NE::MemoryInputStream inputStream (buffer);
+	std::string fileMarker;
+	inputStream.Read (fileMarker);
+	if (fileMarker != ValueMemoFileMarker) {
+		return false;
+	}
+
+	Version readVersion;
+	readVersion.Read (inputStream);
+	if (readVersion != GetCurrentEngineVersion ()) {
+		return false;
+	}
+
+	return uiManager.ReadValueMemo (inputStream);
+}
+
+bool NodeEditor::SaveValueMemo (const std::wstring& fileName) const
+{
+	NE::MemoryOutputStream outputStream;
+	outputStream.Write (ValueMemoFileMarker);
+	GetCurrentEngineVersion ().Write (outputStream);
+	if (DBGERROR (!uiManager.WriteValueMemo (outputStream))) {
+		return false;
+	}
+
+	const std::vector<char>& buffer = outputStream.GetBuffer ();
+	if (DBGERROR (!WriteBufferToFile (fileName, buffer))) {
+		return false;
+	}
+
+	return true;
+}
+
 void NodeEditor::ExecuteCommand (CommandCode command)
 {
 	interactionHandler.ExecuteCommand (uiEnvironment, command);
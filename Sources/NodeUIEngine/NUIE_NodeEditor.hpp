@@ -23,6 +23,18 @@ public:
 		Manual
 	};
 
+	enum class EvaluationScope
+	{
+		AllNodes,
+		VisibleNodes
+	};
+
+	enum class EvaluationThread
+	{
+		Foreground,
+		Background
+	};
+
 	NodeEditor (NodeUIEnvironment& uiEnvironment);
 	virtual ~NodeEditor ();
 
@@ -39,6 +51,24 @@ public:
 	void							SetUpdateMode (UpdateMode newUpdateMode);
 	void							ManualUpdate ();
 
+	EvaluationScope					GetEvaluationScope () const;
+	void							SetEvaluationScope (EvaluationScope newEvaluationScope);
+	std::chrono::microseconds		GetEvaluationTimeBudget () const;
+	void							SetEvaluationTimeBudget (std::chrono::microseconds newEvaluationTimeBudget);
+	EvaluationThread				GetEvaluationThread () const;
+	void							SetEvaluationThread (EvaluationThread newEvaluationThread);
+	bool							IsEvaluationInProgress () const;
+	size_t							GetValueCacheBudget () const;
+	void							SetValueCacheBudget (size_t newValueCacheBudget);
+	NE::NodeValueCacheStatistics	GetValueCacheStatistics () const;
+	size_t							GetValueMemoBudget () const;
+	void							SetValueMemoBudget (size_t newValueMemoBudget);
+	bool							IsProfilingEnabled () const;
+	void							SetProfilingEnabled (bool newIsProfilingEnabled);
+	const NE::EvaluationProfiler&	GetEvaluationProfiler () const;
+	void							ClearEvaluationProfiler ();
+	std::string						ExportChromeTrace () const;
+
 	void							Update ();
 	void							Draw ();
 
@@ -65,6 +95,8 @@ public:
 	bool							Save (const std::wstring& fileName);
 	bool							Save (NE::OutputStream& outputStream);
 	bool							NeedToSave () const;
+	bool							OpenValueMemo (const std::wstring& fileName);
+	bool							SaveValueMemo (const std::wstring& fileName) const;
 
 	void							ExecuteCommand (CommandCode command);
 	void							ExecuteMenuCommand (const MenuCommandPtr& command);
@@ -80,6 +112,7 @@ private:
 	InteractionHandler			interactionHandler;
 	MouseEventTranslator		mouseEventTranslator;
 	NodeUIEnvironment&			uiEnvironment;
+	EvaluationScope				evaluationScope;
 };
 
 }
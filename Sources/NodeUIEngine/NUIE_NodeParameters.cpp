@@ -169,6 +169,7 @@ bool ApplyCommonParameter (NodeUIManager& uiManager, NE::EvaluationEnv& evaluati
 		}
 	}
 
+	uiManager.StopBackgroundEvaluation ();
 	for (UINodePtr& uiNode : uiNodes) {
 		NodeUIManagerNodeInvalidator invalidator (uiManager, uiNode);
 		if (DBGERROR (!parameter->SetValue (invalidator, evaluationEnv, uiNode, value))) {
@@ -23,6 +23,11 @@ NodeUICalculationEnvironment::~NodeUICalculationEnvironment ()
 
 }
 
+NE::EvaluationDataPtr NodeUICalculationEnvironment::CreateBackgroundEvaluationData ()
+{
+	return nullptr;
+}
+
 NodeUIInteractionEnvironment::NodeUIInteractionEnvironment ()
 {
 
@@ -3,6 +3,7 @@
 
 #include "NE_StringConverter.hpp"
 #include "NE_EvaluationEnv.hpp"
+#include "NE_EvaluationProgress.hpp"
 #include "NUIE_Version.hpp"
 #include "NUIE_Selection.hpp"
 #include "NUIE_UndoState.hpp"
@@ -39,8 +40,13 @@ public:
 	virtual NE::EvaluationEnv&	GetEvaluationEnv () = 0;
 	virtual void				OnEvaluationBegin () = 0;
 	virtual void				OnEvaluationEnd () = 0;
+	virtual void				OnEvaluationProgress (const NE::EvaluationProgress& progress) = 0;
 	virtual void				OnValuesRecalculated () = 0;
 	virtual void				OnRedrawRequested () = 0;
+
+	// the data of the background evaluation thread, it must not share
+	// mutable state with the data of the foreground evaluation environment
+	virtual NE::EvaluationDataPtr	CreateBackgroundEvaluationData ();
 };
 
 class NodeUIInteractionEnvironment
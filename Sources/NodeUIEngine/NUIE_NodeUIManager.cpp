@@ -48,6 +48,7 @@ private:
 
 NodeUIManager::Status::Status () :
 	needToRecalculate (false),
+	isEvaluationInProgress (false),
 	needToRedraw (false),
 	needToSave (false)
 {
@@ -57,6 +58,7 @@ NodeUIManager::Status::Status () :
 void NodeUIManager::Status::Reset ()
 {
 	needToRecalculate = false;
+	isEvaluationInProgress = false;
 	needToRedraw = false;
 	needToSave = false;
 }
@@ -76,6 +78,21 @@ bool NodeUIManager::Status::NeedToRecalculate () const
 	return needToRecalculate;
 }
 
+void NodeUIManager::Status::StartEvaluation ()
+{
+	isEvaluationInProgress = true;
+}
+
+void NodeUIManager::Status::FinishEvaluation ()
+{
+	isEvaluationInProgress = false;
+}
+
+bool NodeUIManager::Status::IsEvaluationInProgress () const
+{
+	return isEvaluationInProgress;
+}
+
 void NodeUIManager::Status::RequestRedraw ()
 {
 	needToRedraw = true;
@@ -197,7 +214,10 @@ NodeUIManager::NodeUIManager (NodeUIEnvironment& uiEnvironment) :
 	undoHandler (),
 	selection (),
 	viewBox (),
-	status ()
+	evaluationTimeBudget (std::chrono::microseconds::zero ()),
+	evaluationThread (EvaluationThread::Foreground),
+	status (),
+	backgroundEvaluator ()
 {
 	New (uiEnvironment);
 }
@@ -228,6 +248,7 @@ bool NodeUIManager::DeleteNode (const UINodePtr& uiNode, NE::EvaluationEnv& eval
 		return false;
 	}
 
+	StopBackgroundEvaluation ();
 	uiNode->OnDelete (evalEnv);
 	
 	Selection::ChangeResult selResult = selection.DeleteNode (uiNode->GetId ());
@@ -423,7 +444,7 @@ bool NodeUIManager::ContainsNode (const NE::NodeId& nodeId) const
 std::vector<NUIE::UINodeConstPtr> NodeUIManager::FindNodes (const UINodeFilter& nodeFilter) const
 {
 	std::vector<NUIE::UINodeConstPtr> result;
-	EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+	ForEachNode ([&] (UINodeConstPtr uiNode) {
 		if (nodeFilter.IsMatch (uiNode)) {
 			result.push_back (uiNode);
 		}
@@ -446,26 +467,23 @@ UINodeConstPtr NodeUIManager::GetNode (const NE::NodeId& nodeId) const
 
 void NodeUIManager::EnumerateNodes (const std::function<bool (UINodePtr)>& processor)
 {
-	nodeManager.EnumerateNodes ([&] (NE::NodePtr node) {
-		return processor (std::static_pointer_cast<UINode> (node));
-	});
+	ForEachNode (processor);
 }
 
 void NodeUIManager::EnumerateNodes (const std::function<bool (UINodeConstPtr)>& processor) const
 {
-	nodeManager.EnumerateNodes ([&] (NE::NodeConstPtr node) {
-		return processor (std::static_pointer_cast<const UINode> (node));
-	});
+	ForEachNode (processor);
 }
 
 void NodeUIManager::RequestRecalculateAndRedraw ()
 {
-	status.RequestRecalculate ();
-	status.RequestRedraw ();
+	RequestRecalculate ();
+	RequestRedraw ();
 }
 
 void NodeUIManager::RequestRecalculate ()
 {
+	backgroundEvaluator.Cancel ();
 	status.RequestRecalculate ();
 }
 
@@ -482,7 +500,7 @@ void NodeUIManager::InvalidateAllDrawings ()
 
 void NodeUIManager::InvalidateAllNodesDrawing ()
 {
-	EnumerateNodes ([&] (UINodePtr uiNode) {
+	ForEachNode ([&] (UINodePtr uiNode) {
 		uiNode->InvalidateDrawing ();
 		return true;
 	});
@@ -520,9 +538,10 @@ void NodeUIManager::InvalidateNodeDrawing (const UINodePtr& uiNode)
 {
 	uiNode->InvalidateDrawing ();
 	InvalidateNodeGroupDrawing (uiNode);
-	nodeManager.EnumerateDependentNodes (uiNode, [&] (const NE::NodeId& dependentNodeId) {
+	nodeManager.EnumerateDependentNodesRecursive (uiNode, [&] (const NE::NodeId& dependentNodeId) {
 		UINodePtr dependentNode = GetNode (dependentNodeId);
-		InvalidateNodeDrawing (dependentNode);
+		dependentNode->InvalidateDrawing ();
+		InvalidateNodeGroupDrawing (dependentNode);
 	});
 	status.RequestRedraw ();
 }
@@ -546,13 +565,31 @@ void NodeUIManager::InvalidateNodeGroupDrawing (const UINodePtr& uiNode)
 
 void NodeUIManager::Update (NodeUICalculationEnvironment& calcEnv)
 {
-	UpdateInternal (calcEnv, InternalUpdateMode::Normal);
+	UpdateInternal (calcEnv, InternalUpdateMode::Normal, NE::EmptyNodeCollection);
+}
+
+void NodeUIManager::UpdateVisible (NodeUIEnvironment& uiEnvironment, const Rect& viewport)
+{
+	if (!status.NeedToRecalculate () && !status.NeedToRedraw ()) {
+		return;
+	}
+
+	NE::NodeCollection visibleNodes = GetVisibleNodes (uiEnvironment, viewport);
+	visibleNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+		UINodeConstPtr uiNode = GetNode (nodeId);
+		if (uiNode->GetCalculationStatus () == NE::Node::CalculationStatus::NeedToCalculate) {
+			status.RequestRecalculate ();
+			return false;
+		}
+		return true;
+	});
+	UpdateInternal (uiEnvironment, InternalUpdateMode::VisibleNodes, visibleNodes);
 }
 
 void NodeUIManager::ManualUpdate (NodeUICalculationEnvironment& calcEnv)
 {
 	InvalidateDrawingsForInvalidatedNodes ();
-	UpdateInternal (calcEnv, InternalUpdateMode::Manual);
+	UpdateInternal (calcEnv, InternalUpdateMode::Manual, NE::EmptyNodeCollection);
 }
 
 void NodeUIManager::Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawingModifier)
@@ -570,7 +607,7 @@ void NodeUIManager::ResizeContext (NodeUIDrawingEnvironment& drawingEnv, int new
 bool NodeUIManager::GetBoundingRect (NodeUIDrawingEnvironment& drawingEnv, Rect& rect) const
 {
 	BoundingRect boundingRect;
-	EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+	ForEachNode ([&] (UINodeConstPtr uiNode) {
 		Rect nodeRect = uiNode->GetExtendedRect (drawingEnv);
 		boundingRect.AddRect (nodeRect);
 		return true;
@@ -680,6 +717,114 @@ void NodeUIManager::SetUpdateMode (UpdateMode newUpdateMode)
 	}
 }
 
+std::chrono::microseconds NodeUIManager::GetEvaluationTimeBudget () const
+{
+	return evaluationTimeBudget;
+}
+
+void NodeUIManager::SetEvaluationTimeBudget (std::chrono::microseconds newEvaluationTimeBudget)
+{
+	evaluationTimeBudget = newEvaluationTimeBudget;
+}
+
+NodeUIManager::EvaluationThread NodeUIManager::GetEvaluationThread () const
+{
+	return evaluationThread;
+}
+
+void NodeUIManager::SetEvaluationThread (EvaluationThread newEvaluationThread)
+{
+	evaluationThread = newEvaluationThread;
+}
+
+void NodeUIManager::StopBackgroundEvaluation ()
+{
+	// the stopped snapshot is kept, its valid values are published by the next update
+	backgroundEvaluator.Cancel ();
+	backgroundEvaluator.Wait ();
+}
+
+bool NodeUIManager::IsEvaluationInProgress () const
+{
+	return status.IsEvaluationInProgress ();
+}
+
+size_t NodeUIManager::GetValueCacheBudget () const
+{
+	return nodeManager.GetValueCacheBudget ();
+}
+
+void NodeUIManager::SetValueCacheBudget (size_t newValueCacheBudget)
+{
+	nodeManager.SetValueCacheBudget (newValueCacheBudget);
+}
+
+NE::NodeValueCacheStatistics NodeUIManager::GetValueCacheStatistics () const
+{
+	return nodeManager.GetValueCacheStatistics ();
+}
+
+size_t NodeUIManager::GetValueMemoBudget () const
+{
+	return nodeManager.GetValueMemoBudget ();
+}
+
+void NodeUIManager::SetValueMemoBudget (size_t newValueMemoBudget)
+{
+	nodeManager.SetValueMemoBudget (newValueMemoBudget);
+}
+
+bool NodeUIManager::ReadValueMemo (NE::InputStream& inputStream)
+{
+	return nodeManager.ReadValueMemo (inputStream) == NE::Stream::Status::NoError;
+}
+
+bool NodeUIManager::WriteValueMemo (NE::OutputStream& outputStream) const
+{
+	return nodeManager.WriteValueMemo (outputStream) == NE::Stream::Status::NoError;
+}
+
+bool NodeUIManager::IsEvaluationArenaEnabled () const
+{
+	return nodeManager.IsEvaluationArenaEnabled ();
+}
+
+void NodeUIManager::SetEvaluationArenaEnabled (bool newIsEvaluationArenaEnabled)
+{
+	nodeManager.SetEvaluationArenaEnabled (newIsEvaluationArenaEnabled);
+}
+
+bool NodeUIManager::IsProfilingEnabled () const
+{
+	return nodeManager.IsProfilingEnabled ();
+}
+
+void NodeUIManager::SetProfilingEnabled (bool newIsProfilingEnabled)
+{
+	nodeManager.SetProfilingEnabled (newIsProfilingEnabled);
+}
+
+const NE::EvaluationProfiler& NodeUIManager::GetEvaluationProfiler () const
+{
+	return nodeManager.GetEvaluationProfiler ();
+}
+
+void NodeUIManager::ClearEvaluationProfiler ()
+{
+	nodeManager.ClearEvaluationProfiler ();
+}
+
+std::string NodeUIManager::ExportChromeTrace () const
+{
+	return nodeManager.GetEvaluationProfiler ().ExportChromeTrace ([&] (const NE::NodeId& nodeId) {
+		std::wstring nodeName = L"Node " + std::to_wstring (nodeId.GetUniqueId ());
+		if (nodeManager.ContainsNode (nodeId)) {
+			nodeName = GetNode (nodeId)->GetName ().GetLocalized () + L" (" + std::to_wstring (nodeId.GetUniqueId ()) + L")";
+		}
+		return nodeName;
+	});
+}
+
 void NodeUIManager::New (NodeUIEnvironment& uiEnvironment)
 {
 	Clear (uiEnvironment);
@@ -743,6 +888,7 @@ bool NodeUIManager::CanRedo () const
 
 void NodeUIManager::Undo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironment& interactionEnv)
 {
+	StopBackgroundEvaluation ();
 	NodeUIManagerUpdateEventHandler eventHandler (*this, interactionEnv, evalEnv);
 	UndoHandler::ChangeResult undoResult = undoHandler.Undo (nodeManager, eventHandler);
 	HandleUndoStateChanged (undoResult, interactionEnv);
@@ -752,6 +898,7 @@ void NodeUIManager::Undo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironme
 
 void NodeUIManager::Redo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironment& interactionEnv)
 {
+	StopBackgroundEvaluation ();
 	NodeUIManagerUpdateEventHandler eventHandler (*this, interactionEnv, evalEnv);
 	UndoHandler::ChangeResult undoResult = undoHandler.Redo (nodeManager, eventHandler);
 	HandleUndoStateChanged (undoResult, interactionEnv);
@@ -820,6 +967,7 @@ void NodeUIManager::EnumerateNodeGroups (const std::function<bool (UINodeGroupPt
 
 void NodeUIManager::ExecuteCommand (NodeUIManagerCommand& command, NodeUIInteractionEnvironment& interactionEnv)
 {
+	StopBackgroundEvaluation ();
 	if (command.IsUndoable ()) {
 		UndoHandler::ChangeResult result = undoHandler.AddUndoStep (nodeManager);
 		HandleUndoStateChanged (result, interactionEnv);
@@ -846,7 +994,14 @@ void NodeUIManager::Clear (NodeUIEnvironment& uiEnvironment)
 	UndoHandler::ChangeResult undoResult = undoHandler.Clear ();
 	HandleUndoStateChanged (undoResult, uiEnvironment);
 
+	if (backgroundEvaluator.IsRunning ()) {
+		backgroundEvaluator.Cancel ();
+		backgroundEvaluator.Finish ();
+	}
 	nodeManager.Clear ();
+	if (status.IsEvaluationInProgress ()) {
+		uiEnvironment.OnEvaluationEnd ();
+	}
 
 	viewBox.Set (Point (0.0, 0.0), windowScale);
 	status.Reset ();
@@ -855,7 +1010,7 @@ void NodeUIManager::Clear (NodeUIEnvironment& uiEnvironment)
 void NodeUIManager::InvalidateDrawingsForInvalidatedNodes ()
 {
 	std::vector<UINodePtr> nodesToInvalidate;
-	EnumerateNodes ([&] (UINodePtr uiNode) {
+	ForEachNode ([&] (UINodePtr uiNode) {
 		NE::Node::CalculationStatus calcStatus = uiNode->GetCalculationStatus ();
 		if (calcStatus == NE::Node::CalculationStatus::NeedToCalculate || calcStatus == NE::Node::CalculationStatus::NeedToCalculateButDisabled) {
 			nodesToInvalidate.push_back (uiNode);
@@ -868,19 +1023,105 @@ void NodeUIManager::InvalidateDrawingsForInvalidatedNodes ()
 	status.RequestRedraw ();
 }
 
-void NodeUIManager::UpdateInternal (NodeUICalculationEnvironment& calcEnv, InternalUpdateMode mode)
+void NodeUIManager::InvalidateDrawingsForCalculatedNodes (const std::vector<NE::NodeId>& nodeIds)
+{
+	for (const NE::NodeId& nodeId : nodeIds) {
+		UINodePtr uiNode = GetNode (nodeId);
+		uiNode->InvalidateDrawing ();
+		InvalidateNodeGroupDrawing (uiNode);
+	}
+	if (!nodeIds.empty ()) {
+		RequestRedraw ();
+	}
+}
+
+void NodeUIManager::InvalidateDrawingsForCalculatedNodes (const std::vector<UINodePtr>& uiNodes)
+{
+	for (const UINodePtr& uiNode : uiNodes) {
+		if (uiNode->HasCalculatedValue ()) {
+			uiNode->InvalidateDrawing ();
+			InvalidateNodeGroupDrawing (uiNode);
+			RequestRedraw ();
+		}
+	}
+}
+
+bool NodeUIManager::EvaluateInBackground (NodeUICalculationEnvironment& calcEnv)
+{
+	NE::EvaluationEnv& evalEnv = calcEnv.GetEvaluationEnv ();
+	if (backgroundEvaluator.IsRunning ()) {
+		if (!backgroundEvaluator.IsFinished ()) {
+			return false;
+		}
+		std::unique_ptr<NE::EvaluationSnapshot> snapshot = backgroundEvaluator.Finish ();
+		NE::NodeCollection publishedNodes = nodeManager.PublishEvaluationSnapshot (*snapshot, evalEnv);
+		publishedNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+			UINodePtr uiNode = GetNode (nodeId);
+			uiNode->InvalidateDrawing ();
+			InvalidateNodeGroupDrawing (uiNode);
+			RequestRedraw ();
+			return true;
+		});
+	}
+
+	bool needToEvaluate = false;
+	nodeManager.ForEachNode ([&] (NE::NodeConstPtr node) {
+		needToEvaluate = (node->GetCalculationStatus () == NE::Node::CalculationStatus::NeedToCalculate);
+		return !needToEvaluate;
+	});
+	if (!needToEvaluate) {
+		return true;
+	}
+
+	std::unique_ptr<NE::EvaluationSnapshot> snapshot (new NE::EvaluationSnapshot ());
+	if (!nodeManager.CreateEvaluationSnapshot (*snapshot)) {
+		nodeManager.EvaluateAllNodes (evalEnv);
+		return true;
+	}
+	backgroundEvaluator.Start (std::move (snapshot), calcEnv.CreateBackgroundEvaluationData ());
+	return false;
+}
+
+void NodeUIManager::UpdateInternal (NodeUICalculationEnvironment& calcEnv, InternalUpdateMode mode, const NE::NodeCollection& visibleNodes)
 {
 	if (status.NeedToRecalculate ()) {
-		calcEnv.OnEvaluationBegin ();
+		if (!status.IsEvaluationInProgress ()) {
+			calcEnv.OnEvaluationBegin ();
+			status.StartEvaluation ();
+		}
+		bool isEvaluationFinished = true;
 		if (mode == InternalUpdateMode::Normal) {
-			nodeManager.EvaluateAllNodes (calcEnv.GetEvaluationEnv ());
+			if (evaluationThread == EvaluationThread::Background) {
+				isEvaluationFinished = EvaluateInBackground (calcEnv);
+			} else if (evaluationTimeBudget > std::chrono::microseconds::zero ()) {
+				NE::EvaluationProgress progress = nodeManager.EvaluateAllNodes (calcEnv.GetEvaluationEnv (), evaluationTimeBudget);
+				InvalidateDrawingsForCalculatedNodes (progress.GetCalculatedNodes ());
+				calcEnv.OnEvaluationProgress (progress);
+				isEvaluationFinished = progress.IsFinished ();
+			} else {
+				nodeManager.EvaluateAllNodes (calcEnv.GetEvaluationEnv ());
+			}
 		} else if (mode == InternalUpdateMode::Manual) {
 			nodeManager.ForceEvaluateAllNodes (calcEnv.GetEvaluationEnv ());
+		} else if (mode == InternalUpdateMode::VisibleNodes) {
+			std::vector<UINodePtr> uncalculatedNodes;
+			visibleNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+				UINodePtr uiNode = GetNode (nodeId);
+				if (!uiNode->HasCalculatedValue ()) {
+					uncalculatedNodes.push_back (uiNode);
+				}
+				return true;
+			});
+			nodeManager.EvaluateNodes (visibleNodes, calcEnv.GetEvaluationEnv ());
+			InvalidateDrawingsForCalculatedNodes (uncalculatedNodes);
 		}
-		calcEnv.OnEvaluationEnd ();
+		if (isEvaluationFinished) {
+			calcEnv.OnEvaluationEnd ();
+			status.FinishEvaluation ();
 
-		calcEnv.OnValuesRecalculated ();
-		status.ResetRecalculate ();
+			calcEnv.OnValuesRecalculated ();
+			status.ResetRecalculate ();
+		}
 	}
 	if (status.NeedToRedraw ()) {
 		calcEnv.OnRedrawRequested ();
@@ -888,6 +1129,20 @@ void NodeUIManager::UpdateInternal (NodeUICalculationEnvironment& calcEnv, Inter
 	}
 }
 
+NE::NodeCollection NodeUIManager::GetVisibleNodes (NodeUIDrawingEnvironment& drawingEnv, const Rect& viewport) const
+{
+	NE::NodeCollection visibleNodes;
+	Point viewportOffset (-viewport.GetLeft (), -viewport.GetTop ());
+	ForEachNode ([&] (UINodeConstPtr uiNode) {
+		Rect nodeRect = viewBox.ModelToView (uiNode->GetExtendedRect (drawingEnv)).Offset (viewportOffset);
+		if (Rect::IsInBounds (nodeRect, viewport.GetWidth (), viewport.GetHeight ())) {
+			visibleNodes.Insert (uiNode->GetId ());
+		}
+		return true;
+	});
+	return visibleNodes;
+}
+
 void NodeUIManager::HandleSelectionChanged (Selection::ChangeResult changeResult, NodeUIInteractionEnvironment& interactionEnv)
 {
 	if (changeResult == Selection::ChangeResult::Changed) {
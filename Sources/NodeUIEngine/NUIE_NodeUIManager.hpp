@@ -3,6 +3,7 @@
 
 #include "NE_NodeManager.hpp"
 #include "NE_NodeCollection.hpp"
+#include "NE_BackgroundEvaluator.hpp"
 #include "NUIE_UINode.hpp"
 #include "NUIE_UINodeGroup.hpp"
 #include "NUIE_NodeUIEnvironment.hpp"
@@ -14,6 +15,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <chrono>
 
 namespace NUIE
 {
@@ -96,6 +98,12 @@ public:
 		Manual
 	};
 
+	enum class EvaluationThread
+	{
+		Foreground,
+		Background
+	};
+
 	NodeUIManager (NodeUIEnvironment& uiEnvironment);
 	NodeUIManager (const NodeUIManager& src) = delete;
 	NodeUIManager (NodeUIManager&& src) = delete;
@@ -138,6 +146,11 @@ public:
 	void							EnumerateUIConnections (const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const;
 	void							EnumerateUIConnections (const NE::NodeCollection& nodes, const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const;
 
+	template <typename Processor>
+	void							ForEachConnectedUIInputSlot (const UIOutputSlotConstPtr& outputSlot, Processor&& processor) const;
+	template <typename Processor>
+	void							ForEachConnectedUIOutputSlot (const UIInputSlotConstPtr& inputSlot, Processor&& processor) const;
+
 	bool							ContainsNode (const NE::NodeId& nodeId) const;
 	std::vector<UINodeConstPtr>		FindNodes (const UINodeFilter& nodeFilter) const;
 	UINodePtr						GetNode (const NE::NodeId& nodeId);
@@ -146,6 +159,11 @@ public:
 	void							EnumerateNodes (const std::function<bool (UINodePtr)>& processor);
 	void							EnumerateNodes (const std::function<bool (UINodeConstPtr)>& processor) const;
 
+	template <typename Processor>
+	void							ForEachNode (Processor&& processor);
+	template <typename Processor>
+	void							ForEachNode (Processor&& processor) const;
+
 	void							RequestRecalculateAndRedraw ();
 	void							RequestRecalculate ();
 	void							RequestRedraw ();
@@ -161,6 +179,8 @@ public:
 	void							InvalidateNodeGroupDrawing (const UINodePtr& uiNode);
 
 	void							Update (NodeUICalculationEnvironment& calcEnv);
+	// evaluates the nodes intersecting the viewport given in view coordinates and their inputs
+	void							UpdateVisible (NodeUIEnvironment& uiEnvironment, const Rect& viewport);
 	void							ManualUpdate (NodeUICalculationEnvironment& calcEnv);
 	void							Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawingModifier);
 	void							ResizeContext (NodeUIDrawingEnvironment& drawingEnv, int newWidth, int newHeight);
@@ -176,6 +196,28 @@ public:
 
 	UpdateMode						GetUpdateMode () const;
 	void							SetUpdateMode (UpdateMode newUpdateMode);
+	std::chrono::microseconds		GetEvaluationTimeBudget () const;
+	void							SetEvaluationTimeBudget (std::chrono::microseconds newEvaluationTimeBudget);
+	EvaluationThread				GetEvaluationThread () const;
+	void							SetEvaluationThread (EvaluationThread newEvaluationThread);
+	// the background evaluation shares the nodes, so it must be stopped before a node is
+	// modified; commands, parameters, node events and deletion do it, other callers must
+	void							StopBackgroundEvaluation ();
+	bool							IsEvaluationInProgress () const;
+	size_t							GetValueCacheBudget () const;
+	void							SetValueCacheBudget (size_t newValueCacheBudget);
+	NE::NodeValueCacheStatistics	GetValueCacheStatistics () const;
+	size_t							GetValueMemoBudget () const;
+	void							SetValueMemoBudget (size_t newValueMemoBudget);
+	bool							ReadValueMemo (NE::InputStream& inputStream);
+	bool							WriteValueMemo (NE::OutputStream& outputStream) const;
+	bool							IsEvaluationArenaEnabled () const;
+	void							SetEvaluationArenaEnabled (bool newIsEvaluationArenaEnabled);
+	bool							IsProfilingEnabled () const;
+	void							SetProfilingEnabled (bool newIsProfilingEnabled);
+	const NE::EvaluationProfiler&	GetEvaluationProfiler () const;
+	void							ClearEvaluationProfiler ();
+	std::string						ExportChromeTrace () const;
 
 	void							New (NodeUIEnvironment& uiEnvironment);
 	bool							Open (NodeUIEnvironment& uiEnvironment, NE::InputStream& inputStream);
@@ -217,6 +259,10 @@ private:
 		void	ResetRecalculate ();
 		bool	NeedToRecalculate () const;
 
+		void	StartEvaluation ();
+		void	FinishEvaluation ();
+		bool	IsEvaluationInProgress () const;
+
 		void	RequestRedraw ();
 		void	ResetRedraw ();
 		bool	NeedToRedraw () const;
@@ -227,6 +273,7 @@ private:
 
 	private:
 		bool	needToRecalculate;
+		bool	isEvaluationInProgress;
 		bool	needToRedraw;
 		bool	needToSave;
 	};
@@ -234,25 +281,67 @@ private:
 	enum class InternalUpdateMode
 	{
 		Normal,
-		Manual
+		Manual,
+		VisibleNodes
 	};
 
 	void				Clear (NodeUIEnvironment& uiEnvironment);
 	void				InvalidateDrawingsForInvalidatedNodes ();
-	void				UpdateInternal (NodeUICalculationEnvironment& calcEnv, InternalUpdateMode mode);
+	void				InvalidateDrawingsForCalculatedNodes (const std::vector<NE::NodeId>& nodeIds);
+	void				InvalidateDrawingsForCalculatedNodes (const std::vector<UINodePtr>& uiNodes);
+	bool				EvaluateInBackground (NodeUICalculationEnvironment& calcEnv);
+	void				UpdateInternal (NodeUICalculationEnvironment& calcEnv, InternalUpdateMode mode, const NE::NodeCollection& visibleNodes);
+	NE::NodeCollection	GetVisibleNodes (NodeUIDrawingEnvironment& drawingEnv, const Rect& viewport) const;
 	void				HandleSelectionChanged (Selection::ChangeResult changeResult, NodeUIInteractionEnvironment& interactionEnv);
 	void				HandleUndoStateChanged (UndoHandler::ChangeResult changeResult, NodeUIInteractionEnvironment& interactionEnv);
 
 	NE::Stream::Status	Read (NE::InputStream& inputStream);
 	NE::Stream::Status	Write (NE::OutputStream& outputStream) const;
 
-	NE::NodeManager		nodeManager;
-	UndoHandler			undoHandler;
-	Selection			selection;
-	ViewBox				viewBox;
-	Status				status;
+	NE::NodeManager				nodeManager;
+	UndoHandler					undoHandler;
+	Selection					selection;
+	ViewBox						viewBox;
+	std::chrono::microseconds	evaluationTimeBudget;
+	EvaluationThread			evaluationThread;
+	Status						status;
+	NE::BackgroundEvaluator		backgroundEvaluator;
 };
 
+template <typename Processor>
+void NodeUIManager::ForEachConnectedUIInputSlot (const UIOutputSlotConstPtr& outputSlot, Processor&& processor) const
+{
+	nodeManager.ForEachConnectedInputSlot (outputSlot, [&] (const NE::InputSlotConstPtr& inputSlot) {
+		DBGASSERT (dynamic_cast<const UIInputSlot*> (inputSlot.get ()) != nullptr);
+		processor (std::static_pointer_cast<const UIInputSlot> (inputSlot));
+	});
+}
+
+template <typename Processor>
+void NodeUIManager::ForEachConnectedUIOutputSlot (const UIInputSlotConstPtr& inputSlot, Processor&& processor) const
+{
+	nodeManager.ForEachConnectedOutputSlot (inputSlot, [&] (const NE::OutputSlotConstPtr& outputSlot) {
+		DBGASSERT (dynamic_cast<const UIOutputSlot*> (outputSlot.get ()) != nullptr);
+		processor (std::static_pointer_cast<const UIOutputSlot> (outputSlot));
+	});
+}
+
+template <typename Processor>
+void NodeUIManager::ForEachNode (Processor&& processor)
+{
+	nodeManager.ForEachNode ([&] (const NE::NodePtr& node) {
+		return processor (std::static_pointer_cast<UINode> (node));
+	});
+}
+
+template <typename Processor>
+void NodeUIManager::ForEachNode (Processor&& processor) const
+{
+	nodeManager.ForEachNode ([&] (const NE::NodeConstPtr& node) {
+		return processor (std::static_pointer_cast<const UINode> (node));
+	});
+}
+
 }
 
 #endif
@@ -111,11 +111,11 @@ void NodeUIManagerDrawer::DrawConnections (NodeUIDrawingEnvironment& drawingEnv,
 
 	const Selection& selection = uiManager.GetSelection ();
 	const NE::NodeCollection& selectedNodes = selection.GetNodes ();
-	uiManager.EnumerateNodes ([&] (UINodeConstPtr begNode) {
+	uiManager.ForEachNode ([&] (UINodeConstPtr begNode) {
 		bool begSelected = selectedNodes.Contains (begNode->GetId ());
-		begNode->EnumerateUIOutputSlots ([&] (UIOutputSlotConstPtr outputSlot) {
+		begNode->ForEachUIOutputSlot ([&] (UIOutputSlotConstPtr outputSlot) {
 			Point beg = GetOutputSlotConnPosition (drawingEnv, drawModifier, begNode, outputSlot->GetId ());
-			uiManager.EnumerateConnectedUIInputSlots (outputSlot, [&] (UIInputSlotConstPtr inputSlot) {
+			uiManager.ForEachConnectedUIInputSlot (outputSlot, [&] (UIInputSlotConstPtr inputSlot) {
 				UINodeConstPtr endNode = uiManager.GetNode (inputSlot->GetOwnerNodeId ());
 				if (DBGERROR (endNode == nullptr)) {
 					return;
@@ -180,7 +180,7 @@ void NodeUIManagerDrawer::DrawTemporaryConnection (NodeUIDrawingEnvironment& dra
 
 void NodeUIManagerDrawer::DrawNodes (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const
 {
-	uiManager.EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+	uiManager.ForEachNode ([&] (UINodeConstPtr uiNode) {
 		if (!IsNodeVisible (drawingEnv, selectionParams, drawModifier, uiNode)) {
 			return true;
 		}
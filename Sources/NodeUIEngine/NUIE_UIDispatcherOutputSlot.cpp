@@ -24,20 +24,20 @@ UIDispatcherOutputSlot::~UIDispatcherOutputSlot ()
 
 }
 
-NE::ValueConstPtr UIDispatcherOutputSlot::Evaluate (NE::EvaluationEnv& env) const
+NE::ValueHandle UIDispatcherOutputSlot::Evaluate (NE::EvaluationEnv& env) const
 {
 	NE::ValueConstPtr value = EvaluateOwnerNode (env);
 	if (value == nullptr) {
 		return nullptr;
 	}
-	if (DBGERROR (!NE::Value::IsType<NE::ListValue> (value))) {
+	if (DBGERROR (!NE::Value::IsType<NE::IListValue> (value))) {
 		return nullptr;
 	}
-	NE::ListValueConstPtr listValue = NE::Value::Cast<NE::ListValue> (value);
+	NE::IListValueConstPtr listValue = NE::Value::Cast<NE::IListValue> (value);
 	if (DBGERROR (listIndex > listValue->GetSize ())) {
 		return nullptr;
 	}
-	return listValue->GetValue (listIndex);
+	return listValue->GetElement (listIndex);
 }
 
 NE::Stream::Status UIDispatcherOutputSlot::Read (NE::InputStream& inputStream)
@@ -15,7 +15,7 @@ public:
 	UIDispatcherOutputSlot (const NE::SlotId& id, const NE::LocString& name, size_t listIndex);
 	~UIDispatcherOutputSlot ();
 
-	virtual NE::ValueConstPtr	Evaluate (NE::EvaluationEnv& env) const override;
+	virtual NE::ValueHandle		Evaluate (NE::EvaluationEnv& env) const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
@@ -15,7 +15,7 @@ template <class SlotType>
 Rect GetSlotRect (const UINodePtr& uiNode, const NE::SlotId& slotId, NodeUIDrawingEnvironment& env);
 
 template <class SlotType>
-static void EnumerateUISlots (const UINodePtr& uiNode, const std::function<bool (SlotType)>& processor);
+struct UISlotEnumerator;
 
 template <>
 Point GetSlotConnPosition<UIInputSlotPtr> (const UINodePtr& uiNode, const NE::SlotId& slotId, NodeUIDrawingEnvironment& env)
@@ -54,23 +54,31 @@ Rect GetSlotRect<UIOutputSlotPtr> (const UINodePtr& uiNode, const NE::SlotId& sl
 }
 
 template <>
-void EnumerateUISlots<UIInputSlotPtr> (const UINodePtr& uiNode, const std::function<bool (UIInputSlotPtr)>& processor)
+struct UISlotEnumerator<UIInputSlotPtr>
 {
-	uiNode->EnumerateUIInputSlots (processor);
-}
+	template <typename Processor>
+	static void Enumerate (const UINodePtr& uiNode, Processor&& processor)
+	{
+		uiNode->ForEachUIInputSlot (processor);
+	}
+};
 
 template <>
-void EnumerateUISlots<UIOutputSlotPtr> (const UINodePtr& uiNode, const std::function<bool (UIOutputSlotPtr)>& processor)
+struct UISlotEnumerator<UIOutputSlotPtr>
 {
-	uiNode->EnumerateUIOutputSlots (processor);
-}
+	template <typename Processor>
+	static void Enumerate (const UINodePtr& uiNode, Processor&& processor)
+	{
+		uiNode->ForEachUIOutputSlot (processor);
+	}
+};
 
 template <class SlotType>
 static SlotType FindSlotInNode (const UINodePtr& uiNode, const NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition)
 {
 	SlotType foundSlot = nullptr;
 	const ViewBox& viewBox = uiManager.GetViewBox ();
-	EnumerateUISlots<SlotType> (uiNode, [&] (SlotType currentSlot) {
+	UISlotEnumerator<SlotType>::Enumerate (uiNode, [&] (const SlotType& currentSlot) {
 		if (HasSlotRect<SlotType> (uiNode, currentSlot->GetId (), env)) {
 			Rect slotModelRect = GetSlotRect<SlotType> (uiNode, currentSlot->GetId (), env);
 			Rect slotRect = viewBox.ModelToView (slotModelRect);
@@ -90,8 +98,8 @@ static SlotType FindSlotByConnPosition (NodeUIManager& uiManager, NodeUIDrawingE
 	SlotType foundSlot = nullptr;
 	double minDistance = INF;
 	const ViewBox& viewBox = uiManager.GetViewBox ();
-	uiManager.EnumerateNodes ([&] (UINodePtr uiNode) {
-		EnumerateUISlots<SlotType> (uiNode, [&] (SlotType currentSlot) {
+	uiManager.ForEachNode ([&] (UINodePtr uiNode) {
+		UISlotEnumerator<SlotType>::Enumerate (uiNode, [&] (const SlotType& currentSlot) {
 			Point slotModelConnPosition = GetSlotConnPosition<SlotType> (uiNode, currentSlot->GetId (), env);
 			Point slotConnPosition = viewBox.ModelToView (slotModelConnPosition);
 			double distance = Point::Distance (viewPosition, slotConnPosition);
@@ -140,7 +148,7 @@ UINodePtr FindNodeUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironm
 {
 	const ViewBox& viewBox = uiManager.GetViewBox ();
 	UINodePtr foundNode = nullptr;
-	uiManager.EnumerateNodes ([&] (UINodePtr uiNode) {
+	uiManager.ForEachNode ([&] (UINodePtr uiNode) {
 		Rect nodeRect = viewBox.ModelToView (uiNode->GetRect (env));
 		if (nodeRect.Contains (viewPosition)) {
 			foundNode = uiNode;
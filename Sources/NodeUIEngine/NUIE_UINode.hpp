@@ -3,6 +3,7 @@
 
 #include "NE_LocString.hpp"
 #include "NE_Node.hpp"
+#include "NE_Debug.hpp"
 #include "NUIE_NodeDrawingImage.hpp"
 #include "NUIE_NodeUIEnvironment.hpp"
 #include "NUIE_InputEventHandler.hpp"
@@ -68,6 +69,16 @@ public:
 	void						EnumerateUIInputSlots (const std::function<bool (UIInputSlotConstPtr)>& processor) const;
 	void						EnumerateUIOutputSlots (const std::function<bool (UIOutputSlotConstPtr)>& processor) const;
 
+	template <typename Processor>
+	void						ForEachUIInputSlot (Processor&& processor);
+	template <typename Processor>
+	void						ForEachUIOutputSlot (Processor&& processor);
+
+	template <typename Processor>
+	void						ForEachUIInputSlot (Processor&& processor) const;
+	template <typename Processor>
+	void						ForEachUIOutputSlot (Processor&& processor) const;
+
 	virtual EventHandlerResult	HandleMouseClick (NodeUIEnvironment& env, const ModifierKeys& modifierKeys, MouseButton mouseButton, const Point& position, UINodeCommandInterface& commandInterface);
 	virtual EventHandlerResult	HandleMouseDoubleClick (NodeUIEnvironment& env, const ModifierKeys& modifierKeys, MouseButton mouseButton, const Point& position, UINodeCommandInterface& commandInterface);
 
@@ -97,6 +108,43 @@ private:
 using UINodePtr = std::shared_ptr<UINode>;
 using UINodeConstPtr = std::shared_ptr<const UINode>;
 
+// ui nodes register their slots as ui slots, so the slot types are checked only in debug builds
+template <typename Processor>
+void UINode::ForEachUIInputSlot (Processor&& processor)
+{
+	ForEachInputSlot ([&] (const NE::InputSlotPtr& inputSlot) {
+		DBGASSERT (dynamic_cast<UIInputSlot*> (inputSlot.get ()) != nullptr);
+		return processor (std::static_pointer_cast<UIInputSlot> (inputSlot));
+	});
+}
+
+template <typename Processor>
+void UINode::ForEachUIOutputSlot (Processor&& processor)
+{
+	ForEachOutputSlot ([&] (const NE::OutputSlotPtr& outputSlot) {
+		DBGASSERT (dynamic_cast<UIOutputSlot*> (outputSlot.get ()) != nullptr);
+		return processor (std::static_pointer_cast<UIOutputSlot> (outputSlot));
+	});
+}
+
+template <typename Processor>
+void UINode::ForEachUIInputSlot (Processor&& processor) const
+{
+	ForEachInputSlot ([&] (const NE::InputSlotConstPtr& inputSlot) {
+		DBGASSERT (dynamic_cast<const UIInputSlot*> (inputSlot.get ()) != nullptr);
+		return processor (std::static_pointer_cast<const UIInputSlot> (inputSlot));
+	});
+}
+
+template <typename Processor>
+void UINode::ForEachUIOutputSlot (Processor&& processor) const
+{
+	ForEachOutputSlot ([&] (const NE::OutputSlotConstPtr& outputSlot) {
+		DBGASSERT (dynamic_cast<const UIOutputSlot*> (outputSlot.get ()) != nullptr);
+		return processor (std::static_pointer_cast<const UIOutputSlot> (outputSlot));
+	});
+}
+
 }
 
 #endif
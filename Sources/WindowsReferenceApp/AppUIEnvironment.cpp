@@ -265,6 +265,11 @@ void AppUIEnvironment::OnEvaluationEnd ()
 
 }
 
+void AppUIEnvironment::OnEvaluationProgress (const NE::EvaluationProgress&)
+{
+
+}
+
 void AppUIEnvironment::OnValuesRecalculated ()
 {
 		
@@ -26,6 +26,7 @@ public:
 
 	virtual void						OnEvaluationBegin () override;
 	virtual void						OnEvaluationEnd () override;
+	virtual void						OnEvaluationProgress (const NE::EvaluationProgress& progress) override;
 
 	virtual void						OnValuesRecalculated () override;
 	virtual void						OnRedrawRequested () override;